@@ -37,6 +37,7 @@
   V(File_SetPosition, 2)                                                       \
   V(File_Truncate, 2)                                                          \
   V(File_Length, 1)                                                            \
+  V(File_Map, 5)                                                               \
   V(File_LengthFromName, 1)                                                    \
   V(File_LastModified, 1)                                                      \
   V(File_Flush, 1)                                                             \
@@ -47,6 +48,8 @@
   V(File_OpenStdio, 1)                                                         \
   V(File_GetStdioHandleType, 1)                                                \
   V(File_NewServicePort, 0)                                                    \
+  V(File_SubmitIO, 2)                                                          \
+  V(JsonParser_Parse, 2)                                                       \
   V(Logger_PrintString, 1)
 
 BUILTIN_NATIVE_LIST(DECLARE_FUNCTION);
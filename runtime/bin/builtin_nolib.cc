@@ -13,7 +13,7 @@
 Builtin::builtin_lib_props Builtin::builtin_libraries_[] = {
   /* { url_, source_, patch_url_, patch_source_, has_natives_ } */
   { DartUtils::kBuiltinLibURL, NULL, NULL, NULL, true },
-  { DartUtils::kJsonLibURL, NULL, NULL, NULL, false },
+  { DartUtils::kJsonLibURL, NULL, NULL, NULL, true },
   { DartUtils::kUriLibURL, NULL, NULL, NULL, false },
   { DartUtils::kCryptoLibURL, NULL, NULL, NULL, false },
   { DartUtils::kIOLibURL, NULL, NULL, NULL, true  },
@@ -54,3 +54,11 @@ void FUNCTION_NAME(Common_IsBuiltinList)(Dart_NativeArguments args) {
   Dart_SetReturnValue(args, Dart_NewBoolean(builtin_array));
   Dart_ExitScope();
 }
+
+
+void FUNCTION_NAME(Common_IsExternalByteArray)(Dart_NativeArguments args) {
+  Dart_EnterScope();
+  Dart_Handle list = Dart_GetNativeArgument(args, 0);
+  Dart_SetReturnValue(args, Dart_NewBoolean(Dart_IsByteArrayExternal(list)));
+  Dart_ExitScope();
+}
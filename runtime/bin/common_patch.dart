@@ -5,6 +5,8 @@
 patch class _BufferUtils {
   /* patch */ static bool _isBuiltinList(List buffer)
       native "Common_IsBuiltinList";
+  /* patch */ static bool _isExternalByteArray(List buffer)
+      native "Common_IsExternalByteArray";
 }
 
 
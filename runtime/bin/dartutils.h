@@ -169,6 +169,7 @@ class DartUtils {
   static const char* kIOLibURL;
   static const char* kIOLibPatchURL;
   static const char* kJsonLibURL;
+  static const char* kJsonLibPatchURL;
   static const char* kUriLibURL;
   static const char* kUtfLibURL;
   static const char* kIsolateLibURL;
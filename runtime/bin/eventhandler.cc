@@ -10,8 +10,6 @@
 
 
 static const int kNativeEventHandlerFieldIndex = 0;
-static const intptr_t kTimerId = -1;
-static const intptr_t kInvalidId = -2;
 
 /*
  * Returns the reference of the EventHandler stored in the native field.
@@ -63,12 +61,8 @@ void FUNCTION_NAME(EventHandler_SendData)(Dart_NativeArguments args) {
   Dart_Handle handle = Dart_GetNativeArgument(args, 0);
   EventHandler* event_handler = GetEventHandler(handle);
   Dart_Handle sender = Dart_GetNativeArgument(args, 1);
-  intptr_t id = kInvalidId;
-  if (Dart_IsNull(sender)) {
-    id = kTimerId;
-  } else {
-    Socket::GetSocketIdNativeField(sender, &id);
-  }
+  intptr_t id = 0;
+  Socket::GetSocketIdNativeField(sender, &id);
   handle = Dart_GetNativeArgument(args, 2);
   Dart_Port dart_port =
       DartUtils::GetIntegerField(handle, DartUtils::kIdFieldName);
@@ -76,3 +70,36 @@ void FUNCTION_NAME(EventHandler_SendData)(Dart_NativeArguments args) {
   event_handler->SendData(id, dart_port, data);
   Dart_ExitScope();
 }
+
+
+/*
+ * Adds a timer posting to the ReceivePort args[1] at the time args[2], in
+ * milliseconds since the epoch, and returns its id. args[0] holds the
+ * reference to the dart EventHandler object.
+ */
+void FUNCTION_NAME(EventHandler_AddTimer)(Dart_NativeArguments args) {
+  Dart_EnterScope();
+  EventHandler* event_handler =
+      GetEventHandler(Dart_GetNativeArgument(args, 0));
+  Dart_Port dart_port = DartUtils::GetIntegerField(
+      Dart_GetNativeArgument(args, 1), DartUtils::kIdFieldName);
+  int64_t deadline =
+      DartUtils::GetIntegerValue(Dart_GetNativeArgument(args, 2));
+  intptr_t id = event_handler->AddTimer(dart_port, deadline);
+  Dart_SetReturnValue(args, Dart_NewInteger(id));
+  Dart_ExitScope();
+}
+
+
+/*
+ * Cancels the timer with the id args[1]. args[0] holds the reference to the
+ * dart EventHandler object.
+ */
+void FUNCTION_NAME(EventHandler_CancelTimer)(Dart_NativeArguments args) {
+  Dart_EnterScope();
+  EventHandler* event_handler =
+      GetEventHandler(Dart_GetNativeArgument(args, 0));
+  intptr_t id = DartUtils::GetIntptrValue(Dart_GetNativeArgument(args, 1));
+  event_handler->CancelTimer(id);
+  Dart_ExitScope();
+}
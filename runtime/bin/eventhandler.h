@@ -44,6 +44,14 @@ class EventHandler {
     delegate_.SendData(id, dart_port, data);
   }
 
+  intptr_t AddTimer(Dart_Port dart_port, int64_t deadline) {
+    return delegate_.AddTimer(dart_port, deadline);
+  }
+
+  void CancelTimer(intptr_t id) {
+    delegate_.CancelTimer(id);
+  }
+
   void Shutdown() {
     delegate_.Shutdown();
   }
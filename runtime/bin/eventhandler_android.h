@@ -13,7 +13,9 @@
 #include <unistd.h>
 #include <sys/socket.h>
 
+#include "bin/timer_wheel.h"
 #include "platform/hashmap.h"
+#include "platform/thread.h"
 
 class InterruptMessage {
  public:
@@ -91,9 +93,12 @@ class EventHandlerImplementation {
   ~EventHandlerImplementation();
 
   // Gets the socket data structure for a given file
-  // descriptor. Creates a new one if one is not found.
+  // descriptor. Creates a new one if one is not found. Must be called
+  // with the mutex held.
   SocketData* GetSocketData(intptr_t fd);
   void SendData(intptr_t id, Dart_Port dart_port, intptr_t data);
+  intptr_t AddTimer(Dart_Port dart_port, int64_t deadline);
+  void CancelTimer(intptr_t id);
   void Start();
   void Shutdown();
 
@@ -105,17 +110,22 @@ class EventHandlerImplementation {
   static void Poll(uword args);
   void WakeupHandler(intptr_t id, Dart_Port dart_port, int64_t data);
   void HandleInterruptFd();
+  bool TryRearm(intptr_t fd, Dart_Port dart_port, intptr_t data);
   void SetPort(intptr_t fd, Dart_Port dart_port, intptr_t mask);
   intptr_t GetPollEvents(intptr_t events, SocketData* sd);
   static void* GetHashmapKeyFromFd(intptr_t fd);
   static uint32_t GetHashmapHashFromFd(intptr_t fd);
 
   HashMap socket_map_;
-  int64_t timeout_;  // Time for next timeout.
-  Dart_Port timeout_port_;
+  TimerWheel timers_;
   bool shutdown_;
   int interrupt_fds_[2];
   int epoll_fd_;
+  // Protects the socket map and the socket data, which are also accessed
+  // by the threads sending data to the event handler, and the number of
+  // messages sent through the interrupt fds and not yet handled.
+  dart::Mutex mutex_;
+  intptr_t pending_messages_;
 };
 
 
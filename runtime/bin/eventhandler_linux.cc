@@ -10,27 +10,18 @@
 #include <string.h>
 #include <sys/epoll.h>
 #include <sys/stat.h>
-#include <sys/time.h>
 #include <unistd.h>
 
 #include "bin/dartutils.h"
 #include "bin/fdutils.h"
 #include "bin/log.h"
+#include "bin/thread.h"
+#include "bin/utils.h"
 #include "platform/hashmap.h"
 #include "platform/thread.h"
 #include "platform/utils.h"
 
 
-int64_t GetCurrentTimeMilliseconds() {
-  struct timeval tv;
-  if (gettimeofday(&tv, NULL) < 0) {
-    UNREACHABLE();
-    return 0;
-  }
-  return ((static_cast<int64_t>(tv.tv_sec) * 1000000) + tv.tv_usec) / 1000;
-}
-
-
 static const int kInterruptMessageSize = sizeof(InterruptMessage);
 static const int kInfinityTimeout = -1;
 static const int kTimerId = -1;
@@ -71,12 +62,15 @@ static void RemoveFromEpollInstance(intptr_t epoll_fd_, SocketData* sd) {
 
 
 // Register the file descriptor for a SocketData structure with epoll
-// if events are requested.
+// if events are requested. File descriptors are registered in one-shot
+// mode: after reporting an event epoll disables the file descriptor
+// until it is registered again.
 static void UpdateEpollInstance(intptr_t epoll_fd_, SocketData* sd) {
   struct epoll_event event;
   event.events = sd->GetPollEvents();
   event.data.ptr = sd;
   if (sd->port() != 0 && event.events != 0) {
+    event.events |= EPOLLONESHOT;
     int status = 0;
     if (sd->tracked_by_epoll()) {
       status = TEMP_FAILURE_RETRY(epoll_ctl(epoll_fd_,
@@ -98,7 +92,7 @@ static void UpdateEpollInstance(intptr_t epoll_fd_, SocketData* sd) {
 
 
 EventHandlerImplementation::EventHandlerImplementation()
-    : socket_map_(&HashMap::SamePointerValue, 16) {
+    : socket_map_(&HashMap::SamePointerValue, 16), pending_messages_(0) {
   intptr_t result;
   result = TEMP_FAILURE_RETRY(pipe(interrupt_fds_));
   if (result != 0) {
@@ -107,8 +101,6 @@ EventHandlerImplementation::EventHandlerImplementation()
   FDUtils::SetNonBlocking(interrupt_fds_[0]);
   FDUtils::SetCloseOnExec(interrupt_fds_[0]);
   FDUtils::SetCloseOnExec(interrupt_fds_[1]);
-  timeout_ = kInfinityTimeout;
-  timeout_port_ = 0;
   shutdown_ = false;
   // The initial size passed to epoll_create is ignore on newer (>=
   // 2.6.8) Linux versions
@@ -196,9 +188,12 @@ bool EventHandlerImplementation::GetInterruptMessage(InterruptMessage* msg) {
 void EventHandlerImplementation::HandleInterruptFd() {
   InterruptMessage msg;
   while (GetInterruptMessage(&msg)) {
+    // The socket map and the socket data are shared with the threads
+    // re-arming registrations in SendData. The message stays pending until
+    // it has been applied, so a re-arm can never be overwritten by it.
+    MutexLocker ml(&mutex_);
     if (msg.id == kTimerId) {
-      timeout_ = msg.data;
-      timeout_port_ = msg.dart_port;
+      // A timer was added. The next wait uses the new deadline.
     } else if (msg.id == kShutdownId) {
       shutdown_ = true;
     } else {
@@ -228,6 +223,7 @@ void EventHandlerImplementation::HandleInterruptFd() {
         UpdateEpollInstance(epoll_fd_, sd);
       }
     }
+    pending_messages_--;
   }
 }
 
@@ -335,18 +331,23 @@ intptr_t EventHandlerImplementation::GetPollEvents(intptr_t events,
 
 void EventHandlerImplementation::HandleEvents(struct epoll_event* events,
                                               int size) {
-  for (int i = 0; i < size; i++) {
-    if (events[i].data.ptr != NULL) {
-      SocketData* sd = reinterpret_cast<SocketData*>(events[i].data.ptr);
-      intptr_t event_mask = GetPollEvents(events[i].events, sd);
-      if (event_mask != 0) {
-        // Unregister events for the file descriptor. Events will be
-        // registered again when the current event has been handled in
-        // Dart code.
-        RemoveFromEpollInstance(epoll_fd_, sd);
-        Dart_Port port = sd->port();
-        ASSERT(port != 0);
-        DartUtils::PostInt32(port, event_mask);
+  {
+    MutexLocker ml(&mutex_);
+    for (int i = 0; i < size; i++) {
+      if (events[i].data.ptr != NULL) {
+        SocketData* sd = reinterpret_cast<SocketData*>(events[i].data.ptr);
+        intptr_t event_mask = GetPollEvents(events[i].events, sd);
+        if (event_mask != 0) {
+          // Epoll has disabled the file descriptor. Events will be
+          // registered again when the current event has been handled in
+          // Dart code.
+          Dart_Port port = sd->port();
+          ASSERT(port != 0);
+          DartUtils::PostInt32(port, event_mask);
+        } else {
+          // Nothing to report, wait for the next event.
+          UpdateEpollInstance(epoll_fd_, sd);
+        }
       }
     }
   }
@@ -355,28 +356,23 @@ void EventHandlerImplementation::HandleEvents(struct epoll_event* events,
 
 
 intptr_t EventHandlerImplementation::GetTimeout() {
-  if (timeout_ == kInfinityTimeout) {
+  int64_t deadline = timers_.NextDeadline();
+  if (deadline == TimerWheel::kNoDeadline) {
     return kInfinityTimeout;
   }
-  intptr_t millis = timeout_ - GetCurrentTimeMilliseconds();
+  intptr_t millis = deadline - TimerUtils::GetCurrentTimeMilliseconds();
   return (millis < 0) ? 0 : millis;
 }
 
 
 void EventHandlerImplementation::HandleTimeout() {
-  if (timeout_ != kInfinityTimeout) {
-    intptr_t millis = timeout_ - GetCurrentTimeMilliseconds();
-    if (millis <= 0) {
-      DartUtils::PostNull(timeout_port_);
-      timeout_ = kInfinityTimeout;
-      timeout_port_ = 0;
-    }
-  }
+  TimerWheel::PostExpired(
+      timers_.Expire(TimerUtils::GetCurrentTimeMilliseconds()));
 }
 
 
 void EventHandlerImplementation::Poll(uword args) {
-  static const intptr_t kMaxEvents = 16;
+  static const intptr_t kMaxEvents = 128;
   struct epoll_event events[kMaxEvents];
   EventHandlerImplementation* handler =
       reinterpret_cast<EventHandlerImplementation*>(args);
@@ -414,13 +410,70 @@ void EventHandlerImplementation::Shutdown() {
 }
 
 
+intptr_t EventHandlerImplementation::AddTimer(Dart_Port dart_port,
+                                              int64_t deadline) {
+  bool wakeup = false;
+  intptr_t id = timers_.Add(dart_port,
+                            deadline,
+                            TimerUtils::GetCurrentTimeMilliseconds(),
+                            &wakeup);
+  if (wakeup) {
+    // The event handler is waiting for a later deadline.
+    SendData(kTimerId, 0, 0);
+  }
+  return id;
+}
+
+
+void EventHandlerImplementation::CancelTimer(intptr_t id) {
+  timers_.Cancel(id);
+}
+
+
 void EventHandlerImplementation::SendData(intptr_t id,
                                           Dart_Port dart_port,
                                           int64_t data) {
+  {
+    MutexLocker ml(&mutex_);
+    // Messages still queued in the interrupt fds must not be overtaken.
+    if ((id >= 0) && (pending_messages_ == 0) &&
+        TryRearm(id, dart_port, data)) {
+      return;
+    }
+    pending_messages_++;
+  }
   WakeupHandler(id, dart_port, data);
 }
 
 
+// Registering the events of interest again after an event has been
+// handled in Dart code is the common case. It is done directly on the
+// calling thread, saving the round trip through the interrupt fds to the
+// event handler thread. Must be called with the mutex held.
+bool EventHandlerImplementation::TryRearm(intptr_t fd,
+                                          Dart_Port dart_port,
+                                          int64_t data) {
+  static const int64_t kCommands = (1 << kCloseCommand) |
+                                   (1 << kShutdownReadCommand) |
+                                   (1 << kShutdownWriteCommand);
+  if ((data & kCommands) != 0) {
+    return false;
+  }
+  HashMap::Entry* entry = socket_map_.Lookup(
+      GetHashmapKeyFromFd(fd), GetHashmapHashFromFd(fd), false);
+  if (entry == NULL) {
+    return false;
+  }
+  SocketData* sd = reinterpret_cast<SocketData*>(entry->value);
+  if (!sd->tracked_by_epoll()) {
+    return false;
+  }
+  sd->SetPortAndMask(dart_port, data);
+  UpdateEpollInstance(epoll_fd_, sd);
+  return true;
+}
+
+
 void* EventHandlerImplementation::GetHashmapKeyFromFd(intptr_t fd) {
   // The hashmap does not support keys with value 0.
   return reinterpret_cast<void*>(fd + 1);
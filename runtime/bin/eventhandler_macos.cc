@@ -9,27 +9,17 @@
 #include <stdio.h>
 #include <string.h>
 #include <sys/event.h>
-#include <sys/time.h>
 #include <unistd.h>
 
 #include "bin/dartutils.h"
 #include "bin/fdutils.h"
 #include "bin/log.h"
+#include "bin/utils.h"
 #include "platform/hashmap.h"
 #include "platform/thread.h"
 #include "platform/utils.h"
 
 
-int64_t GetCurrentTimeMilliseconds() {
-  struct timeval tv;
-  if (gettimeofday(&tv, NULL) < 0) {
-    UNREACHABLE();
-    return 0;
-  }
-  return ((static_cast<int64_t>(tv.tv_sec) * 1000000) + tv.tv_usec) / 1000;
-}
-
-
 static const int kInterruptMessageSize = sizeof(InterruptMessage);
 static const int kInfinityTimeout = -1;
 static const int kTimerId = -1;
@@ -125,8 +115,6 @@ EventHandlerImplementation::EventHandlerImplementation()
   FDUtils::SetNonBlocking(interrupt_fds_[0]);
   FDUtils::SetCloseOnExec(interrupt_fds_[0]);
   FDUtils::SetCloseOnExec(interrupt_fds_[1]);
-  timeout_ = kInfinityTimeout;
-  timeout_port_ = 0;
   shutdown_ = false;
 
   kqueue_fd_ = TEMP_FAILURE_RETRY(kqueue());
@@ -209,8 +197,7 @@ void EventHandlerImplementation::HandleInterruptFd() {
   InterruptMessage msg;
   while (GetInterruptMessage(&msg)) {
     if (msg.id == kTimerId) {
-      timeout_ = msg.data;
-      timeout_port_ = msg.dart_port;
+      // A timer was added. The next wait uses the new deadline.
     } else if (msg.id == kShutdownId) {
       shutdown_ = true;
     } else {
@@ -340,28 +327,23 @@ void EventHandlerImplementation::HandleEvents(struct kevent* events,
 
 
 intptr_t EventHandlerImplementation::GetTimeout() {
-  if (timeout_ == kInfinityTimeout) {
+  int64_t deadline = timers_.NextDeadline();
+  if (deadline == TimerWheel::kNoDeadline) {
     return kInfinityTimeout;
   }
-  intptr_t millis = timeout_ - GetCurrentTimeMilliseconds();
+  intptr_t millis = deadline - TimerUtils::GetCurrentTimeMilliseconds();
   return (millis < 0) ? 0 : millis;
 }
 
 
 void EventHandlerImplementation::HandleTimeout() {
-  if (timeout_ != kInfinityTimeout) {
-    intptr_t millis = timeout_ - GetCurrentTimeMilliseconds();
-    if (millis <= 0) {
-      DartUtils::PostNull(timeout_port_);
-      timeout_ = kInfinityTimeout;
-      timeout_port_ = 0;
-    }
-  }
+  TimerWheel::PostExpired(
+      timers_.Expire(TimerUtils::GetCurrentTimeMilliseconds()));
 }
 
 
 void EventHandlerImplementation::EventHandlerEntry(uword args) {
-  static const intptr_t kMaxEvents = 16;
+  static const intptr_t kMaxEvents = 128;
   struct kevent events[kMaxEvents];
   EventHandlerImplementation* handler =
       reinterpret_cast<EventHandlerImplementation*>(args);
@@ -408,6 +390,26 @@ void EventHandlerImplementation::Shutdown() {
 }
 
 
+intptr_t EventHandlerImplementation::AddTimer(Dart_Port dart_port,
+                                              int64_t deadline) {
+  bool wakeup = false;
+  intptr_t id = timers_.Add(dart_port,
+                            deadline,
+                            TimerUtils::GetCurrentTimeMilliseconds(),
+                            &wakeup);
+  if (wakeup) {
+    // The event handler is waiting for a later deadline.
+    SendData(kTimerId, 0, 0);
+  }
+  return id;
+}
+
+
+void EventHandlerImplementation::CancelTimer(intptr_t id) {
+  timers_.Cancel(id);
+}
+
+
 void EventHandlerImplementation::SendData(intptr_t id,
                                           Dart_Port dart_port,
                                           int64_t data) {
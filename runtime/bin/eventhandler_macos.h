@@ -12,6 +12,7 @@
 #include <unistd.h>
 #include <sys/socket.h>
 
+#include "bin/timer_wheel.h"
 #include "platform/hashmap.h"
 
 class InterruptMessage {
@@ -106,6 +107,8 @@ class EventHandlerImplementation {
   // descriptor. Creates a new one if one is not found.
   SocketData* GetSocketData(intptr_t fd);
   void SendData(intptr_t id, Dart_Port dart_port, int64_t data);
+  intptr_t AddTimer(Dart_Port dart_port, int64_t deadline);
+  void CancelTimer(intptr_t id);
   void Start();
   void Shutdown();
 
@@ -123,8 +126,7 @@ class EventHandlerImplementation {
   static uint32_t GetHashmapHashFromFd(intptr_t fd);
 
   HashMap socket_map_;
-  int64_t timeout_;  // Time for next timeout.
-  Dart_Port timeout_port_;
+  TimerWheel timers_;
   bool shutdown_;
   int interrupt_fds_[2];
   int kqueue_fd_;
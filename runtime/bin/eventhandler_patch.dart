@@ -18,6 +18,16 @@ patch class _EventHandler {
     }
   }
 
+  /* patch */ static int _addTimer(ReceivePort receivePort, int wakeupTime) {
+    return _eventHandler._addTimer(receivePort, wakeupTime);
+  }
+
+  /* patch */ static void _cancelTimer(int id) {
+    if (_eventHandler != null) {
+      _eventHandler._cancelTimer(id);
+    }
+  }
+
   static _EventHandlerImpl _eventHandler;
 }
 
@@ -27,4 +37,7 @@ class _EventHandlerImpl extends NativeFieldWrapperClass1 {
   void _start() native "EventHandler_Start";
   void _sendData(Object sender, ReceivePort receivePort, int data)
       native "EventHandler_SendData";
+  int _addTimer(ReceivePort receivePort, int wakeupTime)
+      native "EventHandler_AddTimer";
+  void _cancelTimer(int id) native "EventHandler_CancelTimer";
 }
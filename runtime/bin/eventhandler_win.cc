@@ -13,6 +13,7 @@
 #include "bin/dartutils.h"
 #include "bin/log.h"
 #include "bin/socket.h"
+#include "bin/utils.h"
 #include "platform/thread.h"
 
 
@@ -21,23 +22,6 @@ static const int kTimeoutId = -1;
 static const int kShutdownId = -2;
 
 
-int64_t GetCurrentTimeMilliseconds() {
-  static const int64_t kTimeEpoc = 116444736000000000LL;
-
-  // Although win32 uses 64-bit integers for representing timestamps,
-  // these are packed into a FILETIME structure. The FILETIME structure
-  // is just a struct representing a 64-bit integer. The TimeStamp union
-  // allows access to both a FILETIME and an integer representation of
-  // the timestamp.
-  union TimeStamp {
-    FILETIME ft_;
-    int64_t t_;
-  };
-  TimeStamp time;
-  GetSystemTimeAsFileTime(&time.ft_);
-  return (time.t_ - kTimeEpoc) / 10000;
-}
-
 IOBuffer* IOBuffer::AllocateBuffer(int buffer_size, Operation operation) {
   IOBuffer* buffer = new(buffer_size) IOBuffer(buffer_size, operation);
   return buffer;
@@ -629,10 +613,8 @@ bool ClientSocket::IsClosed() {
 
 void EventHandlerImplementation::HandleInterrupt(InterruptMessage* msg) {
   if (msg->id == kTimeoutId) {
-    // Change of timeout request. Just set the new timeout and port as the
-    // completion thread will use the new timeout value for its next wait.
-    timeout_ = msg->data;
-    timeout_port_ = msg->dart_port;
+    // A timer was added. The completion thread uses the new deadline for
+    // its next wait.
   } else if (msg->id == kShutdownId) {
     shutdown_ = true;
   } else {
@@ -806,10 +788,8 @@ void EventHandlerImplementation::HandleWrite(Handle* handle,
 
 
 void EventHandlerImplementation::HandleTimeout() {
-  // TODO(sgjesse) check if there actually is a timeout.
-  DartUtils::PostNull(timeout_port_);
-  timeout_ = kInfinityTimeout;
-  timeout_port_ = 0;
+  TimerWheel::PostExpired(
+      timers_.Expire(TimerUtils::GetCurrentTimeMilliseconds()));
 }
 
 
@@ -846,17 +826,16 @@ EventHandlerImplementation::EventHandlerImplementation() {
   if (completion_port_ == NULL) {
     FATAL("Completion port creation failed");
   }
-  timeout_ = kInfinityTimeout;
-  timeout_port_ = 0;
   shutdown_ = false;
 }
 
 
 DWORD EventHandlerImplementation::GetTimeout() {
-  if (timeout_ == kInfinityTimeout) {
+  int64_t deadline = timers_.NextDeadline();
+  if (deadline == TimerWheel::kNoDeadline) {
     return kInfinityTimeout;
   }
-  intptr_t millis = timeout_ - GetCurrentTimeMilliseconds();
+  intptr_t millis = deadline - TimerUtils::GetCurrentTimeMilliseconds();
   return (millis < 0) ? 0 : millis;
 }
 
@@ -876,6 +855,26 @@ void EventHandlerImplementation::SendData(intptr_t id,
 }
 
 
+intptr_t EventHandlerImplementation::AddTimer(Dart_Port dart_port,
+                                              int64_t deadline) {
+  bool wakeup = false;
+  intptr_t id = timers_.Add(dart_port,
+                            deadline,
+                            TimerUtils::GetCurrentTimeMilliseconds(),
+                            &wakeup);
+  if (wakeup) {
+    // The event handler is waiting for a later deadline.
+    SendData(kTimeoutId, 0, 0);
+  }
+  return id;
+}
+
+
+void EventHandlerImplementation::CancelTimer(intptr_t id) {
+  timers_.Cancel(id);
+}
+
+
 void EventHandlerImplementation::EventHandlerEntry(uword args) {
   EventHandlerImplementation* handler =
       reinterpret_cast<EventHandlerImplementation*>(args);
@@ -13,6 +13,7 @@
 #include <mswsock.h>
 
 #include "bin/builtin.h"
+#include "bin/timer_wheel.h"
 
 
 // Forward declarations.
@@ -351,6 +352,8 @@ class EventHandlerImplementation {
   virtual ~EventHandlerImplementation() {}
 
   void SendData(intptr_t id, Dart_Port dart_port, int64_t data);
+  intptr_t AddTimer(Dart_Port dart_port, int64_t deadline);
+  void CancelTimer(intptr_t id);
   void Start();
   void Shutdown();
 
@@ -372,8 +375,7 @@ class EventHandlerImplementation {
  private:
   ClientSocket* client_sockets_head_;
 
-  int64_t timeout_;  // Time for next timeout.
-  Dart_Port timeout_port_;
+  TimerWheel timers_;
   bool shutdown_;
   HANDLE completion_port_;
 };
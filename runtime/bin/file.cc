@@ -6,6 +6,7 @@
 
 #include "bin/builtin.h"
 #include "bin/dartutils.h"
+#include "bin/file_io_engine.h"
 #include "bin/io_buffer.h"
 #include "bin/thread.h"
 #include "bin/utils.h"
@@ -73,6 +74,17 @@ File::FileOpenMode File::DartModeToFileMode(DartFileOpenMode mode) {
 }
 
 
+File::MapType File::DartMapModeToMapType(DartMapMode mode) {
+  ASSERT(mode == File::kDartMapRead || mode == File::kDartMapReadWrite);
+  if (mode == File::kDartMapReadWrite) {
+    return File::kMapReadWrite;
+  }
+  // Stores into a list mapped for reading must not fault. A copy-on-write
+  // mapping still shares its pages with the page cache until written to.
+  return File::kMapCopyOnWrite;
+}
+
+
 void FUNCTION_NAME(File_Open)(Dart_NativeArguments args) {
   Dart_EnterScope();
   const char* filename =
@@ -214,12 +226,12 @@ void FUNCTION_NAME(File_ReadList)(Dart_NativeArguments args) {
   Dart_Handle result = Dart_ListLength(buffer_obj, &array_len);
   if (Dart_IsError(result)) Dart_PropagateError(result);
   ASSERT((offset + length) <= array_len);
-  uint8_t* buffer = new uint8_t[length];
+  uint8_t* buffer = IOBuffer::Allocate(length);
   int64_t bytes_read = file->Read(reinterpret_cast<void*>(buffer), length);
   if (bytes_read >= 0) {
     result = Dart_ListSetAsBytes(buffer_obj, offset, buffer, bytes_read);
     if (Dart_IsError(result)) {
-      delete[] buffer;
+      IOBuffer::Free(buffer);
       Dart_PropagateError(result);
     }
     Dart_SetReturnValue(args, Dart_NewInteger(bytes_read));
@@ -228,7 +240,7 @@ void FUNCTION_NAME(File_ReadList)(Dart_NativeArguments args) {
     if (Dart_IsError(err)) Dart_PropagateError(err);
     Dart_SetReturnValue(args, err);
   }
-  delete[] buffer;
+  IOBuffer::Free(buffer);
   Dart_ExitScope();
 }
 
@@ -251,10 +263,10 @@ void FUNCTION_NAME(File_WriteList)(Dart_NativeArguments args) {
   Dart_Handle result = Dart_ListLength(buffer_obj, &buffer_len);
   if (Dart_IsError(result)) Dart_PropagateError(result);
   ASSERT((offset + length) <= buffer_len);
-  uint8_t* buffer = new uint8_t[length];
+  uint8_t* buffer = IOBuffer::Allocate(length);
   result = Dart_ListGetAsBytes(buffer_obj, offset, buffer, length);
   if (Dart_IsError(result)) {
-    delete[] buffer;
+    IOBuffer::Free(buffer);
     Dart_PropagateError(result);
   }
   int64_t bytes_written = file->Write(reinterpret_cast<void*>(buffer), length);
@@ -265,7 +277,7 @@ void FUNCTION_NAME(File_WriteList)(Dart_NativeArguments args) {
     if (Dart_IsError(err)) Dart_PropagateError(err);
     Dart_SetReturnValue(args, err);
   }
-  delete[] buffer;
+  IOBuffer::Free(buffer);
   Dart_ExitScope();
 }
 
@@ -348,6 +360,68 @@ void FUNCTION_NAME(File_Length)(Dart_NativeArguments args) {
 }
 
 
+// A region mapped by File_Map. It is unmapped when the external byte array
+// referencing it is collected.
+struct MappedRegion {
+  void* address;
+  int64_t length;
+};
+
+
+static void UnmapRegion(void* peer) {
+  MappedRegion* region = reinterpret_cast<MappedRegion*>(peer);
+  File::Unmap(region->address, region->length);
+  delete region;
+}
+
+
+void FUNCTION_NAME(File_Map)(Dart_NativeArguments args) {
+  Dart_EnterScope();
+  File* file = GetFilePointer(Dart_GetNativeArgument(args, 0));
+  ASSERT(file != NULL);
+  File::DartMapMode mode = static_cast<File::DartMapMode>(
+      DartUtils::GetIntegerValue(Dart_GetNativeArgument(args, 1)));
+  // Position and length are checked against the file length in Dart code
+  // as accessing a mapping beyond the end of the file faults.
+  int64_t position =
+      DartUtils::GetIntegerValue(Dart_GetNativeArgument(args, 2));
+  int64_t length = DartUtils::GetIntegerValue(Dart_GetNativeArgument(args, 3));
+  File::MapAdvice advice = static_cast<File::MapAdvice>(
+      DartUtils::GetIntegerValue(Dart_GetNativeArgument(args, 4)));
+  ASSERT(position >= 0 && length > 0);
+  // Mappings start at an aligned position, the list starts at the
+  // requested position within the mapping.
+  int64_t offset = position % File::MapAlignment();
+  int64_t map_length = length + offset;
+  void* address = file->Map(File::DartMapModeToMapType(mode),
+                            position - offset,
+                            map_length);
+  if (address == NULL) {
+    Dart_Handle err = DartUtils::NewDartOSError();
+    if (Dart_IsError(err)) Dart_PropagateError(err);
+    Dart_SetReturnValue(args, err);
+    Dart_ExitScope();
+    return;
+  }
+  // The advice is only a hint, failing to apply it is not an error.
+  File::Advise(address, map_length, advice);
+  MappedRegion* region = new MappedRegion();
+  region->address = address;
+  region->length = map_length;
+  Dart_Handle result = Dart_NewExternalByteArray(
+      reinterpret_cast<uint8_t*>(address) + offset,
+      length,
+      region,
+      UnmapRegion);
+  if (Dart_IsError(result)) {
+    UnmapRegion(region);
+    Dart_PropagateError(result);
+  }
+  Dart_SetReturnValue(args, result);
+  Dart_ExitScope();
+}
+
+
 void FUNCTION_NAME(File_LengthFromName)(Dart_NativeArguments args) {
   Dart_EnterScope();
   const char* name =
@@ -483,6 +557,61 @@ void FUNCTION_NAME(File_GetStdioHandleType)(Dart_NativeArguments args) {
 }
 
 
+// Each request passed to File_SubmitIO is described by the fields
+// [id, file, operation, buffer, offset, length, position]. The buffer is an
+// external byte array, offset and length are checked in Dart code.
+static const intptr_t kSubmitIOFields = 7;
+
+
+static int64_t GetListInteger(Dart_Handle list, intptr_t index) {
+  return DartUtils::GetIntegerValue(Dart_ListGetAt(list, index));
+}
+
+
+void FUNCTION_NAME(File_SubmitIO)(Dart_NativeArguments args) {
+  Dart_EnterScope();
+  Dart_Port port = DartUtils::GetIntegerField(Dart_GetNativeArgument(args, 0),
+                                              DartUtils::kIdFieldName);
+  Dart_Handle fields = Dart_GetNativeArgument(args, 1);
+  intptr_t fields_length = 0;
+  Dart_Handle result = Dart_ListLength(fields, &fields_length);
+  if (Dart_IsError(result)) Dart_PropagateError(result);
+  ASSERT((fields_length % kSubmitIOFields) == 0);
+  intptr_t count = fields_length / kSubmitIOFields;
+  FileIOEngine::Request** requests = new FileIOEngine::Request*[count];
+  for (intptr_t i = 0; i < count; i++) {
+    intptr_t base = i * kSubmitIOFields;
+    void* data = NULL;
+    result = Dart_ExternalByteArrayGetData(Dart_ListGetAt(fields, base + 3),
+                                           &data);
+    if (Dart_IsError(result)) {
+      for (intptr_t j = 0; j < i; j++) delete requests[j];
+      delete[] requests;
+      Dart_PropagateError(result);
+    }
+    int64_t id = GetListInteger(fields, base);
+    File* file = GetFilePointer(Dart_ListGetAt(fields, base + 1));
+    ASSERT(file != NULL && !file->IsClosed());
+    FileIOEngine::Operation operation =
+        static_cast<FileIOEngine::Operation>(GetListInteger(fields, base + 2));
+    int64_t offset = GetListInteger(fields, base + 4);
+    int64_t length = GetListInteger(fields, base + 5);
+    int64_t position = GetListInteger(fields, base + 6);
+    requests[i] = new FileIOEngine::Request(
+        port,
+        id,
+        file,
+        operation,
+        reinterpret_cast<uint8_t*>(data) + offset,
+        length,
+        position);
+  }
+  FileIOEngine::Submit(requests, count);
+  delete[] requests;
+  Dart_ExitScope();
+}
+
+
 static int64_t CObjectInt32OrInt64ToInt64(CObject* cobject) {
   ASSERT(cobject->IsInt32OrInt64());
   int64_t result;
@@ -859,14 +988,14 @@ static CObject* FileWriteListRequest(const CObjectArray& request) {
         buffer_start = byte_array.Buffer() + offset;
       } else {
         CObjectArray array(request[2]);
-        buffer_start = new uint8_t[length];
+        buffer_start = IOBuffer::Allocate(length);
         for (int i = 0; i < length; i++) {
           if (array[i + offset]->IsInt32OrInt64()) {
             int64_t value = CObjectInt32OrInt64ToInt64(array[i + offset]);
             buffer_start[i] = static_cast<uint8_t>(value & 0xFF);
           } else {
             // Unsupported type.
-            delete[] buffer_start;
+            IOBuffer::Free(buffer_start);
             return CObject::IllegalArgumentError();
           }
         }
@@ -875,7 +1004,7 @@ static CObject* FileWriteListRequest(const CObjectArray& request) {
       int64_t bytes_written =
           file->Write(reinterpret_cast<void*>(buffer_start), length);
       if (!request[2]->IsUint8Array()) {
-        delete[] buffer_start;
+        IOBuffer::Free(buffer_start);
       }
       if (bytes_written >= 0) {
         return new CObjectInt64(CObject::NewInt64(bytes_written));
@@ -43,6 +43,28 @@ class File {
     kOther = -1
   };
 
+  enum MapType {
+    kMapReadOnly = 0,
+    kMapReadWrite = 1,
+    kMapCopyOnWrite = 2
+  };
+
+  // These values have to be kept in sync with the mode values of
+  // FileMapMode.READ and FileMapMode.READ_WRITE in file.dart.
+  enum DartMapMode {
+    kDartMapRead = 0,
+    kDartMapReadWrite = 1
+  };
+
+  // These values have to be kept in sync with the access values of
+  // FileMapAccess in file.dart.
+  enum MapAdvice {
+    kAdviceNormal = 0,
+    kAdviceSequential = 1,
+    kAdviceRandom = 2,
+    kAdviceWillNeed = 3
+  };
+
   enum FileRequest {
     kExistsRequest = 0,
     kCreateRequest = 1,
@@ -72,6 +94,12 @@ class File {
   int64_t Read(void* buffer, int64_t num_bytes);
   int64_t Write(const void* buffer, int64_t num_bytes);
 
+  // ReadAt/WriteAt attempt to transfer num_bytes to/from buffer starting
+  // at the given position in the file. The current position of the file is
+  // not used. They return the number of bytes read/written.
+  int64_t ReadAt(void* buffer, int64_t num_bytes, int64_t position);
+  int64_t WriteAt(const void* buffer, int64_t num_bytes, int64_t position);
+
   // ReadFully and WriteFully do attempt to transfer num_bytes to/from
   // the buffer. In the event of short accesses they will loop internally until
   // the whole buffer has been transferred or an error occurs. If an error
@@ -102,6 +130,36 @@ class File {
   // Returns whether the file has been closed.
   bool IsClosed();
 
+  // Map length bytes of the file starting at position into memory. A
+  // read-only mapping shares its pages with every other mapping of the
+  // same file, a read-write mapping writes changes through to the file. A
+  // copy-on-write mapping shares its pages until they are written to, the
+  // changes are not written to the file.
+  // The mapping stays valid after the file is closed and has to be
+  // released with Unmap. Returns NULL if the file cannot be mapped.
+  void* Map(MapType type, int64_t position, int64_t length);
+
+  // Release a mapping created by Map.
+  static bool Unmap(void* address, int64_t length);
+
+  // Tell the OS how a mapping created by Map is going to be accessed. This
+  // is only a hint and does nothing where the OS does not support it.
+  static bool Advise(void* address, int64_t length, MapAdvice advice);
+
+  // The position passed to Map has to be a multiple of the alignment.
+  static intptr_t MapAlignment();
+
+  // Write up to num_bytes of the file starting at position to the socket
+  // with the given id. Where the platform supports it the data is copied by
+  // the kernel without passing through user space. The current position of
+  // the file is not changed. Returns the number of bytes written, which is
+  // less than num_bytes if the socket cannot take more data without
+  // blocking, or -1 on error.
+  int64_t TransferTo(intptr_t socket, int64_t position, int64_t num_bytes);
+
+  // Returns the OS file descriptor of the file.
+  intptr_t GetFD();
+
   // Open the file with the given name. The file is always opened for
   // reading. If mode contains kWrite the file is opened for both
   // reading and writing. If mode contains kWrite and the file does
@@ -127,6 +185,8 @@ class File {
 
   static FileOpenMode DartModeToFileMode(DartFileOpenMode mode);
 
+  static MapType DartMapModeToMapType(DartMapMode mode);
+
   static Dart_Port GetServicePort();
 
  private:
@@ -0,0 +1,138 @@
+// Copyright (c) 2013, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "bin/file_io_engine.h"
+
+#include "bin/log.h"
+#include "bin/thread.h"
+
+
+// The worker threads wait on the monitor until the process exits, so it is
+// never destroyed.
+dart::Monitor* FileIOEngine::monitor_ = new dart::Monitor();
+FileIOEngine::Request* FileIOEngine::queue_head_ = NULL;
+FileIOEngine::Request* FileIOEngine::queue_tail_ = NULL;
+intptr_t FileIOEngine::worker_threads_ = 0;
+intptr_t FileIOEngine::idle_worker_threads_ = 0;
+
+
+// Has to be kept in sync with _OSERROR_RESPONSE in common.dart.
+static const int32_t kOSErrorResponse = 2;
+
+
+void FileIOEngine::Submit(Request** requests, intptr_t count) {
+  intptr_t submitted = PlatformSubmit(requests, count);
+  if (submitted == count) return;
+
+  MonitorLocker locker(monitor_);
+  for (intptr_t i = submitted; i < count; i++) {
+    Request* request = requests[i];
+    ASSERT(request->next_ == NULL);
+    if (queue_tail_ == NULL) {
+      queue_head_ = request;
+    } else {
+      queue_tail_->next_ = request;
+    }
+    queue_tail_ = request;
+  }
+  intptr_t pending = count - submitted;
+  while (idle_worker_threads_ < pending &&
+         worker_threads_ < kMaxWorkerThreads) {
+    int result = dart::Thread::Start(&WorkerMain, 0);
+    if (result != 0) {
+      Log::PrintErr("Failed to start file I/O worker thread %d\n", result);
+      break;
+    }
+    worker_threads_++;
+    pending--;
+  }
+  // With no worker threads the requests are performed by the submitter.
+  if (worker_threads_ == 0) {
+    while (queue_head_ != NULL) {
+      Request* request = queue_head_;
+      queue_head_ = request->next_;
+      if (queue_head_ == NULL) queue_tail_ = NULL;
+      Perform(request);
+    }
+    return;
+  }
+  locker.NotifyAll();
+}
+
+
+void FileIOEngine::Complete(Request* request, int64_t result,
+                            OSError* os_error) {
+  Dart_CObject id;
+  id.type = Dart_CObject::kInt64;
+  id.value.as_int64 = request->id();
+  Dart_CObject value;
+  Dart_CObject error_type;
+  Dart_CObject error_code;
+  Dart_CObject error_message;
+  Dart_CObject* error_values[3] = { &error_type, &error_code, &error_message };
+  if (os_error == NULL) {
+    value.type = Dart_CObject::kInt64;
+    value.value.as_int64 = result;
+  } else {
+    // The response is allocated on the stack as this thread might not have
+    // an API scope to allocate CObjects in.
+    error_type.type = Dart_CObject::kInt32;
+    error_type.value.as_int32 = kOSErrorResponse;
+    error_code.type = Dart_CObject::kInt32;
+    error_code.value.as_int32 = os_error->code();
+    error_message.type = Dart_CObject::kString;
+    error_message.value.as_string = os_error->message();
+    value.type = Dart_CObject::kArray;
+    value.value.as_array.length = 3;
+    value.value.as_array.values = error_values;
+  }
+  Dart_CObject* values[2] = { &id, &value };
+  Dart_CObject message;
+  message.type = Dart_CObject::kArray;
+  message.value.as_array.length = 2;
+  message.value.as_array.values = values;
+  Dart_PostCObject(request->port(), &message);
+  delete request;
+}
+
+
+void FileIOEngine::Perform(Request* request) {
+  File* file = request->file();
+  int64_t result;
+  if (request->operation() == kRead) {
+    result = file->ReadAt(request->buffer(),
+                          request->length(),
+                          request->position());
+  } else {
+    result = file->WriteAt(request->buffer(),
+                           request->length(),
+                           request->position());
+  }
+  if (result < 0) {
+    OSError os_error;
+    Complete(request, result, &os_error);
+  } else {
+    Complete(request, result, NULL);
+  }
+}
+
+
+void FileIOEngine::WorkerMain(uword parameter) {
+  while (true) {
+    Request* request = NULL;
+    {
+      MonitorLocker locker(monitor_);
+      while (queue_head_ == NULL) {
+        idle_worker_threads_++;
+        locker.Wait();
+        idle_worker_threads_--;
+      }
+      request = queue_head_;
+      queue_head_ = request->next_;
+      if (queue_head_ == NULL) queue_tail_ = NULL;
+    }
+    request->next_ = NULL;
+    Perform(request);
+  }
+}
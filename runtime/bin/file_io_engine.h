@@ -0,0 +1,100 @@
+// Copyright (c) 2013, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#ifndef BIN_FILE_IO_ENGINE_H_
+#define BIN_FILE_IO_ENGINE_H_
+
+#include "bin/builtin.h"
+#include "bin/file.h"
+#include "bin/utils.h"
+#include "platform/globals.h"
+#include "platform/thread.h"
+
+// Performs positional reads and writes of files directly to and from
+// buffers owned by the caller. Each request completes asynchronously by
+// posting [id, result] to the port of the request, where result is the
+// number of bytes transferred or an OS error response.
+//
+// On Linux the requests are submitted to the kernel through an io_uring
+// when the kernel supports it. Requests which cannot be submitted to the
+// kernel are performed by a pool of worker threads.
+class FileIOEngine {
+ public:
+  enum Operation {
+    kRead = 0,
+    kWrite = 1
+  };
+
+  class Request {
+   public:
+    Request(Dart_Port port,
+            int64_t id,
+            File* file,
+            Operation operation,
+            uint8_t* buffer,
+            int64_t length,
+            int64_t position)
+        : port_(port),
+          id_(id),
+          file_(file),
+          operation_(operation),
+          buffer_(buffer),
+          length_(length),
+          position_(position),
+          next_(NULL) { }
+
+    Dart_Port port() const { return port_; }
+    int64_t id() const { return id_; }
+    File* file() const { return file_; }
+    Operation operation() const { return operation_; }
+    uint8_t* buffer() const { return buffer_; }
+    int64_t length() const { return length_; }
+    int64_t position() const { return position_; }
+
+   private:
+    Dart_Port port_;
+    int64_t id_;
+    File* file_;
+    Operation operation_;
+    uint8_t* buffer_;
+    int64_t length_;
+    int64_t position_;
+    Request* next_;  // Link in the queue of the worker threads.
+
+    friend class FileIOEngine;
+
+    DISALLOW_COPY_AND_ASSIGN(Request);
+  };
+
+  // Submits count requests and takes ownership of them. The files must
+  // stay open and the buffers valid until the requests have completed.
+  static void Submit(Request** requests, intptr_t count);
+
+  // Posts the result of a request and deletes it. If os_error is not NULL
+  // the request failed and result is ignored.
+  static void Complete(Request* request, int64_t result, OSError* os_error);
+
+ private:
+  static const intptr_t kMaxWorkerThreads = 4;
+
+  // Performs the request on the calling thread and completes it.
+  static void Perform(Request* request);
+  static void WorkerMain(uword parameter);
+
+  // Platform specific. Submits requests to the kernel and returns the
+  // number of requests submitted, starting from the first. The remaining
+  // requests are performed by the worker threads.
+  static intptr_t PlatformSubmit(Request** requests, intptr_t count);
+
+  static dart::Monitor* monitor_;
+  static Request* queue_head_;
+  static Request* queue_tail_;
+  static intptr_t worker_threads_;
+  static intptr_t idle_worker_threads_;
+
+  DISALLOW_ALLOCATION();
+  DISALLOW_IMPLICIT_CONSTRUCTORS(FileIOEngine);
+};
+
+#endif  // BIN_FILE_IO_ENGINE_H_
@@ -0,0 +1,297 @@
+// Copyright (c) 2013, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "bin/file_io_engine.h"
+
+#include <errno.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include "bin/fdutils.h"
+#include "bin/log.h"
+#include "bin/thread.h"
+
+
+// The io_uring kernel interface. It is declared here as the system headers
+// might predate it. The system call numbers are the same on all supported
+// architectures.
+static const int kIoUringSetup = 425;
+static const int kIoUringEnter = 426;
+static const uint32_t kIoUringEnterGetEvents = 1;
+static const uint8_t kIoUringOpReadv = 1;
+static const uint8_t kIoUringOpWritev = 2;
+static const off_t kIoUringOffSqRing = 0;
+static const off_t kIoUringOffCqRing = 0x8000000;
+static const off_t kIoUringOffSqes = 0x10000000;
+
+struct IoSqringOffsets {
+  uint32_t head;
+  uint32_t tail;
+  uint32_t ring_mask;
+  uint32_t ring_entries;
+  uint32_t flags;
+  uint32_t dropped;
+  uint32_t array;
+  uint32_t resv1;
+  uint64_t resv2;
+};
+
+struct IoCqringOffsets {
+  uint32_t head;
+  uint32_t tail;
+  uint32_t ring_mask;
+  uint32_t ring_entries;
+  uint32_t overflow;
+  uint32_t cqes;
+  uint32_t flags;
+  uint32_t resv1;
+  uint64_t resv2;
+};
+
+struct IoUringParams {
+  uint32_t sq_entries;
+  uint32_t cq_entries;
+  uint32_t flags;
+  uint32_t sq_thread_cpu;
+  uint32_t sq_thread_idle;
+  uint32_t features;
+  uint32_t wq_fd;
+  uint32_t resv[3];
+  IoSqringOffsets sq_off;
+  IoCqringOffsets cq_off;
+};
+
+struct IoUringSqe {
+  uint8_t opcode;
+  uint8_t flags;
+  uint16_t ioprio;
+  int32_t fd;
+  uint64_t off;
+  uint64_t addr;
+  uint32_t len;
+  uint32_t rw_flags;
+  uint64_t user_data;
+  uint64_t pad[3];
+};
+
+struct IoUringCqe {
+  uint64_t user_data;
+  int32_t res;
+  uint32_t flags;
+};
+
+
+// A request submitted to the ring. The iovec has to stay valid until the
+// request completes.
+struct Submission {
+  FileIOEngine::Request* request;
+  struct iovec iov;
+};
+
+
+// A single io_uring shared by all isolates. Submissions are serialized by
+// a mutex, a dedicated thread waits for and posts the completions.
+class IoUring {
+ public:
+  static const uint32_t kEntries = 256;
+
+  IoUring() : fd_(-1), in_flight_(0) { }
+
+  bool Init();
+  intptr_t Submit(FileIOEngine::Request** requests, intptr_t count);
+
+ private:
+  static void CompletionThreadMain(uword parameter);
+  void ReapCompletions();
+
+  int fd_;
+  uint32_t in_flight_;  // Guarded by mutex_.
+  dart::Mutex mutex_;
+
+  IoUringParams params_;
+  uint32_t* sq_head_;
+  uint32_t* sq_tail_;
+  uint32_t sq_mask_;
+  uint32_t* sq_array_;
+  IoUringSqe* sqes_;
+  uint32_t* cq_head_;
+  uint32_t* cq_tail_;
+  uint32_t cq_mask_;
+  IoUringCqe* cqes_;
+
+  DISALLOW_COPY_AND_ASSIGN(IoUring);
+};
+
+
+bool IoUring::Init() {
+  memset(&params_, 0, sizeof(params_));
+  fd_ = syscall(kIoUringSetup, kEntries, &params_);
+  if (fd_ < 0) {
+    // Not supported by the kernel or not permitted.
+    return false;
+  }
+  FDUtils::SetCloseOnExec(fd_);
+  size_t sq_size = params_.sq_off.array + params_.sq_entries * sizeof(uint32_t);
+  size_t cq_size =
+      params_.cq_off.cqes + params_.cq_entries * sizeof(IoUringCqe);
+  size_t sqes_size = params_.sq_entries * sizeof(IoUringSqe);
+  uint8_t* sq = reinterpret_cast<uint8_t*>(
+      mmap(NULL, sq_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+           fd_, kIoUringOffSqRing));
+  uint8_t* cq = reinterpret_cast<uint8_t*>(
+      mmap(NULL, cq_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+           fd_, kIoUringOffCqRing));
+  void* sqes = mmap(NULL, sqes_size, PROT_READ | PROT_WRITE,
+                    MAP_SHARED | MAP_POPULATE, fd_, kIoUringOffSqes);
+  if (sq == MAP_FAILED || cq == MAP_FAILED || sqes == MAP_FAILED) {
+    if (sq != MAP_FAILED) munmap(sq, sq_size);
+    if (cq != MAP_FAILED) munmap(cq, cq_size);
+    if (sqes != MAP_FAILED) munmap(sqes, sqes_size);
+    close(fd_);
+    fd_ = -1;
+    return false;
+  }
+  sq_head_ = reinterpret_cast<uint32_t*>(sq + params_.sq_off.head);
+  sq_tail_ = reinterpret_cast<uint32_t*>(sq + params_.sq_off.tail);
+  sq_mask_ = *reinterpret_cast<uint32_t*>(sq + params_.sq_off.ring_mask);
+  sq_array_ = reinterpret_cast<uint32_t*>(sq + params_.sq_off.array);
+  sqes_ = reinterpret_cast<IoUringSqe*>(sqes);
+  cq_head_ = reinterpret_cast<uint32_t*>(cq + params_.cq_off.head);
+  cq_tail_ = reinterpret_cast<uint32_t*>(cq + params_.cq_off.tail);
+  cq_mask_ = *reinterpret_cast<uint32_t*>(cq + params_.cq_off.ring_mask);
+  cqes_ = reinterpret_cast<IoUringCqe*>(cq + params_.cq_off.cqes);
+
+  int result = dart::Thread::Start(&CompletionThreadMain,
+                                   reinterpret_cast<uword>(this));
+  if (result != 0) {
+    Log::PrintErr("Failed to start io_uring completion thread %d\n", result);
+    // The mappings stay around, the ring is never used.
+    close(fd_);
+    fd_ = -1;
+    return false;
+  }
+  return true;
+}
+
+
+intptr_t IoUring::Submit(FileIOEngine::Request** requests, intptr_t count) {
+  MutexLocker ml(&mutex_);
+  // Never have more requests in flight than the completion queue holds.
+  uint32_t available = params_.cq_entries - in_flight_;
+  if (available > params_.sq_entries) available = params_.sq_entries;
+  intptr_t to_submit = count;
+  if (static_cast<uintptr_t>(to_submit) > available) to_submit = available;
+  if (to_submit == 0) return 0;
+
+  // Without a kernel submission thread the submission queue is only read
+  // during io_uring_enter, which is serialized by the mutex. Therefore the
+  // queue is empty here.
+  uint32_t tail = *sq_tail_;
+  for (intptr_t i = 0; i < to_submit; i++) {
+    FileIOEngine::Request* request = requests[i];
+    Submission* submission = new Submission();
+    submission->request = request;
+    submission->iov.iov_base = request->buffer();
+    submission->iov.iov_len = request->length();
+    uint32_t index = (tail + i) & sq_mask_;
+    IoUringSqe* sqe = &sqes_[index];
+    memset(sqe, 0, sizeof(*sqe));
+    sqe->opcode = (request->operation() == FileIOEngine::kRead) ?
+        kIoUringOpReadv : kIoUringOpWritev;
+    sqe->fd = request->file()->GetFD();
+    sqe->off = request->position();
+    sqe->addr = reinterpret_cast<uint64_t>(&submission->iov);
+    sqe->len = 1;
+    sqe->user_data = reinterpret_cast<uint64_t>(submission);
+    sq_array_[index] = index;
+  }
+  // Publish the entries before the new tail.
+  __sync_synchronize();
+  *sq_tail_ = tail + to_submit;
+  __sync_synchronize();
+  int result = TEMP_FAILURE_RETRY(
+      syscall(kIoUringEnter, fd_, to_submit, 0, 0, NULL, 0));
+  // Entries the kernel did not consume are taken back and handed to the
+  // worker threads.
+  __sync_synchronize();
+  uint32_t consumed = *sq_head_ - tail;
+  if (result < 0 && consumed == 0) {
+    Log::PrintErr("io_uring_enter failed %d\n", errno);
+  }
+  for (intptr_t i = consumed; i < to_submit; i++) {
+    uint32_t index = (tail + i) & sq_mask_;
+    delete reinterpret_cast<Submission*>(sqes_[index].user_data);
+  }
+  *sq_tail_ = tail + consumed;
+  in_flight_ += consumed;
+  return consumed;
+}
+
+
+void IoUring::ReapCompletions() {
+  uint32_t head = *cq_head_;
+  __sync_synchronize();
+  uint32_t tail = *cq_tail_;
+  __sync_synchronize();
+  if (head == tail) return;
+  uint32_t reaped = tail - head;
+  for (; head != tail; head++) {
+    IoUringCqe* cqe = &cqes_[head & cq_mask_];
+    Submission* submission = reinterpret_cast<Submission*>(cqe->user_data);
+    if (cqe->res < 0) {
+      OSError os_error;
+      os_error.SetCodeAndMessage(OSError::kSystem, -cqe->res);
+      FileIOEngine::Complete(submission->request, 0, &os_error);
+    } else {
+      FileIOEngine::Complete(submission->request, cqe->res, NULL);
+    }
+    delete submission;
+  }
+  // Release the entries to the kernel.
+  __sync_synchronize();
+  *cq_head_ = tail;
+  MutexLocker ml(&mutex_);
+  in_flight_ -= reaped;
+}
+
+
+void IoUring::CompletionThreadMain(uword parameter) {
+  IoUring* ring = reinterpret_cast<IoUring*>(parameter);
+  while (true) {
+    int result = syscall(kIoUringEnter, ring->fd_, 0, 1,
+                         kIoUringEnterGetEvents, NULL, 0);
+    if (result < 0 && errno != EINTR) {
+      FATAL1("io_uring_enter failed %d\n", errno);
+    }
+    ring->ReapCompletions();
+  }
+}
+
+
+static dart::Mutex ring_mutex;
+static IoUring* ring = NULL;
+static bool ring_initialized = false;
+
+
+intptr_t FileIOEngine::PlatformSubmit(Request** requests, intptr_t count) {
+  IoUring* current_ring;
+  {
+    MutexLocker ml(&ring_mutex);
+    if (!ring_initialized) {
+      ring_initialized = true;
+      IoUring* new_ring = new IoUring();
+      if (new_ring->Init()) {
+        ring = new_ring;
+      } else {
+        // Fall back to the worker threads.
+        delete new_ring;
+      }
+    }
+    current_ring = ring;
+  }
+  if (current_ring == NULL) return 0;
+  return current_ring->Submit(requests, count);
+}
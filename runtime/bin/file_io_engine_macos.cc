@@ -0,0 +1,12 @@
+// Copyright (c) 2013, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "bin/file_io_engine.h"
+
+
+intptr_t FileIOEngine::PlatformSubmit(Request** requests, intptr_t count) {
+  // There is no kernel interface for asynchronous file I/O in use on
+  // Mac OS, all requests are performed by the worker threads.
+  return 0;
+}
@@ -6,7 +6,11 @@
 
 #include <errno.h>
 #include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
 #include <sys/stat.h>
+#include <sys/types.h>
+#include <sys/uio.h>
 #include <unistd.h>
 #include <libgen.h>
 #include <limits.h>
@@ -56,6 +60,68 @@ bool File::IsClosed() {
 }
 
 
+void* File::Map(MapType type, int64_t position, int64_t length) {
+  ASSERT(handle_->fd() >= 0);
+  int prot = PROT_READ;
+  int flags = MAP_PRIVATE;
+  if (type == kMapReadWrite) {
+    prot |= PROT_WRITE;
+    flags = MAP_SHARED;
+  } else if (type == kMapCopyOnWrite) {
+    prot |= PROT_WRITE;
+  }
+  void* address = mmap(NULL, length, prot, flags, handle_->fd(), position);
+  if (address == MAP_FAILED) {
+    return NULL;
+  }
+  return address;
+}
+
+
+bool File::Unmap(void* address, int64_t length) {
+  return munmap(address, length) == 0;
+}
+
+
+bool File::Advise(void* address, int64_t length, MapAdvice advice) {
+  int os_advice = MADV_NORMAL;
+  switch (advice) {
+    case kAdviceSequential:
+      os_advice = MADV_SEQUENTIAL;
+      break;
+    case kAdviceRandom:
+      os_advice = MADV_RANDOM;
+      break;
+    case kAdviceWillNeed:
+      os_advice = MADV_WILLNEED;
+      break;
+    default:
+      break;
+  }
+  return madvise(address, length, os_advice) == 0;
+}
+
+
+intptr_t File::MapAlignment() {
+  return sysconf(_SC_PAGESIZE);
+}
+
+
+int64_t File::TransferTo(intptr_t socket,
+                         int64_t position,
+                         int64_t num_bytes) {
+  ASSERT(handle_->fd() >= 0);
+  off_t length = num_bytes;
+  int result = sendfile(handle_->fd(), socket, position, &length, NULL, 0);
+  if (result == -1 && errno != EAGAIN && errno != EINTR) {
+    return -1;
+  }
+  // When interrupted or when the socket cannot take more data without
+  // blocking length holds the number of bytes written.
+  return length;
+}
+
+
 int64_t File::Read(void* buffer, int64_t num_bytes) {
   ASSERT(handle_->fd() >= 0);
   return TEMP_FAILURE_RETRY(read(handle_->fd(), buffer, num_bytes));
@@ -68,6 +134,26 @@ int64_t File::Write(const void* buffer, int64_t num_bytes) {
 }
 
 
+int64_t File::ReadAt(void* buffer, int64_t num_bytes, int64_t position) {
+  ASSERT(handle_->fd() >= 0);
+  return TEMP_FAILURE_RETRY(pread(handle_->fd(), buffer, num_bytes, position));
+}
+
+
+int64_t File::WriteAt(const void* buffer,
+                      int64_t num_bytes,
+                      int64_t position) {
+  ASSERT(handle_->fd() >= 0);
+  return TEMP_FAILURE_RETRY(
+      pwrite(handle_->fd(), buffer, num_bytes, position));
+}
+
+
+intptr_t File::GetFD() {
+  return handle_->fd();
+}
+
+
 off_t File::Position() {
   ASSERT(handle_->fd() >= 0);
   return TEMP_FAILURE_RETRY(lseek(handle_->fd(), 0, SEEK_CUR));
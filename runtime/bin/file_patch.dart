@@ -6,6 +6,11 @@ patch class _FileUtils {
   /* patch */ static SendPort _newServicePort() native "File_NewServicePort";
 }
 
+patch class _FileIO {
+  /* patch */ static void _submit(SendPort port, List batch)
+      native "File_SubmitIO";
+}
+
 patch class _File {
   /* patch */ static _exists(String name) native "File_Exists";
   /* patch */ static _create(String name) native "File_Create";
@@ -32,5 +37,7 @@ patch class _RandomAccessFile {
       native "File_SetPosition";
   /* patch */ static _truncate(int id, int length) native "File_Truncate";
   /* patch */ static _length(int id) native "File_Length";
+  /* patch */ static _map(int id, int mode, int position, int length,
+                          int access) native "File_Map";
   /* patch */ static _flush(int id) native "File_Flush";
 }
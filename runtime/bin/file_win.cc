@@ -12,21 +12,72 @@
 
 #include "bin/builtin.h"
 #include "bin/log.h"
+#include "bin/socket.h"
 
 class FileHandle {
  public:
-  explicit FileHandle(int fd) : fd_(fd) { }
-  ~FileHandle() { }
+  explicit FileHandle(int fd)
+      : fd_(fd), overlapped_handle_(INVALID_HANDLE_VALUE) { }
+  ~FileHandle() { CloseOverlappedHandle(); }
   int fd() const { return fd_; }
   void set_fd(int fd) { fd_ = fd; }
 
+  // Returns a second handle for the file, opened for overlapped I/O. The
+  // positional transfers use it so that they never move the file pointer
+  // shared by the other operations on fd. Returns INVALID_HANDLE_VALUE if
+  // the file cannot be reopened.
+  HANDLE OverlappedHandle();
+  void CloseOverlappedHandle();
+
  private:
   int fd_;
+  // Created on first use. Transfers on several threads can race to create
+  // it, so it is only ever set with an interlocked compare and exchange.
+  HANDLE volatile overlapped_handle_;
 
   DISALLOW_COPY_AND_ASSIGN(FileHandle);
 };
 
 
+HANDLE FileHandle::OverlappedHandle() {
+  HANDLE handle = overlapped_handle_;
+  if (handle != INVALID_HANDLE_VALUE) return handle;
+  HANDLE file_handle = reinterpret_cast<HANDLE>(_get_osfhandle(fd_));
+  const DWORD kShareMode =
+      FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE;
+  // Files are opened either for reading or for reading and writing.
+  handle = ReOpenFile(file_handle,
+                      GENERIC_READ | GENERIC_WRITE,
+                      kShareMode,
+                      FILE_FLAG_OVERLAPPED);
+  if (handle == INVALID_HANDLE_VALUE) {
+    handle = ReOpenFile(file_handle,
+                        GENERIC_READ,
+                        kShareMode,
+                        FILE_FLAG_OVERLAPPED);
+    if (handle == INVALID_HANDLE_VALUE) return INVALID_HANDLE_VALUE;
+  }
+  HANDLE existing = InterlockedCompareExchangePointer(
+      reinterpret_cast<PVOID volatile*>(&overlapped_handle_),
+      handle,
+      INVALID_HANDLE_VALUE);
+  if (existing != INVALID_HANDLE_VALUE) {
+    // Another transfer created the handle first.
+    CloseHandle(handle);
+    return existing;
+  }
+  return handle;
+}
+
+
+void FileHandle::CloseOverlappedHandle() {
+  if (overlapped_handle_ != INVALID_HANDLE_VALUE) {
+    CloseHandle(overlapped_handle_);
+    overlapped_handle_ = INVALID_HANDLE_VALUE;
+  }
+}
+
+
 File::~File() {
   // Close the file (unless it's a standard stream).
   if (handle_->fd() > 2) {
@@ -38,6 +89,7 @@ File::~File() {
 
 void File::Close() {
   ASSERT(handle_->fd() >= 0);
+  handle_->CloseOverlappedHandle();
   int err = close(handle_->fd());
   if (err != 0) {
     Log::PrintErr("%s\n", strerror(errno));
@@ -51,6 +103,83 @@ bool File::IsClosed() {
 }
 
 
+void* File::Map(MapType type, int64_t position, int64_t length) {
+  ASSERT(handle_->fd() >= 0);
+  HANDLE file_handle = reinterpret_cast<HANDLE>(_get_osfhandle(handle_->fd()));
+  DWORD protect = (type == kMapReadWrite) ? PAGE_READWRITE : PAGE_READONLY;
+  DWORD access = FILE_MAP_READ;
+  if (type == kMapReadWrite) {
+    access = FILE_MAP_WRITE;
+  } else if (type == kMapCopyOnWrite) {
+    access = FILE_MAP_COPY;
+  }
+  HANDLE mapping = CreateFileMapping(file_handle, NULL, protect, 0, 0, NULL);
+  if (mapping == NULL) {
+    return NULL;
+  }
+  void* address = MapViewOfFile(mapping,
+                                access,
+                                static_cast<DWORD>(position >> 32),
+                                static_cast<DWORD>(position & 0xFFFFFFFF),
+                                static_cast<SIZE_T>(length));
+  // The view keeps the mapping object alive until it is unmapped.
+  CloseHandle(mapping);
+  return address;
+}
+
+
+bool File::Unmap(void* address, int64_t length) {
+  return UnmapViewOfFile(address) != 0;
+}
+
+
+bool File::Advise(void* address, int64_t length, MapAdvice advice) {
+  // There is no access pattern hint for mapped views.
+  return true;
+}
+
+
+intptr_t File::MapAlignment() {
+  // Views have to start at a multiple of the allocation granularity.
+  SYSTEM_INFO info;
+  GetSystemInfo(&info);
+  return info.dwAllocationGranularity;
+}
+
+
+int64_t File::TransferTo(intptr_t socket,
+                         int64_t position,
+                         int64_t num_bytes) {
+  // Copy the data through a buffer and restore the file position.
+  off_t saved_position = Position();
+  if (saved_position < 0 || !SetPosition(position)) {
+    return -1;
+  }
+  const int64_t kBufferSize = 16 * KB;
+  uint8_t* buffer = new uint8_t[kBufferSize];
+  int64_t total_bytes_written = 0;
+  while (total_bytes_written < num_bytes) {
+    int64_t remaining = num_bytes - total_bytes_written;
+    int64_t bytes_read =
+        Read(buffer, (remaining < kBufferSize) ? remaining : kBufferSize);
+    if (bytes_read <= 0) {
+      if (bytes_read < 0 && total_bytes_written == 0) total_bytes_written = -1;
+      break;
+    }
+    intptr_t bytes_written = Socket::Write(socket, buffer, bytes_read);
+    if (bytes_written < 0) {
+      if (total_bytes_written == 0) total_bytes_written = -1;
+      break;
+    }
+    total_bytes_written += bytes_written;
+    if (bytes_written < bytes_read) break;
+  }
+  delete[] buffer;
+  SetPosition(saved_position);
+  return total_bytes_written;
+}
+
+
 int64_t File::Read(void* buffer, int64_t num_bytes) {
   ASSERT(handle_->fd() >= 0);
   return read(handle_->fd(), buffer, num_bytes);
@@ -63,6 +192,72 @@ int64_t File::Write(const void* buffer, int64_t num_bytes) {
 }
 
 
+// The positional transfers pass the position in an OVERLAPPED structure to
+// ReadFile and WriteFile on the overlapped handle of the file, and wait for
+// the transfer to complete. The file pointer of the file is not used.
+static int64_t TransferAt(HANDLE handle,
+                          void* buffer,
+                          int64_t num_bytes,
+                          int64_t position,
+                          bool write) {
+  if (handle == INVALID_HANDLE_VALUE) return -1;
+  OVERLAPPED overlapped;
+  memset(&overlapped, 0, sizeof(overlapped));
+  overlapped.Offset = static_cast<DWORD>(position & 0xFFFFFFFF);
+  overlapped.OffsetHigh = static_cast<DWORD>(position >> 32);
+  // Each transfer waits on an event of its own, as several transfers can be
+  // in flight on the handle at the same time.
+  overlapped.hEvent = CreateEvent(NULL, TRUE, FALSE, NULL);
+  if (overlapped.hEvent == NULL) return -1;
+  BOOL ok;
+  if (write) {
+    ok = WriteFile(handle, buffer, static_cast<DWORD>(num_bytes), NULL,
+                   &overlapped);
+  } else {
+    ok = ReadFile(handle, buffer, static_cast<DWORD>(num_bytes), NULL,
+                  &overlapped);
+  }
+  DWORD bytes_transferred = 0;
+  if (ok || (GetLastError() == ERROR_IO_PENDING)) {
+    ok = GetOverlappedResult(handle, &overlapped, &bytes_transferred, TRUE);
+  }
+  int64_t result = bytes_transferred;
+  // Reading at or beyond the end of the file is not an error.
+  if (!ok && (write || (GetLastError() != ERROR_HANDLE_EOF))) {
+    result = -1;
+  }
+  CloseHandle(overlapped.hEvent);
+  return result;
+}
+
+
+int64_t File::ReadAt(void* buffer, int64_t num_bytes, int64_t position) {
+  ASSERT(handle_->fd() >= 0);
+  return TransferAt(handle_->OverlappedHandle(),
+                    buffer,
+                    num_bytes,
+                    position,
+                    false);
+}
+
+
+int64_t File::WriteAt(const void* buffer,
+                      int64_t num_bytes,
+                      int64_t position) {
+  ASSERT(handle_->fd() >= 0);
+  return TransferAt(handle_->OverlappedHandle(),
+                    const_cast<void*>(buffer),
+                    num_bytes,
+                    position,
+                    true);
+}
+
+
+intptr_t File::GetFD() {
+  return handle_->fd();
+}
+
+
 off_t File::Position() {
   ASSERT(handle_->fd() >= 0);
   return lseek(handle_->fd(), 0, SEEK_CUR);
@@ -533,5 +533,6 @@ int main(int argc, char** argv) {
     SetupForGenericSnapshotCreation();
     CreateAndWriteSnapshot();
   }
+  Dart_Cleanup();
   return 0;
 }
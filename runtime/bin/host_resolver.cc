@@ -0,0 +1,272 @@
+// Copyright (c) 2013, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "bin/host_resolver.h"
+
+#include "bin/socket.h"
+#include "bin/thread.h"
+#include "platform/hashmap.h"
+#include "platform/utils.h"
+
+
+dart::Mutex HostResolver::mutex_;
+HostResolver::LookupFunction HostResolver::lookup_function_ =
+    HostResolver::PlatformLookup;
+HashMap* HostResolver::cache_ = NULL;
+intptr_t HostResolver::cache_size_ = 0;
+int64_t HostResolver::use_count_ = 0;
+
+
+static bool SameHost(void* key1, void* key2) {
+  return strcmp(reinterpret_cast<char*>(key1),
+                reinterpret_cast<char*>(key2)) == 0;
+}
+
+
+static uint32_t HostHash(const char* host) {
+  return dart::Utils::StringHash(host, strlen(host));
+}
+
+
+static OSError* CopyOSError(OSError* os_error) {
+  return new OSError(os_error->code(),
+                     os_error->message(),
+                     os_error->sub_system());
+}
+
+
+// The cached result of looking up a host name. While a lookup is pending
+// the callbacks of other lookups of the same host are queued on the entry.
+class HostResolver::Entry {
+ public:
+  explicit Entry(const char* host)
+      : host_(strdup(host)),
+        address_(NULL),
+        os_error_(NULL),
+        expires_(0),
+        last_used_(0),
+        pending_(false),
+        waiters_(NULL) { }
+
+  ~Entry() {
+    ASSERT(waiters_ == NULL);
+    free(host_);
+    free(address_);
+    delete os_error_;
+  }
+
+  char* host() const { return host_; }
+  bool pending() const { return pending_; }
+  void set_pending(bool value) { pending_ = value; }
+  int64_t last_used() const { return last_used_; }
+  void set_last_used(int64_t value) { last_used_ = value; }
+  bool IsValid(int64_t now) const { return !pending_ && (now < expires_); }
+
+  // Copies the cached result for use outside the lock.
+  void CopyResult(char** address, OSError** os_error) const {
+    ASSERT(!pending_);
+    *address = (address_ == NULL) ? NULL : strdup(address_);
+    *os_error = (os_error_ == NULL) ? NULL : CopyOSError(os_error_);
+  }
+
+  void SetResult(const char* address, OSError* os_error, int64_t expires) {
+    free(address_);
+    delete os_error_;
+    address_ = (address == NULL) ? NULL : strdup(address);
+    os_error_ = (os_error == NULL) ? NULL : CopyOSError(os_error);
+    expires_ = expires;
+    pending_ = false;
+  }
+
+  void AddWaiter(LookupCallback callback, void* data) {
+    waiters_ = new Waiter(callback, data, waiters_);
+  }
+
+  // A lookup waiting for the pending result.
+  struct Waiter {
+    Waiter(LookupCallback callback, void* data, Waiter* next)
+        : callback(callback), data(data), next(next) { }
+
+    LookupCallback callback;
+    void* data;
+    Waiter* next;
+  };
+
+  // Removes the queued waiters, oldest first.
+  Waiter* TakeWaiters() {
+    Waiter* reversed = NULL;
+    while (waiters_ != NULL) {
+      Waiter* next = waiters_->next;
+      waiters_->next = reversed;
+      reversed = waiters_;
+      waiters_ = next;
+    }
+    return reversed;
+  }
+
+ private:
+  char* host_;
+  char* address_;
+  OSError* os_error_;
+  int64_t expires_;
+  int64_t last_used_;
+  bool pending_;
+  Waiter* waiters_;
+
+  DISALLOW_COPY_AND_ASSIGN(Entry);
+};
+
+
+void HostResolver::Lookup(const char* host,
+                          LookupCallback callback,
+                          void* data) {
+  uint32_t hash = HostHash(host);
+  LookupFunction lookup_function = NULL;
+  char* address = NULL;
+  OSError* os_error = NULL;
+  {
+    MutexLocker ml(&mutex_);
+    if (cache_ == NULL) {
+      cache_ = new HashMap(&SameHost, 16);
+    }
+    int64_t now = TimerUtils::GetCurrentTimeMilliseconds();
+    HashMap::Entry* map_entry =
+        cache_->Lookup(const_cast<char*>(host), hash, false);
+    if (map_entry == NULL) {
+      if (cache_size_ >= kMaxCacheEntries) {
+        EvictExpired(now);
+      }
+      if (cache_size_ >= kMaxCacheEntries) {
+        EvictLeastRecentlyUsed();
+      }
+      Entry* entry = new Entry(host);
+      map_entry = cache_->Lookup(entry->host(), hash, true);
+      map_entry->value = entry;
+      cache_size_++;
+    }
+    Entry* entry = reinterpret_cast<Entry*>(map_entry->value);
+    entry->set_last_used(++use_count_);
+    if (entry->pending()) {
+      // Another thread is resolving the host and calls back when done.
+      entry->AddWaiter(callback, data);
+      return;
+    }
+    if (entry->IsValid(now)) {
+      entry->CopyResult(&address, &os_error);
+    } else {
+      entry->set_pending(true);
+      lookup_function = lookup_function_;
+    }
+  }
+
+  if (lookup_function == NULL) {
+    // Cached result.
+    callback(address, os_error, data);
+    free(address);
+    delete os_error;
+    return;
+  }
+
+  int64_t time_to_live = kDefaultTimeToLive;
+  address = lookup_function(host, &time_to_live, &os_error);
+  if (address == NULL) {
+    if (os_error == NULL) os_error = new OSError();
+    if (time_to_live > kMaxErrorTimeToLive) {
+      time_to_live = kMaxErrorTimeToLive;
+    }
+  }
+  Entry::Waiter* waiters = NULL;
+  {
+    MutexLocker ml(&mutex_);
+    // Pending entries are never removed from the cache.
+    HashMap::Entry* map_entry =
+        cache_->Lookup(const_cast<char*>(host), hash, false);
+    ASSERT(map_entry != NULL);
+    Entry* entry = reinterpret_cast<Entry*>(map_entry->value);
+    entry->SetResult(address,
+                     os_error,
+                     TimerUtils::GetCurrentTimeMilliseconds() + time_to_live);
+    waiters = entry->TakeWaiters();
+  }
+  callback(address, os_error, data);
+  while (waiters != NULL) {
+    Entry::Waiter* next = waiters->next;
+    waiters->callback(address, os_error, waiters->data);
+    delete waiters;
+    waiters = next;
+  }
+  free(address);
+  delete os_error;
+}
+
+
+void HostResolver::EvictExpired(int64_t now) {
+  // Removing entries while iterating the map is not supported, so collect
+  // the entries first.
+  Entry** expired = new Entry*[cache_size_];
+  intptr_t count = 0;
+  for (HashMap::Entry* p = cache_->Start(); p != NULL; p = cache_->Next(p)) {
+    Entry* entry = reinterpret_cast<Entry*>(p->value);
+    if (!entry->pending() && !entry->IsValid(now)) {
+      expired[count++] = entry;
+    }
+  }
+  for (intptr_t i = 0; i < count; i++) {
+    cache_->Remove(expired[i]->host(), HostHash(expired[i]->host()));
+    delete expired[i];
+  }
+  cache_size_ -= count;
+  delete[] expired;
+}
+
+
+void HostResolver::EvictLeastRecentlyUsed() {
+  // Pending entries cannot be evicted. There is at most one for each thread
+  // resolving a host name.
+  Entry* oldest = NULL;
+  for (HashMap::Entry* p = cache_->Start(); p != NULL; p = cache_->Next(p)) {
+    Entry* entry = reinterpret_cast<Entry*>(p->value);
+    if (!entry->pending() &&
+        ((oldest == NULL) || (entry->last_used() < oldest->last_used()))) {
+      oldest = entry;
+    }
+  }
+  if (oldest == NULL) return;
+  cache_->Remove(oldest->host(), HostHash(oldest->host()));
+  delete oldest;
+  cache_size_--;
+}
+
+
+void HostResolver::SetLookupFunction(LookupFunction function) {
+  {
+    MutexLocker ml(&mutex_);
+    lookup_function_ = (function == NULL) ? PlatformLookup : function;
+  }
+  ClearCache();
+}
+
+
+void HostResolver::ClearCache() {
+  MutexLocker ml(&mutex_);
+  if (cache_ == NULL) return;
+  // Expire every entry which is not pending, then evict them.
+  for (HashMap::Entry* p = cache_->Start(); p != NULL; p = cache_->Next(p)) {
+    Entry* entry = reinterpret_cast<Entry*>(p->value);
+    if (!entry->pending()) {
+      entry->SetResult(NULL, NULL, 0);
+    }
+  }
+  EvictExpired(TimerUtils::GetCurrentTimeMilliseconds());
+}
+
+
+char* HostResolver::PlatformLookup(const char* host,
+                                   int64_t* time_to_live,
+                                   OSError** os_error) {
+  // getaddrinfo does not report the time to live of the result.
+  *time_to_live = kDefaultTimeToLive;
+  return const_cast<char*>(
+      Socket::LookupIPv4Address(const_cast<char*>(host), os_error));
+}
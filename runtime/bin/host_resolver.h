@@ -0,0 +1,80 @@
+// Copyright (c) 2013, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#ifndef BIN_HOST_RESOLVER_H_
+#define BIN_HOST_RESOLVER_H_
+
+#include "bin/builtin.h"
+#include "bin/utils.h"
+#include "platform/globals.h"
+#include "platform/thread.h"
+
+class HashMap;
+
+// Resolves host names to IPv4 addresses for the socket service.
+//
+// Results, including failed lookups, are cached until their time to live
+// expires. Concurrent lookups of the same host name share a single
+// resolution: a lookup started while another lookup of the host is in
+// progress does not block, its callback is called by the thread running
+// the resolution once the result is known.
+class HostResolver {
+ public:
+  // Time to live of results from resolvers which do not report one.
+  static const int64_t kDefaultTimeToLive = 60 * 1000;
+  // Failed lookups are cached for at most this long.
+  static const int64_t kMaxErrorTimeToLive = 5 * 1000;
+  // Expired entries are evicted once the cache holds this many entries. If
+  // none has expired, the least recently used entry is evicted.
+  static const intptr_t kMaxCacheEntries = 256;
+
+  // Resolves host to an IPv4 address in dotted-decimal notation allocated
+  // with malloc. Sets time_to_live to the number of milliseconds the
+  // result can be cached. On failure returns NULL and sets os_error.
+  typedef char* (*LookupFunction)(const char* host,
+                                  int64_t* time_to_live,
+                                  OSError** os_error);
+
+  // Receives the result of a lookup. Either address or os_error is NULL.
+  // Both are owned by the resolver and only valid during the call.
+  typedef void (*LookupCallback)(const char* address,
+                                 OSError* os_error,
+                                 void* data);
+
+  // Looks up the address of host and calls callback with data once the
+  // result is known. Cached results are returned immediately, otherwise
+  // the name is resolved on the calling thread unless a lookup of the
+  // same host is already in progress.
+  static void Lookup(const char* host, LookupCallback callback, void* data);
+
+  // Replaces the function used to resolve host names. Passing NULL
+  // restores the platform resolver. Clears the cache.
+  static void SetLookupFunction(LookupFunction function);
+
+  // Removes all results from the cache. Lookups in progress are not
+  // affected.
+  static void ClearCache();
+
+ private:
+  class Entry;
+
+  static char* PlatformLookup(const char* host,
+                              int64_t* time_to_live,
+                              OSError** os_error);
+  static void EvictExpired(int64_t now);
+  static void EvictLeastRecentlyUsed();
+
+  static dart::Mutex mutex_;
+  static LookupFunction lookup_function_;
+  // Maps host names to entries. Guarded by mutex_.
+  static HashMap* cache_;
+  static intptr_t cache_size_;
+  // Counts lookups to order the entries by their last use.
+  static int64_t use_count_;
+
+  DISALLOW_ALLOCATION();
+  DISALLOW_IMPLICIT_CONSTRUCTORS(HostResolver);
+};
+
+#endif  // BIN_HOST_RESOLVER_H_
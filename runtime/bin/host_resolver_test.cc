@@ -0,0 +1,205 @@
+// Copyright (c) 2013, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "bin/host_resolver.h"
+#include "bin/thread.h"
+#include "platform/assert.h"
+#include "platform/globals.h"
+#include "vm/unit_test.h"
+
+
+static int lookup_count = 0;
+static int64_t lookup_time_to_live = HostResolver::kDefaultTimeToLive;
+
+
+static char* CountingLookup(const char* host,
+                            int64_t* time_to_live,
+                            OSError** os_error) {
+  lookup_count++;
+  *time_to_live = lookup_time_to_live;
+  if (strcmp(host, "unknown.host") == 0) {
+    *os_error = new OSError(-2, "Unknown host", OSError::kGetAddressInfo);
+    return NULL;
+  }
+  return strdup("10.0.0.1");
+}
+
+
+struct LookupResult {
+  LookupResult() : count(0), error_code(0) { address[0] = '\0'; }
+
+  int count;
+  char address[16];
+  int error_code;
+};
+
+
+static void StoreResult(const char* address, OSError* os_error, void* data) {
+  LookupResult* result = reinterpret_cast<LookupResult*>(data);
+  result->count++;
+  if (address != NULL) {
+    snprintf(result->address, sizeof(result->address), "%s", address);
+  } else {
+    result->error_code = os_error->code();
+  }
+}
+
+
+UNIT_TEST_CASE(HostResolverCache) {
+  lookup_count = 0;
+  lookup_time_to_live = HostResolver::kDefaultTimeToLive;
+  HostResolver::SetLookupFunction(CountingLookup);
+  LookupResult result;
+  HostResolver::Lookup("test.host", StoreResult, &result);
+  EXPECT_EQ(1, result.count);
+  EXPECT_STREQ("10.0.0.1", result.address);
+  EXPECT_EQ(1, lookup_count);
+  HostResolver::Lookup("test.host", StoreResult, &result);
+  EXPECT_EQ(2, result.count);
+  EXPECT_STREQ("10.0.0.1", result.address);
+  EXPECT_EQ(1, lookup_count);
+  HostResolver::Lookup("other.host", StoreResult, &result);
+  EXPECT_EQ(2, lookup_count);
+  HostResolver::ClearCache();
+  HostResolver::Lookup("test.host", StoreResult, &result);
+  EXPECT_EQ(3, lookup_count);
+  HostResolver::SetLookupFunction(NULL);
+}
+
+
+UNIT_TEST_CASE(HostResolverExpiredEntries) {
+  lookup_count = 0;
+  lookup_time_to_live = 0;
+  HostResolver::SetLookupFunction(CountingLookup);
+  LookupResult result;
+  HostResolver::Lookup("test.host", StoreResult, &result);
+  HostResolver::Lookup("test.host", StoreResult, &result);
+  EXPECT_EQ(2, result.count);
+  EXPECT_EQ(2, lookup_count);
+  HostResolver::SetLookupFunction(NULL);
+  lookup_time_to_live = HostResolver::kDefaultTimeToLive;
+}
+
+
+UNIT_TEST_CASE(HostResolverCacheLimit) {
+  lookup_count = 0;
+  HostResolver::SetLookupFunction(CountingLookup);
+  LookupResult result;
+  const intptr_t max_entries = HostResolver::kMaxCacheEntries;
+  char host[32];
+  for (intptr_t i = 0; i < max_entries; i++) {
+    snprintf(host, sizeof(host), "host%"Pd"", i);
+    HostResolver::Lookup(host, StoreResult, &result);
+  }
+  EXPECT_EQ(max_entries, lookup_count);
+  // None of the entries has expired, so adding another one to the full
+  // cache evicts the least recently used entry, which is host1.
+  HostResolver::Lookup("host0", StoreResult, &result);
+  HostResolver::Lookup("other.host", StoreResult, &result);
+  EXPECT_EQ(max_entries + 1, lookup_count);
+  HostResolver::Lookup("host0", StoreResult, &result);
+  EXPECT_EQ(max_entries + 1, lookup_count);
+  HostResolver::Lookup("host2", StoreResult, &result);
+  EXPECT_EQ(max_entries + 1, lookup_count);
+  HostResolver::Lookup("host1", StoreResult, &result);
+  EXPECT_EQ(max_entries + 2, lookup_count);
+  HostResolver::SetLookupFunction(NULL);
+}
+
+
+UNIT_TEST_CASE(HostResolverErrors) {
+  lookup_count = 0;
+  HostResolver::SetLookupFunction(CountingLookup);
+  LookupResult result;
+  HostResolver::Lookup("unknown.host", StoreResult, &result);
+  EXPECT_EQ(1, result.count);
+  EXPECT_EQ(-2, result.error_code);
+  EXPECT_STREQ("", result.address);
+  // Failed lookups are cached too.
+  HostResolver::Lookup("unknown.host", StoreResult, &result);
+  EXPECT_EQ(2, result.count);
+  EXPECT_EQ(1, lookup_count);
+  HostResolver::SetLookupFunction(NULL);
+}
+
+
+UNIT_TEST_CASE(HostResolverPlatformLookup) {
+  HostResolver::SetLookupFunction(NULL);
+  LookupResult result;
+  HostResolver::Lookup("127.0.0.1", StoreResult, &result);
+  EXPECT_EQ(1, result.count);
+  EXPECT_STREQ("127.0.0.1", result.address);
+  HostResolver::ClearCache();
+}
+
+
+static dart::Monitor* lookup_monitor = NULL;
+static bool lookup_started = false;
+static bool lookup_released = false;
+
+
+static char* BlockingLookup(const char* host,
+                            int64_t* time_to_live,
+                            OSError** os_error) {
+  MonitorLocker ml(lookup_monitor);
+  lookup_count++;
+  lookup_started = true;
+  ml.NotifyAll();
+  while (!lookup_released) {
+    ml.Wait();
+  }
+  return strdup("10.0.0.2");
+}
+
+
+static LookupResult* thread_result = NULL;
+static bool thread_done = false;
+
+
+static void LookupThread(uword parameter) {
+  HostResolver::Lookup("blocking.host", StoreResult, thread_result);
+  MonitorLocker ml(lookup_monitor);
+  thread_done = true;
+  ml.NotifyAll();
+}
+
+
+UNIT_TEST_CASE(HostResolverSharedLookup) {
+  lookup_monitor = new dart::Monitor();
+  lookup_count = 0;
+  lookup_started = false;
+  lookup_released = false;
+  thread_done = false;
+  HostResolver::SetLookupFunction(BlockingLookup);
+  LookupResult first;
+  LookupResult second;
+  thread_result = &first;
+  int result = dart::Thread::Start(LookupThread, 0);
+  EXPECT_EQ(0, result);
+  {
+    MonitorLocker ml(lookup_monitor);
+    while (!lookup_started) {
+      ml.Wait();
+    }
+  }
+  // The second lookup does not block and is answered by the first.
+  HostResolver::Lookup("blocking.host", StoreResult, &second);
+  EXPECT_EQ(0, second.count);
+  {
+    MonitorLocker ml(lookup_monitor);
+    lookup_released = true;
+    ml.NotifyAll();
+    while (!thread_done) {
+      ml.Wait();
+    }
+  }
+  EXPECT_EQ(1, lookup_count);
+  EXPECT_EQ(1, first.count);
+  EXPECT_STREQ("10.0.0.2", first.address);
+  EXPECT_EQ(1, second.count);
+  EXPECT_STREQ("10.0.0.2", second.address);
+  HostResolver::SetLookupFunction(NULL);
+  delete lookup_monitor;
+  lookup_monitor = NULL;
+}
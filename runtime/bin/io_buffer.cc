@@ -4,6 +4,31 @@
 
 #include "bin/io_buffer.h"
 
+#include "bin/thread.h"
+#include "platform/assert.h"
+#include "platform/utils.h"
+
+
+// The header in front of the storage of an IO buffer. Blocks in the pool
+// are linked through next.
+struct IOBuffer::Block {
+  intptr_t size_class;
+  Block* next;
+};
+
+
+// The header keeps the storage aligned for doubles.
+const intptr_t IOBuffer::kHeaderSize = dart::Utils::RoundUp(
+    static_cast<intptr_t>(sizeof(IOBuffer::Block)), sizeof(double));
+
+
+IOBuffer::Block* IOBuffer::free_blocks_[kSizeClasses] = { NULL };
+intptr_t IOBuffer::free_counts_[kSizeClasses] = { 0 };
+intptr_t IOBuffer::hits_ = 0;
+intptr_t IOBuffer::misses_ = 0;
+dart::Mutex IOBuffer::mutex_;
+
+
 Dart_Handle IOBuffer::Allocate(intptr_t size, uint8_t **buffer) {
   uint8_t* data = Allocate(size);
   Dart_Handle result = Dart_NewExternalByteArray(data, size, data, Free);
@@ -17,6 +42,87 @@ Dart_Handle IOBuffer::Allocate(intptr_t size, uint8_t **buffer) {
   return result;
 }
 
+
 uint8_t* IOBuffer::Allocate(intptr_t size) {
-  return new uint8_t[size];
+  intptr_t size_class = SizeClass(size);
+  Block* block = NULL;
+  if (size_class != kNotPooled) {
+    MutexLocker ml(&mutex_);
+    block = free_blocks_[size_class];
+    if (block != NULL) {
+      free_blocks_[size_class] = block->next;
+      free_counts_[size_class]--;
+      hits_++;
+    } else {
+      misses_++;
+    }
+  }
+  if (block == NULL) {
+    intptr_t block_size = (size_class == kNotPooled)
+        ? size
+        : kMinPooledSize << size_class;
+    block = reinterpret_cast<Block*>(new uint8_t[kHeaderSize + block_size]);
+    block->size_class = size_class;
+  }
+  block->next = NULL;
+  return reinterpret_cast<uint8_t*>(block) + kHeaderSize;
+}
+
+
+void IOBuffer::Free(void* buffer) {
+  if (buffer == NULL) return;
+  Block* block = BlockFromBuffer(buffer);
+  intptr_t size_class = block->size_class;
+  if (size_class != kNotPooled) {
+    MutexLocker ml(&mutex_);
+    intptr_t max_count = kMaxPooledBytes >> (kMinPooledSizeLog2 + size_class);
+    if (free_counts_[size_class] < max_count) {
+      block->next = free_blocks_[size_class];
+      free_blocks_[size_class] = block;
+      free_counts_[size_class]++;
+      return;
+    }
+  }
+  delete[] reinterpret_cast<uint8_t*>(block);
+}
+
+
+void IOBuffer::ClearPool() {
+  MutexLocker ml(&mutex_);
+  for (intptr_t i = 0; i < kSizeClasses; i++) {
+    Block* block = free_blocks_[i];
+    while (block != NULL) {
+      Block* next = block->next;
+      delete[] reinterpret_cast<uint8_t*>(block);
+      block = next;
+    }
+    free_blocks_[i] = NULL;
+    free_counts_[i] = 0;
+  }
+}
+
+
+intptr_t IOBuffer::pool_hits() {
+  MutexLocker ml(&mutex_);
+  return hits_;
+}
+
+
+intptr_t IOBuffer::pool_misses() {
+  MutexLocker ml(&mutex_);
+  return misses_;
+}
+
+
+intptr_t IOBuffer::SizeClass(intptr_t size) {
+  if (size > kMaxPooledSize) return kNotPooled;
+  intptr_t size_class = 0;
+  while ((kMinPooledSize << size_class) < size) size_class++;
+  return size_class;
+}
+
+
+IOBuffer::Block* IOBuffer::BlockFromBuffer(void* buffer) {
+  return reinterpret_cast<Block*>(
+      reinterpret_cast<uint8_t*>(buffer) - kHeaderSize);
 }
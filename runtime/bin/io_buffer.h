@@ -6,11 +6,22 @@
 #define IO_BUFFER_H_
 
 #include "platform/globals.h"
+#include "platform/thread.h"
 
 #include "include/dart_api.h"
 
+// IO buffer storage is taken from a thread safe pool of blocks with sizes
+// in powers of two from kMinPooledSize to kMaxPooledSize. Freed blocks are
+// kept for reuse up to kMaxPooledBytes per size. Larger buffers are
+// allocated and freed directly.
 class IOBuffer {
  public:
+  static const intptr_t kMinPooledSizeLog2 = 8;
+  static const intptr_t kMaxPooledSizeLog2 = 16;
+  static const intptr_t kMinPooledSize = 1 << kMinPooledSizeLog2;
+  static const intptr_t kMaxPooledSize = 1 << kMaxPooledSizeLog2;
+  static const intptr_t kMaxPooledBytes = 512 * KB;
+
   // Allocate an IO buffer dart object (of type Uint8List) backed by
   // an external byte array.
   static Dart_Handle Allocate(intptr_t size, uint8_t **buffer);
@@ -19,12 +30,35 @@ class IOBuffer {
   static uint8_t* Allocate(intptr_t size);
 
   // Function for disposing of IO buffer storage. All backing storage
-  // for IO buffers must be freed using this function.
-  static void Free(void* buffer) {
-    delete[] reinterpret_cast<uint8_t*>(buffer);
-  }
+  // for IO buffers must be freed using this function. The storage is
+  // returned to the pool if there is room for it.
+  static void Free(void* buffer);
+
+  // Releases all the blocks kept in the pool.
+  static void ClearPool();
+
+  // The number of allocations of pooled sizes which did and did not reuse
+  // a block from the pool.
+  static intptr_t pool_hits();
+  static intptr_t pool_misses();
 
  private:
+  static const intptr_t kSizeClasses =
+      kMaxPooledSizeLog2 - kMinPooledSizeLog2 + 1;
+  static const intptr_t kNotPooled = -1;
+
+  struct Block;
+  static const intptr_t kHeaderSize;
+
+  static intptr_t SizeClass(intptr_t size);
+  static Block* BlockFromBuffer(void* buffer);
+
+  static Block* free_blocks_[kSizeClasses];
+  static intptr_t free_counts_[kSizeClasses];
+  static intptr_t hits_;
+  static intptr_t misses_;
+  static dart::Mutex mutex_;
+
   DISALLOW_ALLOCATION();
   DISALLOW_IMPLICIT_CONSTRUCTORS(IOBuffer);
 };
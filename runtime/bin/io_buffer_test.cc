@@ -0,0 +1,72 @@
+// Copyright (c) 2013, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "bin/io_buffer.h"
+#include "platform/assert.h"
+#include "platform/globals.h"
+#include "vm/unit_test.h"
+
+
+UNIT_TEST_CASE(IOBufferPoolReuse) {
+  IOBuffer::ClearPool();
+  intptr_t hits = IOBuffer::pool_hits();
+  intptr_t misses = IOBuffer::pool_misses();
+  uint8_t* buffer = IOBuffer::Allocate(1000);
+  EXPECT_EQ(misses + 1, IOBuffer::pool_misses());
+  EXPECT((reinterpret_cast<uword>(buffer) % sizeof(double)) == 0);
+  buffer[0] = 1;
+  buffer[999] = 2;
+  IOBuffer::Free(buffer);
+  // Sizes rounding up to the same power of two share blocks.
+  uint8_t* other = IOBuffer::Allocate(1024);
+  EXPECT(other == buffer);
+  EXPECT_EQ(hits + 1, IOBuffer::pool_hits());
+  // A block of the size class is not reused for another one.
+  uint8_t* small = IOBuffer::Allocate(100);
+  EXPECT(small != other);
+  EXPECT_EQ(misses + 2, IOBuffer::pool_misses());
+  IOBuffer::Free(small);
+  IOBuffer::Free(other);
+  IOBuffer::ClearPool();
+}
+
+
+UNIT_TEST_CASE(IOBufferPoolLarge) {
+  IOBuffer::ClearPool();
+  intptr_t hits = IOBuffer::pool_hits();
+  intptr_t misses = IOBuffer::pool_misses();
+  // Buffers larger than the largest pooled size bypass the pool.
+  uint8_t* buffer = IOBuffer::Allocate(IOBuffer::kMaxPooledSize + 1);
+  buffer[IOBuffer::kMaxPooledSize] = 1;
+  IOBuffer::Free(buffer);
+  buffer = IOBuffer::Allocate(IOBuffer::kMaxPooledSize + 1);
+  IOBuffer::Free(buffer);
+  EXPECT_EQ(hits, IOBuffer::pool_hits());
+  EXPECT_EQ(misses, IOBuffer::pool_misses());
+  IOBuffer::ClearPool();
+}
+
+
+UNIT_TEST_CASE(IOBufferPoolLimit) {
+  IOBuffer::ClearPool();
+  const intptr_t kCount =
+      2 * IOBuffer::kMaxPooledBytes / IOBuffer::kMaxPooledSize;
+  uint8_t* buffers[kCount];
+  for (intptr_t i = 0; i < kCount; i++) {
+    buffers[i] = IOBuffer::Allocate(IOBuffer::kMaxPooledSize);
+  }
+  for (intptr_t i = 0; i < kCount; i++) {
+    IOBuffer::Free(buffers[i]);
+  }
+  // Only kMaxPooledBytes of the freed blocks are kept.
+  intptr_t hits = IOBuffer::pool_hits();
+  for (intptr_t i = 0; i < kCount; i++) {
+    buffers[i] = IOBuffer::Allocate(IOBuffer::kMaxPooledSize);
+  }
+  EXPECT_EQ(hits + kCount / 2, IOBuffer::pool_hits());
+  for (intptr_t i = 0; i < kCount; i++) {
+    IOBuffer::Free(buffers[i]);
+  }
+  IOBuffer::ClearPool();
+}
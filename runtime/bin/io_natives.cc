@@ -18,9 +18,12 @@
 // builtin_natives.cc instead.
 #define IO_NATIVE_LIST(V)                                                      \
   V(Common_IsBuiltinList, 1)                                                   \
+  V(Common_IsExternalByteArray, 1)                                             \
   V(Crypto_GetRandomBytes, 1)                                                  \
   V(EventHandler_Start, 1)                                                     \
   V(EventHandler_SendData, 4)                                                  \
+  V(EventHandler_AddTimer, 3)                                                  \
+  V(EventHandler_CancelTimer, 2)                                               \
   V(Platform_NumberOfProcessors, 0)                                            \
   V(Platform_OperatingSystem, 0)                                               \
   V(Platform_PathSeparator, 0)                                                 \
@@ -30,13 +33,15 @@
   V(Process_Kill, 3)                                                           \
   V(Process_SetExitCode, 1)                                                    \
   V(Process_Exit, 1)                                                           \
-  V(ServerSocket_CreateBindListen, 4)                                          \
+  V(ServerSocket_CreateBindListen, 5)                                          \
   V(ServerSocket_Accept, 2)                                                    \
   V(Socket_CreateConnect, 3)                                                   \
   V(Socket_Available, 1)                                                       \
   V(Socket_Read, 2)                                                            \
   V(Socket_ReadList, 4)                                                        \
   V(Socket_WriteList, 4)                                                       \
+  V(Socket_WriteBuffers, 3)                                                    \
+  V(Socket_WriteFile, 4)                                                       \
   V(Socket_GetPort, 1)                                                         \
   V(Socket_GetRemotePeer, 1)                                                   \
   V(Socket_GetError, 1)                                                        \
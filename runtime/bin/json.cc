@@ -0,0 +1,534 @@
+// Copyright (c) 2013, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "third_party/double-conversion/src/double-conversion.h"
+
+#include "bin/builtin.h"
+#include "include/dart_api.h"
+#include "platform/assert.h"
+#include "platform/globals.h"
+#include "platform/utils.h"
+
+
+// Builds Dart values from JSON text held as UTF-8 (CharType uint8_t) or
+// UTF-16 (CharType uint16_t) code units. Arrays become fixed-length lists.
+// Maps cannot be created through the embedding API, so objects become
+// fixed-length lists holding the object marker followed by the keys and
+// values, and the Dart code turns them into maps. Keys without escapes are
+// only allocated once per parse.
+//
+// The parser gives up on input which is not valid JSON, on integers which
+// do not fit in 64 bits, on escaped lone surrogates in UTF-8 input and on
+// deep nesting. The Dart parser then handles the input and reports the
+// errors.
+template<typename CharType>
+class JsonParser {
+ public:
+  JsonParser(const CharType* json, intptr_t length, Dart_Handle object_marker)
+      : json_(json),
+        length_(length),
+        position_(0),
+        object_marker_(object_marker),
+        stack_(NULL),
+        stack_length_(0),
+        stack_capacity_(0),
+        buffer_(NULL),
+        buffer_capacity_(0),
+        keys_(NULL),
+        keys_count_(0),
+        keys_capacity_(0) {
+  }
+
+  ~JsonParser() {
+    free(stack_);
+    free(buffer_);
+    free(keys_);
+  }
+
+  // Returns the parsed value, or NULL if the parser gave up.
+  Dart_Handle Parse() {
+    SkipWhitespace();
+    if (!ParseValue(0)) return NULL;
+    SkipWhitespace();
+    if (position_ != length_) return NULL;
+    ASSERT(stack_length_ == 1);
+    return stack_[0];
+  }
+
+ private:
+  static const intptr_t kMaxDepth = 1000;
+  // Integers with more digits are left to the Dart parser.
+  static const intptr_t kMaxInt64Digits = 18;
+
+  struct Key {
+    const CharType* chars;
+    intptr_t length;
+    uint32_t hash;
+    Dart_Handle string;
+  };
+
+  static bool IsDigit(CharType c) {
+    return (c >= '0') && (c <= '9');
+  }
+
+  static int HexDigitValue(CharType c) {
+    if ((c >= '0') && (c <= '9')) return c - '0';
+    if ((c >= 'a') && (c <= 'f')) return c - 'a' + 10;
+    if ((c >= 'A') && (c <= 'F')) return c - 'A' + 10;
+    return -1;
+  }
+
+  static Dart_Handle NewString(const uint8_t* utf8, intptr_t length) {
+    return Dart_NewStringFromUTF8(utf8, length);
+  }
+
+  static Dart_Handle NewString(const uint16_t* utf16, intptr_t length) {
+    return Dart_NewStringFromUTF16(utf16, length);
+  }
+
+  void SkipWhitespace() {
+    while (position_ < length_) {
+      CharType c = json_[position_];
+      if ((c != ' ') && (c != '\n') && (c != '\r') && (c != '\t')) return;
+      position_++;
+    }
+  }
+
+  void Push(Dart_Handle value) {
+    if (stack_length_ == stack_capacity_) {
+      stack_capacity_ = (stack_capacity_ == 0) ? 64 : stack_capacity_ * 2;
+      stack_ = reinterpret_cast<Dart_Handle*>(
+          realloc(stack_, stack_capacity_ * sizeof(Dart_Handle)));
+    }
+    stack_[stack_length_++] = value;
+  }
+
+  void EnsureBufferCapacity(intptr_t capacity) {
+    if (capacity > buffer_capacity_) {
+      buffer_capacity_ = dart::Utils::Maximum(capacity, buffer_capacity_ * 2);
+      buffer_ = reinterpret_cast<CharType*>(
+          realloc(buffer_, buffer_capacity_ * sizeof(CharType)));
+    }
+  }
+
+  // Parses a value and pushes it on the stack.
+  bool ParseValue(intptr_t depth) {
+    if (position_ == length_) return false;
+    switch (json_[position_]) {
+      case '"':
+        return ParseString(false);
+      case '[':
+        return ParseArray(depth + 1);
+      case '{':
+        return ParseObject(depth + 1);
+      case 't':
+        return ParseLiteral("true", Dart_True());
+      case 'f':
+        return ParseLiteral("false", Dart_False());
+      case 'n':
+        return ParseLiteral("null", Dart_Null());
+      default:
+        return ParseNumber();
+    }
+  }
+
+  bool ParseLiteral(const char* literal, Dart_Handle value) {
+    intptr_t length = strlen(literal);
+    if (position_ + length > length_) return false;
+    for (intptr_t i = 0; i < length; i++) {
+      if (json_[position_ + i] != literal[i]) return false;
+    }
+    position_ += length;
+    Push(value);
+    return true;
+  }
+
+  bool ParseArray(intptr_t depth) {
+    if (depth > kMaxDepth) return false;
+    ASSERT(json_[position_] == '[');
+    position_++;
+    intptr_t start = stack_length_;
+    SkipWhitespace();
+    if ((position_ < length_) && (json_[position_] == ']')) {
+      position_++;
+      return MakeList(start);
+    }
+    while (true) {
+      if (!ParseValue(depth)) return false;
+      SkipWhitespace();
+      if (position_ == length_) return false;
+      CharType c = json_[position_++];
+      if (c == ']') return MakeList(start);
+      if (c != ',') return false;
+      SkipWhitespace();
+    }
+  }
+
+  bool ParseObject(intptr_t depth) {
+    if (depth > kMaxDepth) return false;
+    ASSERT(json_[position_] == '{');
+    position_++;
+    intptr_t start = stack_length_;
+    Push(object_marker_);
+    SkipWhitespace();
+    if ((position_ < length_) && (json_[position_] == '}')) {
+      position_++;
+      return MakeList(start);
+    }
+    while (true) {
+      if ((position_ == length_) || (json_[position_] != '"')) return false;
+      if (!ParseString(true)) return false;
+      SkipWhitespace();
+      if ((position_ == length_) || (json_[position_] != ':')) return false;
+      position_++;
+      SkipWhitespace();
+      if (!ParseValue(depth)) return false;
+      SkipWhitespace();
+      if (position_ == length_) return false;
+      CharType c = json_[position_++];
+      if (c == '}') return MakeList(start);
+      if (c != ',') return false;
+      SkipWhitespace();
+    }
+  }
+
+  // Replaces the values on the stack from start on with a list of them.
+  bool MakeList(intptr_t start) {
+    intptr_t length = stack_length_ - start;
+    Dart_Handle list = Dart_NewList(length);
+    if (Dart_IsError(list)) return false;
+    for (intptr_t i = 0; i < length; i++) {
+      Dart_ListSetAt(list, i, stack_[start + i]);
+    }
+    stack_length_ = start;
+    Push(list);
+    return true;
+  }
+
+  bool ParseString(bool is_key) {
+    ASSERT(json_[position_] == '"');
+    intptr_t start = ++position_;
+    while (position_ < length_) {
+      CharType c = json_[position_];
+      if (c == '"') {
+        const CharType* chars = &json_[start];
+        intptr_t length = position_ - start;
+        position_++;
+        Dart_Handle string =
+            is_key ? LookupKey(chars, length) : NewString(chars, length);
+        if (Dart_IsError(string)) return false;
+        Push(string);
+        return true;
+      }
+      if (c == '\\') break;
+      if (c < ' ') return false;
+      position_++;
+    }
+    // The string has escapes. Collect the code units in the buffer.
+    intptr_t length = position_ - start;
+    EnsureBufferCapacity(length + 16);
+    memmove(buffer_, &json_[start], length * sizeof(CharType));
+    while (true) {
+      if (position_ == length_) return false;
+      CharType c = json_[position_++];
+      if (c == '"') break;
+      if (c < ' ') return false;
+      // An escape produces at most four UTF-8 code units.
+      EnsureBufferCapacity(length + 4);
+      if (c != '\\') {
+        buffer_[length++] = c;
+        continue;
+      }
+      if (position_ == length_) return false;
+      c = json_[position_++];
+      switch (c) {
+        case '"':
+        case '\\':
+        case '/':
+          buffer_[length++] = c;
+          break;
+        case 'b':
+          buffer_[length++] = '\b';
+          break;
+        case 'f':
+          buffer_[length++] = '\f';
+          break;
+        case 'n':
+          buffer_[length++] = '\n';
+          break;
+        case 'r':
+          buffer_[length++] = '\r';
+          break;
+        case 't':
+          buffer_[length++] = '\t';
+          break;
+        case 'u': {
+          int32_t code_unit = ParseHexEscape();
+          if (code_unit < 0) return false;
+          if (!AddCodeUnit(code_unit, &length)) return false;
+          break;
+        }
+        default:
+          return false;
+      }
+    }
+    Dart_Handle string = NewString(buffer_, length);
+    if (Dart_IsError(string)) return false;
+    Push(string);
+    return true;
+  }
+
+  // Parses the four hex digits of a \u escape.
+  int32_t ParseHexEscape() {
+    if (position_ + 4 > length_) return -1;
+    int32_t value = 0;
+    for (intptr_t i = 0; i < 4; i++) {
+      int digit = HexDigitValue(json_[position_++]);
+      if (digit < 0) return -1;
+      value = (value << 4) | digit;
+    }
+    return value;
+  }
+
+  // Adds an escaped UTF-16 code unit to the buffer.
+  bool AddCodeUnit(int32_t code_unit, intptr_t* length);
+
+  // Converts the number of the given length at start, which matches the
+  // JSON number grammar, to a double.
+  double ParseDouble(intptr_t start, intptr_t length);
+
+  bool ParseNumber() {
+    intptr_t start = position_;
+    bool is_negative = false;
+    if (json_[position_] == '-') {
+      is_negative = true;
+      position_++;
+    }
+    if ((position_ == length_) || !IsDigit(json_[position_])) return false;
+    if (json_[position_] == '0') {
+      position_++;
+      if ((position_ < length_) && IsDigit(json_[position_])) return false;
+    } else {
+      while ((position_ < length_) && IsDigit(json_[position_])) position_++;
+    }
+    intptr_t integer_end = position_;
+    bool is_double = false;
+    if ((position_ < length_) && (json_[position_] == '.')) {
+      is_double = true;
+      position_++;
+      if ((position_ == length_) || !IsDigit(json_[position_])) return false;
+      while ((position_ < length_) && IsDigit(json_[position_])) position_++;
+    }
+    if ((position_ < length_) &&
+        ((json_[position_] == 'e') || (json_[position_] == 'E'))) {
+      is_double = true;
+      position_++;
+      if ((position_ < length_) &&
+          ((json_[position_] == '+') || (json_[position_] == '-'))) {
+        position_++;
+      }
+      if ((position_ == length_) || !IsDigit(json_[position_])) return false;
+      while ((position_ < length_) && IsDigit(json_[position_])) position_++;
+    }
+    if (!is_double) {
+      intptr_t digits_start = is_negative ? start + 1 : start;
+      if (integer_end - digits_start > kMaxInt64Digits) return false;
+      int64_t value = 0;
+      for (intptr_t i = digits_start; i < integer_end; i++) {
+        value = value * 10 + (json_[i] - '0');
+      }
+      Push(Dart_NewInteger(is_negative ? -value : value));
+      return true;
+    }
+    Push(Dart_NewDouble(ParseDouble(start, position_ - start)));
+    return true;
+  }
+
+  // Returns the string for a key, allocating it the first time the key is
+  // seen.
+  Dart_Handle LookupKey(const CharType* chars, intptr_t length) {
+    if (2 * (keys_count_ + 1) > keys_capacity_) GrowKeys();
+    uint32_t hash = dart::Utils::StringHash(
+        reinterpret_cast<const char*>(chars), length * sizeof(CharType));
+    intptr_t mask = keys_capacity_ - 1;
+    intptr_t index = hash & mask;
+    while (keys_[index].chars != NULL) {
+      Key* key = &keys_[index];
+      if ((key->hash == hash) && (key->length == length) &&
+          (memcmp(key->chars, chars, length * sizeof(CharType)) == 0)) {
+        return key->string;
+      }
+      index = (index + 1) & mask;
+    }
+    Dart_Handle string = NewString(chars, length);
+    if (Dart_IsError(string)) return string;
+    keys_[index].chars = chars;
+    keys_[index].length = length;
+    keys_[index].hash = hash;
+    keys_[index].string = string;
+    keys_count_++;
+    return string;
+  }
+
+  void GrowKeys() {
+    Key* old_keys = keys_;
+    intptr_t old_capacity = keys_capacity_;
+    keys_capacity_ = (old_capacity == 0) ? 64 : old_capacity * 2;
+    keys_ = reinterpret_cast<Key*>(calloc(keys_capacity_, sizeof(Key)));
+    intptr_t mask = keys_capacity_ - 1;
+    for (intptr_t i = 0; i < old_capacity; i++) {
+      if (old_keys[i].chars != NULL) {
+        intptr_t index = old_keys[i].hash & mask;
+        while (keys_[index].chars != NULL) index = (index + 1) & mask;
+        keys_[index] = old_keys[i];
+      }
+    }
+    free(old_keys);
+  }
+
+  const CharType* json_;
+  intptr_t length_;
+  intptr_t position_;
+  Dart_Handle object_marker_;
+
+  // The values of the arrays and objects being parsed.
+  Dart_Handle* stack_;
+  intptr_t stack_length_;
+  intptr_t stack_capacity_;
+
+  // The code units of a string with escapes.
+  CharType* buffer_;
+  intptr_t buffer_capacity_;
+
+  // Open addressing table of the keys seen so far.
+  Key* keys_;
+  intptr_t keys_count_;
+  intptr_t keys_capacity_;
+
+  DISALLOW_IMPLICIT_CONSTRUCTORS(JsonParser);
+};
+
+
+template<>
+bool JsonParser<uint8_t>::AddCodeUnit(int32_t code_unit, intptr_t* length) {
+  int32_t code_point = code_unit;
+  if ((code_unit & 0xFC00) == 0xD800) {
+    // A lead surrogate must be followed by an escaped trail surrogate.
+    if ((position_ + 2 > length_) || (json_[position_] != '\\') ||
+        (json_[position_ + 1] != 'u')) {
+      return false;
+    }
+    position_ += 2;
+    int32_t trail = ParseHexEscape();
+    if ((trail < 0) || ((trail & 0xFC00) != 0xDC00)) return false;
+    code_point = 0x10000 + ((code_unit & 0x3FF) << 10) + (trail & 0x3FF);
+  } else if ((code_unit & 0xFC00) == 0xDC00) {
+    return false;
+  }
+  uint8_t* dst = &buffer_[*length];
+  if (code_point <= 0x7F) {
+    dst[0] = code_point;
+    *length += 1;
+  } else if (code_point <= 0x7FF) {
+    dst[0] = 0xC0 | (code_point >> 6);
+    dst[1] = 0x80 | (code_point & 0x3F);
+    *length += 2;
+  } else if (code_point <= 0xFFFF) {
+    dst[0] = 0xE0 | (code_point >> 12);
+    dst[1] = 0x80 | ((code_point >> 6) & 0x3F);
+    dst[2] = 0x80 | (code_point & 0x3F);
+    *length += 3;
+  } else {
+    dst[0] = 0xF0 | (code_point >> 18);
+    dst[1] = 0x80 | ((code_point >> 12) & 0x3F);
+    dst[2] = 0x80 | ((code_point >> 6) & 0x3F);
+    dst[3] = 0x80 | (code_point & 0x3F);
+    *length += 4;
+  }
+  return true;
+}
+
+
+template<>
+bool JsonParser<uint16_t>::AddCodeUnit(int32_t code_unit, intptr_t* length) {
+  buffer_[(*length)++] = code_unit;
+  return true;
+}
+
+
+// Converts a number matching the JSON grammar, which is a subset of what
+// the converter accepts. Unlike strtod the conversion does not depend on
+// the locale.
+static double StringToDouble(const char* chars, intptr_t length) {
+  double_conversion::StringToDoubleConverter converter(
+      double_conversion::StringToDoubleConverter::NO_FLAGS,
+      0.0,
+      0.0,
+      NULL,
+      NULL);
+  int processed = 0;
+  double value =
+      converter.StringToDouble(chars, static_cast<int>(length), &processed);
+  ASSERT(processed == length);
+  return value;
+}
+
+
+template<>
+double JsonParser<uint8_t>::ParseDouble(intptr_t start, intptr_t length) {
+  return StringToDouble(reinterpret_cast<const char*>(json_ + start), length);
+}
+
+
+template<>
+double JsonParser<uint16_t>::ParseDouble(intptr_t start, intptr_t length) {
+  // The converter reads 8-bit characters. The number only has ASCII
+  // characters, so it is narrowed on the stack unless it is unusually long.
+  const intptr_t kBufferSize = 64;
+  char buffer[kBufferSize];
+  char* number = (length <= kBufferSize) ? buffer : new char[length];
+  for (intptr_t i = 0; i < length; i++) {
+    number[i] = static_cast<char>(json_[start + i]);
+  }
+  double value = StringToDouble(number, length);
+  if (number != buffer) delete[] number;
+  return value;
+}
+
+
+// Parses a JSON string. Returns the object marker if the parser gives up,
+// so that the Dart parser can handle the input.
+void FUNCTION_NAME(JsonParser_Parse)(Dart_NativeArguments args) {
+  Dart_EnterScope();
+  Dart_Handle json = Dart_GetNativeArgument(args, 0);
+  Dart_Handle object_marker = Dart_GetNativeArgument(args, 1);
+  Dart_Handle result = NULL;
+  if (Dart_IsStringLatin1(json)) {
+    // Latin-1 strings have no surrogates, so they are parsed as UTF-8.
+    uint8_t* utf8 = NULL;
+    intptr_t length = 0;
+    Dart_Handle status = Dart_StringToUTF8(json, &utf8, &length);
+    if (Dart_IsError(status)) Dart_PropagateError(status);
+    JsonParser<uint8_t> parser(utf8, length, object_marker);
+    result = parser.Parse();
+  } else if (Dart_IsString(json)) {
+    intptr_t length = 0;
+    Dart_Handle status = Dart_StringLength(json, &length);
+    if (Dart_IsError(status)) Dart_PropagateError(status);
+    uint16_t* utf16 = new uint16_t[length];
+    status = Dart_StringToUTF16(json, utf16, &length);
+    if (Dart_IsError(status)) {
+      delete[] utf16;
+      Dart_PropagateError(status);
+    }
+    JsonParser<uint16_t> parser(utf16, length, object_marker);
+    result = parser.Parse();
+    delete[] utf16;
+  }
+  Dart_SetReturnValue(args, (result != NULL) ? result : object_marker);
+  Dart_ExitScope();
+}
@@ -0,0 +1,60 @@
+// Copyright (c) 2013, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+patch parse(String json, [reviver(var key, var value)]) {
+  var value = _parse(json, _OBJECT_MARKER);
+  if (identical(value, _OBJECT_MARKER)) {
+    // The native parser gave up. The Dart parser handles the input and
+    // reports the errors.
+    BuildJsonListener listener;
+    if (reviver == null) {
+      listener = new BuildJsonListener();
+    } else {
+      listener = new ReviverJsonListener(reviver);
+    }
+    new JsonParser(json, listener).parse();
+    return listener.result;
+  }
+  value = _buildJsonValue(value, reviver);
+  return (reviver == null) ? value : reviver("", value);
+}
+
+
+// Marks the lists holding the keys and values of JSON objects.
+class _JsonObjectMarker {
+  const _JsonObjectMarker();
+}
+
+const _OBJECT_MARKER = const _JsonObjectMarker();
+
+
+// Returns the value of json, or objectMarker if json is not valid JSON or
+// uses features the native parser leaves to the Dart parser. Arrays are
+// returned as fixed-length lists and objects as fixed-length lists holding
+// objectMarker followed by the keys and values.
+_parse(String json, objectMarker) native "JsonParser_Parse";
+
+
+// Turns the lists returned by _parse into growable lists and maps, calling
+// reviver on the elements and properties in the order the Dart parser does.
+_buildJsonValue(value, reviver(var key, var value)) {
+  if (value is! List) return value;
+  List list = value;
+  int length = list.length;
+  if (length > 0 && identical(list[0], _OBJECT_MARKER)) {
+    Map map = {};
+    for (int i = 1; i < length; i += 2) {
+      var key = list[i];
+      var element = _buildJsonValue(list[i + 1], reviver);
+      map[key] = (reviver == null) ? element : reviver(key, element);
+    }
+    return map;
+  }
+  List result = new List(length);
+  for (int i = 0; i < length; i++) {
+    var element = _buildJsonValue(list[i], reviver);
+    result[i] = (reviver == null) ? element : reviver(i, element);
+  }
+  return result;
+}
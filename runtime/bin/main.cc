@@ -421,6 +421,7 @@ static bool CreateIsolateAndSetupHelper(const char* script_uri,
   if (snapshot_buffer != NULL) {
     // Setup the native resolver as the snapshot does not carry it.
     Builtin::SetNativeResolver(Builtin::kBuiltinLibrary);
+    Builtin::SetNativeResolver(Builtin::kJsonLibrary);
     Builtin::SetNativeResolver(Builtin::kIOLibrary);
   }
 
@@ -439,7 +440,16 @@ static bool CreateIsolateAndSetupHelper(const char* script_uri,
       return false;
     }
     size_t len = snapshot_file->Length();
-    uint8_t* buffer = reinterpret_cast<uint8_t*>(malloc(len));
+    // Map the snapshot read-only so that its pages are shared between
+    // processes running the same snapshot and the isolate can refer to the
+    // immutable parts of the snapshot in place. The mapping is never
+    // released as the isolate keeps referring to it.
+    uint8_t* mapping = reinterpret_cast<uint8_t*>(
+        snapshot_file->Map(File::kMapReadOnly, 0, len));
+    uint8_t* buffer = mapping;
+    if (mapping == NULL) {
+      buffer = reinterpret_cast<uint8_t*>(malloc(len));
+    }
     if (buffer == NULL) {
       delete snapshot_file;
       snapshot_file = NULL;
@@ -455,9 +465,13 @@ static bool CreateIsolateAndSetupHelper(const char* script_uri,
         Builtin::LoadAndCheckLibrary(Builtin::kBuiltinLibrary);
     DartUtils::PrepareForScriptLoading(package_root, builtin_lib);
 
-    snapshot_file->ReadFully(buffer, len);
-    library = Dart_LoadScriptFromSnapshot(buffer);
-    free(buffer);
+    if (mapping != NULL) {
+      library = Dart_LoadScriptFromMappedSnapshot(mapping);
+    } else {
+      snapshot_file->ReadFully(buffer, len);
+      library = Dart_LoadScriptFromSnapshot(buffer);
+      free(buffer);
+    }
     delete snapshot_file;
     snapshot_file = NULL;
     use_script_snapshot = false;  // No further usage of script snapshots.
@@ -620,6 +634,7 @@ static int ErrorExit(const char* format, ...) {
 
   Dart_ExitScope();
   Dart_ShutdownIsolate();
+  Dart_Cleanup();
 
   return kErrorExitCode;
 }
@@ -775,6 +790,8 @@ int main(int argc, char** argv) {
   Dart_ExitScope();
   // Shutdown the isolate.
   Dart_ShutdownIsolate();
+  // Shutdown the VM.
+  Dart_Cleanup();
   // Terminate process exit-code handler.
   Process::TerminateExitCodeHandler();
   // Free copied argument strings if converted.
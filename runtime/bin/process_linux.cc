@@ -8,9 +8,11 @@
 #include <fcntl.h>
 #include <poll.h>
 #include <signal.h>
+#include <spawn.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/stat.h>
 #include <sys/wait.h>
 #include <unistd.h>
 
@@ -20,6 +22,19 @@
 
 extern char **environ;
 
+// posix_spawn returns the error of a failed exec in the child process from
+// glibc 2.24, and can change the working directory of the child process from
+// glibc 2.29. Otherwise the child process is forked when it needs the
+// feature that is missing.
+#if defined(__GLIBC_PREREQ)
+#if __GLIBC_PREREQ(2, 24)
+#define HAS_POSIX_SPAWN_EXEC_ERRORS 1
+#endif
+#if __GLIBC_PREREQ(2, 29)
+#define HAS_POSIX_SPAWN_CHDIR 1
+#endif
+#endif
+
 // ProcessInfo is used to map a process id to the file descriptor for
 // the pipe used to communicate the exit code of the process to Dart.
 // ProcessInfo objects are kept in the static singly-linked
@@ -170,6 +185,10 @@ class ExitCodeHandler {
     }
   }
 
+  // Held while waiting for exited processes. Process::Start holds it
+  // until a started process is registered.
+  static dart::Mutex* reap_mutex() { return &reap_mutex_; }
+
   static void ExitCodeThreadTerminated() {
     MonitorLocker locker(&thread_terminate_monitor_);
     thread_terminated_ = true;
@@ -183,6 +202,7 @@ class ExitCodeHandler {
   // signal is received to retrieve the exit codes and post them to
   // dart.
   static void GetProcessExitCodes() {
+    MutexLocker locker(&reap_mutex_);
     pid_t pid = 0;
     int status = 0;
     while ((pid = TEMP_FAILURE_RETRY(waitpid(-1, &status, WNOHANG))) > 0) {
@@ -247,6 +267,7 @@ class ExitCodeHandler {
   }
 
   static dart::Mutex mutex_;
+  static dart::Mutex reap_mutex_;
   static bool initialized_;
   static int sig_chld_fds_[2];
   static bool thread_terminated_;
@@ -255,6 +276,7 @@ class ExitCodeHandler {
 
 
 dart::Mutex ExitCodeHandler::mutex_;
+dart::Mutex ExitCodeHandler::reap_mutex_;
 bool ExitCodeHandler::initialized_ = false;
 int ExitCodeHandler::sig_chld_fds_[2] = { 0, 0 };
 bool ExitCodeHandler::thread_terminated_ = false;
@@ -281,22 +303,110 @@ static void SigChldHandler(int process_signal, siginfo_t* siginfo, void* tmp) {
 }
 
 
-static void ReportChildError(int exec_control_fd) {
-  // In the case of failure in the child process write the errno and
-  // the OS error message to the exec control pipe and exit.
-  int child_errno = errno;
-  char* os_error_message = strerror(errno);
-  ASSERT(sizeof(child_errno) == sizeof(errno));
-  int bytes_written =
-      FDUtils::WriteToBlocking(
-          exec_control_fd, &child_errno, sizeof(child_errno));
-  if (bytes_written == sizeof(child_errno)) {
-    FDUtils::WriteToBlocking(
-        exec_control_fd, os_error_message, strlen(os_error_message) + 1);
+// Returns the path of the executable to start, which the caller has to
+// free. A path without a slash is looked up on the PATH of the environment
+// of the process to start, which is where execvp would look for it, or on
+// the PATH of this process if no environment is passed. The lookup is done
+// before the child process is started so that the child only has to call
+// execve. Returns NULL if the executable is not found.
+static char* FindExecutable(const char* path,
+                            char* environment[],
+                            intptr_t environment_length) {
+  if (strchr(path, '/') != NULL) return strdup(path);
+  const char* search_path = NULL;
+  if (environment == NULL) {
+    search_path = getenv("PATH");
+  } else {
+    for (intptr_t i = 0; i < environment_length; i++) {
+      if (strncmp(environment[i], "PATH=", 5) == 0) {
+        search_path = environment[i] + 5;
+      }
+    }
+  }
+  // The default search path of execvp.
+  if (search_path == NULL) search_path = "/bin:/usr/bin";
+  intptr_t path_length = strlen(path);
+  while (true) {
+    const char* end = strchr(search_path, ':');
+    intptr_t length =
+        (end == NULL) ? strlen(search_path) : end - search_path;
+    // An empty entry is the current directory.
+    char* candidate = static_cast<char*>(malloc(length + path_length + 3));
+    if (length == 0) {
+      snprintf(candidate, path_length + 3, "./%s", path);
+    } else {
+      snprintf(candidate, length + path_length + 2, "%.*s/%s",
+               static_cast<int>(length), search_path, path);
+    }
+    // access succeeds for directories, which cannot be executed.
+    struct stat st;
+    if ((TEMP_FAILURE_RETRY(stat(candidate, &st)) == 0) &&
+        S_ISREG(st.st_mode) &&
+        (TEMP_FAILURE_RETRY(access(candidate, X_OK)) == 0)) {
+      return candidate;
+    }
+    free(candidate);
+    if (end == NULL) return NULL;
+    search_path = end + 1;
+  }
+}
+
+
+static void ClosePipe(int fds[2]) {
+  TEMP_FAILURE_RETRY(close(fds[0]));
+  TEMP_FAILURE_RETRY(close(fds[1]));
+}
+
+
+#if !defined(HAS_POSIX_SPAWN_CHDIR)
+// Starts the child process with fork, for when posix_spawn cannot change its
+// working directory or report a failed exec. The child process sets up its
+// standard file descriptors and working directory like the file actions of
+// posix_spawn would. Returns 0 or the errno of the step that failed, which
+// the child process reports through a pipe that is closed on exec.
+static int ForkAndExec(const char* executable,
+                       char* arguments[],
+                       char* environment[],
+                       const char* working_directory,
+                       int stdin_fd,
+                       int stdout_fd,
+                       int stderr_fd,
+                       pid_t* pid) {
+  int exec_control[2];
+  if (TEMP_FAILURE_RETRY(pipe2(exec_control, O_CLOEXEC)) < 0) {
+    return errno;
+  }
+  *pid = TEMP_FAILURE_RETRY(fork());
+  if (*pid < 0) {
+    int error = errno;
+    ClosePipe(exec_control);
+    return error;
+  } else if (*pid == 0) {
+    // Only async signal safe functions can be called in the child process.
+    if ((TEMP_FAILURE_RETRY(dup2(stdin_fd, STDIN_FILENO)) != -1) &&
+        (TEMP_FAILURE_RETRY(dup2(stdout_fd, STDOUT_FILENO)) != -1) &&
+        (TEMP_FAILURE_RETRY(dup2(stderr_fd, STDERR_FILENO)) != -1) &&
+        ((working_directory == NULL) ||
+         (TEMP_FAILURE_RETRY(chdir(working_directory)) != -1))) {
+      execve(executable, arguments, environment);
+    }
+    int child_errno = errno;
+    TEMP_FAILURE_RETRY(
+        write(exec_control[1], &child_errno, sizeof(child_errno)));
+    _exit(127);
   }
-  TEMP_FAILURE_RETRY(close(exec_control_fd));
-  exit(1);
+  // The read returns no data when the exec closed the pipe.
+  TEMP_FAILURE_RETRY(close(exec_control[1]));
+  int child_errno = 0;
+  ssize_t bytes_read = FDUtils::ReadFromBlocking(exec_control[0],
+                                                 &child_errno,
+                                                 sizeof(child_errno));
+  int error = (bytes_read == -1) ? errno : 0;
+  TEMP_FAILURE_RETRY(close(exec_control[0]));
+  if (bytes_read == sizeof(child_errno)) return child_errno;
+  return error;
 }
+#endif
 
 
 int Process::Start(const char* path,
@@ -315,7 +425,7 @@ int Process::Start(const char* path,
   int read_in[2];  // Pipe for stdout to child process.
   int read_err[2];  // Pipe for stderr to child process.
   int write_out[2];  // Pipe for stdin to child process.
-  int exec_control[2];  // Pipe to get the result from exec.
+  int event_fds[2];  // Pipe for the exit code of the child process.
   int result;
 
   bool initialized = ExitCodeHandler::EnsureInitialized();
@@ -327,63 +437,21 @@ int Process::Start(const char* path,
     return errno;
   }
 
-  result = TEMP_FAILURE_RETRY(pipe(read_in));
-  if (result < 0) {
-    SetChildOsErrorMessage(os_error_message);
-    Log::PrintErr("Error pipe creation failed: %s\n", *os_error_message);
-    return errno;
-  }
-
-  result = TEMP_FAILURE_RETRY(pipe(read_err));
-  if (result < 0) {
-    SetChildOsErrorMessage(os_error_message);
-    TEMP_FAILURE_RETRY(close(read_in[0]));
-    TEMP_FAILURE_RETRY(close(read_in[1]));
-    Log::PrintErr("Error pipe creation failed: %s\n", *os_error_message);
-    return errno;
-  }
-
-  result = TEMP_FAILURE_RETRY(pipe(write_out));
-  if (result < 0) {
-    SetChildOsErrorMessage(os_error_message);
-    TEMP_FAILURE_RETRY(close(read_in[0]));
-    TEMP_FAILURE_RETRY(close(read_in[1]));
-    TEMP_FAILURE_RETRY(close(read_err[0]));
-    TEMP_FAILURE_RETRY(close(read_err[1]));
-    Log::PrintErr("Error pipe creation failed: %s\n", *os_error_message);
-    return errno;
-  }
-
-  result = TEMP_FAILURE_RETRY(pipe(exec_control));
-  if (result < 0) {
-    SetChildOsErrorMessage(os_error_message);
-    TEMP_FAILURE_RETRY(close(read_in[0]));
-    TEMP_FAILURE_RETRY(close(read_in[1]));
-    TEMP_FAILURE_RETRY(close(read_err[0]));
-    TEMP_FAILURE_RETRY(close(read_err[1]));
-    TEMP_FAILURE_RETRY(close(write_out[0]));
-    TEMP_FAILURE_RETRY(close(write_out[1]));
-    Log::PrintErr("Error pipe creation failed: %s\n", *os_error_message);
-    return errno;
-  }
-
-  // Set close on exec on the write file descriptor of the exec control pipe.
-  result = TEMP_FAILURE_RETRY(
-      fcntl(exec_control[1],
-            F_SETFD,
-            TEMP_FAILURE_RETRY(fcntl(exec_control[1], F_GETFD)) | FD_CLOEXEC));
-  if (result < 0) {
-    SetChildOsErrorMessage(os_error_message);
-    TEMP_FAILURE_RETRY(close(read_in[0]));
-    TEMP_FAILURE_RETRY(close(read_in[1]));
-    TEMP_FAILURE_RETRY(close(read_err[0]));
-    TEMP_FAILURE_RETRY(close(read_err[1]));
-    TEMP_FAILURE_RETRY(close(write_out[0]));
-    TEMP_FAILURE_RETRY(close(write_out[1]));
-    TEMP_FAILURE_RETRY(close(exec_control[0]));
-    TEMP_FAILURE_RETRY(close(exec_control[1]));
-    Log::PrintErr("fcntl failed: %s\n", *os_error_message);
-    return errno;
+  // All pipes are created close on exec so that processes started
+  // concurrently by other threads do not inherit them. Duplicating the
+  // ends used by the child process onto its standard file descriptors
+  // clears the flag for those.
+  int* pipes[] = { read_in, read_err, write_out, event_fds };
+  const intptr_t kPipeCount = sizeof(pipes) / sizeof(pipes[0]);
+  for (intptr_t i = 0; i < kPipeCount; i++) {
+    result = TEMP_FAILURE_RETRY(pipe2(pipes[i], O_CLOEXEC));
+    if (result < 0) {
+      int error = errno;
+      SetChildOsErrorMessage(os_error_message);
+      for (intptr_t j = 0; j < i; j++) ClosePipe(pipes[j]);
+      Log::PrintErr("Error pipe creation failed: %s\n", *os_error_message);
+      return error;
+    }
   }
 
   char** program_arguments = new char*[arguments_length + 2];
@@ -393,7 +461,7 @@ int Process::Start(const char* path,
   }
   program_arguments[arguments_length + 1] = NULL;
 
-  char** program_environment = NULL;
+  char** program_environment = environ;
   if (environment != NULL) {
     program_environment = new char*[environment_length + 1];
     for (int i = 0; i < environment_length; i++) {
@@ -401,6 +469,35 @@ int Process::Start(const char* path,
     }
     program_environment[environment_length] = NULL;
   }
+  char* executable = FindExecutable(path, environment, environment_length);
+
+  // The child process is started with posix_spawn which does not copy the
+  // page tables of the VM like fork does. The child only sets up its
+  // standard file descriptors and working directory before exec.
+  posix_spawn_file_actions_t file_actions;
+  result = posix_spawn_file_actions_init(&file_actions);
+  const bool has_file_actions = (result == 0);
+  if (result == 0) {
+    result = posix_spawn_file_actions_adddup2(
+        &file_actions, write_out[0], STDIN_FILENO);
+  }
+  if (result == 0) {
+    result = posix_spawn_file_actions_adddup2(
+        &file_actions, read_in[1], STDOUT_FILENO);
+  }
+  if (result == 0) {
+    result = posix_spawn_file_actions_adddup2(
+        &file_actions, read_err[1], STDERR_FILENO);
+  }
+#if defined(HAS_POSIX_SPAWN_CHDIR)
+  if ((result == 0) && (working_directory != NULL)) {
+    result = posix_spawn_file_actions_addchdir_np(&file_actions,
+                                                  working_directory);
+  }
+#endif
+  if ((result == 0) && (executable == NULL)) {
+    result = ENOENT;
+  }
 
   struct sigaction act;
   bzero(&act, sizeof(act));
@@ -409,131 +506,58 @@ int Process::Start(const char* path,
   if (sigaction(SIGCHLD, &act, 0) != 0) {
     perror("Process start: setting signal handler failed");
   }
-  pid = TEMP_FAILURE_RETRY(fork());
-  if (pid < 0) {
-    SetChildOsErrorMessage(os_error_message);
-    delete[] program_arguments;
-    TEMP_FAILURE_RETRY(close(read_in[0]));
-    TEMP_FAILURE_RETRY(close(read_in[1]));
-    TEMP_FAILURE_RETRY(close(read_err[0]));
-    TEMP_FAILURE_RETRY(close(read_err[1]));
-    TEMP_FAILURE_RETRY(close(write_out[0]));
-    TEMP_FAILURE_RETRY(close(write_out[1]));
-    TEMP_FAILURE_RETRY(close(exec_control[0]));
-    TEMP_FAILURE_RETRY(close(exec_control[1]));
-    return errno;
-  } else if (pid == 0) {
-    // Wait for parent process before setting up the child process.
-    char msg;
-    int bytes_read = FDUtils::ReadFromBlocking(read_in[0], &msg, sizeof(msg));
-    if (bytes_read != sizeof(msg)) {
-      perror("Failed receiving notification message");
-      exit(1);
-    }
-
-    TEMP_FAILURE_RETRY(close(write_out[1]));
-    TEMP_FAILURE_RETRY(close(read_in[0]));
-    TEMP_FAILURE_RETRY(close(read_err[0]));
-    TEMP_FAILURE_RETRY(close(exec_control[0]));
-
-    if (TEMP_FAILURE_RETRY(dup2(write_out[0], STDIN_FILENO)) == -1) {
-      ReportChildError(exec_control[1]);
-    }
-    TEMP_FAILURE_RETRY(close(write_out[0]));
-
-    if (TEMP_FAILURE_RETRY(dup2(read_in[1], STDOUT_FILENO)) == -1) {
-      ReportChildError(exec_control[1]);
-    }
-    TEMP_FAILURE_RETRY(close(read_in[1]));
-
-    if (TEMP_FAILURE_RETRY(dup2(read_err[1], STDERR_FILENO)) == -1) {
-      ReportChildError(exec_control[1]);
-    }
-    TEMP_FAILURE_RETRY(close(read_err[1]));
-
-    if (working_directory != NULL &&
-        TEMP_FAILURE_RETRY(chdir(working_directory)) == -1) {
-      ReportChildError(exec_control[1]);
+  if (result == 0) {
+    // The exit code handler must not reap the child process before it is
+    // registered with its exit code pipe.
+    MutexLocker locker(ExitCodeHandler::reap_mutex());
+#if defined(HAS_POSIX_SPAWN_CHDIR)
+    result = posix_spawn(&pid, executable, &file_actions, NULL,
+                         program_arguments, program_environment);
+#else
+#if defined(HAS_POSIX_SPAWN_EXEC_ERRORS)
+    bool use_fork = (working_directory != NULL);
+#else
+    bool use_fork = true;
+#endif
+    if (use_fork) {
+      result = ForkAndExec(executable, program_arguments,
+                           program_environment, working_directory,
+                           write_out[0], read_in[1], read_err[1], &pid);
+    } else {
+      result = posix_spawn(&pid, executable, &file_actions, NULL,
+                           program_arguments, program_environment);
     }
-
-    if (program_environment != NULL) {
-      environ = program_environment;
+#endif
+    if (result == 0) {
+      ProcessInfoList::AddProcess(pid, event_fds[1]);
     }
-
-    TEMP_FAILURE_RETRY(
-        execvp(path, const_cast<char* const*>(program_arguments)));
-
-    ReportChildError(exec_control[1]);
+  }
+  if (has_file_actions) {
+    posix_spawn_file_actions_destroy(&file_actions);
   }
 
   // The arguments and environment for the spawned process are not needed
   // any longer.
+  free(executable);
   delete[] program_arguments;
-  delete[] program_environment;
+  if (program_environment != environ) {
+    delete[] program_environment;
+  }
 
-  int event_fds[2];
-  result = TEMP_FAILURE_RETRY(pipe(event_fds));
-  if (result < 0) {
-    SetChildOsErrorMessage(os_error_message);
-    TEMP_FAILURE_RETRY(close(read_in[0]));
-    TEMP_FAILURE_RETRY(close(read_in[1]));
-    TEMP_FAILURE_RETRY(close(read_err[0]));
-    TEMP_FAILURE_RETRY(close(read_err[1]));
-    TEMP_FAILURE_RETRY(close(write_out[0]));
-    TEMP_FAILURE_RETRY(close(write_out[1]));
-    Log::PrintErr("Error pipe creation failed: %s\n", *os_error_message);
-    return errno;
+  // Return error code if the process could not be started. This includes
+  // exec failing in the child process.
+  if (result != 0) {
+    *os_error_message = strdup(strerror(result));
+    ClosePipe(read_in);
+    ClosePipe(read_err);
+    ClosePipe(write_out);
+    ClosePipe(event_fds);
+    return result;
   }
-  FDUtils::SetCloseOnExec(event_fds[0]);
-  FDUtils::SetCloseOnExec(event_fds[1]);
 
-  ProcessInfoList::AddProcess(pid, event_fds[1]);
   *exit_event = event_fds[0];
   FDUtils::SetNonBlocking(event_fds[0]);
 
-  // Notify child process to start.
-  char msg = '1';
-  result = FDUtils::WriteToBlocking(read_in[1], &msg, sizeof(msg));
-  if (result != sizeof(msg)) {
-    perror("Failed sending notification message");
-  }
-
-  // Read exec result from child. If no data is returned the exec was
-  // successful and the exec call closed the pipe. Otherwise the errno
-  // is written to the pipe.
-  TEMP_FAILURE_RETRY(close(exec_control[1]));
-  int child_errno;
-  int bytes_read = -1;
-  ASSERT(sizeof(child_errno) == sizeof(errno));
-  bytes_read =
-      FDUtils::ReadFromBlocking(
-          exec_control[0], &child_errno, sizeof(child_errno));
-  if (bytes_read == sizeof(child_errno)) {
-    static const int kMaxMessageSize = 256;
-    char* message = static_cast<char*>(malloc(kMaxMessageSize));
-    bytes_read = FDUtils::ReadFromBlocking(exec_control[0],
-                                           message,
-                                           kMaxMessageSize);
-    message[kMaxMessageSize - 1] = '\0';
-    *os_error_message = message;
-  }
-  TEMP_FAILURE_RETRY(close(exec_control[0]));
-
-  // Return error code if any failures.
-  if (bytes_read != 0) {
-    TEMP_FAILURE_RETRY(close(read_in[0]));
-    TEMP_FAILURE_RETRY(close(read_in[1]));
-    TEMP_FAILURE_RETRY(close(read_err[0]));
-    TEMP_FAILURE_RETRY(close(read_err[1]));
-    TEMP_FAILURE_RETRY(close(write_out[0]));
-    TEMP_FAILURE_RETRY(close(write_out[1]));
-    if (bytes_read == -1) {
-      return errno;  // Read failed.
-    } else {
-      return child_errno;  // Exec failed.
-    }
-  }
-
   FDUtils::SetNonBlocking(read_in[0]);
   *in = read_in[0];
   TEMP_FAILURE_RETRY(close(read_in[1]));
@@ -5,6 +5,8 @@
 #include "bin/io_buffer.h"
 #include "bin/socket.h"
 #include "bin/dartutils.h"
+#include "bin/file.h"
+#include "bin/host_resolver.h"
 #include "bin/thread.h"
 #include "bin/utils.h"
 
@@ -128,17 +130,17 @@ void FUNCTION_NAME(Socket_ReadList)(Dart_NativeArguments args) {
     if (short_socket_reads) {
       length = (length + 1) / 2;
     }
-    uint8_t* buffer = new uint8_t[length];
+    uint8_t* buffer = IOBuffer::Allocate(length);
     intptr_t bytes_read = Socket::Read(socket, buffer, length);
     if (bytes_read > 0) {
       Dart_Handle result =
           Dart_ListSetAsBytes(buffer_obj, offset, buffer, bytes_read);
       if (Dart_IsError(result)) {
-        delete[] buffer;
+        IOBuffer::Free(buffer);
         Dart_PropagateError(result);
       }
     }
-    delete[] buffer;
+    IOBuffer::Free(buffer);
     if (bytes_read >= 0) {
       Dart_SetReturnValue(args, Dart_NewInteger(bytes_read));
     } else {
@@ -180,19 +182,28 @@ void FUNCTION_NAME(Socket_WriteList)(Dart_NativeArguments args) {
 
   intptr_t total_bytes_written = 0;
   intptr_t bytes_written = 0;
-  if (Dart_IsByteArrayExternal(buffer_obj)) {
+  if (Dart_IsByteArray(buffer_obj)) {
+    // Write directly from the bytes of the array.
     void* buffer = NULL;
-    result = Dart_ExternalByteArrayGetData(buffer_obj, &buffer);
+    intptr_t buffer_length = 0;
+    result = Dart_ByteArrayAcquireData(buffer_obj, &buffer, &buffer_length);
     if (Dart_IsError(result)) {
       Dart_PropagateError(result);
     }
-    bytes_written = Socket::Write(socket, buffer, length);
+    ASSERT(buffer_length == buffer_len);
+    bytes_written = Socket::Write(
+        socket, reinterpret_cast<uint8_t*>(buffer) + offset, length);
     if (bytes_written > 0) total_bytes_written = bytes_written;
+    // Releasing the data does not change errno.
+    result = Dart_ByteArrayReleaseData(buffer_obj);
+    if (Dart_IsError(result)) {
+      Dart_PropagateError(result);
+    }
   } else {
     // Send data in chunks of maximum 16KB.
     const intptr_t max_chunk_length =
         dart::Utils::Minimum(length, static_cast<intptr_t>(16 * KB));
-    uint8_t* buffer = new uint8_t[max_chunk_length];
+    uint8_t* buffer = IOBuffer::Allocate(max_chunk_length);
     do {
       intptr_t chunk_length =
           dart::Utils::Minimum(max_chunk_length, length - total_bytes_written);
@@ -201,14 +212,14 @@ void FUNCTION_NAME(Socket_WriteList)(Dart_NativeArguments args) {
                                    buffer,
                                    chunk_length);
       if (Dart_IsError(result)) {
-        delete[] buffer;
+        IOBuffer::Free(buffer);
         Dart_PropagateError(result);
       }
       bytes_written =
           Socket::Write(socket, reinterpret_cast<void*>(buffer), chunk_length);
       if (bytes_written > 0) total_bytes_written += bytes_written;
     } while (bytes_written > 0 && total_bytes_written < length);
-    delete[] buffer;
+    IOBuffer::Free(buffer);
   }
   if (bytes_written >= 0) {
     Dart_SetReturnValue(args, Dart_NewInteger(total_bytes_written));
@@ -219,6 +230,108 @@ void FUNCTION_NAME(Socket_WriteList)(Dart_NativeArguments args) {
 }
 
 
+void FUNCTION_NAME(Socket_WriteBuffers)(Dart_NativeArguments args) {
+  Dart_EnterScope();
+  static bool short_socket_writes = Dart_IsVMFlagSet("short_socket_write");
+  Dart_Handle socket_obj = Dart_GetNativeArgument(args, 0);
+  intptr_t socket = 0;
+  Socket::GetSocketIdNativeField(socket_obj, &socket);
+  Dart_Handle buffers_obj = Dart_GetNativeArgument(args, 1);
+  ASSERT(Dart_IsList(buffers_obj));
+  intptr_t offset =
+      DartUtils::GetIntegerValue(Dart_GetNativeArgument(args, 2));
+  intptr_t count = 0;
+  Dart_Handle result = Dart_ListLength(buffers_obj, &count);
+  if (Dart_IsError(result)) {
+    Dart_PropagateError(result);
+  }
+  count = dart::Utils::Minimum(count, Socket::kMaxWriteBuffers);
+  if (short_socket_writes) {
+    count = dart::Utils::Minimum(count, static_cast<intptr_t>(1));
+  }
+
+  // Byte arrays are written directly from their bytes, other lists are
+  // copied. As acquiring the bytes of an array prevents allocation, all
+  // copies are made before any array is acquired.
+  Dart_Handle buffer_objs[Socket::kMaxWriteBuffers];
+  const void* buffers[Socket::kMaxWriteBuffers];
+  intptr_t starts[Socket::kMaxWriteBuffers];
+  intptr_t lengths[Socket::kMaxWriteBuffers];
+  uint8_t* copies[Socket::kMaxWriteBuffers];
+  intptr_t copied = 0;
+  for (intptr_t i = 0; i < count; i++) {
+    buffer_objs[i] = Dart_ListGetAt(buffers_obj, i);
+    intptr_t buffer_len = 0;
+    result = Dart_ListLength(buffer_objs[i], &buffer_len);
+    if (!Dart_IsError(result)) {
+      starts[i] = (i == 0) ? offset : 0;
+      ASSERT(starts[i] <= buffer_len);
+      lengths[i] = buffer_len - starts[i];
+      if (short_socket_writes) {
+        lengths[i] = (lengths[i] + 1) / 2;
+      }
+      if (!Dart_IsByteArray(buffer_objs[i])) {
+        uint8_t* copy = IOBuffer::Allocate(lengths[i]);
+        copies[copied++] = copy;
+        buffers[i] = copy;
+        result =
+            Dart_ListGetAsBytes(buffer_objs[i], starts[i], copy, lengths[i]);
+      }
+    }
+    if (Dart_IsError(result)) {
+      for (intptr_t j = 0; j < copied; j++) IOBuffer::Free(copies[j]);
+      Dart_PropagateError(result);
+    }
+  }
+  for (intptr_t i = 0; i < count; i++) {
+    if (Dart_IsByteArray(buffer_objs[i])) {
+      void* data = NULL;
+      intptr_t data_length = 0;
+      result = Dart_ByteArrayAcquireData(buffer_objs[i], &data, &data_length);
+      ASSERT(!Dart_IsError(result));
+      buffers[i] = reinterpret_cast<uint8_t*>(data) + starts[i];
+    }
+  }
+  intptr_t bytes_written =
+      Socket::WriteBuffers(socket, buffers, lengths, count);
+  // Releasing the data and freeing the copies does not change errno.
+  for (intptr_t i = 0; i < count; i++) {
+    if (Dart_IsByteArray(buffer_objs[i])) {
+      Dart_ByteArrayReleaseData(buffer_objs[i]);
+    }
+  }
+  for (intptr_t i = 0; i < copied; i++) IOBuffer::Free(copies[i]);
+  if (bytes_written >= 0) {
+    Dart_SetReturnValue(args, Dart_NewInteger(bytes_written));
+  } else {
+    Dart_SetReturnValue(args, DartUtils::NewDartOSError());
+  }
+  Dart_ExitScope();
+}
+
+
+void FUNCTION_NAME(Socket_WriteFile)(Dart_NativeArguments args) {
+  Dart_EnterScope();
+  Dart_Handle socket_obj = Dart_GetNativeArgument(args, 0);
+  intptr_t socket = 0;
+  Socket::GetSocketIdNativeField(socket_obj, &socket);
+  File* file = reinterpret_cast<File*>(
+      DartUtils::GetIntptrValue(Dart_GetNativeArgument(args, 1)));
+  ASSERT(file != NULL);
+  int64_t position =
+      DartUtils::GetIntegerValue(Dart_GetNativeArgument(args, 2));
+  int64_t length =
+      DartUtils::GetIntegerValue(Dart_GetNativeArgument(args, 3));
+  int64_t bytes_written = file->TransferTo(socket, position, length);
+  if (bytes_written >= 0) {
+    Dart_SetReturnValue(args, Dart_NewInteger(bytes_written));
+  } else {
+    Dart_SetReturnValue(args, DartUtils::NewDartOSError());
+  }
+  Dart_ExitScope();
+}
+
+
 void FUNCTION_NAME(Socket_GetPort)(Dart_NativeArguments args) {
   Dart_EnterScope();
   Dart_Handle socket_obj = Dart_GetNativeArgument(args, 0);
@@ -302,14 +415,17 @@ void FUNCTION_NAME(ServerSocket_CreateBindListen)(Dart_NativeArguments args) {
   Dart_Handle bind_address_obj = Dart_GetNativeArgument(args, 1);
   Dart_Handle port_obj = Dart_GetNativeArgument(args, 2);
   Dart_Handle backlog_obj = Dart_GetNativeArgument(args, 3);
+  Dart_Handle shared_obj = Dart_GetNativeArgument(args, 4);
   int64_t port = 0;
   int64_t backlog = 0;
   if (Dart_IsString(bind_address_obj) &&
       DartUtils::GetInt64Value(port_obj, &port) &&
-      DartUtils::GetInt64Value(backlog_obj, &backlog)) {
+      DartUtils::GetInt64Value(backlog_obj, &backlog) &&
+      Dart_IsBoolean(shared_obj)) {
     const char* bind_address = DartUtils::GetStringValue(bind_address_obj);
+    bool shared = DartUtils::GetBooleanValue(shared_obj);
     intptr_t socket =
-        ServerSocket::CreateBindListen(bind_address, port, backlog);
+        ServerSocket::CreateBindListen(bind_address, port, backlog, shared);
     if (socket >= 0) {
       Socket::SetSocketIdNativeField(socket_obj, socket);
       Dart_SetReturnValue(args, Dart_True());
@@ -336,37 +452,50 @@ void FUNCTION_NAME(ServerSocket_Accept)(Dart_NativeArguments args) {
   Dart_Handle socket_obj = Dart_GetNativeArgument(args, 0);
   intptr_t socket = 0;
   Socket::GetSocketIdNativeField(socket_obj, &socket);
-  Dart_Handle result_socket_obj = Dart_GetNativeArgument(args, 1);
-  intptr_t new_socket = ServerSocket::Accept(socket);
-  if (new_socket >= 0) {
+  Dart_Handle result_sockets_obj = Dart_GetNativeArgument(args, 1);
+  intptr_t length = 0;
+  Dart_Handle result = Dart_ListLength(result_sockets_obj, &length);
+  if (Dart_IsError(result)) Dart_PropagateError(result);
+  // Accept pending connections until the listening socket has no more
+  // connections ready or the result list is full.
+  intptr_t accepted = 0;
+  while (accepted < length) {
+    intptr_t new_socket = ServerSocket::Accept(socket);
+    if (new_socket < 0) {
+      if (new_socket != ServerSocket::kTemporaryFailure && accepted == 0) {
+        Dart_SetReturnValue(args, DartUtils::NewDartOSError());
+        Dart_ExitScope();
+        return;
+      }
+      // An error after some connections have been accepted is reported on
+      // the next wakeup.
+      break;
+    }
+    Dart_Handle result_socket_obj =
+        Dart_ListGetAt(result_sockets_obj, accepted);
+    if (Dart_IsError(result_socket_obj)) {
+      Dart_PropagateError(result_socket_obj);
+    }
     Socket::SetSocketIdNativeField(result_socket_obj, new_socket);
-    Dart_SetReturnValue(args, Dart_True());
-  } else if (new_socket == ServerSocket::kTemporaryFailure) {
-    Dart_SetReturnValue(args, Dart_False());
-  } else {
-    Dart_SetReturnValue(args, DartUtils::NewDartOSError());
+    accepted++;
   }
+  Dart_SetReturnValue(args, Dart_NewInteger(accepted));
   Dart_ExitScope();
 }
 
 
-static CObject* LookupRequest(const CObjectArray& request) {
-  if (request.Length() == 2 && request[1]->IsString()) {
-    CObjectString host(request[1]);
-    CObject* result = NULL;
-    OSError* os_error = NULL;
-    const char* ip_address =
-        Socket::LookupIPv4Address(host.CString(), &os_error);
-    if (ip_address != NULL) {
-      result = new CObjectString(CObject::NewString(ip_address));
-      free(const_cast<char*>(ip_address));
-    } else {
-      result = CObject::NewOSError(os_error);
-      delete os_error;
-    }
-    return result;
+static void PostLookupResult(const char* address,
+                             OSError* os_error,
+                             void* data) {
+  Dart_Port* reply_port = reinterpret_cast<Dart_Port*>(data);
+  CObject* result = NULL;
+  if (address != NULL) {
+    result = new CObjectString(CObject::NewString(address));
+  } else {
+    result = CObject::NewOSError(os_error);
   }
-  return CObject::IllegalArgumentError();
+  Dart_PostCObject(*reply_port, result->AsApiCObject());
+  delete reply_port;
 }
 
 
@@ -380,7 +509,16 @@ void SocketService(Dart_Port dest_port_id,
       CObjectInt32 request_type(request[0]);
       switch (request_type.Value()) {
         case Socket::kLookupRequest:
-          response = LookupRequest(request);
+          if (request.Length() == 2 && request[1]->IsString()) {
+            // The reply is posted by the resolver, possibly from the thread
+            // of another lookup of the same host.
+            CObjectString host(request[1]);
+            HostResolver::Lookup(host.CString(),
+                                 PostLookupResult,
+                                 new Dart_Port(reply_port_id));
+            return;
+          }
+          response = CObject::IllegalArgumentError();
           break;
         default:
           UNREACHABLE();
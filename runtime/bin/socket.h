@@ -30,10 +30,21 @@ class Socket {
     kLookupRequest = 0,
   };
 
+  // Maximum number of buffers passed to a single WriteBuffers call.
+  static const intptr_t kMaxWriteBuffers = 64;
+
   static bool Initialize();
   static intptr_t Available(intptr_t fd);
   static int Read(intptr_t fd, void* buffer, intptr_t num_bytes);
   static int Write(intptr_t fd, const void* buffer, intptr_t num_bytes);
+  // Write count buffers in order, using a single system call where the
+  // platform supports it. Returns the number of bytes written, which is
+  // less than the total length of the buffers if the socket cannot take
+  // more data without blocking, or -1 on error.
+  static intptr_t WriteBuffers(intptr_t fd,
+                               const void* const* buffers,
+                               const intptr_t* lengths,
+                               intptr_t count);
   static intptr_t CreateConnect(const char* host, const intptr_t port);
   static intptr_t GetPort(intptr_t fd);
   static bool GetRemotePeer(intptr_t fd, char* host, intptr_t* port);
@@ -72,9 +83,14 @@ class ServerSocket {
   //
   //   -1: system error (errno set)
   //   -5: invalid bindAddress
+  //
+  // If shared is true several listening sockets can be bound to the same
+  // address and port, and the incoming connections are distributed
+  // between them. This is not supported on all platforms.
   static intptr_t CreateBindListen(const char* bindAddress,
                                    intptr_t port,
-                                   intptr_t backlog);
+                                   intptr_t backlog,
+                                   bool shared = false);
 
   DISALLOW_ALLOCATION();
   DISALLOW_IMPLICIT_CONSTRUCTORS(ServerSocket);
@@ -6,6 +6,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/uio.h>
 #include <unistd.h>
 
 #include "bin/socket.h"
@@ -21,7 +22,6 @@ bool Socket::Initialize() {
 
 intptr_t Socket::CreateConnect(const char* host, const intptr_t port) {
   intptr_t fd;
-  struct hostent* server;
   struct sockaddr_in server_address;
 
   fd = TEMP_FAILURE_RETRY(socket(AF_INET, SOCK_STREAM, 0));
@@ -33,16 +33,16 @@ intptr_t Socket::CreateConnect(const char* host, const intptr_t port) {
   FDUtils::SetCloseOnExec(fd);
   FDUtils::SetNonBlocking(fd);
 
-  server = gethostbyname(host);
-  if (server == NULL) {
+  server_address.sin_family = AF_INET;
+  server_address.sin_port = htons(port);
+  // The host name has already been resolved to an IPv4 address in
+  // dotted-decimal notation, so this does not block on a name lookup.
+  if (inet_pton(AF_INET, host, &server_address.sin_addr) != 1) {
     TEMP_FAILURE_RETRY(close(fd));
-    Log::PrintErr("Error CreateConnect: %s\n", strerror(errno));
+    Log::PrintErr("Error CreateConnect: invalid address %s\n", host);
+    errno = EINVAL;
     return -1;
   }
-
-  server_address.sin_family = AF_INET;
-  server_address.sin_port = htons(port);
-  bcopy(server->h_addr, &server_address.sin_addr.s_addr, server->h_length);
   memset(&server_address.sin_zero, 0, sizeof(server_address.sin_zero));
   intptr_t result = TEMP_FAILURE_RETRY(
       connect(fd,
@@ -86,6 +86,28 @@ int Socket::Write(intptr_t fd, const void* buffer, intptr_t num_bytes) {
 }
 
 
+intptr_t Socket::WriteBuffers(intptr_t fd,
+                              const void* const* buffers,
+                              const intptr_t* lengths,
+                              intptr_t count) {
+  ASSERT(fd >= 0);
+  ASSERT(count <= kMaxWriteBuffers);
+  struct iovec iov[kMaxWriteBuffers];
+  for (intptr_t i = 0; i < count; i++) {
+    iov[i].iov_base = const_cast<void*>(buffers[i]);
+    iov[i].iov_len = lengths[i];
+  }
+  ssize_t written_bytes = TEMP_FAILURE_RETRY(writev(fd, iov, count));
+  ASSERT(EAGAIN == EWOULDBLOCK);
+  if (written_bytes == -1 && errno == EWOULDBLOCK) {
+    // If the would block we need to retry and therefore return 0 as
+    // the number of bytes written.
+    written_bytes = 0;
+  }
+  return written_bytes;
+}
+
+
 intptr_t Socket::GetPort(intptr_t fd) {
   ASSERT(fd >= 0);
   struct sockaddr_in socket_address;
@@ -175,7 +197,8 @@ const char* Socket::LookupIPv4Address(char* host, OSError** os_error) {
 
 intptr_t ServerSocket::CreateBindListen(const char* host,
                                         intptr_t port,
-                                        intptr_t backlog) {
+                                        intptr_t backlog,
+                                        bool shared) {
   intptr_t fd;
   struct sockaddr_in server_address;
 
@@ -196,6 +219,21 @@ intptr_t ServerSocket::CreateBindListen(const char* host,
   TEMP_FAILURE_RETRY(
       setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &optval, sizeof(optval)));
 
+  if (shared) {
+#if defined(SO_REUSEPORT)
+    if (TEMP_FAILURE_RETRY(setsockopt(
+            fd, SOL_SOCKET, SO_REUSEPORT, &optval, sizeof(optval))) < 0) {
+      TEMP_FAILURE_RETRY(close(fd));
+      Log::PrintErr("Error SO_REUSEPORT: %s\n", strerror(errno));
+      return -1;
+    }
+#else
+    TEMP_FAILURE_RETRY(close(fd));
+    errno = ENOPROTOOPT;
+    return -1;
+#endif
+  }
+
   server_address.sin_family = AF_INET;
   server_address.sin_port = htons(port);
   server_address.sin_addr.s_addr = s_addr;
@@ -245,6 +283,7 @@ intptr_t ServerSocket::Accept(intptr_t fd) {
     }
   } else {
     FDUtils::SetNonBlocking(socket);
+    FDUtils::SetCloseOnExec(socket);
   }
   return socket;
 }
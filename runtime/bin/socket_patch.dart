@@ -3,8 +3,11 @@
 // BSD-style license that can be found in the LICENSE file.
 
 patch class ServerSocket {
-  /* patch */ factory ServerSocket(String bindAddress, int port, int backlog) {
-    return new _ServerSocket(bindAddress, port, backlog);
+  /* patch */ factory ServerSocket(String bindAddress,
+                                  int port,
+                                  int backlog,
+                                  {bool shared: false}) {
+    return new _ServerSocket(bindAddress, port, backlog, shared);
   }
 }
 
@@ -273,14 +276,21 @@ class _SocketBase extends NativeFieldWrapperClass1 {
 
 
 class _ServerSocket extends _SocketBase implements ServerSocket {
+  // Maximum number of connections accepted per wakeup of the listening
+  // socket.
+  static const int _ACCEPT_BATCH_SIZE = 16;
+
   // Constructor for server socket. First a socket object is allocated
   // in which the native socket is stored. After that _createBind
   // is called which creates a file descriptor and binds the given address
   // and port to the socket. Null is returned if file descriptor creation or
   // bind failed.
-  factory _ServerSocket(String bindAddress, int port, int backlog) {
+  factory _ServerSocket(String bindAddress,
+                        int port,
+                        int backlog,
+                        bool shared) {
     _ServerSocket socket = new _ServerSocket._internal();
-    var result = socket._createBindListen(bindAddress, port, backlog);
+    var result = socket._createBindListen(bindAddress, port, backlog, shared);
     if (result is OSError) {
       socket.close();
       throw new SocketIOException("Failed to create server socket", result);
@@ -295,9 +305,12 @@ class _ServerSocket extends _SocketBase implements ServerSocket {
 
   _ServerSocket._internal();
 
-  _accept(Socket socket) native "ServerSocket_Accept";
+  // Accepts up to sockets.length pending connections, storing the native
+  // socket of each accepted connection in the corresponding element of
+  // sockets. Returns the number of connections accepted or an OSError.
+  _accept(List<_Socket> sockets) native "ServerSocket_Accept";
 
-  _createBindListen(String bindAddress, int port, int backlog)
+  _createBindListen(String bindAddress, int port, int backlog, bool shared)
       native "ServerSocket_CreateBindListen";
 
   void set onConnection(void callback(Socket connection)) {
@@ -308,17 +321,35 @@ class _ServerSocket extends _SocketBase implements ServerSocket {
 
   void _connectionHandler() {
     if (!_closed) {
-      _Socket socket = new _Socket._internal();
-      var result = _accept(socket);
+      // Drain up to a batch of pending connections per wakeup. Sockets not
+      // used by one batch are kept for the next one.
+      if (_acceptSockets == null) {
+        _acceptSockets = new List<_Socket>.fixedLength(_ACCEPT_BATCH_SIZE);
+      }
+      for (int i = 0; i < _ACCEPT_BATCH_SIZE; i++) {
+        if (_acceptSockets[i] == null) {
+          _acceptSockets[i] = new _Socket._internal();
+        }
+      }
+      var result = _accept(_acceptSockets);
       if (result is OSError) {
         _reportError(result, "Accept failed");
-      } else if (result) {
+        return;
+      }
+      // A result of 0 is a temporary failure accepting the connection.
+      // Ignoring temporary failures lets us retry when we wake up with data
+      // on the listening socket again.
+      for (int i = 0; i < result; i++) {
+        _Socket socket = _acceptSockets[i];
+        _acceptSockets[i] = null;
         socket._closed = false;
-        _clientConnectionHandler(socket);
-      } else {
-        // Temporary failure accepting the connection. Ignoring
-        // temporary failures lets us retry when we wake up with data
-        // on the listening socket again.
+        if (_closed) {
+          // The server was closed by a connection handler earlier in the
+          // batch.
+          socket.close();
+        } else {
+          _clientConnectionHandler(socket);
+        }
       }
     }
   }
@@ -327,11 +358,14 @@ class _ServerSocket extends _SocketBase implements ServerSocket {
   bool _isPipe() => false;
 
   var _clientConnectionHandler;
+  List<_Socket> _acceptSockets;
 }
 
 
 class _Socket extends _SocketBase implements Socket {
   static const HOST_NAME_LOOKUP = 0;
+  // Has to be kept in sync with Socket::kMaxWriteBuffers in socket.h.
+  static const int _MAX_WRITE_BUFFERS = 64;
 
   // Constructs a new socket. During the construction an asynchronous
   // host name lookup is initiated. The returned socket is not yet
@@ -455,6 +489,77 @@ class _Socket extends _SocketBase implements Socket {
 
   _writeList(List<int> buffer, int offset, int bytes) native "Socket_WriteList";
 
+  int writeBuffers(List<List<int>> buffers, [int offset = 0]) {
+    if (buffers is! List || offset is! int) {
+      throw new ArgumentError(
+          "Invalid arguments to writeBuffers on Socket");
+    }
+    if (!_closed) {
+      if (buffers.isEmpty) {
+        return 0;
+      }
+      if (offset < 0 || offset > buffers[0].length) {
+        throw new RangeError.value(offset);
+      }
+      // Lists beyond the number of buffers written by the native call are
+      // left for the next call.
+      int count = buffers.length;
+      if (count > _MAX_WRITE_BUFFERS) count = _MAX_WRITE_BUFFERS;
+      List fastBuffers = new List.fixedLength(count);
+      int fastOffset = offset;
+      for (int i = 0; i < count; i++) {
+        List<int> buffer = buffers[i];
+        int start = (i == 0) ? offset : 0;
+        _BufferAndOffset bufferAndOffset =
+            _ensureFastAndSerializableBuffer(buffer,
+                                             start,
+                                             buffer.length - start);
+        fastBuffers[i] = bufferAndOffset.buffer;
+        if (i == 0) fastOffset = bufferAndOffset.offset;
+      }
+      var result = _writeBuffers(fastBuffers, fastOffset);
+      if (result is OSError) {
+        _reportError(result, "Write failed");
+        // If writing fails we return 0 as the number of bytes and
+        // report the error on the error handler.
+        result = 0;
+      }
+      return result;
+    }
+    throw new SocketIOException(
+        "writeBuffers failed - invalid socket handle");
+  }
+
+  _writeBuffers(List buffers, int offset) native "Socket_WriteBuffers";
+
+  int writeFile(RandomAccessFile file, int position, int count) {
+    if (file is! _RandomAccessFile || position is! int || count is! int) {
+      throw new ArgumentError(
+          "Invalid arguments to writeFile on Socket");
+    }
+    if (!_closed) {
+      if (count == 0) {
+        return 0;
+      }
+      if (position < 0) {
+        throw new RangeError.value(position);
+      }
+      if (count < 0) {
+        throw new RangeError.value(count);
+      }
+      file._checkNotClosed();
+      var result = _writeFile(file._id, position, count);
+      if (result is OSError) {
+        _reportError(result, "Write failed");
+        result = 0;
+      }
+      return result;
+    }
+    throw new SocketIOException("writeFile failed - invalid socket handle");
+  }
+
+  _writeFile(int fileId, int position, int count) native "Socket_WriteFile";
+
   bool _isErrorResponse(response) {
     return response is List && response[0] != _SUCCESS_RESPONSE;
   }
@@ -37,6 +37,24 @@ intptr_t Socket::Write(intptr_t fd, const void* buffer, intptr_t num_bytes) {
 }
 
 
+intptr_t Socket::WriteBuffers(intptr_t fd,
+                              const void* const* buffers,
+                              const intptr_t* lengths,
+                              intptr_t count) {
+  // Overlapped writes are issued one buffer at a time.
+  intptr_t total_bytes_written = 0;
+  for (intptr_t i = 0; i < count; i++) {
+    intptr_t bytes_written = Write(fd, buffers[i], lengths[i]);
+    if (bytes_written < 0) {
+      return (total_bytes_written == 0) ? -1 : total_bytes_written;
+    }
+    total_bytes_written += bytes_written;
+    if (bytes_written < lengths[i]) break;
+  }
+  return total_bytes_written;
+}
+
+
 intptr_t Socket::GetPort(intptr_t fd) {
   ASSERT(reinterpret_cast<Handle*>(fd)->is_socket());
   SocketHandle* socket_handle = reinterpret_cast<SocketHandle*>(fd);
@@ -98,12 +116,14 @@ intptr_t Socket::CreateConnect(const char* host, const intptr_t port) {
     FATAL("Failed setting SO_LINGER on socket");
   }
 
-  // Perform a name lookup for an IPv4 address.
+  // The host name has already been resolved to an IPv4 address in
+  // dotted-decimal notation, so only parse the address.
   struct addrinfo hints;
   memset(&hints, 0, sizeof(hints));
   hints.ai_family = AF_INET;
   hints.ai_socktype = SOCK_STREAM;
   hints.ai_protocol = IPPROTO_TCP;
+  hints.ai_flags = AI_NUMERICHOST;
   struct addrinfo* result = NULL;
   status = getaddrinfo(host, 0, &hints, &result);
   if (status != NO_ERROR) {
@@ -223,12 +243,19 @@ const char* Socket::LookupIPv4Address(char* host, OSError** os_error) {
 
 intptr_t ServerSocket::CreateBindListen(const char* host,
                                         intptr_t port,
-                                        intptr_t backlog) {
+                                        intptr_t backlog,
+                                        bool shared) {
   unsigned long socket_addr = inet_addr(host);  // NOLINT
   if (socket_addr == INADDR_NONE) {
     return -5;
   }
 
+  if (shared) {
+    // Windows has no equivalent of SO_REUSEPORT.
+    SetLastError(WSAEOPNOTSUPP);
+    return -1;
+  }
+
   SOCKET s = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
   if (s == INVALID_SOCKET) {
     return -1;
@@ -0,0 +1,261 @@
+// Copyright (c) 2013, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "bin/timer_wheel.h"
+
+#include "bin/thread.h"
+#include "platform/utils.h"
+
+
+TimerWheel::TimerWheel()
+    : current_(0),
+      wakeup_deadline_(kNoDeadline),
+      count_(0),
+      next_id_(1),
+      timer_map_(&HashMap::SamePointerValue, 16) {
+  for (intptr_t level = 0; level < kLevels; level++) {
+    for (intptr_t slot = 0; slot < kSlots; slot++) {
+      slots_[level][slot] = NULL;
+    }
+    occupied_[level] = 0;
+  }
+}
+
+
+TimerWheel::~TimerWheel() {
+  for (intptr_t level = 0; level < kLevels; level++) {
+    for (intptr_t slot = 0; slot < kSlots; slot++) {
+      Timer* timer = slots_[level][slot];
+      while (timer != NULL) {
+        Timer* next = timer->next_;
+        delete timer;
+        timer = next;
+      }
+    }
+  }
+}
+
+
+intptr_t TimerWheel::Add(Dart_Port port,
+                         int64_t deadline,
+                         int64_t now,
+                         bool* wakeup) {
+  MutexLocker ml(&mutex_);
+  if (count_ == 0) {
+    // Nothing is lost by moving an empty wheel to the current time, and
+    // the new timer does not have to be cascaded from a stale position.
+    current_ = now;
+  }
+  intptr_t id = next_id_++;
+  if (next_id_ <= 0) next_id_ = 1;
+  Timer* timer = new Timer(id, port, deadline);
+  Insert(timer);
+  count_++;
+  HashMap::Entry* entry = timer_map_.Lookup(
+      GetHashmapKeyFromId(id), GetHashmapHashFromId(id), true);
+  ASSERT(entry->value == NULL);
+  entry->value = timer;
+  *wakeup = (wakeup_deadline_ == kNoDeadline) || (deadline < wakeup_deadline_);
+  if (*wakeup) {
+    // The event handler asks for the next deadline when it wakes up. Until
+    // then there is no need to wake it up again.
+    wakeup_deadline_ = 0;
+  }
+  return id;
+}
+
+
+bool TimerWheel::Cancel(intptr_t id) {
+  MutexLocker ml(&mutex_);
+  HashMap::Entry* entry = timer_map_.Lookup(
+      GetHashmapKeyFromId(id), GetHashmapHashFromId(id), false);
+  if (entry == NULL) return false;
+  Timer* timer = reinterpret_cast<Timer*>(entry->value);
+  timer_map_.Remove(GetHashmapKeyFromId(id), GetHashmapHashFromId(id));
+  Remove(timer);
+  count_--;
+  delete timer;
+  // The event handler might wake up for nothing, which is harmless.
+  return true;
+}
+
+
+int64_t TimerWheel::NextDeadline() {
+  MutexLocker ml(&mutex_);
+  wakeup_deadline_ = (count_ == 0) ? kNoDeadline : NextTick();
+  return wakeup_deadline_;
+}
+
+
+TimerWheel::Timer* TimerWheel::Expire(int64_t now) {
+  MutexLocker ml(&mutex_);
+  Timer* expired = NULL;
+  while (count_ > 0) {
+    // Skip the milliseconds with nothing to expire or cascade.
+    int64_t tick = NextTick();
+    if (tick > now) break;
+    current_ = tick;
+    for (intptr_t level = 1; level < kLevels; level++) {
+      int64_t level_mask = (static_cast<int64_t>(1) << (kSlotBits * level)) - 1;
+      if ((current_ & level_mask) != 0) break;
+      Cascade(level);
+    }
+    intptr_t slot = current_ & kSlotMask;
+    Timer* timer = slots_[0][slot];
+    while (timer != NULL) {
+      Timer* next = timer->next_;
+      timer_map_.Remove(GetHashmapKeyFromId(timer->id_),
+                        GetHashmapHashFromId(timer->id_));
+      timer->previous_ = NULL;
+      timer->next_ = expired;
+      expired = timer;
+      count_--;
+      timer = next;
+    }
+    slots_[0][slot] = NULL;
+    occupied_[0] &= ~(static_cast<uint32_t>(1) << slot);
+    current_++;
+  }
+  // The slots up to now are empty, so the wheel can move past them.
+  if (current_ <= now) current_ = now + 1;
+  return expired;
+}
+
+
+void TimerWheel::PostExpired(Timer* expired) {
+  while (expired != NULL) {
+    Dart_Port port = expired->port();
+    intptr_t count = 0;
+    for (Timer* timer = expired; timer != NULL; timer = timer->next_) {
+      if (timer->port_ == port) count++;
+    }
+    // The message is allocated on the heap as the event handler thread has
+    // no API scope to allocate CObjects in.
+    Dart_CObject* ids = new Dart_CObject[count];
+    Dart_CObject** values = new Dart_CObject*[count];
+    Timer* remaining = NULL;
+    Timer** remaining_tail = &remaining;
+    intptr_t index = 0;
+    Timer* timer = expired;
+    while (timer != NULL) {
+      Timer* next = timer->next_;
+      if (timer->port_ == port) {
+        ids[index].type = Dart_CObject::kInt64;
+        ids[index].value.as_int64 = timer->id_;
+        values[index] = &ids[index];
+        index++;
+        delete timer;
+      } else {
+        timer->next_ = NULL;
+        *remaining_tail = timer;
+        remaining_tail = &timer->next_;
+      }
+      timer = next;
+    }
+    ASSERT(index == count);
+    Dart_CObject message;
+    message.type = Dart_CObject::kArray;
+    message.value.as_array.length = count;
+    message.value.as_array.values = values;
+    Dart_PostCObject(port, &message);
+    delete[] values;
+    delete[] ids;
+    expired = remaining;
+  }
+}
+
+
+intptr_t TimerWheel::count() {
+  MutexLocker ml(&mutex_);
+  return count_;
+}
+
+
+void TimerWheel::Insert(Timer* timer) {
+  // Timers which are due are expired at the current millisecond.
+  int64_t delta = timer->deadline_ - current_;
+  if (delta < 0) delta = 0;
+  // Timers beyond the range of the wheel are placed as far out as possible
+  // and cascaded into the highest level again when it is reached.
+  const int64_t kMaxDelta =
+      (static_cast<int64_t>(1) << (kSlotBits * kLevels)) - 1;
+  if (delta > kMaxDelta) delta = kMaxDelta;
+  intptr_t level = 0;
+  while ((level < kLevels - 1) &&
+         ((delta >> (kSlotBits * (level + 1))) != 0)) {
+    level++;
+  }
+  intptr_t slot = ((current_ + delta) >> (kSlotBits * level)) & kSlotMask;
+  timer->level_ = level;
+  timer->slot_ = slot;
+  timer->previous_ = NULL;
+  timer->next_ = slots_[level][slot];
+  if (timer->next_ != NULL) timer->next_->previous_ = timer;
+  slots_[level][slot] = timer;
+  occupied_[level] |= static_cast<uint32_t>(1) << slot;
+}
+
+
+void TimerWheel::Remove(Timer* timer) {
+  if (timer->previous_ != NULL) {
+    timer->previous_->next_ = timer->next_;
+  } else {
+    ASSERT(slots_[timer->level_][timer->slot_] == timer);
+    slots_[timer->level_][timer->slot_] = timer->next_;
+  }
+  if (timer->next_ != NULL) timer->next_->previous_ = timer->previous_;
+  if (slots_[timer->level_][timer->slot_] == NULL) {
+    occupied_[timer->level_] &= ~(static_cast<uint32_t>(1) << timer->slot_);
+  }
+  timer->previous_ = NULL;
+  timer->next_ = NULL;
+}
+
+
+void TimerWheel::Cascade(intptr_t level) {
+  intptr_t slot = (current_ >> (kSlotBits * level)) & kSlotMask;
+  Timer* timer = slots_[level][slot];
+  slots_[level][slot] = NULL;
+  occupied_[level] &= ~(static_cast<uint32_t>(1) << slot);
+  while (timer != NULL) {
+    Timer* next = timer->next_;
+    Insert(timer);
+    timer = next;
+  }
+}
+
+
+// Returns the first millisecond at or after current_ at which a slot with
+// timers is reached.
+int64_t TimerWheel::NextTick() {
+  int64_t next = kNoDeadline;
+  for (intptr_t level = 0; level < kLevels; level++) {
+    uint32_t occupied = occupied_[level];
+    if (occupied == 0) continue;
+    intptr_t shift = kSlotBits * level;
+    // The slots of the level are reached in order starting from the first
+    // slot boundary at or after current_.
+    int64_t first =
+        (current_ + (static_cast<int64_t>(1) << shift) - 1) >> shift;
+    intptr_t start = first & kSlotMask;
+    uint32_t rotated = occupied;
+    if (start != 0) {
+      rotated = (occupied >> start) | (occupied << (kSlots - start));
+    }
+    int64_t tick = (first + dart::Utils::CountTrailingZeros(rotated)) << shift;
+    if ((next == kNoDeadline) || (tick < next)) next = tick;
+  }
+  return next;
+}
+
+
+void* TimerWheel::GetHashmapKeyFromId(intptr_t id) {
+  ASSERT(id != 0);
+  return reinterpret_cast<void*>(id);
+}
+
+
+uint32_t TimerWheel::GetHashmapHashFromId(intptr_t id) {
+  return dart::Utils::WordHash(id);
+}
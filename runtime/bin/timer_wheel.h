@@ -0,0 +1,109 @@
+// Copyright (c) 2013, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#ifndef BIN_TIMER_WHEEL_H_
+#define BIN_TIMER_WHEEL_H_
+
+#include "bin/builtin.h"
+#include "platform/globals.h"
+#include "platform/hashmap.h"
+#include "platform/thread.h"
+
+// The timers of an event handler, kept in a hierarchical timing wheel.
+// Adding and cancelling a timer takes constant time.
+//
+// The wheel has kLevels levels of kSlots slots each. A slot of level 0
+// holds the timers expiring in one millisecond, a slot of level n holds the
+// timers expiring in kSlots^n milliseconds. When the wheel reaches a slot
+// of a higher level its timers are cascaded into the lower levels.
+//
+// Timers are added and cancelled by the isolate and expired by the event
+// handler thread. All operations are thread safe.
+class TimerWheel {
+ public:
+  static const int64_t kNoDeadline = -1;
+
+  class Timer {
+   public:
+    Timer(intptr_t id, Dart_Port port, int64_t deadline)
+        : id_(id),
+          port_(port),
+          deadline_(deadline),
+          level_(0),
+          slot_(0),
+          previous_(NULL),
+          next_(NULL) { }
+
+    intptr_t id() const { return id_; }
+    Dart_Port port() const { return port_; }
+    int64_t deadline() const { return deadline_; }
+    Timer* next() const { return next_; }
+
+   private:
+    intptr_t id_;
+    Dart_Port port_;
+    int64_t deadline_;
+    intptr_t level_;
+    intptr_t slot_;
+    Timer* previous_;
+    Timer* next_;
+
+    friend class TimerWheel;
+
+    DISALLOW_COPY_AND_ASSIGN(Timer);
+  };
+
+  TimerWheel();
+  ~TimerWheel();
+
+  // Adds a timer expiring at deadline and returns its id. Both deadline and
+  // now are in milliseconds since the epoch. Sets *wakeup to true if the
+  // event handler is waiting for a later deadline than the one added.
+  intptr_t Add(Dart_Port port, int64_t deadline, int64_t now, bool* wakeup);
+
+  // Returns false if the timer has already expired or been cancelled.
+  bool Cancel(intptr_t id);
+
+  // Returns the time at which Expire has to be called next, or kNoDeadline
+  // if there are no timers. The time returned is earlier than the deadlines
+  // of the timers when they have to be cascaded first.
+  int64_t NextDeadline();
+
+  // Removes the timers which have expired at now and returns them linked
+  // through next(). The caller takes ownership of the timers.
+  Timer* Expire(int64_t now);
+
+  // Posts the ids of the expired timers to their ports as a single list per
+  // port and deletes the timers.
+  static void PostExpired(Timer* expired);
+
+  intptr_t count();
+
+ private:
+  static const intptr_t kSlotBits = 5;
+  static const intptr_t kSlots = 1 << kSlotBits;
+  static const intptr_t kSlotMask = kSlots - 1;
+  static const intptr_t kLevels = 6;
+
+  void Insert(Timer* timer);
+  void Remove(Timer* timer);
+  void Cascade(intptr_t level);
+  int64_t NextTick();
+
+  static void* GetHashmapKeyFromId(intptr_t id);
+  static uint32_t GetHashmapHashFromId(intptr_t id);
+
+  Timer* slots_[kLevels][kSlots];
+  uint32_t occupied_[kLevels];  // Bit n is set if slot n is not empty.
+  int64_t current_;  // The next millisecond to expire timers for.
+  int64_t wakeup_deadline_;  // The deadline the event handler waits for.
+  intptr_t count_;
+  intptr_t next_id_;
+  HashMap timer_map_;  // Maps the ids to the timers in the wheel.
+  dart::Mutex mutex_;
+
+  DISALLOW_COPY_AND_ASSIGN(TimerWheel);
+};
+
+#endif  // BIN_TIMER_WHEEL_H_
@@ -0,0 +1,125 @@
+// Copyright (c) 2013, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "bin/timer_wheel.h"
+#include "platform/assert.h"
+#include "platform/globals.h"
+#include "vm/unit_test.h"
+
+
+static const int64_t kStartTime = 1360000000000LL;
+
+
+static intptr_t DeleteExpired(TimerWheel::Timer* expired) {
+  intptr_t count = 0;
+  while (expired != NULL) {
+    TimerWheel::Timer* next = expired->next();
+    delete expired;
+    expired = next;
+    count++;
+  }
+  return count;
+}
+
+
+UNIT_TEST_CASE(TimerWheelExpire) {
+  TimerWheel wheel;
+  bool wakeup = false;
+  EXPECT(wheel.NextDeadline() == TimerWheel::kNoDeadline);
+  wheel.Add(1, kStartTime, kStartTime, &wakeup);
+  intptr_t id = wheel.Add(1, kStartTime + 5, kStartTime, &wakeup);
+  wheel.Add(1, kStartTime + 100, kStartTime, &wakeup);
+  wheel.Add(1, kStartTime + 5000, kStartTime, &wakeup);
+  EXPECT_EQ(4, wheel.count());
+  EXPECT_EQ(kStartTime, wheel.NextDeadline());
+  EXPECT_EQ(1, DeleteExpired(wheel.Expire(kStartTime)));
+  EXPECT_EQ(kStartTime + 5, wheel.NextDeadline());
+  EXPECT(wheel.Expire(kStartTime + 4) == NULL);
+  TimerWheel::Timer* expired = wheel.Expire(kStartTime + 5);
+  EXPECT(expired != NULL);
+  EXPECT_EQ(id, expired->id());
+  EXPECT_EQ(1, expired->port());
+  EXPECT_EQ(kStartTime + 5, expired->deadline());
+  EXPECT_EQ(1, DeleteExpired(expired));
+  // Timers which are overdue expire together.
+  EXPECT_EQ(2, DeleteExpired(wheel.Expire(kStartTime + 10000)));
+  EXPECT_EQ(0, wheel.count());
+  EXPECT(wheel.NextDeadline() == TimerWheel::kNoDeadline);
+}
+
+
+UNIT_TEST_CASE(TimerWheelCancel) {
+  TimerWheel wheel;
+  bool wakeup = false;
+  intptr_t first = wheel.Add(1, kStartTime + 10, kStartTime, &wakeup);
+  intptr_t second = wheel.Add(1, kStartTime + 10, kStartTime, &wakeup);
+  intptr_t third = wheel.Add(1, kStartTime + 100000, kStartTime, &wakeup);
+  EXPECT(wheel.Cancel(second));
+  EXPECT(!wheel.Cancel(second));
+  EXPECT_EQ(2, wheel.count());
+  TimerWheel::Timer* expired = wheel.Expire(kStartTime + 10);
+  EXPECT(expired != NULL);
+  EXPECT_EQ(first, expired->id());
+  EXPECT_EQ(1, DeleteExpired(expired));
+  EXPECT(!wheel.Cancel(first));
+  EXPECT(wheel.Cancel(third));
+  EXPECT_EQ(0, wheel.count());
+  EXPECT(wheel.NextDeadline() == TimerWheel::kNoDeadline);
+}
+
+
+UNIT_TEST_CASE(TimerWheelCascade) {
+  // Deadlines spread over all the levels of the wheel and beyond. Moving
+  // from deadline to deadline expires every timer exactly on time.
+  static const intptr_t kTimers = 2000;
+  TimerWheel wheel;
+  bool wakeup = false;
+  int64_t delta = 1;
+  for (intptr_t i = 0; i < kTimers; i++) {
+    delta = (delta * 1103515245 + 12345) & 0x7FFFFFFF;
+    int64_t deadline = kStartTime + (delta >> (i % 31));
+    wheel.Add(2, deadline, kStartTime, &wakeup);
+  }
+  // Timers far beyond the range of the wheel.
+  wheel.Add(2, kStartTime + (1LL << 40), kStartTime, &wakeup);
+  wheel.Add(2, kStartTime + (1LL << 40) + 1, kStartTime, &wakeup);
+  int64_t now = kStartTime - 1;
+  intptr_t expired_count = 0;
+  while (true) {
+    int64_t deadline = wheel.NextDeadline();
+    if (deadline == TimerWheel::kNoDeadline) break;
+    EXPECT(deadline > now);
+    now = deadline;
+    TimerWheel::Timer* expired = wheel.Expire(now);
+    for (TimerWheel::Timer* timer = expired;
+         timer != NULL;
+         timer = timer->next()) {
+      EXPECT_EQ(now, timer->deadline());
+    }
+    expired_count += DeleteExpired(expired);
+  }
+  EXPECT_EQ(kTimers + 2, expired_count);
+  EXPECT_EQ(kStartTime + (1LL << 40) + 1, now);
+}
+
+
+UNIT_TEST_CASE(TimerWheelWakeup) {
+  TimerWheel wheel;
+  bool wakeup = false;
+  // The event handler waits without a deadline.
+  wheel.Add(1, kStartTime + 1000, kStartTime, &wakeup);
+  EXPECT(wakeup);
+  EXPECT(wheel.NextDeadline() <= kStartTime + 1000);
+  wheel.Add(1, kStartTime + 2000, kStartTime, &wakeup);
+  EXPECT(!wakeup);
+  wheel.Add(1, kStartTime + 10, kStartTime, &wakeup);
+  EXPECT(wakeup);
+  // The event handler has not asked for the new deadline yet.
+  wheel.Add(1, kStartTime + 5, kStartTime, &wakeup);
+  EXPECT(!wakeup);
+  EXPECT_EQ(kStartTime + 5, wheel.NextDeadline());
+  wheel.Add(1, kStartTime + 5, kStartTime, &wakeup);
+  EXPECT(!wakeup);
+  EXPECT_EQ(5, DeleteExpired(wheel.Expire(kStartTime + 2000)));
+}
@@ -69,6 +69,11 @@ class StringUtils {
   static const wchar_t* Utf8ToWide(const char* utf8);
 };
 
+class TimerUtils {
+ public:
+  static int64_t GetCurrentTimeMilliseconds();
+};
+
 class ShellUtils {
  public:
   // Get the arguments passed to the program as unicode strings.
@@ -4,6 +4,7 @@
 
 #include <errno.h>
 #include <netdb.h>
+#include <sys/time.h>
 
 #include "bin/utils.h"
 #include "platform/assert.h"
@@ -69,3 +70,12 @@ wchar_t** ShellUtils::GetUnicodeArgv(int* argc) {
 
 void ShellUtils::FreeUnicodeArgv(wchar_t** argv) {
 }
+
+int64_t TimerUtils::GetCurrentTimeMilliseconds() {
+  struct timeval tv;
+  if (gettimeofday(&tv, NULL) < 0) {
+    UNREACHABLE();
+    return 0;
+  }
+  return ((static_cast<int64_t>(tv.tv_sec) * 1000000) + tv.tv_usec) / 1000;
+}
@@ -113,3 +113,20 @@ wchar_t** ShellUtils::GetUnicodeArgv(int* argc) {
 void ShellUtils::FreeUnicodeArgv(wchar_t** argv) {
   LocalFree(argv);
 }
+
+int64_t TimerUtils::GetCurrentTimeMilliseconds() {
+  static const int64_t kTimeEpoc = 116444736000000000LL;
+
+  // Although win32 uses 64-bit integers for representing timestamps,
+  // these are packed into a FILETIME structure. The FILETIME structure
+  // is just a struct representing a 64-bit integer. The TimeStamp union
+  // allows access to both a FILETIME and an integer representation of
+  // the timestamp.
+  union TimeStamp {
+    FILETIME ft_;
+    int64_t t_;
+  };
+  TimeStamp time;
+  GetSystemTimeAsFileTime(&time.ft_);
+  return (time.t_ - kTimeEpoc) / 10000;
+}
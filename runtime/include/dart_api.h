@@ -659,6 +659,14 @@ DART_EXPORT bool Dart_Initialize(
     Dart_FileWriteCallback file_write,
     Dart_FileCloseCallback file_close);
 
+/**
+ * Cleans up the VM. Should be called after all isolates have been shut
+ * down, before the embedder exits.
+ *
+ * \return True if cleanup is successful.
+ */
+DART_EXPORT bool Dart_Cleanup();
+
 /**
  * Sets command line flags. Should be called before Dart_Initialize.
  *
@@ -1703,6 +1711,35 @@ DART_EXPORT Dart_Handle Dart_ExternalByteArrayGetData(Dart_Handle object,
 DART_EXPORT Dart_Handle Dart_ExternalByteArrayGetPeer(Dart_Handle object,
                                                       void** peer);
 
+/**
+ * Acquires direct access to the bytes of a ByteArray, internal or
+ * external, without copying them.
+ *
+ * The bytes of an internal ByteArray can be moved by a garbage
+ * collection. Until the data is released with Dart_ByteArrayReleaseData
+ * the caller must not call any Dart API function which allocates Dart
+ * objects or runs Dart code.
+ *
+ * \param array A ByteArray.
+ * \param data Returns the address of the first byte of the array.
+ * \param length Returns the length of the array in bytes.
+ *
+ * \return A valid handle if no error occurs during the operation.
+ */
+DART_EXPORT Dart_Handle Dart_ByteArrayAcquireData(Dart_Handle array,
+                                                  void** data,
+                                                  intptr_t* length);
+
+/**
+ * Releases access to the bytes of a ByteArray acquired with
+ * Dart_ByteArrayAcquireData.
+ *
+ * \param array The ByteArray passed to Dart_ByteArrayAcquireData.
+ *
+ * \return A valid handle if no error occurs during the operation.
+ */
+DART_EXPORT Dart_Handle Dart_ByteArrayReleaseData(Dart_Handle array);
+
 /**
  * Gets an int8_t at some byte offset in a ByteArray.
  *
@@ -2656,6 +2693,26 @@ DART_EXPORT Dart_Handle Dart_LoadEmbeddedScript(
  */
 DART_EXPORT Dart_Handle Dart_LoadScriptFromSnapshot(const uint8_t* buffer);
 
+/**
+ * Loads the root script for current isolate from a snapshot which is
+ * referenced in place rather than copied.
+ *
+ * Immutable data in the snapshot (e.g. token streams and long string
+ * literals) is not copied into the heap, the isolate keeps referring to
+ * it in the buffer. This is meant for snapshots which are memory mapped
+ * read-only, so that the pages are shared by all isolates and processes
+ * loading the same snapshot file.
+ *
+ * \param buffer A buffer which contains a snapshot of the script. The
+ *   buffer must stay valid and unmodified until the isolate has been
+ *   shut down.
+ *
+ * \return If no error occurs, the Library object corresponding to the root
+ *   script is returned. Otherwise an error handle is returned.
+ */
+DART_EXPORT Dart_Handle Dart_LoadScriptFromMappedSnapshot(
+    const uint8_t* buffer);
+
 /**
  * Gets the library for the root script for the current isolate.
  *
@@ -2800,6 +2857,49 @@ DART_EXPORT void Dart_InitPerfEventsSupport(void* perf_events_file);
 DART_EXPORT Dart_Handle Dart_HeapProfile(Dart_FileWriteCallback callback,
                                          void* stream);
 
+// --- CPU Profiler ---
+
+typedef enum {
+  kCpuProfileCallTree = 0,
+  kCpuProfileCollapsedStacks
+} Dart_CpuProfileFormat;
+
+/**
+ * Starts sampling the stack of the current isolate periodically.
+ *
+ * \return Success if sampling has started. Returns an error if CPU
+ *   profiling is not supported on this platform.
+ */
+DART_EXPORT Dart_Handle Dart_StartCpuProfiling();
+
+/**
+ * Stops sampling the current isolate and discards the samples taken.
+ */
+DART_EXPORT Dart_Handle Dart_StopCpuProfiling();
+
+/**
+ * Generates a CPU profile of the samples taken in the current isolate
+ * since profiling was started.
+ *
+ * With kCpuProfileCallTree the profile is a textual call tree annotated
+ * with the percentage and number of samples in each function. With
+ * kCpuProfileCollapsedStacks each line holds a stack, outermost function
+ * first and separated by ';', followed by the number of samples taken
+ * with that stack.
+ *
+ * \param format The format of the profile.
+ * \param callback A function pointer that will be invoked with the
+ *   profile data.
+ * \param stream A pointer that will be passed to the callback.  This
+ *   is a convenient way to provide an open stream to the callback.
+ *
+ * \return Success if the profile is generated. Returns an error if the
+ *   current isolate is not being profiled.
+ */
+DART_EXPORT Dart_Handle Dart_CpuProfile(Dart_CpuProfileFormat format,
+                                        Dart_FileWriteCallback callback,
+                                        void* stream);
+
 // --- Peers ---
 
 /**
@@ -321,7 +321,17 @@ abstract class _ByteArrayBase {
   }
 
   int indexOf(element, [int start = 0]) {
-    return Arrays.indexOf(this, element, start, this.length);
+    int length = this.length;
+    if (start >= length) return -1;
+    if (start < 0) start = 0;
+    // Matches close to start are found faster without the native call.
+    int end = start + _INDEX_OF_PREFIX_LENGTH;
+    if (end >= length) return Arrays.indexOf(this, element, start, length);
+    int index = Arrays.indexOf(this, element, start, end);
+    if (index >= 0) return index;
+    index = _indexOfElement(element, end);
+    if (index != null) return index;
+    return Arrays.indexOf(this, element, end, length);
   }
 
   int lastIndexOf(element, [int start = null]) {
@@ -418,6 +428,26 @@ abstract class _ByteArrayBase {
                  _ByteArrayBase from, int startFromInBytes)
       native "ByteArray_setRange";
 
+  // The number of elements indexOf searches before using the native search.
+  static const int _INDEX_OF_PREFIX_LENGTH = 64;
+
+  // Returns the index of the first element from start on that is equal to
+  // element, -1 if there is none, or null if the type of element requires
+  // the generic search.
+  int _indexOfElement(element, int start) native "ByteArray_indexOfElement";
+
+  // Bulk operations on the bytes of the array. The arguments are byte
+  // offsets and lengths that have already been checked.
+  void _fill(int startInBytes, int lengthInBytes, int value)
+      native "ByteArray_fill";
+  int _indexOfByte(int value, int startInBytes, int endInBytes)
+      native "ByteArray_indexOfByte";
+  int _compare(int startInBytes, int lengthInBytes,
+               _ByteArrayBase other, int otherStartInBytes,
+               int otherLengthInBytes) native "ByteArray_compare";
+  int _crc32(int startInBytes, int lengthInBytes, int crc)
+      native "ByteArray_crc32";
+
   int _getInt8(int byteOffset) native "ByteArray_getInt8";
   int _setInt8(int byteOffset, int value) native "ByteArray_setInt8";
 
@@ -506,6 +536,41 @@ void _rangeCheck(int listLength, int start, int length) {
 }
 
 
+// Returns true if the elements of the typed list are stored in a typed
+// array that the natives can access directly.
+bool _isByteBacked(List list) {
+  return (list is _ByteArrayBase) ||
+         ((list is _ByteArrayViewBase) && (list._array is _ByteArrayView));
+}
+
+
+// Copies length elements from one typed list to another with the same
+// element representation with a single memmove. The lists may be internal
+// arrays, external arrays or views, and may overlap.
+void _setRangeBytes(List to, int start, int length,
+                    List from, int startFrom, int bytesPerElement) {
+  if (!_isByteBacked(to) || !_isByteBacked(from)) {
+    Arrays.copy(from, startFrom, to, start, length);
+    return;
+  }
+  _rangeCheck(to.length, start, length);
+  _rangeCheck(from.length, startFrom, length);
+  int toOffset = start * bytesPerElement;
+  if (to is _ByteArrayViewBase) {
+    _ByteArrayView view = to._array;
+    toOffset += view._offset + to._offset;
+    to = view._array;
+  }
+  int fromOffset = startFrom * bytesPerElement;
+  if (from is _ByteArrayViewBase) {
+    _ByteArrayView view = from._array;
+    fromOffset += view._offset + from._offset;
+    from = view._array;
+  }
+  to._setRange(toOffset, length * bytesPerElement, from, fromOffset);
+}
+
+
 int _requireInteger(object) {
   if (object is int) {
     return object;
@@ -557,11 +622,8 @@ class _Int8Array extends _ByteArrayBase implements Int8List {
   }
 
   void setRange(int start, int length, List<int> from, [int startFrom = 0]) {
-    if (from is _Int8Array) {
-      _setRange(start * _BYTES_PER_ELEMENT,
-                length * _BYTES_PER_ELEMENT,
-                from,
-                startFrom * _BYTES_PER_ELEMENT);
+    if (from is Int8List) {
+      _setRangeBytes(this, start, length, from, startFrom, _BYTES_PER_ELEMENT);
     } else {
       Arrays.copy(from, startFrom, this, start, length);
     }
@@ -620,12 +682,8 @@ class _Uint8Array extends _ByteArrayBase implements Uint8List {
   }
 
   void setRange(int start, int length, List<int> from, [int startFrom = 0]) {
-    if (from is _Uint8Array || from is _ExternalUint8Array ||
-        from is _Uint8ClampedArray || from is _ExternalUint8ClampedArray) {
-      _setRange(start * _BYTES_PER_ELEMENT,
-                length * _BYTES_PER_ELEMENT,
-                from,
-                startFrom * _BYTES_PER_ELEMENT);
+    if (from is Uint8List || from is Uint8ClampedList) {
+      _setRangeBytes(this, start, length, from, startFrom, _BYTES_PER_ELEMENT);
     } else {
       Arrays.copy(from, startFrom, this, start, length);
     }
@@ -685,12 +743,8 @@ class _Uint8ClampedArray extends _ByteArrayBase implements Uint8ClampedList {
   }
 
   void setRange(int start, int length, List<int> from, [int startFrom = 0]) {
-    if (from is _Uint8Array || from is _ExternalUint8Array ||
-        from is _Uint8ClampedArray || from is _ExternalUint8ClampedArray) {
-      _setRange(start * _BYTES_PER_ELEMENT,
-                length * _BYTES_PER_ELEMENT,
-                from,
-                startFrom * _BYTES_PER_ELEMENT);
+    if (from is Uint8List || from is Uint8ClampedList) {
+      _setRangeBytes(this, start, length, from, startFrom, _BYTES_PER_ELEMENT);
     } else {
       Arrays.copy(from, startFrom, this, start, length);
     }
@@ -749,11 +803,8 @@ class _Int16Array extends _ByteArrayBase implements Int16List {
   }
 
   void setRange(int start, int length, List<int> from, [int startFrom = 0]) {
-    if (from is _Int16Array) {
-      _setRange(start * _BYTES_PER_ELEMENT,
-                length * _BYTES_PER_ELEMENT,
-                from,
-                startFrom * _BYTES_PER_ELEMENT);
+    if (from is Int16List) {
+      _setRangeBytes(this, start, length, from, startFrom, _BYTES_PER_ELEMENT);
     } else {
       Arrays.copy(from, startFrom, this, start, length);
     }
@@ -812,11 +863,8 @@ class _Uint16Array extends _ByteArrayBase implements Uint16List {
   }
 
   void setRange(int start, int length, List<int> from, [int startFrom = 0]) {
-    if (from is _Uint16Array) {
-      _setRange(start * _BYTES_PER_ELEMENT,
-                length * _BYTES_PER_ELEMENT,
-                from,
-                startFrom * _BYTES_PER_ELEMENT);
+    if (from is Uint16List) {
+      _setRangeBytes(this, start, length, from, startFrom, _BYTES_PER_ELEMENT);
     } else {
       Arrays.copy(from, startFrom, this, start, length);
     }
@@ -875,11 +923,8 @@ class _Int32Array extends _ByteArrayBase implements Int32List {
   }
 
   void setRange(int start, int length, List<int> from, [int startFrom = 0]) {
-    if (from is _Int32Array) {
-      _setRange(start * _BYTES_PER_ELEMENT,
-                length * _BYTES_PER_ELEMENT,
-                from,
-                startFrom * _BYTES_PER_ELEMENT);
+    if (from is Int32List) {
+      _setRangeBytes(this, start, length, from, startFrom, _BYTES_PER_ELEMENT);
     } else {
       Arrays.copy(from, startFrom, this, start, length);
     }
@@ -939,11 +984,8 @@ class _Uint32Array extends _ByteArrayBase implements Uint32List {
   }
 
   void setRange(int start, int length, List<int> from, [int startFrom = 0]) {
-    if (from is _Uint32Array) {
-      _setRange(start * _BYTES_PER_ELEMENT,
-                length * _BYTES_PER_ELEMENT,
-                from,
-                startFrom * _BYTES_PER_ELEMENT);
+    if (from is Uint32List) {
+      _setRangeBytes(this, start, length, from, startFrom, _BYTES_PER_ELEMENT);
     } else {
       Arrays.copy(from, startFrom, this, start, length);
     }
@@ -1002,11 +1044,8 @@ class _Int64Array extends _ByteArrayBase implements Int64List {
   }
 
   void setRange(int start, int length, List<int> from, [int startFrom = 0]) {
-    if (from is _Int64Array) {
-      _setRange(start * _BYTES_PER_ELEMENT,
-                length * _BYTES_PER_ELEMENT,
-                from,
-                startFrom * _BYTES_PER_ELEMENT);
+    if (from is Int64List) {
+      _setRangeBytes(this, start, length, from, startFrom, _BYTES_PER_ELEMENT);
     } else {
       Arrays.copy(from, startFrom, this, start, length);
     }
@@ -1065,11 +1104,8 @@ class _Uint64Array extends _ByteArrayBase implements Uint64List {
   }
 
   void setRange(int start, int length, List<int> from, [int startFrom = 0]) {
-    if (from is _Uint64Array) {
-      _setRange(start * _BYTES_PER_ELEMENT,
-                length * _BYTES_PER_ELEMENT,
-                from,
-                startFrom * _BYTES_PER_ELEMENT);
+    if (from is Uint64List) {
+      _setRangeBytes(this, start, length, from, startFrom, _BYTES_PER_ELEMENT);
     } else {
       Arrays.copy(from, startFrom, this, start, length);
     }
@@ -1128,11 +1164,8 @@ class _Float32Array extends _ByteArrayBase implements Float32List {
   }
 
   void setRange(int start, int length, List<double> from, [int startFrom = 0]) {
-    if (from is _Float32Array) {
-      _setRange(start * _BYTES_PER_ELEMENT,
-                length * _BYTES_PER_ELEMENT,
-                from,
-                startFrom * _BYTES_PER_ELEMENT);
+    if (from is Float32List) {
+      _setRangeBytes(this, start, length, from, startFrom, _BYTES_PER_ELEMENT);
     } else {
       Arrays.copy(from, startFrom, this, start, length);
     }
@@ -1191,11 +1224,8 @@ class _Float64Array extends _ByteArrayBase implements Float64List {
   }
 
   void setRange(int start, int length, List<double> from, [int startFrom = 0]) {
-    if (from is _Float64Array) {
-      _setRange(start * _BYTES_PER_ELEMENT,
-                length * _BYTES_PER_ELEMENT,
-                from,
-                startFrom * _BYTES_PER_ELEMENT);
+    if (from is Float64List) {
+      _setRangeBytes(this, start, length, from, startFrom, _BYTES_PER_ELEMENT);
     } else {
       Arrays.copy(from, startFrom, this, start, length);
     }
@@ -1243,11 +1273,8 @@ class _ExternalInt8Array extends _ByteArrayBase implements Int8List {
   }
 
   void setRange(int start, int length, List<int> from, [int startFrom = 0]) {
-    if (from is _ExternalInt8Array) {
-      _setRange(start * _BYTES_PER_ELEMENT,
-                length * _BYTES_PER_ELEMENT,
-                from,
-                startFrom * _BYTES_PER_ELEMENT);
+    if (from is Int8List) {
+      _setRangeBytes(this, start, length, from, startFrom, _BYTES_PER_ELEMENT);
     } else {
       Arrays.copy(from, startFrom, this, start, length);
     }
@@ -1293,11 +1320,8 @@ class _ExternalUint8Array extends _ByteArrayBase implements Uint8List {
   }
 
   void setRange(int start, int length, List<int> from, [int startFrom = 0]) {
-    if (from is _ExternalUint8Array || from is _Uint8Array) {
-      _setRange(start * _BYTES_PER_ELEMENT,
-                length * _BYTES_PER_ELEMENT,
-                from,
-                startFrom * _BYTES_PER_ELEMENT);
+    if (from is Uint8List || from is Uint8ClampedList) {
+      _setRangeBytes(this, start, length, from, startFrom, _BYTES_PER_ELEMENT);
     } else {
       Arrays.copy(from, startFrom, this, start, length);
     }
@@ -1345,11 +1369,8 @@ class _ExternalUint8ClampedArray
   }
 
   void setRange(int start, int length, List<int> from, [int startFrom = 0]) {
-    if (from is _ExternalUint8ClampedArray || from is _Uint8ClampedArray) {
-      _setRange(start * _BYTES_PER_ELEMENT,
-                length * _BYTES_PER_ELEMENT,
-                from,
-                startFrom * _BYTES_PER_ELEMENT);
+    if (from is Uint8List || from is Uint8ClampedList) {
+      _setRangeBytes(this, start, length, from, startFrom, _BYTES_PER_ELEMENT);
     } else {
       Arrays.copy(from, startFrom, this, start, length);
     }
@@ -1395,11 +1416,8 @@ class _ExternalInt16Array extends _ByteArrayBase implements Int16List {
   }
 
   void setRange(int start, int length, List<int> from, [int startFrom = 0]) {
-    if (from is _ExternalInt16Array) {
-      _setRange(start * _BYTES_PER_ELEMENT,
-                length * _BYTES_PER_ELEMENT,
-                from,
-                startFrom * _BYTES_PER_ELEMENT);
+    if (from is Int16List) {
+      _setRangeBytes(this, start, length, from, startFrom, _BYTES_PER_ELEMENT);
     } else {
       Arrays.copy(from, startFrom, this, start, length);
     }
@@ -1445,11 +1463,8 @@ class _ExternalUint16Array extends _ByteArrayBase implements Uint16List {
   }
 
   void setRange(int start, int length, List<int> from, [int startFrom = 0]) {
-    if (from is _ExternalUint16Array) {
-      _setRange(start * _BYTES_PER_ELEMENT,
-                length * _BYTES_PER_ELEMENT,
-                from,
-                startFrom * _BYTES_PER_ELEMENT);
+    if (from is Uint16List) {
+      _setRangeBytes(this, start, length, from, startFrom, _BYTES_PER_ELEMENT);
     } else {
       Arrays.copy(from, startFrom, this, start, length);
     }
@@ -1497,11 +1512,8 @@ class _ExternalInt32Array extends _ByteArrayBase implements Int32List {
   }
 
   void setRange(int start, int length, List<int> from, [int startFrom = 0]) {
-    if (from is _ExternalInt32Array) {
-      _setRange(start * _BYTES_PER_ELEMENT,
-                length * _BYTES_PER_ELEMENT,
-                from,
-                startFrom * _BYTES_PER_ELEMENT);
+    if (from is Int32List) {
+      _setRangeBytes(this, start, length, from, startFrom, _BYTES_PER_ELEMENT);
     } else {
       Arrays.copy(from, startFrom, this, start, length);
     }
@@ -1549,11 +1561,8 @@ class _ExternalUint32Array extends _ByteArrayBase implements Uint32List {
   }
 
   void setRange(int start, int length, List<int> from, [int startFrom = 0]) {
-    if (from is _ExternalUint32Array) {
-      _setRange(start * _BYTES_PER_ELEMENT,
-                length * _BYTES_PER_ELEMENT,
-                from,
-                startFrom * _BYTES_PER_ELEMENT);
+    if (from is Uint32List) {
+      _setRangeBytes(this, start, length, from, startFrom, _BYTES_PER_ELEMENT);
     } else {
       Arrays.copy(from, startFrom, this, start, length);
     }
@@ -1601,11 +1610,8 @@ class _ExternalInt64Array extends _ByteArrayBase implements Int64List {
   }
 
   void setRange(int start, int length, List<int> from, [int startFrom = 0]) {
-    if (from is _ExternalInt64Array) {
-      _setRange(start * _BYTES_PER_ELEMENT,
-                length * _BYTES_PER_ELEMENT,
-                from,
-                startFrom * _BYTES_PER_ELEMENT);
+    if (from is Int64List) {
+      _setRangeBytes(this, start, length, from, startFrom, _BYTES_PER_ELEMENT);
     } else {
       Arrays.copy(from, startFrom, this, start, length);
     }
@@ -1653,11 +1659,8 @@ class _ExternalUint64Array extends _ByteArrayBase implements Uint64List {
   }
 
   void setRange(int start, int length, List<int> from, [int startFrom = 0]) {
-    if (from is _ExternalUint64Array) {
-      _setRange(start * _BYTES_PER_ELEMENT,
-                length * _BYTES_PER_ELEMENT,
-                from,
-                startFrom * _BYTES_PER_ELEMENT);
+    if (from is Uint64List) {
+      _setRangeBytes(this, start, length, from, startFrom, _BYTES_PER_ELEMENT);
     } else {
       Arrays.copy(from, startFrom, this, start, length);
     }
@@ -1705,11 +1708,8 @@ class _ExternalFloat32Array extends _ByteArrayBase implements Float32List {
   }
 
   void setRange(int start, int length, List<double> from, [int startFrom = 0]) {
-    if (from is _ExternalFloat32Array) {
-      _setRange(start * _BYTES_PER_ELEMENT,
-                length * _BYTES_PER_ELEMENT,
-                from,
-                startFrom * _BYTES_PER_ELEMENT);
+    if (from is Float32List) {
+      _setRangeBytes(this, start, length, from, startFrom, _BYTES_PER_ELEMENT);
     } else {
       Arrays.copy(from, startFrom, this, start, length);
     }
@@ -1757,11 +1757,8 @@ class _ExternalFloat64Array extends _ByteArrayBase implements Float64List {
   }
 
   void setRange(int start, int length, List<double> from, [int startFrom = 0]) {
-    if (from is _ExternalFloat64Array) {
-      _setRange(start * _BYTES_PER_ELEMENT,
-                length * _BYTES_PER_ELEMENT,
-                from,
-                startFrom * _BYTES_PER_ELEMENT);
+    if (from is Float64List) {
+      _setRangeBytes(this, start, length, from, startFrom, _BYTES_PER_ELEMENT);
     } else {
       Arrays.copy(from, startFrom, this, start, length);
     }
@@ -1904,6 +1901,39 @@ class _ByteArrayView implements ByteArray {
     return _array._setFloat64(_offset + byteOffset, value);
   }
 
+  void fill(int value, [int start = 0, int length]) {
+    if (length == null) length = _length - start;
+    _rangeCheck(_length, start, length);
+    _array._fill(_offset + start, length, value & 0xFF);
+  }
+
+  int indexOf(int value, [int start = 0]) {
+    if (start >= _length) return -1;
+    if (start < 0) start = 0;
+    int index = _array._indexOfByte(value, _offset + start, _offset + _length);
+    return (index < 0) ? -1 : index - _offset;
+  }
+
+  int compareTo(ByteArray other) {
+    if (other is! _ByteArrayView) {
+      int length = other.lengthInBytes();
+      for (int i = 0; (i < _length) && (i < length); i++) {
+        int difference = getUint8(i) - other.getUint8(i);
+        if (difference != 0) return difference;
+      }
+      return _length - length;
+    }
+    _ByteArrayView view = other;
+    return _array._compare(_offset, _length,
+                           view._array, view._offset, view._length);
+  }
+
+  int crc32([int start = 0, int length, int crc = 0]) {
+    if (length == null) length = _length - start;
+    _rangeCheck(_length, start, length);
+    return _array._crc32(_offset + start, length, crc & 0xFFFFFFFF);
+  }
+
   final _ByteArrayBase _array;
   final int _offset;
   final int _length;
@@ -2075,7 +2105,11 @@ class _Int8ArrayView extends _ByteArrayViewBase implements Int8List {
   }
 
   void setRange(int start, int length, List<int> from, [int startFrom = 0]) {
-    Arrays.copy(from, startFrom, this, start, length);
+    if (from is Int8List) {
+      _setRangeBytes(this, start, length, from, startFrom, _BYTES_PER_ELEMENT);
+    } else {
+      Arrays.copy(from, startFrom, this, start, length);
+    }
   }
 
   String toString() {
@@ -2139,7 +2173,11 @@ class _Uint8ArrayView extends _ByteArrayViewBase implements Uint8List {
   }
 
   void setRange(int start, int length, List<int> from, [int startFrom = 0]) {
-    Arrays.copy(from, startFrom, this, start, length);
+    if (from is Uint8List || from is Uint8ClampedList) {
+      _setRangeBytes(this, start, length, from, startFrom, _BYTES_PER_ELEMENT);
+    } else {
+      Arrays.copy(from, startFrom, this, start, length);
+    }
   }
 
   String toString() {
@@ -2203,7 +2241,11 @@ class _Int16ArrayView extends _ByteArrayViewBase implements Int16List {
   }
 
   void setRange(int start, int length, List<int> from, [int startFrom = 0]) {
-    Arrays.copy(from, startFrom, this, start, length);
+    if (from is Int16List) {
+      _setRangeBytes(this, start, length, from, startFrom, _BYTES_PER_ELEMENT);
+    } else {
+      Arrays.copy(from, startFrom, this, start, length);
+    }
   }
 
   String toString() {
@@ -2267,7 +2309,11 @@ class _Uint16ArrayView extends _ByteArrayViewBase implements Uint16List {
   }
 
   void setRange(int start, int length, List<int> from, [int startFrom = 0]) {
-    Arrays.copy(from, startFrom, this, start, length);
+    if (from is Uint16List) {
+      _setRangeBytes(this, start, length, from, startFrom, _BYTES_PER_ELEMENT);
+    } else {
+      Arrays.copy(from, startFrom, this, start, length);
+    }
   }
 
   String toString() {
@@ -2331,7 +2377,11 @@ class _Int32ArrayView extends _ByteArrayViewBase implements Int32List {
   }
 
   void setRange(int start, int length, List<int> from, [int startFrom = 0]) {
-    Arrays.copy(from, startFrom, this, start, length);
+    if (from is Int32List) {
+      _setRangeBytes(this, start, length, from, startFrom, _BYTES_PER_ELEMENT);
+    } else {
+      Arrays.copy(from, startFrom, this, start, length);
+    }
   }
 
   String toString() {
@@ -2395,7 +2445,11 @@ class _Uint32ArrayView extends _ByteArrayViewBase implements Uint32List {
   }
 
   void setRange(int start, int length, List<int> from, [int startFrom = 0]) {
-    Arrays.copy(from, startFrom, this, start, length);
+    if (from is Uint32List) {
+      _setRangeBytes(this, start, length, from, startFrom, _BYTES_PER_ELEMENT);
+    } else {
+      Arrays.copy(from, startFrom, this, start, length);
+    }
   }
 
   String toString() {
@@ -2459,7 +2513,11 @@ class _Int64ArrayView extends _ByteArrayViewBase implements Int64List {
   }
 
   void setRange(int start, int length, List<int> from, [int startFrom = 0]) {
-    Arrays.copy(from, startFrom, this, start, length);
+    if (from is Int64List) {
+      _setRangeBytes(this, start, length, from, startFrom, _BYTES_PER_ELEMENT);
+    } else {
+      Arrays.copy(from, startFrom, this, start, length);
+    }
   }
 
   String toString() {
@@ -2523,7 +2581,11 @@ class _Uint64ArrayView extends _ByteArrayViewBase implements Uint64List {
   }
 
   void setRange(int start, int length, List<int> from, [int startFrom = 0]) {
-    Arrays.copy(from, startFrom, this, start, length);
+    if (from is Uint64List) {
+      _setRangeBytes(this, start, length, from, startFrom, _BYTES_PER_ELEMENT);
+    } else {
+      Arrays.copy(from, startFrom, this, start, length);
+    }
   }
 
   String toString() {
@@ -2587,7 +2649,11 @@ class _Float32ArrayView extends _ByteArrayViewBase implements Float32List {
   }
 
   void setRange(int start, int length, List<double> from, [int startFrom = 0]) {
-    Arrays.copy(from, startFrom, this, start, length);
+    if (from is Float32List) {
+      _setRangeBytes(this, start, length, from, startFrom, _BYTES_PER_ELEMENT);
+    } else {
+      Arrays.copy(from, startFrom, this, start, length);
+    }
   }
 
   String toString() {
@@ -2651,7 +2717,11 @@ class _Float64ArrayView extends _ByteArrayViewBase implements Float64List {
   }
 
   void setRange(int start, int length, List<double> from, [int startFrom = 0]) {
-    Arrays.copy(from, startFrom, this, start, length);
+    if (from is Float64List) {
+      _setRangeBytes(this, start, length, from, startFrom, _BYTES_PER_ELEMENT);
+    } else {
+      Arrays.copy(from, startFrom, this, start, length);
+    }
   }
 
   String toString() {
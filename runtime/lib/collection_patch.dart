@@ -0,0 +1,279 @@
+// Copyright (c) 2013, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+patch class HashMap<K, V> {
+  /* patch */ factory HashMap() => new _CompactHashMap<K, V>();
+
+  /* patch */ factory HashMap.from(Map<K, V> other) {
+    return new _CompactHashMap<K, V>.from(other);
+  }
+}
+
+
+patch class LinkedHashMap<K, V> {
+  /* patch */ factory LinkedHashMap() => new _CompactLinkedHashMap<K, V>();
+
+  /* patch */ factory LinkedHashMap.from(Map<K, V> other) {
+    return new _CompactLinkedHashMap<K, V>.from(other);
+  }
+}
+
+
+// Marks the key of a removed entry in the data list of a compact map.
+class _CompactHashHole {
+  const _CompactHashHole();
+}
+
+
+// A hash map which keeps its entries in insertion order in a dense data list
+// of key and value pairs, and finds them through a separate open addressing
+// index with quadratic probing.
+//
+// A slot of the index is _UNUSED, _DELETED, or refers to an entry of the data
+// list. In the latter case the low bits of the slot hold the number of the
+// entry plus _ENTRY_OFFSET and the high bits hold the high bits of the hash
+// code of its key, so most mismatching keys are skipped without calling ==.
+//
+// Removing an entry leaves a hole in the data list. The holes are squeezed
+// out when the data list is full and the map is rehashed. The data list has
+// room for half as many entries as the index has slots, so the index is
+// never more than half full.
+//
+// Iterating over a HashMap happens to follow insertion order as well, but
+// only a LinkedHashMap promises it.
+class _CompactHashMap<K, V> implements HashMap<K, V> {
+  static const int _INITIAL_INDEX_SIZE = 8;  // Must be a power of 2.
+  static const int _UNUSED = 0;
+  static const int _DELETED = 1;
+  static const int _ENTRY_OFFSET = 2;
+  static const int _HASH_MASK = 0x3FFFFFFF;  // Stay in Smi range.
+  static const _CompactHashHole _HOLE = const _CompactHashHole();
+
+  List _index;
+  List _data;
+  // The number of data list elements used by entries and holes.
+  int _usedData;
+  int _holes;
+
+  _CompactHashMap() {
+    _init(_INITIAL_INDEX_SIZE);
+  }
+
+  factory _CompactHashMap.from(Map<K, V> other) {
+    Map<K, V> result = new _CompactHashMap<K, V>();
+    other.forEach((K key, V value) { result[key] = value; });
+    return result;
+  }
+
+  void _init(int indexSize) {
+    _index = new List.fixedLength(indexSize);
+    for (int i = 0; i < indexSize; i++) _index[i] = _UNUSED;
+    _data = new List.fixedLength(indexSize);
+    _usedData = 0;
+    _holes = 0;
+  }
+
+  static int _hashCode(key) {
+    if (key == null) throw new ArgumentError(null);
+    return key.hashCode & _HASH_MASK;
+  }
+
+  // Returns the index slot of the entry for key, or -1 if there is none.
+  int _findSlot(key, int hash) {
+    final List index = _index;
+    final int sizeMask = index.length - 1;
+    final int hashPattern = hash & ~sizeMask;
+    int slot = hash & sizeMask;
+    int probes = 1;
+    int entry = index[slot];
+    while (entry != _UNUSED) {
+      if ((entry != _DELETED) && ((entry & ~sizeMask) == hashPattern)) {
+        var other = _data[((entry & sizeMask) - _ENTRY_OFFSET) << 1];
+        if (identical(other, key) || (other == key)) return slot;
+      }
+      slot = (slot + probes++) & sizeMask;
+      entry = index[slot];
+    }
+    return -1;
+  }
+
+  // Adds an entry for a key that is not in the map yet.
+  void _insert(key, value, int hash) {
+    if (_usedData == _data.length) {
+      _rehash();
+    }
+    final List index = _index;
+    final int sizeMask = index.length - 1;
+    int slot = hash & sizeMask;
+    int probes = 1;
+    int entry = index[slot];
+    // Removed entries do not have to be skipped as the key is not in the map.
+    while ((entry != _UNUSED) && (entry != _DELETED)) {
+      slot = (slot + probes++) & sizeMask;
+      entry = index[slot];
+    }
+    index[slot] = (hash & ~sizeMask) | ((_usedData >> 1) + _ENTRY_OFFSET);
+    _data[_usedData++] = key;
+    _data[_usedData++] = value;
+  }
+
+  // Squeezes out the holes of the data list and grows the map if it is more
+  // than a quarter full without them.
+  void _rehash() {
+    int size = _index.length;
+    int length = this.length;
+    while ((length << 2) >= size) size <<= 1;
+    List oldData = _data;
+    int oldUsedData = _usedData;
+    _init(size);
+    for (int i = 0; i < oldUsedData; i += 2) {
+      var key = oldData[i];
+      if (!identical(key, _HOLE)) {
+        _insert(key, oldData[i + 1], key.hashCode & _HASH_MASK);
+      }
+    }
+  }
+
+  void operator []=(K key, V value) {
+    int hash = _hashCode(key);
+    int slot = _findSlot(key, hash);
+    if (slot >= 0) {
+      int entry = _index[slot] & (_index.length - 1);
+      _data[((entry - _ENTRY_OFFSET) << 1) + 1] = value;
+    } else {
+      _insert(key, value, hash);
+    }
+  }
+
+  V operator [](K key) {
+    int slot = _findSlot(key, _hashCode(key));
+    if (slot < 0) return null;
+    int entry = _index[slot] & (_index.length - 1);
+    return _data[((entry - _ENTRY_OFFSET) << 1) + 1];
+  }
+
+  V putIfAbsent(K key, V ifAbsent()) {
+    int hash = _hashCode(key);
+    int slot = _findSlot(key, hash);
+    if (slot >= 0) {
+      int entry = _index[slot] & (_index.length - 1);
+      return _data[((entry - _ENTRY_OFFSET) << 1) + 1];
+    }
+    V value = ifAbsent();
+    // The callback can have added the key or rehashed the map.
+    this[key] = value;
+    return value;
+  }
+
+  V remove(K key) {
+    int slot = _findSlot(key, _hashCode(key));
+    if (slot < 0) return null;
+    int entry = _index[slot] & (_index.length - 1);
+    int position = (entry - _ENTRY_OFFSET) << 1;
+    V value = _data[position + 1];
+    _index[slot] = _DELETED;
+    _data[position] = _HOLE;
+    _data[position + 1] = null;
+    _holes++;
+    return value;
+  }
+
+  bool containsKey(K key) {
+    return _findSlot(key, _hashCode(key)) >= 0;
+  }
+
+  bool containsValue(V value) {
+    for (int i = 0; i < _usedData; i += 2) {
+      if (!identical(_data[i], _HOLE) && (_data[i + 1] == value)) return true;
+    }
+    return false;
+  }
+
+  void forEach(void f(K key, V value)) {
+    List data = _data;
+    for (int i = 0; i < _usedData; i += 2) {
+      var key = data[i];
+      if (!identical(key, _HOLE)) f(key, data[i + 1]);
+      if (!identical(data, _data)) {
+        throw new ConcurrentModificationError(this);
+      }
+    }
+  }
+
+  Iterable<K> get keys => new _CompactHashMapIterable<K>(this, 0);
+
+  Iterable<V> get values => new _CompactHashMapIterable<V>(this, 1);
+
+  int get length => (_usedData >> 1) - _holes;
+
+  bool get isEmpty => length == 0;
+
+  void clear() {
+    _init(_INITIAL_INDEX_SIZE);
+  }
+
+  String toString() {
+    return Maps.mapToString(this);
+  }
+}
+
+
+class _CompactLinkedHashMap<K, V> extends _CompactHashMap<K, V>
+    implements LinkedHashMap<K, V> {
+  _CompactLinkedHashMap();
+
+  factory _CompactLinkedHashMap.from(Map<K, V> other) {
+    Map<K, V> result = new _CompactLinkedHashMap<K, V>();
+    other.forEach((K key, V value) { result[key] = value; });
+    return result;
+  }
+}
+
+
+// Iterates over the keys or the values of a compact map, depending on
+// whether offset is 0 or 1.
+class _CompactHashMapIterable<E> extends Iterable<E> {
+  final _CompactHashMap _map;
+  final int _offset;
+
+  _CompactHashMapIterable(this._map, this._offset);
+
+  Iterator<E> get iterator {
+    return new _CompactHashMapIterator<E>(_map, _offset);
+  }
+
+  int get length => _map.length;
+
+  bool get isEmpty => _map.isEmpty;
+}
+
+
+class _CompactHashMapIterator<E> implements Iterator<E> {
+  final _CompactHashMap _map;
+  final List _data;
+  final int _offset;
+  int _position = 0;
+  E _current;
+
+  _CompactHashMapIterator(_CompactHashMap map, this._offset)
+      : _map = map, _data = map._data;
+
+  bool moveNext() {
+    if (!identical(_data, _map._data)) {
+      throw new ConcurrentModificationError(_map);
+    }
+    while (_position < _map._usedData) {
+      int position = _position;
+      _position += 2;
+      if (!identical(_data[position], _CompactHashMap._HOLE)) {
+        _current = _data[position + _offset];
+        return true;
+      }
+    }
+    _current = null;
+    return false;
+  }
+
+  E get current => _current;
+}
@@ -208,8 +208,28 @@ DEFINE_NATIVE_ENTRY(Double_toInt, 1) {
 }
 
 
+// Converts value without the scanner if it is a short, plain decimal
+// literal, which is the common case.
+static bool ParseShortDecimalDouble(const String& value, double* result) {
+  static const intptr_t kMaxLength = 64;
+  const intptr_t length = value.Length();
+  if (length > kMaxLength) return false;
+  char buffer[kMaxLength];
+  for (intptr_t i = 0; i < length; i++) {
+    const int32_t c = value.CharAt(i);
+    if (c > 0x7F) return false;
+    buffer[i] = static_cast<char>(c);
+  }
+  return CStringToDouble(buffer, length, result);
+}
+
+
 DEFINE_NATIVE_ENTRY(Double_parse, 1) {
   GET_NON_NULL_NATIVE_ARGUMENT(String, value, arguments->NativeArgAt(0));
+  double double_value;
+  if (ParseShortDecimalDouble(value, &double_value)) {
+    return Double::New(double_value);
+  }
   Scanner scanner(value, Symbols::Empty());
   const Scanner::GrowableTokenStream& tokens = scanner.GetStream();
   String* number_string;
@@ -262,6 +282,12 @@ DEFINE_NATIVE_ENTRY(Double_parse, 1) {
 }
 
 
+DEFINE_NATIVE_ENTRY(Double_toString, 1) {
+  const Double& arg = Double::CheckedHandle(arguments->NativeArgAt(0));
+  return DoubleToString(arg.value());
+}
+
+
 DEFINE_NATIVE_ENTRY(Double_toStringAsFixed, 2) {
   // The boundaries are exclusive.
   static const double kLowerBoundary = -1e21;
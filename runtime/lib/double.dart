@@ -136,6 +136,8 @@ class _Double implements double {
   }
   double _pow(double exponent) native "Double_pow";
 
+  String toString() native "Double_toString";
+
   String toStringAsFixed(int fractionDigits) {
     // See ECMAScript-262, 15.7.4.5 for details.
 
@@ -181,8 +181,35 @@ DEFINE_NATIVE_ENTRY(Integer_equalToInteger, 2) {
 }
 
 
+// Parses value without the scanner if it is a sign followed by at most 18
+// decimal digits, which is the common case and always fits into a Mint.
+static bool ParseShortDecimalInteger(const String& value, int64_t* result) {
+  static const intptr_t kMaxDigits = 18;
+  const intptr_t length = value.Length();
+  intptr_t i = 0;
+  bool is_negative = false;
+  if ((length > 0) && ((value.CharAt(0) == '-') || (value.CharAt(0) == '+'))) {
+    is_negative = (value.CharAt(0) == '-');
+    i++;
+  }
+  if ((i == length) || ((length - i) > kMaxDigits)) return false;
+  int64_t number = 0;
+  for (; i < length; i++) {
+    const int32_t c = value.CharAt(i);
+    if ((c < '0') || (c > '9')) return false;
+    number = number * 10 + (c - '0');
+  }
+  *result = is_negative ? -number : number;
+  return true;
+}
+
+
 DEFINE_NATIVE_ENTRY(Integer_parse, 1) {
   GET_NON_NULL_NATIVE_ARGUMENT(String, value, arguments->NativeArgAt(0));
+  int64_t int_value;
+  if (ParseShortDecimalInteger(value, &int_value)) {
+    return Integer::New(int_value);
+  }
   Scanner scanner(value, Symbols::Empty());
   const Scanner::GrowableTokenStream& tokens = scanner.GetStream();
   String* int_string;
@@ -288,6 +315,30 @@ DEFINE_NATIVE_ENTRY(Smi_bitNegate, 1) {
   return Smi::New(result);
 }
 
+
+// Writes the decimal digits of value directly into a one-byte string.
+static RawString* Int64ToString(int64_t value) {
+  // A sign and at most 19 digits.
+  char buffer[20];
+  intptr_t pos = sizeof(buffer);
+  uint64_t magnitude = (value < 0) ? -static_cast<uint64_t>(value)
+                                   : static_cast<uint64_t>(value);
+  do {
+    buffer[--pos] = '0' + static_cast<char>(magnitude % 10);
+    magnitude /= 10;
+  } while (magnitude != 0);
+  if (value < 0) buffer[--pos] = '-';
+  return OneByteString::New(reinterpret_cast<const uint8_t*>(buffer + pos),
+                            sizeof(buffer) - pos,
+                            Heap::kNew);
+}
+
+
+DEFINE_NATIVE_ENTRY(Smi_toString, 1) {
+  const Smi& operand = Smi::CheckedHandle(arguments->NativeArgAt(0));
+  return Int64ToString(operand.Value());
+}
+
 // Mint natives.
 
 DEFINE_NATIVE_ENTRY(Mint_bitNegate, 1) {
@@ -300,6 +351,12 @@ DEFINE_NATIVE_ENTRY(Mint_bitNegate, 1) {
   return Integer::New(result);
 }
 
+
+DEFINE_NATIVE_ENTRY(Mint_toString, 1) {
+  const Mint& operand = Mint::CheckedHandle(arguments->NativeArgAt(0));
+  return Int64ToString(operand.value());
+}
+
 // Bigint natives.
 
 DEFINE_NATIVE_ENTRY(Bigint_bitNegate, 1) {
@@ -214,6 +214,7 @@ class _Smi extends _IntegerImplementation implements int {
     return this;
   }
   int operator ~() native "Smi_bitNegate";
+  String toString() native "Smi_toString";
   int _shrFromInt(int other) native "Smi_shrFromInt";
   int _shlFromInt(int other) native "Smi_shlFromInt";
 }
@@ -228,6 +229,7 @@ class _Mint extends _IntegerImplementation implements int {
     return this;
   }
   int operator ~() native "Mint_bitNegate";
+  String toString() native "Mint_toString";
 
   // Shift by mint exceeds range that can be handled by the VM.
   int _shrFromInt(int other) {
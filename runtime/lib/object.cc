@@ -67,6 +67,16 @@ DEFINE_NATIVE_ENTRY(Object_runtimeType, 1) {
 }
 
 
+DEFINE_NATIVE_ENTRY(Object_getHash, 1) {
+  const Instance& instance = Instance::CheckedHandle(arguments->NativeArgAt(0));
+  if (instance.IsNull()) {
+    return Smi::New(2011);  // The year Dart was announced and a prime.
+  }
+  ASSERT(!instance.IsSmi());
+  return Smi::New(isolate->heap()->IdentityHash(instance.raw()));
+}
+
+
 DEFINE_NATIVE_ENTRY(Object_instanceOf, 5) {
   const Instance& instance = Instance::CheckedHandle(arguments->NativeArgAt(0));
   // Instantiator at position 1 is not used. It is passed along so that the call
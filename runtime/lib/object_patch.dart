@@ -4,23 +4,9 @@
 
 patch class Object {
 
-  // Helpers used to implement hashCode. If a hashCode is used we remember it
-  // using an Expando object. A new hashCode value is calculated using a Random
-  // number generator.
-  static Expando _hashCodeExp = new Expando("Object.hashCode");
-  static Random _hashCodeRnd = new Random();
-
-  /* patch */ int get hashCode {
-    if (this == null) {
-      return 2011;  // The year Dart was announced and a prime.
-    }
-    var result = _hashCodeExp[this];
-    if (result == null) {
-      result = _hashCodeRnd.nextInt(0x40000000);  // Stay in Smi range.
-      _hashCodeExp[this] = result;
-    }
-    return result;
-  }
+  // The identity hash code is assigned by the VM when it is first asked for
+  // and kept with the object.
+  /* patch */ int get hashCode native "Object_getHash";
 
   /* patch */ String toString() native "Object_toString";
   // A statically dispatched version of Object.toString.
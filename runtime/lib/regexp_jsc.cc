@@ -107,10 +107,6 @@ RawJSRegExp* Jscre::Compile(const String& pattern,
 RawArray* Jscre::Execute(const JSRegExp& regex,
                          const String& str,
                          intptr_t start_index) {
-  // First convert the input str to UTF16 format as the jscre library expects
-  // strings to be in UTF16 encoding.
-  uint16_t* two_byte_str = GetTwoByteData(str);
-
   // Execute a regex match by calling into the jscre library.
   jscre::JSRegExp* jscregexp =
       reinterpret_cast<jscre::JSRegExp*>(regex.GetDataStartAddress());
@@ -126,12 +122,48 @@ RawArray* Jscre::Execute(const JSRegExp& regex,
   int offsets_length = (num_bracket_expressions + 1) * kJscreMultiple;
   int* offsets = NULL;
   offsets = zone->Alloc<int>(offsets_length);
-  int retval = jscre::jsRegExpExecute(jscregexp,
-                                      two_byte_str,
+  int retval;
+  if (str.Length() == 0) {
+    // The jscre library expects a subject even if it is empty.
+    const uint16_t empty = 0;
+    retval = jscre::jsRegExpExecute(jscregexp, &empty, 0, start_index,
+                                    offsets, offsets_length);
+  } else {
+    // The characters of the subject are matched in place, so no GC may
+    // happen until the match is done. The jscre library only allocates
+    // in the C heap.
+    NoGCScope no_gc;
+    if (str.IsOneByteString()) {
+      retval = jscre::jsRegExpExecute(jscregexp,
+                                      OneByteString::CharAddr(str, 0),
                                       str.Length(),
                                       start_index,
                                       offsets,
                                       offsets_length);
+    } else if (str.IsExternalOneByteString()) {
+      retval = jscre::jsRegExpExecute(jscregexp,
+                                      ExternalOneByteString::CharAddr(str, 0),
+                                      str.Length(),
+                                      start_index,
+                                      offsets,
+                                      offsets_length);
+    } else if (str.IsTwoByteString()) {
+      retval = jscre::jsRegExpExecute(jscregexp,
+                                      TwoByteString::CharAddr(str, 0),
+                                      str.Length(),
+                                      start_index,
+                                      offsets,
+                                      offsets_length);
+    } else {
+      ASSERT(str.IsExternalTwoByteString());
+      retval = jscre::jsRegExpExecute(jscregexp,
+                                      ExternalTwoByteString::CharAddr(str, 0),
+                                      str.Length(),
+                                      start_index,
+                                      offsets,
+                                      offsets_length);
+    }
+  }
 
   // The KJS JavaScript engine returns null (ie, a failed match) when
   // JSRE's internal match limit is exceeded.  We duplicate that behavior here.
@@ -197,4 +197,22 @@ DEFINE_NATIVE_ENTRY(Strings_concatAll, 1) {
   return String::ConcatAll(strings);
 }
 
+
+DEFINE_NATIVE_ENTRY(StringBuffer_createStringFromCodeUnits, 3) {
+  GET_NON_NULL_NATIVE_ARGUMENT(Array, code_units, arguments->NativeArgAt(0));
+  GET_NON_NULL_NATIVE_ARGUMENT(Smi, length_obj, arguments->NativeArgAt(1));
+  GET_NON_NULL_NATIVE_ARGUMENT(Bool, is_latin1, arguments->NativeArgAt(2));
+  intptr_t length = length_obj.Value();
+  ASSERT((length >= 0) && (length <= code_units.Length()));
+  // The string buffer only stores Smi code units below 0x10000.
+  uint16_t* utf16_array = isolate->current_zone()->Alloc<uint16_t>(length);
+  for (intptr_t i = 0; i < length; i++) {
+    utf16_array[i] = Smi::Value(reinterpret_cast<RawSmi*>(code_units.At(i)));
+  }
+  if (is_latin1.value()) {
+    return OneByteString::New(utf16_array, length, Heap::kNew);
+  }
+  return TwoByteString::New(utf16_array, length, Heap::kNew);
+}
+
 }  // namespace dart
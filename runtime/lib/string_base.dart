@@ -345,13 +345,14 @@ class _StringBase {
    * Convert all objects in [values] to strings and concat them
    * into a result string.
    */
+  // The values list is allocated for each interpolation by the compiler, so
+  // the strings can be stored into it instead of into a copy.
   static String _interpolate(List values) {
     int numValues = values.length;
-    var stringList = new List.fixedLength(numValues);
     for (int i = 0; i < numValues; i++) {
-      stringList[i] = values[i].toString();
+      values[i] = values[i].toString();
     }
-    return _concatAll(stringList);
+    return _concatAll(values);
   }
 
   Iterable<Match> allMatches(String str) {
@@ -7,10 +7,31 @@ patch /* abstract */ class StringBuffer {
     => new _StringBufferImpl(content);
 }
 
+// Keeps the added strings as a list of parts which are only concatenated on
+// toString. Runs of small parts are concatenated early to keep the list short.
+// Char codes are collected in a code unit buffer and turned into a part at
+// once, so addCharCode does not allocate a string per call.
 class _StringBufferImpl implements StringBuffer {
+  // When this many parts have been added since the last compaction, they are
+  // concatenated if their total length is below _PARTS_TO_COMPACT_SIZE_LIMIT.
+  static const int _PARTS_TO_COMPACT = 128;
+  static const int _PARTS_TO_COMPACT_SIZE_LIMIT = _PARTS_TO_COMPACT * 8;
+  static const int _BUFFER_SIZE = 128;
 
-  List<String> _buffer;
-  int _length;
+  List<String> _parts;
+  // The number of code units in _parts.
+  int _partsCodeUnits;
+  // The first part added since the last compaction, and the number of code
+  // units in the parts added since then.
+  int _partsCompactionIndex;
+  int _partsCodeUnitsSinceCompaction;
+
+  // Code units added with addCharCode which are not in _parts yet. The
+  // buffer is allocated on the first call to addCharCode.
+  List<int> _buffer;
+  int _bufferPosition = 0;
+  // Whether all code units in the buffer are Latin-1.
+  bool _bufferIsLatin1 = true;
 
   /// Creates the string buffer with an initial content.
   _StringBufferImpl(Object content) {
@@ -19,9 +40,9 @@ class _StringBufferImpl implements StringBuffer {
   }
 
   /// Returns the length of the buffer.
-  int get length => _length;
+  int get length => _partsCodeUnits + _bufferPosition;
 
-  bool get isEmpty => _length == 0;
+  bool get isEmpty => length == 0;
 
   /// Adds [obj] to the buffer.
   void add(Object obj) {
@@ -32,8 +53,8 @@ class _StringBufferImpl implements StringBuffer {
       throw new ArgumentError('toString() did not return a string');
     }
     if (str.isEmpty) return;
-    _buffer.add(str);
-    _length += str.length;
+    _consumeBuffer();
+    _addPart(str);
   }
 
   /// Adds all items in [objects] to the buffer.
@@ -43,24 +64,88 @@ class _StringBufferImpl implements StringBuffer {
 
   /// Adds the string representation of [charCode] to the buffer.
   void addCharCode(int charCode) {
-    add(new String.fromCharCodes([charCode]));
+    if ((charCode is! int) || (charCode < 0) || (charCode > 0x10FFFF)) {
+      throw new ArgumentError(charCode);
+    }
+    if (charCode <= 0xFFFF) {
+      _ensureCapacity(1);
+      if (charCode > 0xFF) _bufferIsLatin1 = false;
+      _buffer[_bufferPosition++] = charCode;
+    } else {
+      // Supplementary code points are stored as a surrogate pair.
+      _ensureCapacity(2);
+      _bufferIsLatin1 = false;
+      int bits = charCode - 0x10000;
+      _buffer[_bufferPosition++] = 0xD800 | (bits >> 10);
+      _buffer[_bufferPosition++] = 0xDC00 | (bits & 0x3FF);
+    }
   }
 
   /// Clears the string buffer.
   void clear() {
-    _buffer = new List<String>();
-    _length = 0;
+    _parts = new List<String>();
+    _partsCodeUnits = 0;
+    _partsCompactionIndex = 0;
+    _partsCodeUnitsSinceCompaction = 0;
+    _bufferPosition = 0;
+    _bufferIsLatin1 = true;
   }
 
   /// Returns the contents of buffer as a concatenated string.
   String toString() {
-    if (_buffer.length == 0) return "";
-    if (_buffer.length == 1) return _buffer[0];
-    String result = Strings.concatAll(_buffer);
-    _buffer.clear();
-    _buffer.add(result);
-    // Since we track the length at each add operation, there is no
-    // need to update it in this function.
+    _consumeBuffer();
+    if (_parts.length == 0) return "";
+    if (_parts.length == 1) return _parts[0];
+    String result = _StringBase.concatAll(_parts);
+    _parts.clear();
+    _parts.add(result);
+    _partsCompactionIndex = 0;
+    _partsCodeUnitsSinceCompaction = 0;
+    // The length of the buffer does not change.
     return result;
   }
+
+  void _ensureCapacity(int count) {
+    if (_buffer == null) {
+      _buffer = new _ObjectArray(_BUFFER_SIZE);
+    } else if (_bufferPosition + count > _buffer.length) {
+      _consumeBuffer();
+    }
+  }
+
+  // Moves the code units of the buffer into a new part.
+  void _consumeBuffer() {
+    if (_bufferPosition == 0) return;
+    _addPart(_create(_buffer, _bufferPosition, _bufferIsLatin1));
+    _bufferPosition = 0;
+    _bufferIsLatin1 = true;
+  }
+
+  void _addPart(String str) {
+    int length = str.length;
+    _partsCodeUnits += length;
+    _partsCodeUnitsSinceCompaction += length;
+    _parts.add(str);
+    if (_parts.length - _partsCompactionIndex >= _PARTS_TO_COMPACT) {
+      _compact();
+    }
+  }
+
+  // Concatenates the parts added since the last compaction if they are
+  // small, so that adding many short strings keeps few parts alive.
+  void _compact() {
+    if (_partsCodeUnitsSinceCompaction < _PARTS_TO_COMPACT_SIZE_LIMIT) {
+      String compacted = _StringBase.concatAll(
+          _parts.getRange(_partsCompactionIndex,
+                          _parts.length - _partsCompactionIndex));
+      _parts.removeRange(_partsCompactionIndex,
+                         _parts.length - _partsCompactionIndex);
+      _parts.add(compacted);
+    }
+    _partsCompactionIndex = _parts.length;
+    _partsCodeUnitsSinceCompaction = 0;
+  }
+
+  static String _create(List<int> buffer, int length, bool isLatin1)
+      native "StringBuffer_createStringFromCodeUnits";
 }
@@ -40,6 +40,7 @@ class Thread {
   }
   static void SetThreadLocal(ThreadLocalKey key, uword value);
   static intptr_t GetMaxStackSize();
+  static ThreadId GetCurrentThreadId();
 };
 
 
@@ -135,6 +135,11 @@ intptr_t Thread::GetMaxStackSize() {
 }
 
 
+ThreadId Thread::GetCurrentThreadId() {
+  return pthread_self();
+}
+
+
 Mutex::Mutex() {
   pthread_mutexattr_t attr;
   int result = pthread_mutexattr_init(&attr);
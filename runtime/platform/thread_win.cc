@@ -89,6 +89,11 @@ intptr_t Thread::GetMaxStackSize() {
 }
 
 
+ThreadId Thread::GetCurrentThreadId() {
+  return ::GetCurrentThreadId();
+}
+
+
 void Thread::SetThreadLocal(ThreadLocalKey key, uword value) {
   ASSERT(key != kUnsetThreadLocalKey);
   BOOL result = TlsSetValue(key, reinterpret_cast<void*>(value));
@@ -15,6 +15,7 @@
 namespace dart {
 
 typedef DWORD ThreadLocalKey;
+typedef DWORD ThreadId;
 
 class ThreadInlineImpl {
  private:
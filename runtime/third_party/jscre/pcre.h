@@ -61,6 +61,7 @@ typedef unsigned __int16 uint16_t;
 namespace dart { namespace jscre {
 
 typedef uint16_t UChar;
+typedef uint8_t LChar;
 
 struct JSRegExp;
 typedef struct JSRegExp JscreRegExp;
@@ -86,6 +87,11 @@ int jsRegExpExecute(const JSRegExp*,
     const UChar* subject, int subjectLength, int startOffset,
     int* offsetsVector, int offsetsVectorLength);
 
+// Matches a subject of Latin-1 characters in place.
+int jsRegExpExecute(const JSRegExp*,
+    const LChar* subject, int subjectLength, int startOffset,
+    int* offsetsVector, int offsetsVectorLength);
+
 void jsRegExpFree(JSRegExp* regexp);
 
 } }  // namespace dart::jscre
@@ -72,21 +72,23 @@ typedef void* ReturnLocation;
 /* Structure for building a chain of data for holding the values of
 the subject pointer at the start of each bracket, used to detect when
 an empty string has been matched by a bracket to break infinite loops. */ 
+template <typename CharType>
 struct BracketChainNode {
-    BracketChainNode* previousBracket;
-    const UChar* bracketStart;
+    BracketChainNode<CharType>* previousBracket;
+    const CharType* bracketStart;
 };
 
+template <typename CharType>
 struct MatchFrame {
     ReturnLocation returnLocation;
-    struct MatchFrame* previousFrame;
+    struct MatchFrame<CharType>* previousFrame;
     
     /* Function arguments that may change */
     struct {
-        const UChar* subjectPtr;
+        const CharType* subjectPtr;
         const unsigned char* instructionPtr;
         int offsetTop;
-        BracketChainNode* bracketChain;
+        BracketChainNode<CharType>* bracketChain;
     } args;
     
     
@@ -96,7 +98,7 @@ struct MatchFrame {
     struct {
         const unsigned char* data;
         const unsigned char* startOfRepeatingBracket;
-        const UChar* subjectPtrAtStartOfInstruction; // Several instrutions stash away a subjectPtr here for later compare
+        const CharType* subjectPtrAtStartOfInstruction; // Several instrutions stash away a subjectPtr here for later compare
         const unsigned char* instructionPtrAtStartOfOnce;
         
         int repeatOthercase;
@@ -112,21 +114,23 @@ struct MatchFrame {
         int saveOffset2;
         int saveOffset3;
         
-        BracketChainNode bracketChainNode;
+        BracketChainNode<CharType> bracketChainNode;
     } locals;
 };
 
 /* Structure for passing "static" information around between the functions
-doing traditional NFA matching, so that they are thread-safe. */
+doing traditional NFA matching, so that they are thread-safe. The subject
+is matched in place, as one-byte (Latin-1) or two-byte (UTF-16) characters. */
 
+template <typename CharType>
 struct MatchData {
   int*   offsetVector;         /* Offset vector */
   int    offsetEnd;            /* One past the end */
   int    offsetMax;            /* The maximum usable for return data */
   bool   offsetOverflow;       /* Set if too many extractions */
-  const UChar*  startSubject;         /* Start of the subject string */
-  const UChar*  endSubject;           /* End of the subject string */
-  const UChar*  endMatchPtr;         /* Subject position at end match */
+  const CharType*  startSubject;      /* Start of the subject string */
+  const CharType*  endSubject;        /* End of the subject string */
+  const CharType*  endMatchPtr;       /* Subject position at end match */
   int    endOffsetTop;        /* Highwater mark at end of match */
   bool   multiline;
   bool   ignoreCase;
@@ -157,7 +161,8 @@ Arguments:
   md          pointer to matching data block, if isSubject is true
 */
 
-static void pchars(const UChar* p, int length, bool isSubject, const MatchData& md)
+template <typename CharType>
+static void pchars(const CharType* p, int length, bool isSubject, const MatchData<CharType>& md)
 {
     if (isSubject && length > md.endSubject - p)
         length = md.endSubject - p;
@@ -189,9 +194,10 @@ Arguments:
 Returns:      true if matched
 */
 
-static bool matchRef(int offset, const UChar* subjectPtr, int length, const MatchData& md)
+template <typename CharType>
+static bool matchRef(int offset, const CharType* subjectPtr, int length, const MatchData<CharType>& md)
 {
-    const UChar* p = md.startSubject + md.offsetVector[offset];
+    const CharType* p = md.startSubject + md.offsetVector[offset];
     
 #ifdef DEBUG
     if (subjectPtr >= md.endSubject)
@@ -214,9 +220,9 @@ static bool matchRef(int offset, const UChar* subjectPtr, int length, const Matc
     
     if (md.ignoreCase) {
         while (length-- > 0) {
-            UChar c = *p++;
+            int c = *p++;
             int othercase = kjs_pcre_ucp_othercase(c);
-            UChar d = *subjectPtr++;
+            int d = *subjectPtr++;
             if (c != d && othercase != d)
                 return false;
         }
@@ -298,6 +304,7 @@ Returns:       1 if matched          )  these values are >= 0
 
 static const unsigned FRAMES_ON_STACK = 16;
 
+template <typename CharType>
 struct MatchStack {
     MatchStack()
         : framesEnd(frames + FRAMES_ON_STACK)
@@ -307,9 +314,9 @@ struct MatchStack {
         ASSERT((sizeof(frames) / sizeof(frames[0])) == FRAMES_ON_STACK);
     }
     
-    MatchFrame frames[FRAMES_ON_STACK];
-    MatchFrame* framesEnd;
-    MatchFrame* currentFrame;
+    MatchFrame<CharType> frames[FRAMES_ON_STACK];
+    MatchFrame<CharType>* framesEnd;
+    MatchFrame<CharType>* currentFrame;
     unsigned size;
     
     inline bool canUseStackBufferForNextFrame()
@@ -317,16 +324,16 @@ struct MatchStack {
         return size < FRAMES_ON_STACK;
     }
     
-    inline MatchFrame* allocateNextFrame()
+    inline MatchFrame<CharType>* allocateNextFrame()
     {
         if (canUseStackBufferForNextFrame())
             return currentFrame + 1;
-        return new MatchFrame;
+        return new MatchFrame<CharType>;
     }
     
-    inline void pushNewFrame(const unsigned char* instructionPtr, BracketChainNode* bracketChain, ReturnLocation returnLocation)
+    inline void pushNewFrame(const unsigned char* instructionPtr, BracketChainNode<CharType>* bracketChain, ReturnLocation returnLocation)
     {
-        MatchFrame* newframe = allocateNextFrame();
+        MatchFrame<CharType>* newframe = allocateNextFrame();
         newframe->previousFrame = currentFrame;
 
         newframe->args.subjectPtr = currentFrame->args.subjectPtr;
@@ -341,7 +348,7 @@ struct MatchStack {
     
     inline void popCurrentFrame()
     {
-        MatchFrame* oldFrame = currentFrame;
+        MatchFrame<CharType>* oldFrame = currentFrame;
         currentFrame = currentFrame->previousFrame;
         if (size > FRAMES_ON_STACK)
             delete oldFrame;
@@ -355,7 +362,8 @@ struct MatchStack {
     }
 };
 
-static int matchError(int errorCode, MatchStack& stack)
+template <typename CharType>
+static int matchError(int errorCode, MatchStack<CharType>& stack)
 {
     stack.popAllFrames();
     return errorCode;
@@ -379,7 +387,8 @@ static inline void getUTF8CharAndIncrementLength(int& c, const unsigned char* su
     }
 }
 
-static inline void startNewGroup(MatchFrame* currentFrame)
+template <typename CharType>
+static inline void startNewGroup(MatchFrame<CharType>* currentFrame)
 {
     /* At the start of a bracketed group, add the current subject pointer to the
      stack of such pointers, to be re-instated at the end of the group when we hit
@@ -406,14 +415,15 @@ static inline void repeatInformationFromInstructionOffset(short instructionOffse
     maximumRepeats = maximumRepeatsFromInstructionOffset[instructionOffset];
 }
 
-static int match(const UChar* subjectPtr, const unsigned char* instructionPtr, int offsetTop, MatchData& md)
+template <typename CharType>
+static int match(const CharType* subjectPtr, const unsigned char* instructionPtr, int offsetTop, MatchData<CharType>& md)
 {
     bool isMatch = false;
     int min;
     bool minimize = false; /* Initialization not really needed, but some compilers think so. */
     unsigned matchCount = 0;
     
-    MatchStack stack;
+    MatchStack<CharType> stack;
 
     /* The opcode jump table. */
 #ifdef USE_COMPUTED_GOTO_FOR_MATCH_OPCODE_LOOP
@@ -1831,12 +1841,13 @@ Returns:          > 0 => success; value is the number of elements filled in
                  < -1 => some kind of unexpected problem
 */
 
-static void tryFirstByteOptimization(const UChar*& subjectPtr, const UChar* endSubject, int first_byte, bool first_byte_caseless, bool useMultiLineFirstCharOptimization, const UChar* originalSubjectStart)
+template <typename CharType>
+static void tryFirstByteOptimization(const CharType*& subjectPtr, const CharType* endSubject, int first_byte, bool first_byte_caseless, bool useMultiLineFirstCharOptimization, const CharType* originalSubjectStart)
 {
     // If first_byte is set, try scanning to the first instance of that byte
     // no need to try and match against any earlier part of the subject string.
     if (first_byte >= 0) {
-        UChar first_char = first_byte;
+        CharType first_char = first_byte;
         if (first_byte_caseless)
             while (subjectPtr < endSubject) {
                 int c = *subjectPtr;
@@ -1846,7 +1857,11 @@ static void tryFirstByteOptimization(const UChar*& subjectPtr, const UChar* endS
                     break;
                 subjectPtr++;
             }
-        else {
+        else if (sizeof(CharType) == 1) {
+            // One-byte subjects are scanned with memchr.
+            const void* found = memchr(subjectPtr, first_char, endSubject - subjectPtr);
+            subjectPtr = found ? static_cast<const CharType*>(found) : endSubject;
+        } else {
             while (subjectPtr < endSubject && *subjectPtr != first_char)
                 subjectPtr++;
         }
@@ -1860,7 +1875,8 @@ static void tryFirstByteOptimization(const UChar*& subjectPtr, const UChar* endS
     }
 }
 
-static bool tryRequiredByteOptimization(const UChar*& subjectPtr, const UChar* endSubject, int req_byte, int req_byte2, bool req_byte_caseless, bool hasFirstByte, const UChar*& reqBytePtr)
+template <typename CharType>
+static bool tryRequiredByteOptimization(const CharType*& subjectPtr, const CharType* endSubject, int req_byte, int req_byte2, bool req_byte_caseless, bool hasFirstByte, const CharType*& reqBytePtr)
 {
     /* If req_byte is set, we know that that character must appear in the subject
      for the match to succeed. If the first character is set, req_byte must be
@@ -1877,7 +1893,7 @@ static bool tryRequiredByteOptimization(const UChar*& subjectPtr, const UChar* e
     */
 
     if (req_byte >= 0 && endSubject - subjectPtr < REQ_BYTE_MAX) {
-        const UChar* p = subjectPtr + (hasFirstByte ? 1 : 0);
+        const CharType* p = subjectPtr + (hasFirstByte ? 1 : 0);
 
         /* We don't need to repeat the search if we haven't yet reached the
          place we found it at last time. */
@@ -1891,6 +1907,11 @@ static bool tryRequiredByteOptimization(const UChar*& subjectPtr, const UChar* e
                         break;
                     }
                 }
+            } else if (sizeof(CharType) == 1) {
+                if (p < endSubject) {
+                    const void* found = memchr(p, req_byte, endSubject - p);
+                    p = found ? static_cast<const CharType*>(found) : endSubject;
+                }
             } else {
                 while (p < endSubject) {
                     if (*p++ == req_byte) {
@@ -1915,19 +1936,20 @@ static bool tryRequiredByteOptimization(const UChar*& subjectPtr, const UChar* e
     return false;
 }
 
-int jsRegExpExecute(const JSRegExp* re,
-                    const UChar* subject, int length, int start_offset, int* offsets,
-                    int offsetcount)
+template <typename CharType>
+static int execute(const JSRegExp* re,
+                   const CharType* subject, int length, int start_offset, int* offsets,
+                   int offsetcount)
 {
     ASSERT(re);
     ASSERT(subject);
     ASSERT(offsetcount >= 0);
     ASSERT(offsets || offsetcount == 0);
     
-    MatchData matchBlock;
+    MatchData<CharType> matchBlock;
     matchBlock.startSubject = subject;
     matchBlock.endSubject = matchBlock.startSubject + length;
-    const UChar* endSubject = matchBlock.endSubject;
+    const CharType* endSubject = matchBlock.endSubject;
     
     matchBlock.multiline = (re->options & MatchAcrossMultipleLinesOption);
     matchBlock.ignoreCase = (re->options & IgnoreCaseOption);
@@ -2004,8 +2026,8 @@ int jsRegExpExecute(const JSRegExp* re,
     /* Loop for handling unanchored repeated matching attempts; for anchored regexs
      the loop runs just once. */
     
-    const UChar* startMatch = subject + start_offset;
-    const UChar* reqBytePtr = startMatch - 1;
+    const CharType* startMatch = subject + start_offset;
+    const CharType* reqBytePtr = startMatch - 1;
     bool useMultiLineFirstCharOptimization = re->options & UseMultiLineFirstByteOptimizationOption;
     
     do {
@@ -2083,4 +2105,18 @@ int jsRegExpExecute(const JSRegExp* re,
     return JSRegExpErrorNoMatch;
 }
 
+int jsRegExpExecute(const JSRegExp* re,
+                    const UChar* subject, int length, int start_offset, int* offsets,
+                    int offsetcount)
+{
+    return execute(re, subject, length, start_offset, offsets, offsetcount);
+}
+
+int jsRegExpExecute(const JSRegExp* re,
+                    const LChar* subject, int length, int start_offset, int* offsets,
+                    int offsetcount)
+{
+    return execute(re, subject, length, start_offset, offsets, offsetcount);
+}
+
 } }  // namespace dart::jscre
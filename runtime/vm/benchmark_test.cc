@@ -4,9 +4,12 @@
 
 #include "vm/benchmark_test.h"
 
+#include "bin/eventhandler.h"
 #include "bin/file.h"
+#include "bin/isolate_data.h"
 
 #include "platform/assert.h"
+#include "vm/bigint_operations.h"
 
 #include "vm/dart_api_impl.h"
 #include "vm/stack_frame.h"
@@ -53,6 +56,95 @@ BENCHMARK(CorelibCompileAll) {
 #endif  // TARGET_ARCH_IA32 || TARGET_ARCH_X64
 
 
+//
+// Measure loading a large generated library, which mostly consists of
+// scanning it and creating symbols for its identifiers.
+//
+// Returns the source of a library of generated classes. The caller has to
+// delete the source.
+static char* GenerateLargeLibrary(intptr_t num_classes) {
+  const char* kClassFormat =
+      "class Class%"Pd" extends Object {\n"
+      "  int field%"Pd"A = 0;\n"
+      "  String field%"Pd"B = 'string %"Pd"';\n"
+      "  method%"Pd"(argument%"Pd") {\n"
+      "    var local%"Pd" = argument%"Pd" + field%"Pd"A;\n"
+      "    return '$local%"Pd" $field%"Pd"B';\n"
+      "  }\n"
+      "}\n";
+  intptr_t class_length = strlen(kClassFormat) + 11 * 20;
+  char* script = new char[num_classes * class_length + 1];
+  intptr_t length = 0;
+  for (intptr_t i = 0; i < num_classes; i++) {
+    length += OS::SNPrint(&script[length], class_length, kClassFormat,
+                          i, i, i, i, i, i, i, i, i, i, i);
+  }
+  return script;
+}
+
+
+BENCHMARK(LoadLargeLibrary) {
+  char* script = GenerateLargeLibrary(2000);
+  Timer timer(true, "Load large library benchmark");
+  timer.Start();
+  Dart_Handle lib = TestCase::LoadTestScript(script, NULL);
+  timer.Stop();
+  EXPECT_VALID(lib);
+  delete[] script;
+  int64_t elapsed_time = timer.TotalElapsedTime();
+  benchmark->set_score(elapsed_time);
+}
+
+
+//
+// Measure loading the same library from a script snapshot, which reserves
+// the symbol table for the symbols counted in the snapshot before reading
+// them.
+//
+BENCHMARK(LoadLargeLibrarySnapshot) {
+  char* script = GenerateLargeLibrary(2000);
+  char* err = NULL;
+  Dart_Isolate base_isolate = Dart_CurrentIsolate();
+  // Script snapshots are loaded into isolates created from a full snapshot.
+  uint8_t* buffer = NULL;
+  intptr_t size = 0;
+  Dart_Handle result = Dart_CreateSnapshot(&buffer, &size);
+  EXPECT_VALID(result);
+  uint8_t* full_snapshot = reinterpret_cast<uint8_t*>(malloc(size));
+  memmove(full_snapshot, buffer, size);
+
+  Dart_Isolate test_isolate =
+      Dart_CreateIsolate(NULL, NULL, full_snapshot, NULL, &err);
+  EXPECT(test_isolate != NULL);
+  Dart_EnterScope();
+  Dart_Handle lib = TestCase::LoadTestScript(script, NULL);
+  EXPECT_VALID(lib);
+  result = Dart_CreateScriptSnapshot(&buffer, &size);
+  EXPECT_VALID(result);
+  uint8_t* script_snapshot = reinterpret_cast<uint8_t*>(malloc(size));
+  memmove(script_snapshot, buffer, size);
+  Dart_ExitScope();
+  Dart_ShutdownIsolate();
+
+  test_isolate = Dart_CreateIsolate(NULL, NULL, full_snapshot, NULL, &err);
+  EXPECT(test_isolate != NULL);
+  Dart_EnterScope();
+  Timer timer(true, "Load large library snapshot benchmark");
+  timer.Start();
+  lib = Dart_LoadScriptFromSnapshot(script_snapshot);
+  timer.Stop();
+  EXPECT_VALID(lib);
+  int64_t elapsed_time = timer.TotalElapsedTime();
+  benchmark->set_score(elapsed_time);
+  Dart_ExitScope();
+  Dart_ShutdownIsolate();
+  free(full_snapshot);
+  free(script_snapshot);
+  delete[] script;
+  Dart_EnterIsolate(base_isolate);
+}
+
+
 //
 // Measure creation of core isolate from a snapshot.
 //
@@ -225,6 +317,57 @@ BENCHMARK(DartStringAccess) {
 }
 
 
+//
+// Measure matching a regular expression against all the lines of a log
+// held in a single string. The score is the number of kilobytes of log
+// scanned per second.
+//
+BENCHMARK(RegExpLogScan) {
+  const int kNumLines = 2000;
+  const char* kScriptChars =
+      "String makeLog(int lines) {\n"
+      "  var buffer = new StringBuffer();\n"
+      "  for (int i = 0; i < lines; i++) {\n"
+      "    buffer.add('10.0.0.${i % 256} - - [18/Oct/2012:13:55:36] ');\n"
+      "    buffer.add('\"GET /page$i.html HTTP/1.1\" 200 ${i * 7 % 9999}\\n');\n"
+      "  }\n"
+      "  return buffer.toString();\n"
+      "}\n"
+      "int scan(String log) {\n"
+      "  var exp = new RegExp(r'\"GET (\\S+) HTTP/1\\.1\" (\\d+)');\n"
+      "  int count = 0;\n"
+      "  for (var match in exp.allMatches(log)) {\n"
+      "    if (match.group(2) == '200') count++;\n"
+      "  }\n"
+      "  return count;\n"
+      "}\n";
+  Dart_Handle lib = TestCase::LoadTestScript(kScriptChars, NULL);
+  EXPECT_VALID(lib);
+  Dart_Handle args[1];
+  args[0] = Dart_NewInteger(kNumLines);
+  Dart_Handle log = Dart_Invoke(lib, NewString("makeLog"), 1, args);
+  EXPECT_VALID(log);
+  intptr_t log_length = 0;
+  EXPECT_VALID(Dart_StringLength(log, &log_length));
+  // Warmup first to avoid compilation jitters.
+  Dart_Handle result = Dart_Invoke(lib, NewString("scan"), 1, &log);
+  EXPECT_VALID(result);
+
+  Timer timer(true, "RegExpLogScan benchmark");
+  timer.Start();
+  result = Dart_Invoke(lib, NewString("scan"), 1, &log);
+  EXPECT_VALID(result);
+  timer.Stop();
+  int64_t count = 0;
+  EXPECT_VALID(Dart_IntegerToInt64(result, &count));
+  EXPECT_EQ(kNumLines, count);
+  int64_t elapsed_time = timer.TotalElapsedTime();
+  benchmark->set_score(
+      (static_cast<int64_t>(log_length) * kMicrosecondsPerSecond) /
+      (KB * elapsed_time));
+}
+
+
 //
 // Measure compile of all dart2js(compiler) functions.
 //
@@ -390,4 +533,846 @@ BENCHMARK(FrameLookup) {
   benchmark->set_score(elapsed_time);
 }
 
+
+//
+// Measure stack map lookup while scavenging with a deep optimized stack.
+//
+static void StackFrame_scavenge(Dart_NativeArguments args) {
+  const int kNumIterations = 100;
+  Dart_EnterScope();
+  Isolate* isolate = Isolate::Current();
+  Timer timer(true, "Scavenge with deep stack benchmark");
+  timer.Start();
+  for (int i = 0; i < kNumIterations; i++) {
+    isolate->heap()->CollectGarbage(Heap::kNew);
+  }
+  timer.Stop();
+  int64_t elapsed_time = timer.TotalElapsedTime();
+  Dart_SetReturnValue(args, Dart_NewInteger(elapsed_time));
+  Dart_ExitScope();
+}
+
+
+static Dart_NativeFunction StackmapNativeResolver(Dart_Handle name,
+                                                  int arg_count) {
+  return &StackFrame_scavenge;
+}
+
+
+BENCHMARK(StackmapLookup) {
+  const char* kScriptChars =
+      "class StackFrame {"
+      "  static int scavenge() native \"StackFrame_scavenge\";"
+      "} "
+      "class StackmapTest {"
+      "  static int recurse(int n, bool measure) {"
+      "    if (n == 0) {"
+      "      return measure ? StackFrame.scavenge() : 0;"
+      "    }"
+      "    var a = new List(n);"
+      "    var b = [n, a];"
+      "    var c = a.length + b.length;"
+      "    var result = recurse(n - 1, measure);"
+      "    return result + a.length + b.length - c;"
+      "  }"
+      "  static int testMain() {"
+      "    for (int i = 0; i < 5000; i++) {"
+      "      recurse(2, false);"
+      "    }"
+      "    return recurse(1000, true);"
+      "  }"
+      "}";
+  Dart_Handle lib = TestCase::LoadTestScript(
+      kScriptChars,
+      reinterpret_cast<Dart_NativeEntryResolver>(StackmapNativeResolver));
+  Dart_Handle cls = Dart_GetClass(lib, NewString("StackmapTest"));
+  Dart_Handle result = Dart_Invoke(cls, NewString("testMain"), 0, NULL);
+  EXPECT_VALID(result);
+  int64_t elapsed_time = 0;
+  result = Dart_IntegerToInt64(result, &elapsed_time);
+  EXPECT_VALID(result);
+  benchmark->set_score(elapsed_time);
+}
+
+
+// Runs the benchmark function of a benchmark script, which returns the
+// number of operations it has done, and scores operations per second.
+static void RunOperationsBenchmark(Benchmark* benchmark,
+                                   const char* script_chars,
+                                   intptr_t count) {
+  Dart_Handle lib = TestCase::LoadTestScript(script_chars, NULL);
+  EXPECT_VALID(lib);
+  Dart_Handle args[1];
+  // Warmup first to avoid compilation jitters.
+  args[0] = Dart_NewInteger(100);
+  EXPECT_VALID(Dart_Invoke(lib, NewString("benchmark"), 1, args));
+  args[0] = Dart_NewInteger(count);
+  Timer timer(true, "Operations benchmark");
+  timer.Start();
+  Dart_Handle result = Dart_Invoke(lib, NewString("benchmark"), 1, args);
+  timer.Stop();
+  EXPECT_VALID(result);
+  int64_t operations = DartUtils::GetIntegerValue(result);
+  int64_t elapsed_time = timer.TotalElapsedTime();
+  benchmark->set_score((operations * kMicrosecondsPerSecond) / elapsed_time);
+}
+
+
+// Creates an isolate with the isolate data of the standalone embedder, so
+// that dart:io can use the event handler, and loads the benchmark script
+// into it. The isolate is shut down when the scope is left.
+class IOBenchmarkScope : public ValueObject {
+ public:
+  explicit IOBenchmarkScope(const char* script_chars)
+      : base_isolate_(Dart_CurrentIsolate()),
+        isolate_data_(new IsolateData()) {
+    char* err = NULL;
+    Dart_ExitIsolate();
+    Dart_Isolate isolate =
+        Dart_CreateIsolate(NULL, NULL, NULL, isolate_data_, &err);
+    EXPECT(isolate != NULL);
+    Dart_EnterScope();
+    lib_ = TestCase::LoadTestScript(script_chars, NULL);
+    EXPECT_VALID(lib_);
+  }
+
+  ~IOBenchmarkScope() {
+    Dart_ExitScope();
+    if (isolate_data_->event_handler != NULL) {
+      isolate_data_->event_handler->Shutdown();
+    }
+    Dart_ShutdownIsolate();
+    delete isolate_data_;
+    Dart_EnterIsolate(base_isolate_);
+  }
+
+  Dart_Handle lib() const { return lib_; }
+
+ private:
+  Dart_Isolate base_isolate_;
+  IsolateData* isolate_data_;
+  Dart_Handle lib_;
+
+  DISALLOW_COPY_AND_ASSIGN(IOBenchmarkScope);
+};
+
+
+//
+// Measure the rate at which connections are accepted and connected through
+// the event handler. The score is the number of connections per second.
+//
+BENCHMARK(SocketConnections) {
+  const int kNumWarmupConnections = 500;
+  const int kNumConnections = 5000;
+  const char* kScriptChars =
+      "import 'dart:io';\n"
+      "void benchmark(int count) {\n"
+      "  const int kConcurrency = 32;\n"
+      "  var server = new ServerSocket('127.0.0.1', 0, 512);\n"
+      "  int accepted = 0;\n"
+      "  server.onConnection = (Socket connection) {\n"
+      "    connection.close();\n"
+      "    if (++accepted == count) server.close();\n"
+      "  };\n"
+      "  int started = 0;\n"
+      "  void connect() {\n"
+      "    started++;\n"
+      "    var socket = new Socket('127.0.0.1', server.port);\n"
+      "    socket.onConnect = () {\n"
+      "      socket.close();\n"
+      "      if (started < count) connect();\n"
+      "    };\n"
+      "  }\n"
+      "  for (int i = 0; i < kConcurrency; i++) connect();\n"
+      "}\n";
+  IOBenchmarkScope scope(kScriptChars);
+  Dart_Handle lib = scope.lib();
+  Dart_Handle args[1];
+  // Warmup first to avoid compilation jitters.
+  args[0] = Dart_NewInteger(kNumWarmupConnections);
+  Dart_Handle result = Dart_Invoke(lib, NewString("benchmark"), 1, args);
+  EXPECT_VALID(result);
+  result = Dart_RunLoop();
+  EXPECT_VALID(result);
+
+  args[0] = Dart_NewInteger(kNumConnections);
+  Timer timer(true, "SocketConnections benchmark");
+  timer.Start();
+  result = Dart_Invoke(lib, NewString("benchmark"), 1, args);
+  EXPECT_VALID(result);
+  // Runs until the server and all connections have been closed.
+  result = Dart_RunLoop();
+  EXPECT_VALID(result);
+  timer.Stop();
+  int64_t elapsed_time = timer.TotalElapsedTime();
+  benchmark->set_score(
+      (static_cast<int64_t>(kNumConnections) * kMicrosecondsPerSecond) /
+      elapsed_time);
+}
+
+
+//
+// Measure the rate at which many log files are read concurrently through
+// positional reads into transferable buffers, counting the lines of each
+// chunk read. The score is the number of kilobytes read per second.
+//
+BENCHMARK(FileReadListAt) {
+  const int kNumFiles = 64;
+  const int kFileSize = 256 * KB;
+  const char* kScriptChars =
+      "import 'dart:io';\n"
+      "import 'dart:scalarlist';\n"
+      "const int kChunkSize = 64 * 1024;\n"
+      "int lines;\n"
+      "String createFiles(int count, int size) {\n"
+      "  var directory = new Directory('').createTempSync();\n"
+      "  var line = 'GET /index.html HTTP/1.1 200 5123\\n'.charCodes;\n"
+      "  var data = new Uint8List(size);\n"
+      "  for (int i = 0; i < size; i++) data[i] = line[i % line.length];\n"
+      "  for (int i = 0; i < count; i++) {\n"
+      "    new File('${directory.path}/log$i').writeAsBytesSync(data);\n"
+      "  }\n"
+      "  return directory.path;\n"
+      "}\n"
+      "void deleteFiles(String path) {\n"
+      "  new Directory(path).deleteSync(recursive: true);\n"
+      "}\n"
+      "void benchmark(String path, int count) {\n"
+      "  lines = 0;\n"
+      "  for (int i = 0; i < count; i++) {\n"
+      "    var file = new File('$path/log$i').openSync();\n"
+      "    var buffer = new Uint8List.transferable(kChunkSize);\n"
+      "    void readChunk(int position) {\n"
+      "      file.readListAt(buffer, 0, kChunkSize, position).then((bytes) {\n"
+      "        for (int j = 0; j < bytes; j++) {\n"
+      "          if (buffer[j] == 10) lines++;\n"
+      "        }\n"
+      "        if (bytes == kChunkSize) {\n"
+      "          readChunk(position + bytes);\n"
+      "        } else {\n"
+      "          file.closeSync();\n"
+      "        }\n"
+      "      });\n"
+      "    }\n"
+      "    readChunk(0);\n"
+      "  }\n"
+      "}\n";
+  IOBenchmarkScope scope(kScriptChars);
+  Dart_Handle lib = scope.lib();
+  Dart_Handle args[2];
+  args[0] = Dart_NewInteger(kNumFiles);
+  args[1] = Dart_NewInteger(kFileSize);
+  Dart_Handle path = Dart_Invoke(lib, NewString("createFiles"), 2, args);
+  EXPECT_VALID(path);
+  args[0] = path;
+  args[1] = Dart_NewInteger(kNumFiles);
+  // Warmup first to avoid compilation jitters.
+  Dart_Handle result = Dart_Invoke(lib, NewString("benchmark"), 2, args);
+  EXPECT_VALID(result);
+  result = Dart_RunLoop();
+  EXPECT_VALID(result);
+
+  Timer timer(true, "FileReadListAt benchmark");
+  timer.Start();
+  result = Dart_Invoke(lib, NewString("benchmark"), 2, args);
+  EXPECT_VALID(result);
+  // Runs until all the files have been read and closed.
+  result = Dart_RunLoop();
+  EXPECT_VALID(result);
+  timer.Stop();
+  int64_t elapsed_time = timer.TotalElapsedTime();
+  benchmark->set_score(
+      (static_cast<int64_t>(kNumFiles) * (kFileSize / KB) *
+       kMicrosecondsPerSecond) / elapsed_time);
+  result = Dart_GetField(lib, NewString("lines"));
+  EXPECT_VALID(result);
+  EXPECT(DartUtils::GetIntegerValue(result) > 0);
+  result = Dart_Invoke(lib, NewString("deleteFiles"), 1, &path);
+  EXPECT_VALID(result);
+}
+
+
+//
+// Measure the rate at which short lived processes are started and their
+// exit codes collected. The score is the number of processes per second.
+//
+BENCHMARK(ProcessSpawn) {
+  const int kNumWarmupProcesses = 20;
+  const int kNumProcesses = 500;
+  const char* kScriptChars =
+      "import 'dart:io';\n"
+      "int exited;\n"
+      "void benchmark(int count) {\n"
+      "  const int kConcurrency = 8;\n"
+      "  var executable = 'true';\n"
+      "  var args = [];\n"
+      "  if (Platform.operatingSystem == 'windows') {\n"
+      "    executable = 'cmd.exe';\n"
+      "    args = ['/C', 'exit'];\n"
+      "  }\n"
+      "  exited = 0;\n"
+      "  int started = 0;\n"
+      "  void run() {\n"
+      "    started++;\n"
+      "    Process.run(executable, args).then((result) {\n"
+      "      if (result.exitCode == 0) exited++;\n"
+      "      if (started < count) run();\n"
+      "    });\n"
+      "  }\n"
+      "  for (int i = 0; i < kConcurrency; i++) run();\n"
+      "}\n";
+  IOBenchmarkScope scope(kScriptChars);
+  Dart_Handle lib = scope.lib();
+  // Process.run uses timers, which have to be hooked up like the standalone
+  // embedder does.
+  Dart_Handle io_lib = Dart_LookupLibrary(NewString("dart:io"));
+  EXPECT_VALID(io_lib);
+  Dart_Handle timer_closure =
+      Dart_Invoke(io_lib, NewString("_getTimerFactoryClosure"), 0, NULL);
+  EXPECT_VALID(timer_closure);
+  Dart_Handle async_lib = Dart_LookupLibrary(NewString("dart:async"));
+  EXPECT_VALID(async_lib);
+  EXPECT_VALID(Dart_Invoke(
+      async_lib, NewString("_setTimerFactoryClosure"), 1, &timer_closure));
+  Dart_Handle args[1];
+  // Warmup first to avoid compilation jitters.
+  args[0] = Dart_NewInteger(kNumWarmupProcesses);
+  Dart_Handle result = Dart_Invoke(lib, NewString("benchmark"), 1, args);
+  EXPECT_VALID(result);
+  result = Dart_RunLoop();
+  EXPECT_VALID(result);
+
+  args[0] = Dart_NewInteger(kNumProcesses);
+  Timer timer(true, "ProcessSpawn benchmark");
+  timer.Start();
+  result = Dart_Invoke(lib, NewString("benchmark"), 1, args);
+  EXPECT_VALID(result);
+  // Runs until all the processes have exited.
+  result = Dart_RunLoop();
+  EXPECT_VALID(result);
+  timer.Stop();
+  int64_t elapsed_time = timer.TotalElapsedTime();
+  benchmark->set_score(
+      (static_cast<int64_t>(kNumProcesses) * kMicrosecondsPerSecond) /
+      elapsed_time);
+  result = Dart_GetField(lib, NewString("exited"));
+  EXPECT_VALID(result);
+  EXPECT_EQ(kNumProcesses, DartUtils::GetIntegerValue(result));
+}
+
+
+BENCHMARK(IdentityHashMap) {
+  const int kNumObjects = 20000;
+  const char* kScriptChars =
+      "class Key {}\n"
+      "int benchmark(int count) {\n"
+      "  var keys = new List(count);\n"
+      "  for (int i = 0; i < count; i++) keys[i] = new Key();\n"
+      "  var map = new Map();\n"
+      "  for (int i = 0; i < count; i++) map[keys[i]] = i;\n"
+      "  int sum = 0;\n"
+      "  for (int i = 0; i < count; i++) sum += map[keys[i]];\n"
+      "  return sum;\n"
+      "}\n";
+  Dart_Handle lib = TestCase::LoadTestScript(kScriptChars, NULL);
+  EXPECT_VALID(lib);
+  Dart_Handle args[1];
+  // Warmup first to avoid compilation jitters.
+  args[0] = Dart_NewInteger(100);
+  EXPECT_VALID(Dart_Invoke(lib, NewString("benchmark"), 1, args));
+  args[0] = Dart_NewInteger(kNumObjects);
+  Timer timer(true, "IdentityHashMap benchmark");
+  timer.Start();
+  Dart_Handle result = Dart_Invoke(lib, NewString("benchmark"), 1, args);
+  timer.Stop();
+  EXPECT_VALID(result);
+  EXPECT_EQ((static_cast<int64_t>(kNumObjects) * (kNumObjects - 1)) / 2,
+            DartUtils::GetIntegerValue(result));
+  int64_t elapsed_time = timer.TotalElapsedTime();
+  benchmark->set_score(
+      (static_cast<int64_t>(kNumObjects) * kMicrosecondsPerSecond) /
+      elapsed_time);
+}
+
+
+BENCHMARK(MapSmiKeys) {
+  const char* kScriptChars =
+      "int benchmark(int count) {\n"
+      "  var map = new Map<int, int>();\n"
+      "  for (int i = 0; i < count; i++) map[i * 31] = i;\n"
+      "  int found = 0;\n"
+      "  for (int i = 0; i < 2 * count; i++) {\n"
+      "    if (map.containsKey(i * 31)) found++;\n"
+      "  }\n"
+      "  for (int i = 0; i < count; i += 2) map.remove(i * 31);\n"
+      "  if (found != count || map.length != count ~/ 2) throw 'Bad map';\n"
+      "  return count + 2 * count + count ~/ 2;\n"
+      "}\n";
+  RunOperationsBenchmark(benchmark, kScriptChars, 200000);
+}
+
+
+BENCHMARK(MapStringKeys) {
+  const char* kScriptChars =
+      "int benchmark(int count) {\n"
+      "  var keys = new List(count);\n"
+      "  for (int i = 0; i < count; i++) keys[i] = 'key$i';\n"
+      "  var map = new Map<String, int>();\n"
+      "  for (int i = 0; i < count; i++) map[keys[i]] = i;\n"
+      "  int sum = 0;\n"
+      "  for (int i = 0; i < count; i++) sum += map[keys[i]];\n"
+      "  for (var key in map.keys) sum -= map[key];\n"
+      "  if (sum != 0) throw 'Bad map';\n"
+      "  return 3 * count;\n"
+      "}\n";
+  RunOperationsBenchmark(benchmark, kScriptChars, 100000);
+}
+
+
+BENCHMARK(MapLiterals) {
+  const char* kScriptChars =
+      "int benchmark(int count) {\n"
+      "  int sum = 0;\n"
+      "  for (int i = 0; i < count; i++) {\n"
+      "    var map = {'x': i, 'y': 1, 'z': 2};\n"
+      "    sum += map['x'] + map['y'] + map['z'];\n"
+      "  }\n"
+      "  if (sum != count * (count + 5) ~/ 2) throw 'Bad map';\n"
+      "  return 6 * count;\n"
+      "}\n";
+  RunOperationsBenchmark(benchmark, kScriptChars, 100000);
+}
+
+
+BENCHMARK(StringBufferAddCharCode) {
+  const char* kScriptChars =
+      "int benchmark(int count) {\n"
+      "  int length = 0;\n"
+      "  for (int i = 0; i < count; i++) {\n"
+      "    var buffer = new StringBuffer();\n"
+      "    for (int j = 0; j < 100; j++) buffer.addCharCode(0x41 + (j & 15));\n"
+      "    buffer.addCharCode(0x20AC);\n"
+      "    length += buffer.toString().length;\n"
+      "  }\n"
+      "  if (length != 101 * count) throw 'Bad string';\n"
+      "  return 101 * count;\n"
+      "}\n";
+  RunOperationsBenchmark(benchmark, kScriptChars, 20000);
+}
+
+
+BENCHMARK(StringBufferAdd) {
+  const char* kScriptChars =
+      "int benchmark(int count) {\n"
+      "  var buffer = new StringBuffer();\n"
+      "  for (int i = 0; i < count; i++) {\n"
+      "    buffer.add('x');\n"
+      "    buffer.add(i);\n"
+      "  }\n"
+      "  if (buffer.toString().length != buffer.length) throw 'Bad string';\n"
+      "  return 2 * count;\n"
+      "}\n";
+  RunOperationsBenchmark(benchmark, kScriptChars, 500000);
+}
+
+
+//
+// Measure converting UTF-8 text to strings and back. The text is mostly
+// ASCII with a non-ASCII character every 'stride' bytes, or all ASCII if
+// stride is 0. The score is the number of megabytes converted per second.
+//
+static void RunUtf8Benchmark(Benchmark* benchmark,
+                             intptr_t stride,
+                             bool encode) {
+  const intptr_t kLength = 64 * KB;
+  const int kNumIterations = 2000;
+  uint8_t* utf8 = new uint8_t[kLength];
+  for (intptr_t i = 0; i < kLength; i++) {
+    utf8[i] = 'a' + (i % 26);
+  }
+  if (stride > 0) {
+    // Alternate two-byte and three-byte sequences: U+00E9 and U+20AC.
+    for (intptr_t i = 0; i + 3 <= kLength; i += stride) {
+      if ((i / stride) % 2 == 0) {
+        utf8[i] = 0xC3;
+        utf8[i + 1] = 0xA9;
+      } else {
+        utf8[i] = 0xE2;
+        utf8[i + 1] = 0x82;
+        utf8[i + 2] = 0xAC;
+      }
+    }
+  }
+  Dart_EnterScope();
+  Dart_Handle str = Dart_NewStringFromUTF8(utf8, kLength);
+  EXPECT_VALID(str);
+  Timer timer(true, "UTF-8 benchmark");
+  timer.Start();
+  for (int i = 0; i < kNumIterations; i++) {
+    Dart_EnterScope();
+    if (encode) {
+      uint8_t* result = NULL;
+      intptr_t result_length = 0;
+      EXPECT_VALID(Dart_StringToUTF8(str, &result, &result_length));
+      EXPECT_EQ(kLength, result_length);
+    } else {
+      EXPECT_VALID(Dart_NewStringFromUTF8(utf8, kLength));
+    }
+    Dart_ExitScope();
+  }
+  timer.Stop();
+  Dart_ExitScope();
+  delete[] utf8;
+  int64_t elapsed_time = timer.TotalElapsedTime();
+  benchmark->set_score(
+      (kNumIterations * kLength * kMicrosecondsPerSecond) /
+      (elapsed_time * MB));
+}
+
+
+BENCHMARK(Utf8DecodeAscii) {
+  RunUtf8Benchmark(benchmark, 0, false);
+}
+
+
+BENCHMARK(Utf8DecodeMixed) {
+  RunUtf8Benchmark(benchmark, 16, false);
+}
+
+
+BENCHMARK(Utf8EncodeAscii) {
+  RunUtf8Benchmark(benchmark, 0, true);
+}
+
+
+BENCHMARK(Utf8EncodeMixed) {
+  RunUtf8Benchmark(benchmark, 16, true);
+}
+
+
+//
+// Measure parsing and stringifying JSON. The score is the number of
+// characters of JSON text processed per second.
+//
+static const char* kJsonBenchmarkDocument =
+    "import 'dart:json';\n"
+    "String document() {\n"
+    "  var list = [];\n"
+    "  for (int i = 0; i < 100; i++) {\n"
+    "    list.add({'id': i, 'name': 'item $i', 'price': i * 1.25,\n"
+    "              'tags': ['a', 'b\\n'], 'available': i % 2 == 0,\n"
+    "              'parent': null});\n"
+    "  }\n"
+    "  return stringify(list);\n"
+    "}\n";
+
+
+static void RunJsonBenchmark(Benchmark* benchmark, const char* script_chars) {
+  intptr_t length = strlen(kJsonBenchmarkDocument) + strlen(script_chars);
+  char* script = new char[length + 1];
+  OS::SNPrint(script, length + 1, "%s%s", kJsonBenchmarkDocument,
+              script_chars);
+  RunOperationsBenchmark(benchmark, script, 1000);
+  delete[] script;
+}
+
+
+BENCHMARK(JsonParse) {
+  const char* kScriptChars =
+      "int benchmark(int count) {\n"
+      "  var json = document();\n"
+      "  for (int i = 0; i < count; i++) {\n"
+      "    if (parse(json).length != 100) throw 'Bad JSON';\n"
+      "  }\n"
+      "  return count * json.length;\n"
+      "}\n";
+  RunJsonBenchmark(benchmark, kScriptChars);
+}
+
+
+BENCHMARK(JsonParseDart) {
+  const char* kScriptChars =
+      "int benchmark(int count) {\n"
+      "  var json = document();\n"
+      "  for (int i = 0; i < count; i++) {\n"
+      "    var listener = new BuildJsonListener();\n"
+      "    new JsonParser(json, listener).parse();\n"
+      "    if (listener.result.length != 100) throw 'Bad JSON';\n"
+      "  }\n"
+      "  return count * json.length;\n"
+      "}\n";
+  RunJsonBenchmark(benchmark, kScriptChars);
+}
+
+
+BENCHMARK(JsonStringify) {
+  const char* kScriptChars =
+      "int benchmark(int count) {\n"
+      "  var value = parse(document());\n"
+      "  int length = 0;\n"
+      "  for (int i = 0; i < count; i++) length += stringify(value).length;\n"
+      "  return length;\n"
+      "}\n";
+  RunJsonBenchmark(benchmark, kScriptChars);
+}
+
+
+//
+// Measure arithmetic on and conversions of large integers. The score is the
+// number of operations per second.
+//
+BENCHMARK(BigintMultiply) {
+  const char* kScriptChars =
+      "int benchmark(int count) {\n"
+      "  var a = (1 << 4096) - 12345;\n"
+      "  var b = (1 << 4000) + 54321;\n"
+      "  var product;\n"
+      "  for (int i = 0; i < count; i++) product = a * b;\n"
+      "  if (product ~/ b != a) throw 'Bad product';\n"
+      "  return count;\n"
+      "}\n";
+  RunOperationsBenchmark(benchmark, kScriptChars, 5000);
+}
+
+
+BENCHMARK(BigintDivide) {
+  const char* kScriptChars =
+      "int benchmark(int count) {\n"
+      "  var a = (1 << 8192) - 12345;\n"
+      "  var b = (1 << 4000) + 54321;\n"
+      "  var quotient;\n"
+      "  for (int i = 0; i < count; i++) quotient = a ~/ b;\n"
+      "  if (quotient * b + a.remainder(b) != a) throw 'Bad quotient';\n"
+      "  return count;\n"
+      "}\n";
+  RunOperationsBenchmark(benchmark, kScriptChars, 5000);
+}
+
+
+BENCHMARK(BigintToString) {
+  const char* kScriptChars =
+      "int benchmark(int count) {\n"
+      "  var a = (1 << 4096) - 12345;\n"
+      "  int length = 0;\n"
+      "  for (int i = 0; i < count; i++) length += a.toString().length;\n"
+      "  if (length != 1234 * count) throw 'Bad string';\n"
+      "  return count;\n"
+      "}\n";
+  RunOperationsBenchmark(benchmark, kScriptChars, 1000);
+}
+
+
+BENCHMARK(BigintParse) {
+  const char* kScriptChars =
+      "int benchmark(int count) {\n"
+      "  var a = (1 << 4096) - 12345;\n"
+      "  var str = a.toString();\n"
+      "  for (int i = 0; i < count; i++) {\n"
+      "    if (int.parse(str) != a) throw 'Bad integer';\n"
+      "  }\n"
+      "  return count;\n"
+      "}\n";
+  RunOperationsBenchmark(benchmark, kScriptChars, 1000);
+}
+
+
+BENCHMARK(BigintModPow) {
+  const int kNumIterations = 100;
+  Isolate* isolate = Isolate::Current();
+  const Bigint& one = Bigint::Handle(BigintOperations::NewFromInt64(1));
+  Bigint& modulus = Bigint::Handle(BigintOperations::ShiftLeft(one, 1024));
+  modulus = BigintOperations::Subtract(
+      modulus, Bigint::Handle(BigintOperations::NewFromInt64(105)));
+  const Bigint& exponent = Bigint::Handle(BigintOperations::Subtract(
+      modulus, Bigint::Handle(BigintOperations::NewFromInt64(2))));
+  const Bigint& base = Bigint::Handle(BigintOperations::NewFromInt64(3));
+  Timer timer(true, "BigintModPow benchmark");
+  timer.Start();
+  for (int i = 0; i < kNumIterations; i++) {
+    StackZone zone(isolate);
+    HANDLESCOPE(isolate);
+    const Bigint& result =
+        Bigint::Handle(BigintOperations::ModPow(base, exponent, modulus));
+    EXPECT(!result.IsZero());
+  }
+  timer.Stop();
+  int64_t elapsed_time = timer.TotalElapsedTime();
+  benchmark->set_score(
+      (static_cast<int64_t>(kNumIterations) * kMicrosecondsPerSecond) /
+      elapsed_time);
+}
+
+
+//
+// Measure converting numbers to strings and back. The score is the number of
+// conversions per second.
+//
+BENCHMARK(DoubleToString) {
+  const char* kScriptChars =
+      "int benchmark(int count) {\n"
+      "  int length = 0;\n"
+      "  for (int i = 0; i < count; i++) {\n"
+      "    length += (i / 100).toString().length;\n"
+      "    length += (i * 1.0).toString().length;\n"
+      "    length += (i / 3).toString().length;\n"
+      "  }\n"
+      "  if (length <= 0) throw 'Bad string';\n"
+      "  return 3 * count;\n"
+      "}\n";
+  RunOperationsBenchmark(benchmark, kScriptChars, 200000);
+}
+
+
+BENCHMARK(DoubleParse) {
+  const char* kScriptChars =
+      "int benchmark(int count) {\n"
+      "  var strings = ['0.25', '-12.5', '3.14159', '1e-7', '123456.789'];\n"
+      "  double sum = 0.0;\n"
+      "  for (int i = 0; i < count; i++) {\n"
+      "    sum += double.parse(strings[i % 5]);\n"
+      "  }\n"
+      "  if (sum.isNaN) throw 'Bad double';\n"
+      "  return count;\n"
+      "}\n";
+  RunOperationsBenchmark(benchmark, kScriptChars, 500000);
+}
+
+
+BENCHMARK(IntToString) {
+  const char* kScriptChars =
+      "int benchmark(int count) {\n"
+      "  int length = 0;\n"
+      "  for (int i = 0; i < count; i++) {\n"
+      "    length += (i * 7919).toString().length;\n"
+      "  }\n"
+      "  if (length <= 0) throw 'Bad string';\n"
+      "  return count;\n"
+      "}\n";
+  RunOperationsBenchmark(benchmark, kScriptChars, 500000);
+}
+
+
+BENCHMARK(IntParse) {
+  const char* kScriptChars =
+      "int benchmark(int count) {\n"
+      "  var strings = ['0', '42', '-1234', '987654321', '31415926535'];\n"
+      "  int sum = 0;\n"
+      "  for (int i = 0; i < count; i++) {\n"
+      "    sum += int.parse(strings[i % 5]);\n"
+      "  }\n"
+      "  if (sum != (count ~/ 5) * 32403579664) throw 'Bad integer';\n"
+      "  return count;\n"
+      "}\n";
+  RunOperationsBenchmark(benchmark, kScriptChars, 500000);
+}
+
+
+//
+// Measure the bulk operations on typed arrays, as used when copying frames
+// and searching for line terminators in network buffers. The score is the
+// number of 4 KB buffers processed per second.
+//
+BENCHMARK(Uint8ListSetRange) {
+  const char* kScriptChars =
+      "import 'dart:scalarlist';\n"
+      "int benchmark(int count) {\n"
+      "  var frame = new Uint8List(8192);\n"
+      "  var buffer = new Uint8List.view(frame.asByteArray(), 4096);\n"
+      "  var data = new Uint8List(4096);\n"
+      "  for (int i = 0; i < count; i++) {\n"
+      "    data[i & 4095] = i;\n"
+      "    buffer.setRange(0, 4096, data);\n"
+      "    data.setRange(1, 4095, buffer);\n"
+      "  }\n"
+      "  if (frame[4096] != data[0]) throw 'Bad copy';\n"
+      "  return 2 * count;\n"
+      "}\n";
+  RunOperationsBenchmark(benchmark, kScriptChars, 100000);
+}
+
+
+BENCHMARK(ByteArrayFill) {
+  const char* kScriptChars =
+      "import 'dart:scalarlist';\n"
+      "int benchmark(int count) {\n"
+      "  var bytes = new Uint8List(4096).asByteArray();\n"
+      "  for (int i = 0; i < count; i++) {\n"
+      "    bytes.fill(i);\n"
+      "  }\n"
+      "  if (bytes.getUint8(4095) != ((count - 1) & 0xFF)) throw 'Bad fill';\n"
+      "  return count;\n"
+      "}\n";
+  RunOperationsBenchmark(benchmark, kScriptChars, 100000);
+}
+
+
+BENCHMARK(Uint8ListIndexOf) {
+  const char* kScriptChars =
+      "import 'dart:scalarlist';\n"
+      "int benchmark(int count) {\n"
+      "  var line = 'Content-Type: text/html; charset=utf-8\\r\\n'.charCodes;\n"
+      "  var data = new Uint8List(4096);\n"
+      "  for (int i = 0; i < 4096; i++) data[i] = line[i % line.length];\n"
+      "  var bytes = data.asByteArray();\n"
+      "  int lines = 0;\n"
+      "  for (int i = 0; i < count; i++) {\n"
+      "    int index = data.indexOf(13);\n"
+      "    while (index >= 0) {\n"
+      "      if (bytes.getUint8(index + 1) == 10) lines++;\n"
+      "      index = bytes.indexOf(13, index + 1);\n"
+      "    }\n"
+      "  }\n"
+      "  if (lines != count * (4096 ~/ line.length)) throw 'Bad search';\n"
+      "  return count;\n"
+      "}\n";
+  RunOperationsBenchmark(benchmark, kScriptChars, 10000);
+}
+
+
+BENCHMARK(ByteArrayCrc32) {
+  const char* kScriptChars =
+      "import 'dart:scalarlist';\n"
+      "int benchmark(int count) {\n"
+      "  var data = new Uint8List(4096);\n"
+      "  for (int i = 0; i < 4096; i++) data[i] = i * 7;\n"
+      "  var bytes = data.asByteArray();\n"
+      "  int crc = 0;\n"
+      "  for (int i = 0; i < count; i++) {\n"
+      "    crc = bytes.crc32(0, 4096, crc);\n"
+      "  }\n"
+      "  if (crc < 0 || crc > 0xFFFFFFFF) throw 'Bad checksum';\n"
+      "  return count;\n"
+      "}\n";
+  RunOperationsBenchmark(benchmark, kScriptChars, 20000);
+}
+
+// Measures the overhead of the sampling CPU profiler by running the same
+// calls benchmark without and with profiling.
+static const char* kCpuProfilingScriptChars =
+    "int fib(int n) => (n < 2) ? n : fib(n - 1) + fib(n - 2);\n"
+    "int benchmark(int count) {\n"
+    "  for (int i = 0; i < count; i++) {\n"
+    "    if (fib(20) != 6765) throw 'Bad fib';\n"
+    "  }\n"
+    "  return count;\n"
+    "}\n";
+
+
+BENCHMARK(CpuProfilingOff) {
+  RunOperationsBenchmark(benchmark, kCpuProfilingScriptChars, 2000);
+}
+
+
+BENCHMARK(CpuProfilingOn) {
+  Dart_Handle result = Dart_StartCpuProfiling();
+  if (Dart_IsError(result)) {
+    // Not supported on this platform.
+    benchmark->set_score(0);
+    return;
+  }
+  RunOperationsBenchmark(benchmark, kCpuProfilingScriptChars, 2000);
+  EXPECT_VALID(Dart_StopCpuProfiling());
+}
+
+
 }  // namespace dart
@@ -12,37 +12,8 @@
 namespace dart {
 
 RawBigint* BigintOperations::NewFromSmi(const Smi& smi, Heap::Space space) {
-  intptr_t value = smi.Value();
-  if (value == 0) {
-    return Zero();
-  }
-
-  bool is_negative = (value < 0);
-  if (is_negative) {
-    value = -value;
-  }
-  // Assert that there are no overflows. Smis reserve a bit for themselves, but
-  // protect against future changes.
-  ASSERT(-Smi::kMinValue > 0);
-
-  // A single digit of a Bigint might not be sufficient to store a Smi.
-  // Count number of needed Digits.
-  intptr_t digit_count = 0;
-  intptr_t count_value = value;
-  while (count_value > 0) {
-    digit_count++;
-    count_value >>= kDigitBitSize;
-  }
-
-  // Allocate a bigint of the correct size and copy the bits.
-  const Bigint& result = Bigint::Handle(Bigint::Allocate(digit_count, space));
-  for (int i = 0; i < digit_count; i++) {
-    result.SetChunkAt(i, static_cast<Chunk>(value & kDigitMask));
-    value >>= kDigitBitSize;
-  }
-  result.SetSign(is_negative);
-  ASSERT(IsClamped(result));
-  return result.raw();
+  // A Smi might not fit into a single digit.
+  return NewFromInt64(smi.Value(), space);
 }
 
 
@@ -76,7 +47,7 @@ RawBigint* BigintOperations::NewFromUint64(uint64_t value, Heap::Space space) {
   // Allocate a bigint of the correct size and copy the bits.
   const Bigint& result = Bigint::Handle(Bigint::Allocate(digit_count, space));
   for (int i = 0; i < digit_count; i++) {
-    result.SetChunkAt(i, static_cast<Chunk>(value & kDigitMask));
+    result.SetChunkAt(i, static_cast<Chunk>(value));
     value >>= kDigitBitSize;
   }
   result.SetSign(false);
@@ -152,48 +123,47 @@ RawBigint* BigintOperations::FromHexCString(const char* hex_string,
 
 RawBigint* BigintOperations::FromDecimalCString(const char* str,
                                                 Heap::Space space) {
-  // Read 8 digits a time. 10^8 < 2^27.
-  const int kDigitsPerIteration = 8;
-  const Chunk kTenMultiplier = 100000000;
-  ASSERT(kDigitBitSize >= 27);
+  // Read 9 digits a time. 10^9 < 2^32.
+  const int kDigitsPerIteration = 9;
+  const Chunk kTenMultiplier = 1000000000;
+  ASSERT(kDigitBitSize >= 30);
 
   intptr_t str_length = strlen(str);
   intptr_t str_pos = 0;
 
-  // Read first digit separately. This avoids a multiplication and addition.
-  // The first digit might also not have kDigitsPerIteration decimal digits.
-  int first_digit_decimal_digits = str_length % kDigitsPerIteration;
-  Chunk digit = 0;
-  for (intptr_t i = 0; i < first_digit_decimal_digits; i++) {
-    char c = str[str_pos++];
-    ASSERT(('0' <= c) && (c <= '9'));
-    digit = digit * 10 + c - '0';
-  }
-  Bigint& result = Bigint::Handle(Bigint::Allocate(1));
-  result.SetChunkAt(0, digit);
-  Clamp(result);  // Multiplication requires the inputs to be clamped.
-
-  // Read kDigitsPerIteration at a time, and store it in 'increment'.
-  // Then multiply the temporary result by 10^kDigitsPerIteration and add
-  // 'increment' to the new result.
-  const Bigint& increment = Bigint::Handle(Bigint::Allocate(1));
-  while (str_pos < str_length - 1) {
-    Chunk digit = 0;
-    for (intptr_t i = 0; i < kDigitsPerIteration; i++) {
+  // A decimal digit needs log2(10) < 10/3 bits.
+  intptr_t max_length = ((str_length * 10 / 3) / kDigitBitSize) + 1;
+  const Bigint& result = Bigint::Handle(Bigint::Allocate(max_length, space));
+  NoGCScope no_gc;
+  Chunk* digits = result.ChunkAddr(0);
+  intptr_t length = 0;
+
+  // Read kDigitsPerIteration at a time, and store it in 'increment'. Then
+  // multiply the digits read so far by 10^kDigitsPerIteration and add
+  // 'increment' in place. The first iteration might read fewer decimal digits.
+  intptr_t iteration_digits = str_length % kDigitsPerIteration;
+  if (iteration_digits == 0) iteration_digits = kDigitsPerIteration;
+  while (str_pos < str_length) {
+    Chunk increment = 0;
+    for (intptr_t i = 0; i < iteration_digits; i++) {
       char c = str[str_pos++];
       ASSERT(('0' <= c) && (c <= '9'));
-      digit = digit * 10 + c - '0';
+      increment = increment * 10 + c - '0';
     }
-    result = MultiplyWithDigit(result, kTenMultiplier);
-    if (digit != 0) {
-      increment.SetChunkAt(0, digit);
-      result = Add(result, increment);
+    iteration_digits = kDigitsPerIteration;
+    DoubleChunk carry = increment;
+    for (intptr_t i = 0; i < length; i++) {
+      carry += static_cast<DoubleChunk>(digits[i]) * kTenMultiplier;
+      digits[i] = static_cast<Chunk>(carry);
+      carry >>= kDigitBitSize;
+    }
+    if (carry != 0) {
+      ASSERT(length < max_length);
+      digits[length++] = static_cast<Chunk>(carry);
     }
   }
-  Clamp(result);
-  if ((space == Heap::kOld) && !result.IsOld()) {
-    result ^= Object::Clone(result, Heap::kOld);
-  }
+  result.SetLength(length);
+  ASSERT(IsClamped(result));
   return result.raw();
 }
 
@@ -339,13 +309,20 @@ const char* BigintOperations::ToDecimalCString(
     UNREACHABLE();
   }
 
+  // We repeatedly divide a copy of the magnitude by 10^9 in place. Each
+  // remainder yields the next 9 decimal digits.
+  const Chunk kChunkDivisor = 1000000000;
+  const int kChunkDigits = 9;
+  ASSERT(pow(10.0, kChunkDigits) == kChunkDivisor);
+
   // Approximate the size of the resulting string. We prefer overestimating
   // to not allocating enough.
   int64_t bit_length = length * kDigitBitSize;
   ASSERT(bit_length > length);
   int64_t decimal_length = (bit_length * kLog2Dividend / kLog2Divisor) + 1;
-  // Add one byte for the trailing \0 character.
-  int64_t required_size = decimal_length + 1;
+  // The last remainder is printed with leading zeroes, which are removed
+  // afterwards. Add one byte for the trailing \0 character.
+  int64_t required_size = decimal_length + kChunkDigits + 1;
   if (bigint.IsNegative()) {
     required_size++;
   }
@@ -356,31 +333,22 @@ const char* BigintOperations::ToDecimalCString(
   ASSERT(result != NULL);
   int result_pos = 0;
 
-  // We divide the input into pieces of ~27 bits which can be efficiently
-  // handled.
-  const intptr_t kChunkDivisor = 100000000;
-  const int kChunkDigits = 8;
-  ASSERT(pow(10.0, kChunkDigits) == kChunkDivisor);
-  ASSERT(static_cast<Chunk>(kChunkDivisor) < kDigitMaxValue);
-  ASSERT(Smi::IsValid(kChunkDivisor));
-  const Bigint& divisor = Bigint::Handle(NewFromInt64(kChunkDivisor));
-
-  // Rest contains the remaining bigint that needs to be printed.
-  Bigint& rest = Bigint::Handle(bigint.raw());
-  Bigint& quotient = Bigint::Handle();
-  Bigint& remainder = Bigint::Handle();
-  while (!rest.IsZero()) {
-    DivideRemainder(rest, divisor, &quotient, &remainder);
-    ASSERT(remainder.Length() <= 1);
-    intptr_t part = (remainder.Length() == 1)
-        ? static_cast<intptr_t>(remainder.GetChunkAt(0))
-        : 0;
+  NoGCScope no_gc;
+  Chunk* rest = Isolate::Current()->current_zone()->Alloc<Chunk>(length);
+  if (length > 0) {
+    memmove(rest, bigint.ChunkAddr(0), length * kChunkSize);
+  }
+  intptr_t rest_length = length;
+  while (rest_length > 0) {
+    Chunk part = DivideDigitsByDigit(rest, rest_length, kChunkDivisor);
+    if (rest[rest_length - 1] == 0) {
+      rest_length--;
+    }
     for (int i = 0; i < kChunkDigits; i++) {
       result[result_pos++] = '0' + (part % 10);
       part /= 10;
     }
     ASSERT(part == 0);
-    rest = quotient.raw();
   }
   // Move the resulting position back until we don't have any zeroes anymore.
   // This is done so that we can remove all leading zeroes.
@@ -407,63 +375,13 @@ const char* BigintOperations::ToDecimalCString(
 
 
 bool BigintOperations::FitsIntoSmi(const Bigint& bigint) {
-  intptr_t bigint_length = bigint.Length();
-  if (bigint_length == 0) {
-    return true;
-  }
-  if ((bigint_length == 1) &&
-      (static_cast<size_t>(kDigitBitSize) <
-       (sizeof(intptr_t) * kBitsPerByte))) {
-    return true;
-  }
-
-  uintptr_t limit;
-  if (bigint.IsNegative()) {
-    limit = static_cast<uintptr_t>(-Smi::kMinValue);
-  } else {
-    limit = static_cast<uintptr_t>(Smi::kMaxValue);
-  }
-  bool bigint_is_greater = false;
-  // Consume the least-significant digits of the bigint.
-  // If bigint_is_greater is set, then the processed sub-part of the bigint is
-  // greater than the corresponding part of the limit.
-  for (int i = 0; i < bigint_length - 1; i++) {
-    Chunk limit_digit = static_cast<Chunk>(limit & kDigitMask);
-    Chunk bigint_digit = bigint.GetChunkAt(i);
-    if (limit_digit < bigint_digit) {
-      bigint_is_greater = true;
-    } else if (limit_digit > bigint_digit) {
-      bigint_is_greater = false;
-    }  // else don't change the boolean.
-    limit >>= kDigitBitSize;
-
-    // Bail out if the bigint is definitely too big.
-    if (limit == 0) {
-      return false;
-    }
-  }
-  Chunk most_significant_digit = bigint.GetChunkAt(bigint_length - 1);
-  if (limit > most_significant_digit) {
-    return true;
-  }
-  if (limit < most_significant_digit) {
-    return false;
-  }
-  return !bigint_is_greater;
+  return FitsIntoMint(bigint) && Smi::IsValid64(ToMint(bigint));
 }
 
 
 RawSmi* BigintOperations::ToSmi(const Bigint& bigint) {
   ASSERT(FitsIntoSmi(bigint));
-  intptr_t value = 0;
-  for (int i = bigint.Length() - 1; i >= 0; i--) {
-    value <<= kDigitBitSize;
-    value += static_cast<intptr_t>(bigint.GetChunkAt(i));
-  }
-  if (bigint.IsNegative()) {
-    value = -value;
-  }
-  return Smi::New(value);
+  return Smi::New(static_cast<intptr_t>(ToMint(bigint)));
 }
 
 
@@ -606,49 +524,14 @@ RawDouble* BigintOperations::ToDouble(const Bigint& bigint) {
 
 
 bool BigintOperations::FitsIntoMint(const Bigint& bigint) {
-  intptr_t bigint_length = bigint.Length();
-  if (bigint_length == 0) {
-    return true;
-  }
-  if ((bigint_length < 3) &&
-      (static_cast<size_t>(kDigitBitSize) <
-       (sizeof(intptr_t) * kBitsPerByte))) {
-    return true;
+  if (!AbsFitsIntoUint64(bigint)) {
+    return false;
   }
-
-  uint64_t limit;
+  uint64_t value = AbsToUint64(bigint);
   if (bigint.IsNegative()) {
-    limit = static_cast<uint64_t>(Mint::kMinValue);
-  } else {
-    limit = static_cast<uint64_t>(Mint::kMaxValue);
-  }
-  bool bigint_is_greater = false;
-  // Consume the least-significant digits of the bigint.
-  // If bigint_is_greater is set, then the processed sub-part of the bigint is
-  // greater than the corresponding part of the limit.
-  for (int i = 0; i < bigint_length - 1; i++) {
-    Chunk limit_digit = static_cast<Chunk>(limit & kDigitMask);
-    Chunk bigint_digit = bigint.GetChunkAt(i);
-    if (limit_digit < bigint_digit) {
-      bigint_is_greater = true;
-    } else if (limit_digit > bigint_digit) {
-      bigint_is_greater = false;
-    }  // else don't change the boolean.
-    limit >>= kDigitBitSize;
-
-    // Bail out if the bigint is definitely too big.
-    if (limit == 0) {
-      return false;
-    }
-  }
-  Chunk most_significant_digit = bigint.GetChunkAt(bigint_length - 1);
-  if (limit > most_significant_digit) {
-    return true;
+    return value <= static_cast<uint64_t>(Mint::kMinValue);
   }
-  if (limit < most_significant_digit) {
-    return false;
-  }
-  return !bigint_is_greater;
+  return value <= static_cast<uint64_t>(Mint::kMaxValue);
 }
 
 
@@ -657,7 +540,7 @@ uint64_t BigintOperations::AbsToUint64(const Bigint& bigint) {
   uint64_t value = 0;
   for (int i = bigint.Length() - 1; i >= 0; i--) {
     value <<= kDigitBitSize;
-    value += static_cast<intptr_t>(bigint.GetChunkAt(i));
+    value += static_cast<uint64_t>(bigint.GetChunkAt(i));
   }
   return value;
 }
@@ -675,6 +558,7 @@ int64_t BigintOperations::ToMint(const Bigint& bigint) {
 
 bool BigintOperations::AbsFitsIntoUint64(const Bigint& bigint) {
   intptr_t b_length = bigint.Length();
+  if (b_length == 0) return true;
   int num_bits = CountBits(bigint.GetChunkAt(b_length - 1));
   num_bits += (kDigitBitSize * (b_length - 1));
   if (num_bits > 64) return false;
@@ -698,6 +582,9 @@ RawBigint* BigintOperations::Multiply(const Bigint& a, const Bigint& b) {
   ASSERT(IsClamped(a));
   ASSERT(IsClamped(b));
 
+  if (a.IsZero() || b.IsZero()) {
+    return Zero();
+  }
   intptr_t a_length = a.Length();
   intptr_t b_length = b.Length();
   intptr_t result_length = a_length + b_length;
@@ -707,66 +594,16 @@ RawBigint* BigintOperations::Multiply(const Bigint& a, const Bigint& b) {
     result.ToggleSign();
   }
 
-  // Comba multiplication: compute each column separately.
-  // Example: r = a2a1a0 * b2b1b0.
-  //    r =  1    * a0b0 +
-  //        10    * (a1b0 + a0b1) +
-  //        100   * (a2b0 + a1b1 + a0b2) +
-  //        1000  * (a2b1 + a1b2) +
-  //        10000 * a2b2
-  //
-  // Each column will be accumulated in an integer of type DoubleChunk. We
-  // must guarantee that the column-sum will not overflow.
-  //
-  // In the worst case we have to accumulate k = Min(a.length, b.length)
-  // products plus the carry from the previous round.
-  // Each bigint-digit is smaller than beta = 2^kDigitBitSize.
-  // Each product is at most (beta - 1)^2.
-  // If we want to use Comba multiplication the following condition must hold:
-  // k * (beta - 1)^2 + (2^(kDoubleChunkBitSize - kDigitBitSize) - 1) <
-  //        2^kDoubleChunkBitSize.
-  const DoubleChunk square =
-      static_cast<DoubleChunk>(kDigitMaxValue) * kDigitMaxValue;
-  const DoubleChunk kDoubleChunkMaxValue = static_cast<DoubleChunk>(-1);
-  const DoubleChunk left_over_carry = kDoubleChunkMaxValue >> kDigitBitSize;
-  const intptr_t kMaxDigits = (kDoubleChunkMaxValue - left_over_carry) / square;
-  if (Utils::Minimum(a_length, b_length) > kMaxDigits) {
-    // Use the preallocated out of memory exception to avoid calling
-    // into dart code or allocating any code.
-    Isolate* isolate = Isolate::Current();
-    const Instance& exception =
-        Instance::Handle(isolate->object_store()->out_of_memory());
-    Exceptions::Throw(exception);
-    UNREACHABLE();
-  }
-
-  DoubleChunk accumulator = 0;  // Accumulates the result of one column.
-  for (intptr_t i = 0; i < result_length; i++) {
-    // Example: r = a2a1a0 * b2b1b0.
-    //   For i == 0, compute a0b0.
-    //       i == 1,         a1b0 + a0b1 + overflow from i == 0.
-    //       i == 2,         a2b0 + a1b1 + a0b2 + overflow from i == 1.
-    //       ...
-    // The indices into a and b are such that their sum equals i.
-    intptr_t a_index = Utils::Minimum(a_length - 1, i);
-    intptr_t b_index = i - a_index;
-    ASSERT(a_index + b_index == i);
-
-    // Instead of testing for a_index >= 0 && b_index < b_length we compute the
-    // number of iterations first.
-    intptr_t iterations = Utils::Minimum(b_length - b_index, a_index + 1);
-    for (intptr_t j = 0; j < iterations; j++) {
-      DoubleChunk chunk_a = a.GetChunkAt(a_index);
-      DoubleChunk chunk_b = b.GetChunkAt(b_index);
-      accumulator += chunk_a * chunk_b;
-      a_index--;
-      b_index++;
+  {
+    NoGCScope no_gc;
+    Chunk* scratch = NULL;
+    if (Utils::Minimum(a_length, b_length) >= kKaratsubaThreshold) {
+      scratch = Isolate::Current()->current_zone()->Alloc<Chunk>(
+          MultiplyScratchLength(a_length, b_length));
     }
-    result.SetChunkAt(i, static_cast<Chunk>(accumulator & kDigitMask));
-    accumulator >>= kDigitBitSize;
+    MultiplyDigits(a.ChunkAddr(0), a_length, b.ChunkAddr(0), b_length,
+                   result.ChunkAddr(0), scratch);
   }
-  ASSERT(accumulator == 0);
-
   Clamp(result);
   return result.raw();
 }
@@ -839,7 +676,7 @@ RawBigint* BigintOperations::ShiftLeft(const Bigint& bigint, intptr_t amount) {
     Chunk carry = 0;
     for (intptr_t i = 0; i < bigint_length; i++) {
       Chunk digit = bigint.GetChunkAt(i);
-      Chunk shifted_digit = ((digit << bit_shift) & kDigitMask) + carry;
+      Chunk shifted_digit = (digit << bit_shift) | carry;
       result.SetChunkAt(i + digit_shift, shifted_digit);
       carry = digit >> (kDigitBitSize - bit_shift);
     }
@@ -880,9 +717,9 @@ RawBigint* BigintOperations::ShiftRight(const Bigint& bigint, intptr_t amount) {
     Chunk carry = 0;
     for (intptr_t i = bigint_length - 1; i >= digit_shift; i--) {
       Chunk digit = bigint.GetChunkAt(i);
-      Chunk shifted_digit = (digit >> bit_shift) + carry;
+      Chunk shifted_digit = (digit >> bit_shift) | carry;
       result.SetChunkAt(i - digit_shift, shifted_digit);
-      carry = (digit << (kDigitBitSize - bit_shift)) & kDigitMask;
+      carry = digit << (kDigitBitSize - bit_shift);
     }
     Clamp(result);
   }
@@ -956,13 +793,12 @@ RawBigint* BigintOperations::BitAnd(const Bigint& a, const Bigint& b) {
     const Bigint& result = Bigint::Handle(Bigint::Allocate(result_length));
     Chunk borrow = 1;
     for (intptr_t i = 0; i < min_length; i++) {
-      Chunk b_digit = b.GetChunkAt(i) - borrow;
-      result.SetChunkAt(i, a.GetChunkAt(i) & (~b_digit) & kDigitMask);
-      borrow = b_digit >> (kChunkBitSize - 1);
+      Chunk b_digit = SubtractBorrow(b.GetChunkAt(i), &borrow);
+      result.SetChunkAt(i, a.GetChunkAt(i) & (~b_digit));
     }
     for (intptr_t i = min_length; i < a_length; i++) {
-      result.SetChunkAt(i, a.GetChunkAt(i) & (kDigitMaxValue - borrow));
-      borrow = 0;
+      Chunk b_digit = SubtractBorrow(0, &borrow);
+      result.SetChunkAt(i, a.GetChunkAt(i) & (~b_digit));
     }
     Clamp(result);
     return result.raw();
@@ -984,27 +820,21 @@ RawBigint* BigintOperations::BitAnd(const Bigint& a, const Bigint& b) {
   Chunk result_carry = 1;
   ASSERT(a_length >= b_length);
   for (intptr_t i = 0; i < b_length; i++) {
-    Chunk a_digit = a.GetChunkAt(i) - a_borrow;
-    Chunk b_digit = b.GetChunkAt(i) - b_borrow;
-    Chunk result_chunk = ((a_digit | b_digit) & kDigitMask) + result_carry;
-    result.SetChunkAt(i, result_chunk & kDigitMask);
-    a_borrow = a_digit >> (kChunkBitSize - 1);
-    b_borrow = b_digit >> (kChunkBitSize - 1);
-    result_carry = result_chunk >> kDigitBitSize;
+    Chunk a_digit = SubtractBorrow(a.GetChunkAt(i), &a_borrow);
+    Chunk b_digit = SubtractBorrow(b.GetChunkAt(i), &b_borrow);
+    Chunk result_chunk = AddCarry(a_digit | b_digit, &result_carry);
+    result.SetChunkAt(i, result_chunk);
   }
   for (intptr_t i = b_length; i < a_length; i++) {
-    Chunk a_digit = a.GetChunkAt(i) - a_borrow;
-    Chunk b_digit = -b_borrow;
-    Chunk result_chunk = ((a_digit | b_digit) & kDigitMask) + result_carry;
-    result.SetChunkAt(i, result_chunk & kDigitMask);
-    a_borrow = a_digit >> (kChunkBitSize - 1);
-    b_borrow = 0;
-    result_carry = result_chunk >> kDigitBitSize;
+    Chunk a_digit = SubtractBorrow(a.GetChunkAt(i), &a_borrow);
+    Chunk b_digit = SubtractBorrow(0, &b_borrow);
+    Chunk result_chunk = AddCarry(a_digit | b_digit, &result_carry);
+    result.SetChunkAt(i, result_chunk);
   }
   Chunk a_digit = -a_borrow;
   Chunk b_digit = -b_borrow;
-  Chunk result_chunk = ((a_digit | b_digit) & kDigitMask) + result_carry;
-  result.SetChunkAt(a_length, result_chunk & kDigitMask);
+  Chunk result_chunk = AddCarry(a_digit | b_digit, &result_carry);
+  result.SetChunkAt(a_length, result_chunk);
   Clamp(result);
   return result.raw();
 }
@@ -1065,19 +895,14 @@ RawBigint* BigintOperations::BitOr(const Bigint& a, const Bigint& b) {
     Chunk result_carry = 1;
     for (intptr_t i = 0; i < min_length; i++) {
       Chunk a_digit = a.GetChunkAt(i);
-      Chunk b_digit = b.GetChunkAt(i) - borrow;
-      Chunk result_digit = ((~a_digit) & b_digit & kDigitMask) + result_carry;
-      result.SetChunkAt(i, result_digit & kDigitMask);
-      borrow = b_digit >> (kChunkBitSize - 1);
-      result_carry = result_digit >> kDigitBitSize;
+      Chunk b_digit = SubtractBorrow(b.GetChunkAt(i), &borrow);
+      Chunk result_digit = AddCarry((~a_digit) & b_digit, &result_carry);
+      result.SetChunkAt(i, result_digit);
     }
-    ASSERT(result_carry == 0);
     for (intptr_t i = min_length; i < b_length; i++) {
-      Chunk b_digit = b.GetChunkAt(i) - borrow;
-      Chunk result_digit = (b_digit & kDigitMask) + result_carry;
-      result.SetChunkAt(i, result_digit & kDigitMask);
-      borrow = b_digit >> (kChunkBitSize - 1);
-      result_carry = result_digit >> kDigitBitSize;
+      Chunk b_digit = SubtractBorrow(b.GetChunkAt(i), &borrow);
+      Chunk result_digit = AddCarry(b_digit, &result_carry);
+      result.SetChunkAt(i, result_digit);
     }
     ASSERT(result_carry == 0);
     Clamp(result);
@@ -1101,13 +926,10 @@ RawBigint* BigintOperations::BitOr(const Bigint& a, const Bigint& b) {
   Chunk b_borrow = 1;
   Chunk result_carry = 1;
   for (intptr_t i = 0; i < b_length; i++) {
-    Chunk a_digit = a.GetChunkAt(i) - a_borrow;
-    Chunk b_digit = b.GetChunkAt(i) - b_borrow;
-    Chunk result_chunk = ((a_digit & b_digit) & kDigitMask) + result_carry;
-    result.SetChunkAt(i, result_chunk & kDigitMask);
-    a_borrow = a_digit >> (kChunkBitSize - 1);
-    b_borrow = b_digit >> (kChunkBitSize - 1);
-    result_carry = result_chunk >> kDigitBitSize;
+    Chunk a_digit = SubtractBorrow(a.GetChunkAt(i), &a_borrow);
+    Chunk b_digit = SubtractBorrow(b.GetChunkAt(i), &b_borrow);
+    Chunk result_chunk = AddCarry(a_digit & b_digit, &result_carry);
+    result.SetChunkAt(i, result_chunk);
   }
   result.SetChunkAt(b_length, result_carry);
   Clamp(result);
@@ -1173,29 +995,21 @@ RawBigint* BigintOperations::BitXor(const Bigint& a, const Bigint& b) {
     Chunk result_carry = 1;
     for (intptr_t i = 0; i < min_length; i++) {
       Chunk a_digit = a.GetChunkAt(i);
-      Chunk b_digit = b.GetChunkAt(i) - borrow;
-      Chunk result_digit =
-          ((~(a_digit ^ ~b_digit)) & kDigitMask) + result_carry;
-      result.SetChunkAt(i, result_digit & kDigitMask);
-      borrow = b_digit >> (kChunkBitSize - 1);
-      result_carry = result_digit >> kDigitBitSize;
+      Chunk b_digit = SubtractBorrow(b.GetChunkAt(i), &borrow);
+      Chunk result_digit = AddCarry(~(a_digit ^ ~b_digit), &result_carry);
+      result.SetChunkAt(i, result_digit);
     }
     for (intptr_t i = min_length; i < a_length; i++) {
       Chunk a_digit = a.GetChunkAt(i);
-      Chunk b_digit = -borrow;
-      Chunk result_digit =
-          ((~(a_digit ^ ~b_digit)) & kDigitMask) + result_carry;
-      result.SetChunkAt(i, result_digit & kDigitMask);
-      borrow = b_digit >> (kChunkBitSize - 1);
-      result_carry = result_digit >> kDigitBitSize;
+      Chunk b_digit = SubtractBorrow(0, &borrow);
+      Chunk result_digit = AddCarry(~(a_digit ^ ~b_digit), &result_carry);
+      result.SetChunkAt(i, result_digit);
     }
     for (intptr_t i = min_length; i < b_length; i++) {
       // a_digit = 0.
-      Chunk b_digit = b.GetChunkAt(i) - borrow;
-      Chunk result_digit = (b_digit & kDigitMask) + result_carry;
-      result.SetChunkAt(i, result_digit & kDigitMask);
-      borrow = b_digit >> (kChunkBitSize - 1);
-      result_carry = result_digit >> kDigitBitSize;
+      Chunk b_digit = SubtractBorrow(b.GetChunkAt(i), &borrow);
+      Chunk result_digit = AddCarry(b_digit, &result_carry);
+      result.SetChunkAt(i, result_digit);
     }
     result.SetChunkAt(max_length, result_carry);
     Clamp(result);
@@ -1215,19 +1029,16 @@ RawBigint* BigintOperations::BitXor(const Bigint& a, const Bigint& b) {
   Chunk a_borrow = 1;
   Chunk b_borrow = 1;
   for (intptr_t i = 0; i < b_length; i++) {
-    Chunk a_digit = a.GetChunkAt(i) - a_borrow;
-    Chunk b_digit = b.GetChunkAt(i) - b_borrow;
+    Chunk a_digit = SubtractBorrow(a.GetChunkAt(i), &a_borrow);
+    Chunk b_digit = SubtractBorrow(b.GetChunkAt(i), &b_borrow);
     Chunk result_chunk = (~a_digit) ^ (~b_digit);
-    result.SetChunkAt(i, result_chunk & kDigitMask);
-    a_borrow = a_digit >> (kChunkBitSize - 1);
-    b_borrow = b_digit >> (kChunkBitSize - 1);
+    result.SetChunkAt(i, result_chunk);
   }
   ASSERT(b_borrow == 0);
   for (intptr_t i = b_length; i < a_length; i++) {
-    Chunk a_digit = a.GetChunkAt(i) - a_borrow;
+    Chunk a_digit = SubtractBorrow(a.GetChunkAt(i), &a_borrow);
     // (~a_digit) ^ 0xFFF..FFF == a_digit.
-    result.SetChunkAt(i, a_digit & kDigitMask);
-    a_borrow = a_digit >> (kChunkBitSize - 1);
+    result.SetChunkAt(i, a_digit);
   }
   ASSERT(a_borrow == 0);
   Clamp(result);
@@ -1250,6 +1061,170 @@ RawBigint* BigintOperations::BitNot(const Bigint& bigint) {
 }
 
 
+RawBigint* BigintOperations::ModPow(const Bigint& base,
+                                    const Bigint& exponent,
+                                    const Bigint& modulus) {
+  ASSERT(IsClamped(base));
+  ASSERT(IsClamped(exponent));
+  ASSERT(IsClamped(modulus));
+  ASSERT(!exponent.IsNegative());
+  ASSERT(!modulus.IsNegative() && !modulus.IsZero());
+
+  const Bigint& one = Bigint::Handle(One());
+  if (UnsignedCompare(modulus, one) == 0) {
+    return Zero();
+  }
+  Bigint& x = Bigint::Handle(Modulo(base, modulus));
+  ASSERT(!x.IsNegative());
+
+  if ((modulus.GetChunkAt(0) & 1) == 0) {
+    // Montgomery multiplication requires an odd modulus. Fall back to
+    // squaring and reducing with a division.
+    Bigint& result = Bigint::Handle(One());
+    for (intptr_t i = exponent.Length() - 1; i >= 0; i--) {
+      Chunk digit = exponent.GetChunkAt(i);
+      for (int bit = kDigitBitSize - 1; bit >= 0; bit--) {
+        result = Multiply(result, result);
+        result = Remainder(result, modulus);
+        if (((digit >> bit) & 1) != 0) {
+          result = Multiply(result, x);
+          result = Remainder(result, modulus);
+        }
+      }
+    }
+    return result.raw();
+  }
+
+  // Work on the Montgomery forms v * R mod modulus of the values, with
+  // R = 2^(length * kDigitBitSize). Their products only need a reduction by
+  // R, which is a shift, instead of a division by the modulus.
+  intptr_t length = modulus.Length();
+  const Bigint& r_mod = Bigint::Handle(
+      Remainder(Bigint::Handle(ShiftLeft(one, length * kDigitBitSize)),
+                modulus));
+  x = ShiftLeft(x, length * kDigitBitSize);
+  x = Remainder(x, modulus);
+  const Bigint& result = Bigint::Handle(Bigint::Allocate(length));
+
+  NoGCScope no_gc;
+  Zone* zone = Isolate::Current()->current_zone();
+  const Chunk* m = modulus.ChunkAddr(0);
+  // Compute -1/m mod 2^kDigitBitSize with Newton's iteration. Each step
+  // doubles the number of correct low bits, starting with 3 since m * m == 1
+  // (mod 8) for odd m.
+  Chunk m_inverse = m[0];
+  for (int i = 0; i < 4; i++) {
+    m_inverse *= 2 - m[0] * m_inverse;
+  }
+  m_inverse = -m_inverse;
+
+  // Exponentiate with fixed windows of kWindowBits bits, using precomputed
+  // powers x^0 .. x^(2^kWindowBits - 1).
+  const int kWindowBits = 4;
+  const intptr_t kWindowPowers = 1 << kWindowBits;
+  ASSERT(kDigitBitSize % kWindowBits == 0);
+  Chunk* powers = zone->Alloc<Chunk>(kWindowPowers * length);
+  for (intptr_t i = 0; i < 2 * length; i++) {
+    powers[i] = 0;
+  }
+  intptr_t r_mod_length = r_mod.Length();
+  for (intptr_t i = 0; i < r_mod_length; i++) {
+    powers[i] = r_mod.GetChunkAt(i);
+  }
+  intptr_t x_length = x.Length();
+  for (intptr_t i = 0; i < x_length; i++) {
+    powers[length + i] = x.GetChunkAt(i);
+  }
+  Chunk* scratch = zone->Alloc<Chunk>(length + 2);
+  for (intptr_t i = 2; i < kWindowPowers; i++) {
+    MontgomeryMultiply(powers + (i - 1) * length, powers + length,
+                       m, length, m_inverse,
+                       powers + i * length, scratch);
+  }
+
+  Chunk* accumulator = zone->Alloc<Chunk>(length);
+  memmove(accumulator, powers, length * kChunkSize);
+  bool started = false;
+  for (intptr_t i = exponent.Length() - 1; i >= 0; i--) {
+    Chunk digit = exponent.GetChunkAt(i);
+    for (int shift = kDigitBitSize - kWindowBits; shift >= 0;
+         shift -= kWindowBits) {
+      intptr_t window = (digit >> shift) & (kWindowPowers - 1);
+      if (started) {
+        for (int j = 0; j < kWindowBits; j++) {
+          MontgomeryMultiply(accumulator, accumulator, m, length, m_inverse,
+                             accumulator, scratch);
+        }
+        if (window != 0) {
+          MontgomeryMultiply(accumulator, powers + window * length,
+                             m, length, m_inverse, accumulator, scratch);
+        }
+      } else if (window != 0) {
+        memmove(accumulator, powers + window * length, length * kChunkSize);
+        started = true;
+      }
+    }
+  }
+
+  // Leave the Montgomery form by multiplying with 1.
+  Chunk* plain_one = powers + length;
+  plain_one[0] = 1;
+  for (intptr_t i = 1; i < length; i++) {
+    plain_one[i] = 0;
+  }
+  MontgomeryMultiply(accumulator, plain_one, m, length, m_inverse,
+                     result.ChunkAddr(0), scratch);
+  Clamp(result);
+  return result.raw();
+}
+
+
+void BigintOperations::MontgomeryMultiply(const Chunk* x, const Chunk* y,
+                                          const Chunk* m, intptr_t length,
+                                          Chunk m_inverse,
+                                          Chunk* result, Chunk* scratch) {
+  // Interleaves the multiplication with the reduction, one digit of x at a
+  // time. The intermediate value t stays below 2 * m.
+  Chunk* t = scratch;
+  for (intptr_t i = 0; i < length + 2; i++) {
+    t[i] = 0;
+  }
+  for (intptr_t i = 0; i < length; i++) {
+    // t += x[i] * y.
+    DoubleChunk digit = x[i];
+    DoubleChunk carry = 0;
+    for (intptr_t j = 0; j < length; j++) {
+      carry += digit * y[j] + t[j];
+      t[j] = static_cast<Chunk>(carry);
+      carry >>= kDigitBitSize;
+    }
+    carry += t[length];
+    t[length] = static_cast<Chunk>(carry);
+    t[length + 1] = static_cast<Chunk>(carry >> kDigitBitSize);
+
+    // t = (t + q * m) / beta, where q makes the lowest digit vanish.
+    DoubleChunk q = static_cast<Chunk>(t[0] * m_inverse);
+    carry = q * m[0] + t[0];
+    ASSERT(static_cast<Chunk>(carry) == 0);
+    carry >>= kDigitBitSize;
+    for (intptr_t j = 1; j < length; j++) {
+      carry += q * m[j] + t[j];
+      t[j - 1] = static_cast<Chunk>(carry);
+      carry >>= kDigitBitSize;
+    }
+    carry += t[length];
+    t[length - 1] = static_cast<Chunk>(carry);
+    t[length] = t[length + 1] + static_cast<Chunk>(carry >> kDigitBitSize);
+    t[length + 1] = 0;
+  }
+  if ((t[length] != 0) || (CompareDigits(t, m, length) >= 0)) {
+    SubtractDigits(t, length, m, length, result);
+  } else {
+    memmove(result, t, length * kChunkSize);
+  }
+}
+
+
 int BigintOperations::Compare(const Bigint& a, const Bigint& b) {
   bool a_is_negative = a.IsNegative();
   bool b_is_negative = b.IsNegative();
@@ -1356,29 +1331,6 @@ int BigintOperations::UnsignedCompare(const Bigint& a, const Bigint& b) {
 }
 
 
-int BigintOperations::UnsignedCompareNonClamped(
-    const Bigint& a, const Bigint& b) {
-  intptr_t a_length = a.Length();
-  intptr_t b_length = b.Length();
-  while (a_length > b_length) {
-    if (a.GetChunkAt(a_length - 1) != 0) return 1;
-    a_length--;
-  }
-  while (b_length > a_length) {
-    if (b.GetChunkAt(b_length - 1) != 0) return -1;
-    b_length--;
-  }
-  for (intptr_t i = a_length - 1; i >= 0; i--) {
-    Chunk digit_a = a.GetChunkAt(i);
-    Chunk digit_b = b.GetChunkAt(i);
-    if (digit_a < digit_b) return -1;
-    if (digit_a > digit_b) return 1;
-    // Else look at the next digit.
-  }
-  return 0;  // They are equal.
-}
-
-
 RawBigint* BigintOperations::UnsignedAdd(const Bigint& a, const Bigint& b) {
   ASSERT(IsClamped(a));
   ASSERT(IsClamped(b));
@@ -1394,20 +1346,11 @@ RawBigint* BigintOperations::UnsignedAdd(const Bigint& a, const Bigint& b) {
   intptr_t result_length = a_length + 1;
   const Bigint& result = Bigint::Handle(Bigint::Allocate(result_length));
 
-  Chunk carry = 0;
+  NoGCScope no_gc;
   // b has fewer digits than a.
   ASSERT(b_length <= a_length);
-  for (intptr_t i = 0; i < b_length; i++) {
-    Chunk sum = a.GetChunkAt(i) + b.GetChunkAt(i) + carry;
-    result.SetChunkAt(i, sum & kDigitMask);
-    carry = sum >> kDigitBitSize;
-  }
-  // Copy over the remaining digits of a, but don't forget the carry.
-  for (intptr_t i = b_length; i < a_length; i++) {
-    Chunk sum = a.GetChunkAt(i) + carry;
-    result.SetChunkAt(i, sum & kDigitMask);
-    carry = sum >> kDigitBitSize;
-  }
+  Chunk carry = AddDigits(DigitsOf(a), a_length, DigitsOf(b), b_length,
+                          result.ChunkAddr(0));
   // Shrink the result if there was no overflow. Otherwise apply the carry.
   if (carry == 0) {
     // TODO(floitsch): We change the size of bigint-objects here.
@@ -1426,8 +1369,6 @@ RawBigint* BigintOperations::UnsignedSubtract(const Bigint& a,
   ASSERT(IsClamped(b));
   ASSERT(UnsignedCompare(a, b) >= 0);
 
-  const int kSignBitPos = Bigint::kChunkSize * kBitsPerByte - 1;
-
   intptr_t a_length = a.Length();
   intptr_t b_length = b.Length();
 
@@ -1436,44 +1377,290 @@ RawBigint* BigintOperations::UnsignedSubtract(const Bigint& a,
   intptr_t result_length = a_length;
   const Bigint& result = Bigint::Handle(Bigint::Allocate(result_length));
 
-  Chunk borrow = 0;
+  NoGCScope no_gc;
   ASSERT(b_length <= a_length);
+  Chunk borrow = SubtractDigits(DigitsOf(a), a_length, DigitsOf(b), b_length,
+                                DigitsOf(result));
+  ASSERT(borrow == 0);
+  Clamp(result);
+  return result.raw();
+}
+
+
+BigintOperations::Chunk BigintOperations::AddDigits(
+    const Chunk* a, intptr_t a_length,
+    const Chunk* b, intptr_t b_length,
+    Chunk* result) {
+  ASSERT(a_length >= b_length);
+  DoubleChunk carry = 0;
   for (intptr_t i = 0; i < b_length; i++) {
-    Chunk difference = a.GetChunkAt(i) - b.GetChunkAt(i) - borrow;
-    result.SetChunkAt(i, difference & kDigitMask);
-    borrow = difference >> kSignBitPos;
-    ASSERT((borrow == 0) || (borrow == 1));
+    carry += static_cast<DoubleChunk>(a[i]) + b[i];
+    result[i] = static_cast<Chunk>(carry);
+    carry >>= kDigitBitSize;
   }
-  // Copy over the remaining digits of a, but don't forget the borrow.
   for (intptr_t i = b_length; i < a_length; i++) {
-    Chunk difference = a.GetChunkAt(i) - borrow;
-    result.SetChunkAt(i, difference & kDigitMask);
-    borrow = (difference >> kSignBitPos);
-    ASSERT((borrow == 0) || (borrow == 1));
+    carry += a[i];
+    result[i] = static_cast<Chunk>(carry);
+    carry >>= kDigitBitSize;
+  }
+  return static_cast<Chunk>(carry);
+}
+
+
+BigintOperations::Chunk BigintOperations::SubtractDigits(
+    const Chunk* a, intptr_t a_length,
+    const Chunk* b, intptr_t b_length,
+    Chunk* result) {
+  ASSERT(a_length >= b_length);
+  // A negative difference wraps around and sets all the upper bits.
+  Chunk borrow = 0;
+  for (intptr_t i = 0; i < b_length; i++) {
+    DoubleChunk difference = static_cast<DoubleChunk>(a[i]) - b[i] - borrow;
+    result[i] = static_cast<Chunk>(difference);
+    borrow = static_cast<Chunk>(difference >> kDigitBitSize) & 1;
+  }
+  for (intptr_t i = b_length; i < a_length; i++) {
+    DoubleChunk difference = static_cast<DoubleChunk>(a[i]) - borrow;
+    result[i] = static_cast<Chunk>(difference);
+    borrow = static_cast<Chunk>(difference >> kDigitBitSize) & 1;
+  }
+  return borrow;
+}
+
+
+int BigintOperations::CompareDigits(const Chunk* a,
+                                    const Chunk* b,
+                                    intptr_t length) {
+  for (intptr_t i = length - 1; i >= 0; i--) {
+    if (a[i] < b[i]) return -1;
+    if (a[i] > b[i]) return 1;
+  }
+  return 0;
+}
+
+
+void BigintOperations::MultiplyDigits(const Chunk* a, intptr_t a_length,
+                                      const Chunk* b, intptr_t b_length,
+                                      Chunk* result, Chunk* scratch) {
+  if (a_length < b_length) {
+    MultiplyDigits(b, b_length, a, a_length, result, scratch);
+    return;
+  }
+  if (b_length < kKaratsubaThreshold) {
+    SchoolbookMultiply(a, a_length, b, b_length, result);
+    return;
   }
+  if (a_length < 2 * b_length) {
+    KaratsubaMultiply(a, a_length, b, b_length, result, scratch);
+    return;
+  }
+  // The operands are unbalanced. Multiply b with slices of a that have as
+  // many digits as b, and add up the products.
+  for (intptr_t i = 0; i < a_length + b_length; i++) {
+    result[i] = 0;
+  }
+  Chunk* product = scratch;
+  scratch += 2 * b_length;
+  for (intptr_t i = 0; i < a_length; i += b_length) {
+    intptr_t slice_length = Utils::Minimum(b_length, a_length - i);
+    intptr_t product_length = slice_length + b_length;
+    MultiplyDigits(a + i, slice_length, b, b_length, product, scratch);
+    Chunk carry = AddDigits(result + i, product_length,
+                            product, product_length,
+                            result + i);
+    ASSERT(carry == 0);
+  }
+}
+
+
+// The Karatsuba multiplication of a node with n digits uses less than
+// 2 * n + 8 digits and recurses on operands with at most n / 2 + 2 digits.
+// Unbalanced operands use less. The scratch space needed by all levels of
+// the recursion hence stays below 4 * n digits plus a few digits per level.
+intptr_t BigintOperations::MultiplyScratchLength(intptr_t a_length,
+                                                 intptr_t b_length) {
+  return 4 * (a_length + b_length) + 16 * kBitsPerWord;
+}
+
+
+void BigintOperations::SchoolbookMultiply(const Chunk* a, intptr_t a_length,
+                                          const Chunk* b, intptr_t b_length,
+                                          Chunk* result) {
+  for (intptr_t i = 0; i < a_length + b_length; i++) {
+    result[i] = 0;
+  }
+  // Each step computes at most (beta - 1)^2 + 2 * (beta - 1) with
+  // beta = 2^kDigitBitSize, which fits into a DoubleChunk.
+  for (intptr_t i = 0; i < b_length; i++) {
+    DoubleChunk digit = b[i];
+    if (digit == 0) continue;
+    DoubleChunk carry = 0;
+    Chunk* row = result + i;
+    for (intptr_t j = 0; j < a_length; j++) {
+      carry += digit * a[j] + row[j];
+      row[j] = static_cast<Chunk>(carry);
+      carry >>= kDigitBitSize;
+    }
+    row[a_length] = static_cast<Chunk>(carry);
+  }
+}
+
+
+void BigintOperations::KaratsubaMultiply(const Chunk* a, intptr_t a_length,
+                                         const Chunk* b, intptr_t b_length,
+                                         Chunk* result, Chunk* scratch) {
+  // Split a = a1 * beta^half + a0 and b = b1 * beta^half + b0. Then
+  //   a * b = z2 * beta^(2 * half) + z1 * beta^half + z0
+  // with z0 = a0 * b0, z2 = a1 * b1 and
+  //   z1 = (a0 + a1) * (b0 + b1) - z0 - z2.
+  ASSERT(a_length >= b_length);
+  intptr_t half = a_length / 2;
+  ASSERT(b_length > half);
+  const Chunk* a0 = a;
+  const Chunk* a1 = a + half;
+  intptr_t a1_length = a_length - half;
+  const Chunk* b0 = b;
+  const Chunk* b1 = b + half;
+  intptr_t b1_length = b_length - half;
+  intptr_t result_length = a_length + b_length;
+
+  // z0 and z2 go directly into the lower and upper parts of the result.
+  MultiplyDigits(a0, half, b0, half, result, scratch);
+  MultiplyDigits(a1, a1_length, b1, b1_length, result + 2 * half, scratch);
+
+  intptr_t a_sum_length = a1_length + 1;
+  Chunk* a_sum = scratch;
+  a_sum[a1_length] = AddDigits(a1, a1_length, a0, half, a_sum);
+  intptr_t b_sum_length = Utils::Maximum(half, b1_length) + 1;
+  Chunk* b_sum = a_sum + a_sum_length;
+  if (b1_length >= half) {
+    b_sum[b1_length] = AddDigits(b1, b1_length, b0, half, b_sum);
+  } else {
+    b_sum[half] = AddDigits(b0, half, b1, b1_length, b_sum);
+  }
+  intptr_t z1_length = a_sum_length + b_sum_length;
+  Chunk* z1 = b_sum + b_sum_length;
+  MultiplyDigits(a_sum, a_sum_length, b_sum, b_sum_length,
+                 z1, z1 + z1_length);
+  Chunk borrow = SubtractDigits(z1, z1_length, result, 2 * half, z1);
   ASSERT(borrow == 0);
-  Clamp(result);
-  return result.raw();
+  borrow = SubtractDigits(z1, z1_length,
+                          result + 2 * half, result_length - 2 * half, z1);
+  ASSERT(borrow == 0);
+  while ((z1_length > 0) && (z1[z1_length - 1] == 0)) {
+    z1_length--;
+  }
+  Chunk carry = AddDigits(result + half, result_length - half,
+                          z1, z1_length,
+                          result + half);
+  ASSERT(carry == 0);
 }
 
 
-RawBigint* BigintOperations::MultiplyWithDigit(
-    const Bigint& bigint, Chunk digit) {
-  // TODO(floitsch): implement MultiplyWithDigit.
-  ASSERT(digit <= kDigitMaxValue);
-  if (digit == 0) return Zero();
+BigintOperations::Chunk BigintOperations::DivideDigitsByDigit(
+    Chunk* digits, intptr_t length, Chunk divisor) {
+  ASSERT(divisor != 0);
+  DoubleChunk remainder = 0;
+  for (intptr_t i = length - 1; i >= 0; i--) {
+    DoubleChunk dividend = (remainder << kDigitBitSize) | digits[i];
+    digits[i] = static_cast<Chunk>(dividend / divisor);
+    remainder = dividend % divisor;
+  }
+  return static_cast<Chunk>(remainder);
+}
 
-  Bigint& tmp = Bigint::Handle(Bigint::Allocate(1));
-  tmp.SetChunkAt(0, digit);
-  return Multiply(bigint, tmp);
+
+void BigintOperations::DivideDigits(const Chunk* a, intptr_t a_length,
+                                    const Chunk* b, intptr_t b_length,
+                                    Chunk* quotient, Chunk* remainder) {
+  // Knuth's algorithm D (The Art of Computer Programming, Vol. 2, 4.3.1).
+  ASSERT(b_length > 1);
+  ASSERT(a_length >= b_length);
+  ASSERT(b[b_length - 1] != 0);
+  const DoubleChunk kBase = static_cast<DoubleChunk>(1) << kDigitBitSize;
+
+  // Normalize the operands so that the most significant digit of the divisor
+  // has its highest bit set. The quotient digit estimates are then off by at
+  // most two.
+  Zone* zone = Isolate::Current()->current_zone();
+  Chunk* divisor = zone->Alloc<Chunk>(b_length);
+  Chunk* dividend = zone->Alloc<Chunk>(a_length + 1);
+  int shift = kDigitBitSize - CountBits(b[b_length - 1]);
+  if (shift == 0) {
+    memmove(divisor, b, b_length * kChunkSize);
+    memmove(dividend, a, a_length * kChunkSize);
+    dividend[a_length] = 0;
+  } else {
+    for (intptr_t i = b_length - 1; i > 0; i--) {
+      divisor[i] = (b[i] << shift) | (b[i - 1] >> (kDigitBitSize - shift));
+    }
+    divisor[0] = b[0] << shift;
+    dividend[a_length] = a[a_length - 1] >> (kDigitBitSize - shift);
+    for (intptr_t i = a_length - 1; i > 0; i--) {
+      dividend[i] = (a[i] << shift) | (a[i - 1] >> (kDigitBitSize - shift));
+    }
+    dividend[0] = a[0] << shift;
+  }
+
+  DoubleChunk divisor_high = divisor[b_length - 1];
+  DoubleChunk divisor_next = divisor[b_length - 2];
+  for (intptr_t j = a_length - b_length; j >= 0; j--) {
+    // Estimate the quotient digit from the two leading digits of the
+    // remaining dividend and correct it with the next digits.
+    Chunk* window = dividend + j;
+    DoubleChunk leading =
+        (static_cast<DoubleChunk>(window[b_length]) << kDigitBitSize) |
+        window[b_length - 1];
+    DoubleChunk estimate = leading / divisor_high;
+    DoubleChunk rest = leading % divisor_high;
+    while ((estimate >= kBase) ||
+           (estimate * divisor_next >
+            ((rest << kDigitBitSize) | window[b_length - 2]))) {
+      estimate--;
+      rest += divisor_high;
+      if (rest >= kBase) break;
+    }
+
+    // Subtract estimate * divisor from the window.
+    DoubleChunk carry = 0;
+    Chunk borrow = 0;
+    for (intptr_t i = 0; i < b_length; i++) {
+      carry += estimate * divisor[i];
+      DoubleChunk difference =
+          static_cast<DoubleChunk>(window[i]) -
+          static_cast<Chunk>(carry) - borrow;
+      window[i] = static_cast<Chunk>(difference);
+      borrow = static_cast<Chunk>(difference >> kDigitBitSize) & 1;
+      carry >>= kDigitBitSize;
+    }
+    DoubleChunk difference =
+        static_cast<DoubleChunk>(window[b_length]) - carry - borrow;
+    window[b_length] = static_cast<Chunk>(difference);
+
+    if ((difference >> kDigitBitSize) != 0) {
+      // The estimate was one too big. Add the divisor back.
+      estimate--;
+      Chunk add_carry = AddDigits(window, b_length, divisor, b_length, window);
+      window[b_length] += add_carry;
+    }
+    quotient[j] = static_cast<Chunk>(estimate);
+  }
+
+  // The remainder is the rest of the dividend, shifted back.
+  if (shift == 0) {
+    memmove(remainder, dividend, b_length * kChunkSize);
+  } else {
+    for (intptr_t i = 0; i < b_length - 1; i++) {
+      remainder[i] =
+          (dividend[i] >> shift) | (dividend[i + 1] << (kDigitBitSize - shift));
+    }
+    remainder[b_length - 1] = dividend[b_length - 1] >> shift;
+  }
 }
 
 
 void BigintOperations::DivideRemainder(
     const Bigint& a, const Bigint& b, Bigint* quotient, Bigint* remainder) {
-  // TODO(floitsch): This function is very memory-intensive since all
-  // intermediate bigint results are allocated in new memory. It would be
-  // much more efficient to reuse the space of temporary intermediate variables.
   ASSERT(IsClamped(a));
   ASSERT(IsClamped(b));
   ASSERT(!b.IsZero());
@@ -1490,150 +1677,27 @@ void BigintOperations::DivideRemainder(
     return;
   }
 
-  // High level description:
-  // The algorithm is basically the algorithm that is taught in school:
-  // Let a the dividend and b the divisor. We are looking for
-  // the quotient q = truncate(a / b), and
-  // the remainder r = a - q * b.
-  // School algorithm:
-  // q = 0
-  // n = number_of_digits(a) - number_of_digits(b)
-  // for (i = n; i >= 0; i--) {
-  //   Maximize k such that k*y*10^i is less than or equal to a and
-  //                  (k + 1)*y*10^i is greater.
-  //   q = q + k * 10^i   // Add new digit to result.
-  //   a = a - k * b * 10^i
-  // }
-  // r = a
-  //
-  // Instead of working in base 10 we work in base kDigitBitSize.
-
+  intptr_t a_length = a.Length();
   intptr_t b_length = b.Length();
-  int normalization_shift =
-      kDigitBitSize - CountBits(b.GetChunkAt(b_length - 1));
-  Bigint& dividend = Bigint::Handle(ShiftLeft(a, normalization_shift));
-  const Bigint& divisor = Bigint::Handle(ShiftLeft(b, normalization_shift));
-  dividend.SetSign(false);
-  divisor.SetSign(false);
-
-  intptr_t dividend_length = dividend.Length();
-  intptr_t divisor_length = b_length;
-  ASSERT(divisor_length == divisor.Length());
-
-  intptr_t quotient_length = dividend_length - divisor_length + 1;
+  intptr_t quotient_length = a_length - b_length + 1;
   *quotient = Bigint::Allocate(quotient_length);
-  quotient->SetSign(a.IsNegative() != b.IsNegative());
-
-  intptr_t quotient_pos = dividend_length - divisor_length;
-  // Find the first quotient-digit.
-  // The first digit must be computed separately from the other digits because
-  // the preconditions for the loop are not yet satisfied.
-  // For simplicity use a shifted divisor, so that the comparison and
-  // subtraction are easier.
-  int divisor_shift_amount = dividend_length - divisor_length;
-  Bigint& shifted_divisor =
-      Bigint::Handle(DigitsShiftLeft(divisor, divisor_shift_amount));
-  Chunk first_quotient_digit = 0;
-  while (UnsignedCompare(dividend, shifted_divisor) >= 0) {
-    first_quotient_digit++;
-    dividend = Subtract(dividend, shifted_divisor);
-  }
-  quotient->SetChunkAt(quotient_pos--, first_quotient_digit);
-
-  // Find the remainder of the digits.
-
-  Chunk first_divisor_digit = divisor.GetChunkAt(divisor_length - 1);
-  // The short divisor only represents the first two digits of the divisor.
-  // If the divisor has only one digit, then the second part is zeroed out.
-  Bigint& short_divisor = Bigint::Handle(Bigint::Allocate(2));
-  if (divisor_length > 1) {
-    short_divisor.SetChunkAt(0, divisor.GetChunkAt(divisor_length - 2));
-  } else {
-    short_divisor.SetChunkAt(0, 0);
-  }
-  short_divisor.SetChunkAt(1, first_divisor_digit);
-  // The following bigint will be used inside the loop. It is allocated outside
-  // the loop to avoid repeated allocations.
-  Bigint& target = Bigint::Handle(Bigint::Allocate(3));
-  // The dividend_length here must be from the initial dividend.
-  for (intptr_t i = dividend_length - 1; i >= divisor_length; i--) {
-    // Invariant: let t = i - divisor_length
-    //   then dividend / (divisor << (t * kDigitBitSize)) <= kDigitMaxValue.
-    // Ex: dividend: 53451232, and divisor: 535  (with t == 5) is ok.
-    //     dividend: 56822123, and divisor: 563  (with t == 5) is bad.
-    //     dividend:  6822123, and divisor: 563  (with t == 5) is ok.
-
-    // The dividend has changed. So recompute its length.
-    dividend_length = dividend.Length();
-    Chunk dividend_digit;
-    if (i > dividend_length) {
-      quotient->SetChunkAt(quotient_pos--, 0);
-      continue;
-    } else if (i == dividend_length) {
-      dividend_digit = 0;
-    } else {
-      ASSERT(i + 1 == dividend_length);
-      dividend_digit = dividend.GetChunkAt(i);
-    }
-    Chunk quotient_digit;
-    // Compute an estimate of the quotient_digit. The estimate will never
-    // be too small.
-    if (dividend_digit == first_divisor_digit) {
-      // Small shortcut: the else-branch would compute a value > kDigitMaxValue.
-      // However, by hypothesis, we know that the quotient_digit must fit into
-      // a digit. Avoid going through repeated iterations of the adjustment
-      // loop by directly assigning kDigitMaxValue to the quotient_digit.
-      // Ex:  51235 / 523.
-      //    51 / 5 would yield 10 (if computed in the else branch).
-      // However we know that 9 is the maximal value.
-      quotient_digit = kDigitMaxValue;
+  *remainder = Bigint::Allocate(b_length);
+  {
+    NoGCScope no_gc;
+    if (b_length == 1) {
+      Chunk* quotient_digits = quotient->ChunkAddr(0);
+      memmove(quotient_digits, a.ChunkAddr(0), a_length * kChunkSize);
+      remainder->SetChunkAt(0, DivideDigitsByDigit(quotient_digits,
+                                                   a_length,
+                                                   b.GetChunkAt(0)));
     } else {
-      // Compute the estimate by using two digits of the dividend and one of
-      // the divisor.
-      // Ex: 32421 / 535
-      //    32 / 5 -> 6
-      // The estimate would hence be 6.
-      DoubleChunk two_dividend_digits = dividend_digit;
-      two_dividend_digits <<= kDigitBitSize;
-      two_dividend_digits += dividend.GetChunkAt(i - 1);
-      DoubleChunk q = two_dividend_digits / first_divisor_digit;
-      if (q > kDigitMaxValue) q = kDigitMaxValue;
-      quotient_digit = static_cast<Chunk>(q);
+      DivideDigits(a.ChunkAddr(0), a_length, b.ChunkAddr(0), b_length,
+                   quotient->ChunkAddr(0), remainder->ChunkAddr(0));
     }
-
-    // Refine estimation.
-    quotient_digit++;  // The following loop will start by decrementing.
-    Bigint& estimation_product = Bigint::Handle();
-    target.SetChunkAt(0, ((i - 2) < 0) ? 0 : dividend.GetChunkAt(i - 2));
-    target.SetChunkAt(1, ((i - 1) < 0) ? 0 : dividend.GetChunkAt(i - 1));
-    target.SetChunkAt(2, dividend_digit);
-    do {
-      quotient_digit = (quotient_digit - 1) & kDigitMask;
-      estimation_product = MultiplyWithDigit(short_divisor, quotient_digit);
-    } while (UnsignedCompareNonClamped(estimation_product, target) > 0);
-    // At this point the quotient_digit is fairly accurate.
-    // At the worst it is off by one.
-    // Remove a multiple of the divisor. If the estimate is incorrect we will
-    // subtract the divisor another time.
-    // Let t = i - divisor_length.
-    // dividend -= (quotient_digit * divisor) << (t * kDigitBitSize);
-    shifted_divisor = MultiplyWithDigit(divisor, quotient_digit);
-    shifted_divisor = DigitsShiftLeft(shifted_divisor, i - divisor_length);
-    dividend = Subtract(dividend, shifted_divisor);
-    if (dividend.IsNegative()) {
-      // The estimation was still too big.
-      quotient_digit--;
-      // TODO(floitsch): allocate space for the shifted_divisor once and reuse
-      // it at every iteration.
-      shifted_divisor = DigitsShiftLeft(divisor, i - divisor_length);
-      // TODO(floitsch): reuse the space of the previous dividend.
-      dividend = Add(dividend, shifted_divisor);
-    }
-    quotient->SetChunkAt(quotient_pos--, quotient_digit);
   }
-  ASSERT(quotient_pos == -1);
   Clamp(*quotient);
-  *remainder = ShiftRight(dividend, normalization_shift);
+  quotient->SetSign(a.IsNegative() != b.IsNegative());
+  Clamp(*remainder);
   remainder->SetSign(a.IsNegative());
 }
 
@@ -93,6 +93,12 @@ class BigintOperations : public AllStatic {
   static RawBigint* BitXor(const Bigint& a, const Bigint& b);
   static RawBigint* BitNot(const Bigint& bigint);
 
+  // Computes (base ^ exponent) mod modulus. The exponent must not be negative
+  // and the modulus must be positive. The result is never negative.
+  static RawBigint* ModPow(const Bigint& base,
+                           const Bigint& exponent,
+                           const Bigint& modulus);
+
   static int Compare(const Bigint& a, const Bigint& b);
 
   static bool IsClamped(const Bigint& bigint) {
@@ -104,13 +110,17 @@ class BigintOperations : public AllStatic {
   typedef Bigint::Chunk Chunk;
   typedef Bigint::DoubleChunk DoubleChunk;
 
-  static const int kDigitBitSize = 28;
-  static const Chunk kDigitMask = (static_cast<Chunk>(1) << kDigitBitSize) - 1;
-  static const Chunk kDigitMaxValue = kDigitMask;
+  // Digits use all the bits of a chunk. Intermediate results of digit
+  // operations, including carries, are computed in DoubleChunks.
+  static const int kDigitBitSize = 32;
+  static const Chunk kDigitMaxValue = static_cast<Chunk>(-1);
   static const int kChunkSize = sizeof(Chunk);
   static const int kChunkBitSize = kChunkSize * kBitsPerByte;
   static const int kHexCharsPerDigit = kDigitBitSize / 4;
 
+  // Operands with fewer digits are multiplied with the schoolbook method.
+  static const intptr_t kKaratsubaThreshold = 32;
+
   static RawBigint* Zero() { return Bigint::Allocate(0); }
   static RawBigint* One() {
     Bigint& result = Bigint::Handle(Bigint::Allocate(1));
@@ -129,17 +139,80 @@ class BigintOperations : public AllStatic {
                                 bool negate_b);
 
   static int UnsignedCompare(const Bigint& a, const Bigint& b);
-  static int UnsignedCompareNonClamped(const Bigint& a, const Bigint& b);
   static RawBigint* UnsignedAdd(const Bigint& a, const Bigint& b);
   static RawBigint* UnsignedSubtract(const Bigint& a, const Bigint& b);
 
-  static RawBigint* MultiplyWithDigit(const Bigint& bigint, Chunk digit);
-  static RawBigint* DigitsShiftLeft(const Bigint& bigint, intptr_t amount) {
-    return ShiftLeft(bigint, amount * kDigitBitSize);
-  }
   static void DivideRemainder(const Bigint& a, const Bigint& b,
                               Bigint* quotient, Bigint* remainder);
 
+  // The following helpers work on magnitudes given as arrays of digits, least
+  // significant digit first. They must be called inside a NoGCScope when the
+  // digits are those of a bigint. Where a result array is given it may be the
+  // same as the first operand unless stated otherwise.
+
+  // Subtracts the borrow (0 or 1) from the digit and updates the borrow.
+  static Chunk SubtractBorrow(Chunk digit, Chunk* borrow) {
+    Chunk result = digit - *borrow;
+    *borrow = (digit < *borrow) ? 1 : 0;
+    return result;
+  }
+
+  // Adds the carry (0 or 1) to the digit and updates the carry.
+  static Chunk AddCarry(Chunk digit, Chunk* carry) {
+    Chunk result = digit + *carry;
+    *carry = (result < *carry) ? 1 : 0;
+    return result;
+  }
+
+  // Returns the digits of the bigint, or NULL if it is zero.
+  static Chunk* DigitsOf(const Bigint& bigint) {
+    return bigint.IsZero() ? NULL : bigint.ChunkAddr(0);
+  }
+
+  // Stores a + b in the a_length digits of result and returns the carry.
+  // Requires a_length >= b_length.
+  static Chunk AddDigits(const Chunk* a, intptr_t a_length,
+                         const Chunk* b, intptr_t b_length,
+                         Chunk* result);
+  // Stores a - b in the a_length digits of result and returns the borrow.
+  // Requires a_length >= b_length.
+  static Chunk SubtractDigits(const Chunk* a, intptr_t a_length,
+                              const Chunk* b, intptr_t b_length,
+                              Chunk* result);
+  static int CompareDigits(const Chunk* a, const Chunk* b, intptr_t length);
+
+  // Stores a * b in the a_length + b_length digits of result, which must not
+  // overlap the operands. The scratch space must have
+  // MultiplyScratchLength(a_length, b_length) digits.
+  static void MultiplyDigits(const Chunk* a, intptr_t a_length,
+                             const Chunk* b, intptr_t b_length,
+                             Chunk* result, Chunk* scratch);
+  static intptr_t MultiplyScratchLength(intptr_t a_length, intptr_t b_length);
+  static void SchoolbookMultiply(const Chunk* a, intptr_t a_length,
+                                 const Chunk* b, intptr_t b_length,
+                                 Chunk* result);
+  static void KaratsubaMultiply(const Chunk* a, intptr_t a_length,
+                                const Chunk* b, intptr_t b_length,
+                                Chunk* result, Chunk* scratch);
+
+  // Replaces the digits by their quotient by divisor and returns the
+  // remainder.
+  static Chunk DivideDigitsByDigit(Chunk* digits, intptr_t length,
+                                   Chunk divisor);
+  // Stores the quotient of a by b in the a_length - b_length + 1 digits of
+  // quotient and the remainder in the b_length digits of remainder.
+  // Requires b_length > 1 and a non-zero most significant digit of b.
+  static void DivideDigits(const Chunk* a, intptr_t a_length,
+                           const Chunk* b, intptr_t b_length,
+                           Chunk* quotient, Chunk* remainder);
+
+  // Stores x * y / R mod m in result, where R = 2^(length * kDigitBitSize).
+  // The scratch space must have length + 2 digits.
+  static void MontgomeryMultiply(const Chunk* x, const Chunk* y,
+                                 const Chunk* m, intptr_t length,
+                                 Chunk m_inverse,
+                                 Chunk* result, Chunk* scratch);
+
   // Removes leading zero-chunks by adjusting the bigint's length.
   static void Clamp(const Bigint& bigint);
 
@@ -751,6 +751,31 @@ TEST_CASE(BigintDecimalStrings) {
     const char* str = BigintOperations::ToHexCString(bigint, &ZoneAllocator);
     EXPECT_STREQ("-0x123456789ABCDEF0", str);
   }
+
+  {
+    // 3^1000 has more decimal digits than fit into a single chunk.
+    const char* decimal =
+        "132207081948080663689045525975214436596542203275214816766492036822682859"
+        "734670489954077831385060806196390977769687258235595095458210061891186534"
+        "272525795367402762022519832080387801477422896484127439040011758861804112"
+        "894781562309443806156617305408667449050617812548034440554705439703889581"
+        "746536825491613622083026856377858229022841639830788789691855640408489893"
+        "760937324217184635993869551676501894058810906042608967143886410281435038"
+        "5648747165832010614366132173102768902855220001";
+    const Bigint& bigint = Bigint::Handle(
+        BigintOperations::NewFromCString(decimal));
+    const char* str = BigintOperations::ToHexCString(bigint, &ZoneAllocator);
+    EXPECT_STREQ(
+        "0x1F2DD011353698B8240C1D3A8966CB97BD189E62DE18B737A5F2A204C3465C3F4CFB51"
+        "7240C4B0BF6BC8C1C1C23522FDD8144DD38EEAC64B714394E4A0FD910694426DA120A7D3"
+        "48358FCC35338B723A04B9BA8CFE20EDFAC8E6626B458D62CBBA3C979A16B2C373B454C2"
+        "2DE8F3AB1D74BDB0AB340616C35824D1B60A23C10087A8FB1C54063ADDDE0244AB3DF017"
+        "1EEA92C34990F5BCB3B488C83B30A15A606E9C17A8E7AB6CE065BD2A048F32939DC42EC0"
+        "8348318C4940C56F7867DBE5616937BD3B85B21",
+        str);
+    EXPECT_STREQ(decimal,
+                 BigintOperations::ToDecimalCString(bigint, &ZoneAllocator));
+  }
 }
 
 
@@ -2132,6 +2157,124 @@ TEST_CASE(BigintMultiplyDivide) {
       "000000000000000000000000000000000000000000000000000000000000000000000000"
       "0000000000000000000000000000000000000000000000000000000001");
 }
+
+
+TEST_CASE(BigintKaratsuba) {
+  // Operands of at least kKaratsubaThreshold digits are multiplied with
+  // Karatsuba's method, operands of very different lengths in slices.
+  TestBigintMultiplyDivide(
+      "0xA1E91041DFB66C7CAC7212C4FF1D0727BA023794291678C71EE427A88C338232A8DDD9"
+      "ADEF0E8E7AF51F82F83E7AC323A6A737D214F4386C206FA6399A757E3A82B21B8666F7A8"
+      "490F89DFA4CCB4CE8B1AD2F7517CBC27969B142A677C0B6F945D78C3117314B6C006B431"
+      "55FD43815C2A41F03615CBCB0CAD1E4D60426388E7E802B627EF1D8E91579A21C3A39E50"
+      "C191728C541241",
+      "0xD0ACB8463C566D9270D333052252CF535086FFFBD3EA71D5D7A5A3602BF23600926A19"
+      "F4FE3486CD8F9E61405799236397EE1B85E41EF8F259603B8225AA5E70E1E43D7F5D7459"
+      "C3AE43D13ADC3D7748E5E1847B9C15676DC9CB2DDD7D956CE7284EFB847F44AB04B8A8C5"
+      "2C215B2B9A32F0E7D56B620FB877BF35ECBBB29BCA53CAC1981697FB70096",
+      "0x83FA9A5861999AEC3A7E96EFA2844D67E0C101B15CCD8AC43094D1E56B481F0C4CB0EF"
+      "52F9F417A4B600EDF989EA1A97DA616B912F184CF6512652CB587C7BE3353AD8353B2FF1"
+      "E037DD5D7C6487955C64752F1D7D220FA4CB849C3B6C9A9B394D5D40304ED920836AE070"
+      "52951002C084D3307C764CF35AECDF17E2DE8A480534B99608E79F24EA3B429566C64602"
+      "8F02B6316E91DCD4B1E85545C825CDCF9BCC892E0F566E2AB8797212ADA6DC8D82D8BFDD"
+      "4472DDC6E7BF6B20E6427736A5B060527E3ECAE0FCC0DE9875774877049A31FA06310ADF"
+      "6B80BEB9513021259EC6DB745A53AE21D26B7850C48A76BF03E14FCF7A7922BC29C065F2"
+      "540A0884B57527D1C4D288EED007E295112FF9CEBD1F6A90601395DB17DF27BEE84B9B21"
+      "6");
+  TestBigintMultiplyDivide(
+      "0xE2F91A87DB7E69AB127F5A78C718A135FF95191A377E370228E2BA787B951F14160B98"
+      "CD95AA44D8E98D49D6735176CAED6A453818B8D1AD705CC71ED72C0443DD0A138D82988D"
+      "3672CE28F499D283ABDC2AB0C5CEBB5E33A5EF453C174C6E75E5BA2BBC5E23ADD355FB55"
+      "56A48F7676AE889E6B00BE2E61BDD16CAC0715215C06E7BE67183677EDA2DBF4280A984C"
+      "D44B076374878C84FA7457CE1DE743B600032D1C58DD274518B767DC33A7D19D0AC46417"
+      "196DF5CD87938D4FDD6449A1BAEAE5E29FFAAB5E188CB6B629871BB6A391B097146F4CB1"
+      "E9B1D1646BBBA8E5BDCF9F5DF094B49B52A72BF46DD3A506B4EFA340DA46EFAB6328A394"
+      "B127B815CB391F94CF2A1EB1B5923C8000ED918BCAA2106FB3D42E0CD03912525AB7271D"
+      "ACED01706C9073E4777778D49531594FDF5E669F56C423ED1127B30625423D89639AC9B4"
+      "DF6D866D4F784A8CBF67CCE8A5A39A2D47AF059A07E9FBA837950FAB49CCC2770D003164"
+      "A551078496E2ED54486B79F8626C1C1D625E135D71C815BF9302A11975C6180D891C703A"
+      "0B6E2DBCC0C834395451BBA2AAA9C4B15888F4390F78C2126854789ACCFC5FE6BC259B8B"
+      "B839CB0F5F1D77445AC7567A2C1DCF4C1BB2641C177F38412496FC6A8F4A97AB7D9295F1"
+      "7249FD138C18F87D2D5DC8FF9506CFB25346FA25C89BAB5DFFC85339F5D8DFF4D2",
+      "-0xD0ACB8463C566D9270D333052252CF535086FFFBD3EA71D5D7A5A3602BF23600926A1"
+      "9F4FE3486CD8F9E61405799236397EE1B85E41EF8F259603B8225AA5E70E1E43D7F5D745"
+      "9C3AE43D13ADC3D7748E5E1847B9C15676DC9CB2DDD7D956CE7284EFB847F44AB04B8A8C"
+      "52C215B2B9A32F0E7D56B620FB877BF35ECBBB29BCA53CAC1981697FB70096",
+      "-0xB903884D864C18BF85F65479973DCC050BD4A103E65851BE63893B5300821EDFBF9A9"
+      "9BF68AD220B428A3CFEFCE35259EBCA9838652E99594B7794A319CCCD52C0F6D90CCC087"
+      "3D78188639B72E88A6F7D441E0111E005E9EB2E9432F311E5376AEEEA2916608AAC761D6"
+      "4D7C5B0AB45C234691B75DCB1E145ADB06C25DC594B9AC739D5880022EB5D1BF8AC64D38"
+      "468CD94CA60074F0386D024B1C87051D59A2EF28D83AFE1EDEB27E1CC16D7223E36BA2FE"
+      "A2937634BBD4E537226425400F18EFF556102972121EC34418705C7A1AF599B4C2A9E397"
+      "7E5EDCA831B5BD40AB16F6B5B7504A30C6BD0487DA0BAF37EEF2A2BC5DB10BB2C0DA1CB9"
+      "3D9B4BE459FF6FC876DBDA8E28A0C098FC85C70FA1564FA8225D05B2EB75AE46EC66096A"
+      "42DBA8A37125FE11DBBB93CE6F6AB03ED5374F6EA59E0E475E412DB2508CBF8922F09B30"
+      "699C6030B9FE0057D4B39065798FB21FB77481D44FE4029C39E61CA84D00A4541CE3FAAD"
+      "0065BDC5B4DBC109D2F575DF2F8086108019F4BEE692374081F9B6090CD6144DFE192382"
+      "A39E4ABA7370F4B15C164E30311318D235B20323642838CB5B409BC9FF7F50F6414CC015"
+      "9AF9409DC7683552A377DA29FA8A154DD6AD78BDF5769EDCCD8B908843DB9492C9F9F76E"
+      "3274CA8A74E918B4A39F3D494BD29E24DD9EFBD0B84E414394C95F55D91A847F92F1186E"
+      "218A89356F8B0725E02FD083597C66D46521F08D49168E83E4EC00521E70BFEB6515115B"
+      "477123FA2201D397204BB21F59BFCF917D18619D457C9B6CA932B39270D6B065ADFEC9B0"
+      "5D5D2E6B3DE7EFC5E58153F81159F5C2ACC71E67BF05198EE48C8FFD076CDBE908F7FC7D"
+      "32DB2C3248757CE96D74842067E414D7339AD194D454BB4357730C");
+  TestBigintMultiplyDivide(
+      "0xFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF"
+      "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF"
+      "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF"
+      "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF"
+      "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF"
+      "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF"
+      "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF"
+      "FFFFFFFFFF",
+      "0xFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF"
+      "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF"
+      "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF"
+      "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF"
+      "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF"
+      "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF"
+      "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF"
+      "FFFFFFFFFF",
+      "0xFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF"
+      "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF"
+      "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF"
+      "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF"
+      "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF"
+      "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF"
+      "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF"
+      "FFFFFFFFFE00000000000000000000000000000000000000000000000000000000000000"
+      "000000000000000000000000000000000000000000000000000000000000000000000000"
+      "000000000000000000000000000000000000000000000000000000000000000000000000"
+      "000000000000000000000000000000000000000000000000000000000000000000000000"
+      "000000000000000000000000000000000000000000000000000000000000000000000000"
+      "000000000000000000000000000000000000000000000000000000000000000000000000"
+      "000000000000000000000000000000000000000000000000000000000000000000000000"
+      "000000000000000001");
+  TestBigintMultiplyDivide(
+      "0xFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF"
+      "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF"
+      "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF"
+      "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF"
+      "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF"
+      "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF"
+      "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF"
+      "FFFFFFFFFF",
+      "0xFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF"
+      "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF"
+      "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF"
+      "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF",
+      "0xFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF"
+      "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF"
+      "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF"
+      "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEFFFFFFFFFFFFFFFFFFFFFF"
+      "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF"
+      "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF"
+      "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF"
+      "FFFFFFFFFF00000000000000000000000000000000000000000000000000000000000000"
+      "000000000000000000000000000000000000000000000000000000000000000000000000"
+      "000000000000000000000000000000000000000000000000000000000000000000000000"
+      "0000000000000000000000000000000000000000000000000000000001");
+}
 #endif
 
 
@@ -2229,6 +2372,102 @@ TEST_CASE(BigintDivideRemainder) {
       "90123456789012345678901234567890",
       "0x1234567890ABCDEF01234567890ABCDEF01234567890ABCDEF01234567890ABCDEF"
       "01234567890ABCDEE");
+  // The first estimate of a quotient digit is one too large.
+  TestBigintDivideRemainder("0xFFFFFFFFFFFFFFFF80000000FFFFFFFF7FFFFFFF",
+                            "0x8000000100000001FFFFFFFF",
+                            "0x1FFFFFFFBFFFFFFFF",
+                            "0xBFFFFFFFD7FFFFFFE");
+  TestBigintDivideRemainder(
+      "0x83FA9A5861999AEC3A7E96EFA2844D67E0C101B15CCD8AC43094D1E56B481F0C4CB0EF"
+      "52F9F417A4B600EDF989EA1A97DA616B912F184CF6512652CB587C7BE3353AD8353B2FF1"
+      "E037DD5D7C6487955C64752F1D7D220FA4CB849C3B6C9A9B394D5D40304ED920836AE070"
+      "52951002C084D3307C764CF35AECDF17E2DE8A480534B99608E79F24EA3B429566C64602"
+      "8F02B6316E91DCD4B1E85545C825CDCF9BCC893BE46E5418FFE5B7B84CAD7316E2198F73"
+      "C823DC2822D3FBD147A32B3CFC70D746D8E72241231BC40E050A4B491307E9687B3835B9"
+      "077D04CE3181DF0E189C2D1A5EAE19C242FFBC839B59A04D2C7E030B6A3AA70A90117D66"
+      "048CDD9BAB1946A848B4A4B86DAF632C445A032998745FD849BBA64282C4F11218371F99"
+      "7",
+      "0xD0ACB8463C566D9270D333052252CF535086FFFBD3EA71D5D7A5A3602BF23600926A19"
+      "F4FE3486CD8F9E61405799236397EE1B85E41EF8F259603B8225AA5E70E1E43D7F5D7459"
+      "C3AE43D13ADC3D7748E5E1847B9C15676DC9CB2DDD7D956CE7284EFB847F44AB04B8A8C5"
+      "2C215B2B9A32F0E7D56B620FB877BF35ECBBB29BCA53CAC1981697FB70096",
+      "0xA1E91041DFB66C7CAC7212C4FF1D0727BA023794291678C71EE427A88C338232A8DDD9"
+      "ADEF0E8E7AF51F82F83E7AC323A6A737D214F4386C206FA6399A757E3A82B21B8666F7A8"
+      "490F89DFA4CCB4CE8B1AD2F7517CBC27969B142A677C0B6F945D78C3117314B6C006B431"
+      "55FD43815C2A41F03615CBCB0CAD1E4D60426388E7E802B627EF1D8E91579A21C3A39E50"
+      "C191728C541241",
+      "0xDD517E5EE476C45A59F0696895F40CF9683B0FE613B1490B06160B40656C076F45AA85"
+      "760265AE5758F9302D20E6DB76E75072AD99BFC4614E051BDE879D551A6045A6BA070944"
+      "432D6CF298E289CB33BEFC1844E66511773B082D516F5A41ED683E21BC99DA78097332A0"
+      "95ADB54F547E9A810676AE5C9532FEB84781");
+}
+
+
+static void TestBigintModPow(const char* base,
+                             const char* exponent,
+                             const char* modulus,
+                             const char* result) {
+  const Bigint& bigint_base =
+      Bigint::Handle(BigintOperations::NewFromCString(base));
+  const Bigint& bigint_exponent =
+      Bigint::Handle(BigintOperations::NewFromCString(exponent));
+  const Bigint& bigint_modulus =
+      Bigint::Handle(BigintOperations::NewFromCString(modulus));
+  const Bigint& computed_result = Bigint::Handle(
+      BigintOperations::ModPow(bigint_base, bigint_exponent, bigint_modulus));
+  const char* str_result = BigintOperations::ToHexCString(computed_result,
+                                                          &ZoneAllocator);
+  EXPECT_STREQ(result, str_result);
+}
+
+
+TEST_CASE(BigintModPow) {
+  const char* zero = "0x0";
+  const char* one = "0x1";
+
+  TestBigintModPow("0x4", "0xD", "0x1F1", "0x1BD");
+  TestBigintModPow("0x4", "0xD", "0x1F0", "0x40");
+  TestBigintModPow("-0x3", "0x5", "0x7", "0x2");
+  TestBigintModPow("0x1234", zero, "0x7", one);
+  TestBigintModPow(zero, "0x5", "0x7", zero);
+  TestBigintModPow("0x1234", "0x5", one, zero);
+  // Fermat's little theorem for the Mersenne primes 2^127-1 and 2^521-1.
+  TestBigintModPow("0x3",
+                   "0x7FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFE",
+                   "0x7FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF",
+                   one);
+  TestBigintModPow(
+      "0x123456789ABCDEF",
+      "0x1FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF"
+      "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFE",
+      "0x1FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF"
+      "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF",
+      one);
+  TestBigintModPow(
+      "0x63163E820DF01F0DA9973DE0E39057E4FF12982D0B0B6C0DFEC6DF63556C0058B4F7A8"
+      "F778A341FE0D90B3181E21B97ECDD1ED9EC331B07F6D5263B2B1436A954E3CD4F61F22B6"
+      "C04C1B1DA2B995422412ED9895B635C416E0D7615B00219238F8DF7BE76E313492AD11E2"
+      "C7330C52DF0DA6D2B3BA1FE689D5C4BE369A",
+      "0xC2A392631892DBF4176D6B13D34F264D207ECC281F613B4BED5BD197D48E5B1726ED81"
+      "1A9DE4AE20A10A5AFD4737BAA5BC538F4F02D14FB081F31D5CD238E560",
+      "0x985092DBFB3055A9671BCE0A2F3C8AF708F6D90A32E081441ED019C04F67BC2594A826"
+      "9738689DAB6A10917D750B0401A8784DCD03D4644A20ACE909306378DEF8A9D8A97AE5A1"
+      "564AD5833FCA7D12154D4CEA0CA90F3B12662FCA6A779FEECA546B0B61AD7B4F2592FB6C"
+      "F174880B67807413E6C5CB19A589A68DED6118D39B",
+      "0x16291BFEAE7C0600507DF649E65FD53BBA29099A64027FBE44D0C8A5BF79ED5185577B"
+      "C6DD0D273DF1737584129D694ECC61400B30A045527CCD25C9C30479B63B638895F920DB"
+      "EE269E751FDF8D3DDD3F90DAF3D174435B8B03F87A60CFDB9FC60C3AA2FF5C1B40FC9E59"
+      "FCFD4585E78454C947E1A81AB614CCB7B20DE845D3");
+  TestBigintModPow(
+      "0x63163E820DF01F0DA9973DE0E39057E4FF12982D0B0B6C0DFEC6DF63556C0058B4F7A8"
+      "F778A341FE0D90B3181E21B97ECDD1ED9EC331B07F6D5263B2B1436A954E3CD4F61F22B6"
+      "C04C1B1DA2B995422412ED9895B635C416E0D7615B00219238F8DF7BE76E313492AD11E2"
+      "C7330C52DF0DA6D2B3BA1FE689D5C4BE369A",
+      "0xD37323E482A1586EA9DBAB81C",
+      "0xF26E3A1E4FCB922F01388D6974E5BE6259509995E08679E8943EA407260D817066455F"
+      "A59CA",
+      "0x97D5173CDB221CF567CA52B3698FD1161747FCC09377796138F19A982D0AF498E86F4B"
+      "46C2A");
 }
 
 }  // namespace dart
@@ -37,7 +37,7 @@ TEST_CASE(BitmapBuilder) {
     value = !value;
   }
   // Create a Stackmap object from the builder and verify its contents.
-  const Stackmap& stackmap1 = Stackmap::Handle(Stackmap::New(0, builder1, 0));
+  const Stackmap& stackmap1 = Stackmap::Handle(Stackmap::New(builder1, 0));
   EXPECT_EQ(1024, stackmap1.Length());
   OS::Print("%s\n", stackmap1.ToCString());
   value = true;
@@ -62,7 +62,7 @@ TEST_CASE(BitmapBuilder) {
   for (int32_t i = 1025; i <= 2048; i++) {
     EXPECT(!builder1->Get(i));
   }
-  const Stackmap& stackmap2 = Stackmap::Handle(Stackmap::New(0, builder1, 0));
+  const Stackmap& stackmap2 = Stackmap::Handle(Stackmap::New(builder1, 0));
   EXPECT_EQ(2049, stackmap2.Length());
   for (int32_t i = 0; i <= 256; i++) {
     EXPECT(!stackmap2.IsObject(i));
@@ -73,6 +73,11 @@ TEST_CASE(BitmapBuilder) {
   for (int32_t i = 1025; i <= 2048; i++) {
     EXPECT(!stackmap2.IsObject(i));
   }
+  // Maps built from the same bits describe the same layout.
+  const Stackmap& stackmap3 = Stackmap::Handle(Stackmap::New(builder1, 0));
+  EXPECT(stackmap2.Equals(stackmap3));
+  EXPECT_EQ(stackmap2.Hash(), stackmap3.Hash());
+  EXPECT(!stackmap1.Equals(stackmap2));
 
   // Test using SetLength to shorten the builder, followed by lengthening.
   builder1->SetLength(747);
@@ -17,6 +17,7 @@ namespace dart {
   V(Object_noSuchMethod, 5)                                                    \
   V(Object_runtimeType, 1)                                                     \
   V(Object_instanceOf, 5)                                                      \
+  V(Object_getHash, 1)                                                         \
   V(Function_apply, 2)                                                         \
   V(InvocationMirror_invoke, 4)                                                \
   V(AbstractType_toString, 1)                                                  \
@@ -38,7 +39,9 @@ namespace dart {
   V(Smi_shlFromInt, 2)                                                         \
   V(Smi_shrFromInt, 2)                                                         \
   V(Smi_bitNegate, 1)                                                          \
+  V(Smi_toString, 1)                                                           \
   V(Mint_bitNegate, 1)                                                         \
+  V(Mint_toString, 1)                                                          \
   V(Bigint_bitNegate, 1)                                                       \
   V(Double_getIsNegative, 1)                                                   \
   V(Double_getIsInfinite, 1)                                                   \
@@ -61,6 +64,7 @@ namespace dart {
   V(Double_truncate, 1)                                                        \
   V(Double_toInt, 1)                                                           \
   V(Double_parse, 1)                                                           \
+  V(Double_toString, 1)                                                        \
   V(Double_toStringAsFixed, 2)                                                 \
   V(Double_toStringAsExponential, 2)                                           \
   V(Double_toStringAsPrecision, 2)                                             \
@@ -88,6 +92,7 @@ namespace dart {
   V(String_toLowerCase, 1)                                                     \
   V(String_toUpperCase, 1)                                                     \
   V(Strings_concatAll, 1)                                                      \
+  V(StringBuffer_createStringFromCodeUnits, 3)                                 \
   V(Math_sqrt, 1)                                                              \
   V(Math_sin, 1)                                                               \
   V(Math_cos, 1)                                                               \
@@ -130,6 +135,11 @@ namespace dart {
   V(ByteArray_getFloat64, 2)                                                   \
   V(ByteArray_setFloat64, 3)                                                   \
   V(ByteArray_setRange, 5)                                                     \
+  V(ByteArray_fill, 4)                                                         \
+  V(ByteArray_indexOfByte, 4)                                                  \
+  V(ByteArray_indexOfElement, 3)                                               \
+  V(ByteArray_compare, 6)                                                      \
+  V(ByteArray_crc32, 4)                                                        \
   V(Int8Array_new, 1)                                                          \
   V(Int8List_newTransferable, 1)                                               \
   V(Int8Array_getIndexed, 2)                                                   \
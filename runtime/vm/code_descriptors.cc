@@ -23,6 +23,19 @@ void DescriptorList::AddDescriptor(PcDescriptors::Kind kind,
 
 RawPcDescriptors* DescriptorList::FinalizePcDescriptors(uword entry_point) {
   intptr_t num_descriptors = Length();
+  // Sort the descriptors by pc so that lookups by pc can use a binary search.
+  // Descriptors are recorded in nearly ascending pc order, so an insertion
+  // sort is close to linear and keeps descriptors at the same pc in the order
+  // they were added.
+  for (intptr_t i = 1; i < num_descriptors; i++) {
+    struct PcDesc data = list_[i];
+    intptr_t j = i - 1;
+    while ((j >= 0) && (list_[j].pc_offset > data.pc_offset)) {
+      list_[j + 1] = list_[j];
+      j--;
+    }
+    list_[j + 1] = data;
+  }
   const PcDescriptors& descriptors =
       PcDescriptors::Handle(PcDescriptors::New(num_descriptors));
   for (intptr_t i = 0; i < num_descriptors; i++) {
@@ -40,20 +53,24 @@ RawPcDescriptors* DescriptorList::FinalizePcDescriptors(uword entry_point) {
 void StackmapTableBuilder::AddEntry(intptr_t pc_offset,
                                     BitmapBuilder* bitmap,
                                     intptr_t register_bit_count) {
-  stack_map_ = Stackmap::New(pc_offset, bitmap, register_bit_count);
-  list_.Add(stack_map_);
+  ASSERT(pc_offset >= 0);
+  stack_map_ = Stackmap::New(bitmap, register_bit_count);
+  // Share the map with an earlier safepoint that has the same layout.
+  const Stackmap* map = unique_maps_.Lookup(&stack_map_);
+  if (map == NULL) {
+    map = &Stackmap::ZoneHandle(stack_map_.raw());
+    unique_maps_.Insert(map);
+  }
+  list_.Add(Smi::Handle(Smi::New(pc_offset)));
+  list_.Add(*map);
 }
 
 
 bool StackmapTableBuilder::Verify() {
   intptr_t num_entries = Length();
-  Stackmap& map1 = Stackmap::Handle();
-  Stackmap& map2 = Stackmap::Handle();
   for (intptr_t i = 1; i < num_entries; i++) {
-    map1 = MapAt(i - 1);
-    map2 = MapAt(i);
     // Ensure there are no duplicates and the entries are sorted.
-    if (map1.PC() >= map2.PC()) {
+    if (PcOffsetAt(i - 1) >= PcOffsetAt(i)) {
       return false;
     }
   }
@@ -67,19 +84,26 @@ RawArray* StackmapTableBuilder::FinalizeStackmaps(const Code& code) {
   if (num_entries == 0) {
     return Object::empty_array().raw();
   }
-  uword entry_point = code.EntryPoint();
   for (intptr_t i = 0; i < num_entries; i++) {
     stack_map_ = MapAt(i);
-    stack_map_.SetPC(entry_point + stack_map_.PC());
     stack_map_.SetCode(code);
   }
   return Array::MakeArray(list_);
 }
 
 
-RawStackmap* StackmapTableBuilder::MapAt(int index) const {
+intptr_t StackmapTableBuilder::PcOffsetAt(intptr_t index) const {
+  Smi& pc_offset = Smi::Handle();
+  pc_offset ^= list_.At((index * Code::kStackmapEntryLength) +
+                        Code::kStackmapPcOffsetEntry);
+  return pc_offset.Value();
+}
+
+
+RawStackmap* StackmapTableBuilder::MapAt(intptr_t index) const {
   Stackmap& map = Stackmap::Handle();
-  map ^= list_.At(index);
+  map ^= list_.At((index * Code::kStackmapEntryLength) +
+                  Code::kStackmapEntry);
   return map.raw();
 }
 
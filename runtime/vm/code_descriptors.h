@@ -8,6 +8,7 @@
 #include "vm/code_generator.h"
 #include "vm/globals.h"
 #include "vm/growable_array.h"
+#include "vm/hash_map.h"
 #include "vm/object.h"
 
 namespace dart {
@@ -69,12 +70,38 @@ class DescriptorList : public ZoneAllocated {
 };
 
 
+// KeyValueTrait used to share identical stack maps within one code object.
+class StackmapKeyValueTrait {
+ public:
+  typedef const Stackmap* Value;
+  typedef const Stackmap* Key;
+  typedef const Stackmap* Pair;
+
+  static Key KeyOf(Pair kv) {
+    return kv;
+  }
+
+  static Value ValueOf(Pair kv) {
+    return kv;
+  }
+
+  static inline intptr_t Hashcode(Key key) {
+    return key->Hash();
+  }
+
+  static inline bool IsKeyEqual(Pair kv, Key key) {
+    return kv->Equals(*key);
+  }
+};
+
+
 class StackmapTableBuilder : public ZoneAllocated {
  public:
   explicit StackmapTableBuilder()
       : stack_map_(Stackmap::ZoneHandle()),
         list_(GrowableObjectArray::ZoneHandle(
-            GrowableObjectArray::New(Heap::kOld))) { }
+            GrowableObjectArray::New(Heap::kOld))),
+        unique_maps_() { }
   ~StackmapTableBuilder() { }
 
   void AddEntry(intptr_t pc_offset,
@@ -83,14 +110,20 @@ class StackmapTableBuilder : public ZoneAllocated {
 
   bool Verify();
 
+  // Returns the stack map table of the code object as (pc offset, stackmap)
+  // pairs sorted by pc offset, see Code::GetStackmap.
   RawArray* FinalizeStackmaps(const Code& code);
 
  private:
-  intptr_t Length() const { return list_.Length(); }
-  RawStackmap* MapAt(int index) const;
+  intptr_t Length() const {
+    return list_.Length() / Code::kStackmapEntryLength;
+  }
+  intptr_t PcOffsetAt(intptr_t index) const;
+  RawStackmap* MapAt(intptr_t index) const;
 
   Stackmap& stack_map_;
   GrowableObjectArray& list_;
+  DirectChainedHashMap<StackmapKeyValueTrait> unique_maps_;
   DISALLOW_COPY_AND_ASSIGN(StackmapTableBuilder);
 };
 
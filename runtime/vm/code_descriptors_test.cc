@@ -142,32 +142,33 @@ CODEGEN_TEST_GENERATE(StackmapCodegen, test) {
     code.set_stackmaps(stack_maps);
     const Array& stack_map_list = Array::Handle(code.stackmaps());
     EXPECT(!stack_map_list.IsNull());
+    Array& maps = Array::Handle();
     Stackmap& stack_map = Stackmap::Handle();
-    EXPECT_EQ(4, stack_map_list.Length());
+    EXPECT_EQ(4 * Code::kStackmapEntryLength, stack_map_list.Length());
 
     // Validate the first stack map entry.
-    stack_map ^= stack_map_list.At(0);
+    stack_map = code.GetStackmap(code.EntryPoint() + 0, &maps, &stack_map);
     EXPECT_EQ(kStackSlotCount, stack_map.Length());
     for (intptr_t i = 0; i < kStackSlotCount; ++i) {
       EXPECT_EQ(expectation0[i], stack_map.IsObject(i));
     }
 
     // Validate the second stack map entry.
-    stack_map ^= stack_map_list.At(1);
+    stack_map = code.GetStackmap(code.EntryPoint() + 1, &maps, &stack_map);
     EXPECT_EQ(kStackSlotCount, stack_map.Length());
     for (intptr_t i = 0; i < kStackSlotCount; ++i) {
       EXPECT_EQ(expectation1[i], stack_map.IsObject(i));
     }
 
     // Validate the third stack map entry.
-    stack_map ^= stack_map_list.At(2);
+    stack_map = code.GetStackmap(code.EntryPoint() + 2, &maps, &stack_map);
     EXPECT_EQ(kStackSlotCount, stack_map.Length());
     for (intptr_t i = 0; i < kStackSlotCount; ++i) {
       EXPECT_EQ(expectation2[i], stack_map.IsObject(i));
     }
 
     // Validate the fourth stack map entry.
-    stack_map ^= stack_map_list.At(3);
+    stack_map = code.GetStackmap(code.EntryPoint() + 3, &maps, &stack_map);
     EXPECT_EQ(kStackSlotCount, stack_map.Length());
     for (intptr_t i = 0; i < kStackSlotCount; ++i) {
       EXPECT_EQ(expectation3[i], stack_map.IsObject(i));
@@ -4,10 +4,33 @@
 
 #include "vm/code_observers.h"
 
+#include "vm/object.h"
 #include "vm/os.h"
 
 namespace dart {
 
+void CodeLineInfo::Add(intptr_t pc_offset,
+                       const Function& function,
+                       intptr_t token_pos) {
+  LineEntry entry;
+  entry.pc_offset = pc_offset;
+  entry.function = &function;
+  entry.token_pos = token_pos;
+  entries_.Add(entry);
+}
+
+
+void CodeLineInfo::GetLocationAt(intptr_t index,
+                                 const char** url,
+                                 intptr_t* line) const {
+  const LineEntry& entry = entries_[index];
+  const Script& script = Script::Handle(entry.function->script());
+  *url = String::Handle(script.url()).ToCString();
+  intptr_t column;
+  script.GetTokenLocation(entry.token_pos, line, &column);
+}
+
+
 intptr_t CodeObservers::observers_length_ = 0;
 CodeObserver** CodeObservers::observers_ = NULL;
 
@@ -27,11 +50,13 @@ void CodeObservers::NotifyAll(const char* name,
                               uword base,
                               uword prologue_offset,
                               uword size,
-                              bool optimized) {
+                              bool optimized,
+                              const CodeLineInfo* line_info) {
   ASSERT(!AreActive() || (strlen(name) != 0));
   for (intptr_t i = 0; i < observers_length_; i++) {
     if (observers_[i]->IsActive()) {
-      observers_[i]->Notify(name, base, prologue_offset, size, optimized);
+      observers_[i]->Notify(name, base, prologue_offset, size, optimized,
+                            line_info);
     }
   }
 }
@@ -50,6 +75,8 @@ void CodeObservers::DeleteAll() {
     delete observers_[i];
   }
   free(observers_);
+  observers_ = NULL;
+  observers_length_ = 0;
 }
 
 
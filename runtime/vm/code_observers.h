@@ -7,9 +7,42 @@
 
 #include "vm/globals.h"
 #include "vm/allocation.h"
+#include "vm/growable_array.h"
 
 namespace dart {
 
+class Function;
+
+// Maps the instructions of a compiled function to the source positions
+// they were generated from. Code inlined into an optimized function is
+// mapped to the positions in the inlined function.
+class CodeLineInfo : public ZoneAllocated {
+ public:
+  CodeLineInfo() : entries_(16) { }
+
+  void Add(intptr_t pc_offset, const Function& function, intptr_t token_pos);
+
+  intptr_t Length() const { return entries_.length(); }
+  intptr_t PcOffsetAt(intptr_t index) const {
+    return entries_[index].pc_offset;
+  }
+
+  // Computes the url of the script and the line of the entry at index.
+  void GetLocationAt(intptr_t index, const char** url, intptr_t* line) const;
+
+ private:
+  struct LineEntry {
+    intptr_t pc_offset;
+    const Function* function;
+    intptr_t token_pos;
+  };
+
+  GrowableArray<LineEntry> entries_;
+
+  DISALLOW_COPY_AND_ASSIGN(CodeLineInfo);
+};
+
+
 // Object observing code creation events. Used by external profilers and
 // debuggers to map address ranges to function names.
 class CodeObserver {
@@ -23,12 +56,13 @@ class CodeObserver {
   virtual bool IsActive() const = 0;
 
   // Notify code observer about a newly created code object with the
-  // given properties.
+  // given properties. The line info is NULL for stubs.
   virtual void Notify(const char* name,
                       uword base,
                       uword prologue_offset,
                       uword size,
-                      bool optimized) = 0;
+                      bool optimized,
+                      const CodeLineInfo* line_info) = 0;
 
  private:
   DISALLOW_COPY_AND_ASSIGN(CodeObserver);
@@ -46,11 +80,13 @@ class CodeObservers : public AllStatic {
                         uword base,
                         uword prologue_offset,
                         uword size,
-                        bool optimized);
+                        bool optimized,
+                        const CodeLineInfo* line_info);
 
   // Returns true if there is at least one active code observer.
   static bool AreActive();
 
+  // Deletes the observers at VM shutdown.
   static void DeleteAll();
 
  private:
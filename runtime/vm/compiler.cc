@@ -281,6 +281,10 @@ static bool CompileParsedFunctionHelper(const ParsedFunction& parsed_function,
           Code::FinalizeCode(function, &assembler, optimized));
       code.set_is_optimized(optimized);
       graph_compiler.FinalizePcDescriptors(code);
+      Code::NotifyCodeObservers(function,
+                                code,
+                                assembler.prologue_offset(),
+                                graph_compiler.line_info());
       graph_compiler.FinalizeDeoptInfo(code);
       graph_compiler.FinalizeStackmaps(code);
       graph_compiler.FinalizeVarDescriptors(code);
@@ -383,10 +387,16 @@ static void DisassembleCode(const Function& function, bool optimized) {
   OS::Print("Stackmaps for function '%s' {\n", function_fullname);
   if (code.stackmaps() != Array::null()) {
     const Array& stackmap_table = Array::Handle(code.stackmaps());
+    Smi& offset = Smi::Handle();
     Stackmap& map = Stackmap::Handle();
-    for (intptr_t i = 0; i < stackmap_table.Length(); ++i) {
-      map ^= stackmap_table.At(i);
-      OS::Print("%s\n", map.ToCString());
+    for (intptr_t i = 0;
+         i < stackmap_table.Length();
+         i += Code::kStackmapEntryLength) {
+      offset ^= stackmap_table.At(i + Code::kStackmapPcOffsetEntry);
+      map ^= stackmap_table.At(i + Code::kStackmapEntry);
+      OS::Print("%#"Px": %s\n",
+                code.EntryPoint() + offset.Value(),
+                map.ToCString());
     }
   }
   OS::Print("}\n");
@@ -15,6 +15,7 @@
 #include "vm/object.h"
 #include "vm/object_store.h"
 #include "vm/port.h"
+#include "vm/profiler.h"
 #include "vm/simulator.h"
 #include "vm/snapshot.h"
 #include "vm/stub_code.h"
@@ -30,6 +31,7 @@ DEFINE_FLAG(bool, heap_profile_initialize, false,
 DECLARE_FLAG(bool, heap_trace);
 DECLARE_FLAG(bool, print_bootstrap);
 DECLARE_FLAG(bool, print_class_table);
+DECLARE_FLAG(bool, profile);
 DECLARE_FLAG(bool, trace_isolates);
 
 Isolate* Dart::vm_isolate_ = NULL;
@@ -75,7 +77,6 @@ class ReadOnlyHandles {
 };
 
 
-// TODO(turnidge): We should add a corresponding Dart::Cleanup.
 const char* Dart::InitOnce(Dart_IsolateCreateCallback create,
                            Dart_IsolateInterruptCallback interrupt,
                            Dart_IsolateUnhandledExceptionCallback unhandled,
@@ -95,6 +96,7 @@ const char* Dart::InitOnce(Dart_IsolateCreateCallback create,
   FreeListElement::InitOnce();
   Api::InitOnce();
   CodeObservers::InitOnce();
+  Profiler::InitOnce();
 #if defined(USING_SIMULATOR)
   Simulator::InitOnce();
 #endif
@@ -141,6 +143,18 @@ const char* Dart::InitOnce(Dart_IsolateCreateCallback create,
 }
 
 
+// Must be called after all isolates have been shut down.
+const char* Dart::Cleanup() {
+  if (vm_isolate_ == NULL) {
+    return "VM not initialized.";
+  }
+  Profiler::Shutdown();
+  // Deleting the observers closes the files they write to.
+  CodeObservers::DeleteAll();
+  return NULL;
+}
+
+
 Isolate* Dart::CreateIsolate(const char* name_prefix) {
   // Create a new isolate.
   Isolate* isolate = Isolate::Init(name_prefix);
@@ -232,6 +246,9 @@ RawError* Dart::InitializeIsolate(const uint8_t* snapshot_buffer, void* data) {
   if (FLAG_print_class_table) {
     isolate->class_table()->Print();
   }
+  if (FLAG_profile) {
+    Profiler::StartSampling(isolate);
+  }
   return Error::null();
 }
 
@@ -4,6 +4,7 @@
 
 #include "include/dart_api.h"
 
+#include "platform/json.h"
 #include "vm/bigint_operations.h"
 #include "vm/class_finalizer.h"
 #include "vm/compiler.h"
@@ -22,6 +23,7 @@
 #include "vm/object.h"
 #include "vm/object_store.h"
 #include "vm/port.h"
+#include "vm/profiler.h"
 #include "vm/resolver.h"
 #include "vm/stack_frame.h"
 #include "vm/symbols.h"
@@ -730,6 +732,51 @@ DART_EXPORT Dart_Handle Dart_HeapProfile(Dart_FileWriteCallback callback,
   return Api::Success(isolate);
 }
 
+
+DART_EXPORT Dart_Handle Dart_StartCpuProfiling() {
+  Isolate* isolate = Isolate::Current();
+  CHECK_ISOLATE(isolate);
+  if (!Profiler::StartSampling(isolate)) {
+    return Api::NewError("%s: CPU profiling is not supported on this platform.",
+                         CURRENT_FUNC);
+  }
+  return Api::Success(isolate);
+}
+
+
+DART_EXPORT Dart_Handle Dart_StopCpuProfiling() {
+  Isolate* isolate = Isolate::Current();
+  CHECK_ISOLATE(isolate);
+  Profiler::StopSampling(isolate);
+  return Api::Success(isolate);
+}
+
+
+DART_EXPORT Dart_Handle Dart_CpuProfile(Dart_CpuProfileFormat format,
+                                        Dart_FileWriteCallback callback,
+                                        void* stream) {
+  Isolate* isolate = Isolate::Current();
+  DARTSCOPE(isolate);
+  if (callback == NULL) {
+    RETURN_NULL_ERROR(callback);
+  }
+  if ((format != kCpuProfileCallTree) &&
+      (format != kCpuProfileCollapsedStacks)) {
+    return Api::NewError("%s: Unknown profile format %d.",
+                         CURRENT_FUNC, format);
+  }
+  if (isolate->profiler_data() == NULL) {
+    return Api::NewError("%s: The current isolate is not being profiled.",
+                         CURRENT_FUNC);
+  }
+  TextBuffer buffer(1024);
+  Profiler::PrintProfile(isolate,
+                         static_cast<Profiler::ProfileFormat>(format),
+                         &buffer);
+  callback(buffer.buf(), buffer.length(), stream);
+  return Api::Success(isolate);
+}
+
 // --- Initialization and Globals ---
 
 DART_EXPORT const char* Dart_VersionString() {
@@ -753,6 +800,15 @@ DART_EXPORT bool Dart_Initialize(
   return true;
 }
 
+DART_EXPORT bool Dart_Cleanup() {
+  const char* err_msg = Dart::Cleanup();
+  if (err_msg != NULL) {
+    OS::PrintErr("Dart_Cleanup: %s\n", err_msg);
+    return false;
+  }
+  return true;
+}
+
 DART_EXPORT bool Dart_SetVMFlags(int argc, const char** argv) {
   return Flags::ProcessCommandLineFlags(argc, argv);
 }
@@ -2294,6 +2350,41 @@ DART_EXPORT Dart_Handle Dart_ExternalByteArrayGetPeer(Dart_Handle object,
 }
 
 
+DART_EXPORT Dart_Handle Dart_ByteArrayAcquireData(Dart_Handle array,
+                                                  void** data,
+                                                  intptr_t* length) {
+  Isolate* isolate = Isolate::Current();
+  DARTSCOPE(isolate);
+  const ByteArray& array_obj = Api::UnwrapByteArrayHandle(isolate, array);
+  if (array_obj.IsNull()) {
+    RETURN_TYPE_ERROR(isolate, array, ByteArray);
+  }
+  if (data == NULL) {
+    RETURN_NULL_ERROR(data);
+  }
+  if (length == NULL) {
+    RETURN_NULL_ERROR(length);
+  }
+  // Allocating while the data is acquired could move an internal array.
+  isolate->IncrementNoGCScopeDepth();
+  *data = array_obj.DataAddr();
+  *length = array_obj.ByteLength();
+  return Api::Success(isolate);
+}
+
+
+DART_EXPORT Dart_Handle Dart_ByteArrayReleaseData(Dart_Handle array) {
+  Isolate* isolate = Isolate::Current();
+  DARTSCOPE(isolate);
+  const ByteArray& array_obj = Api::UnwrapByteArrayHandle(isolate, array);
+  if (array_obj.IsNull()) {
+    RETURN_TYPE_ERROR(isolate, array, ByteArray);
+  }
+  isolate->DecrementNoGCScopeDepth();
+  return Api::Success(isolate);
+}
+
+
 template<typename T>
 Dart_Handle ByteArrayGetAt(T* value, Dart_Handle array, intptr_t offset) {
   Isolate* isolate = Isolate::Current();
@@ -4152,33 +4243,38 @@ DART_EXPORT Dart_Handle Dart_LoadEmbeddedScript(Dart_Handle url,
 }
 
 
-DART_EXPORT Dart_Handle Dart_LoadScriptFromSnapshot(const uint8_t* buffer) {
-  Isolate* isolate = Isolate::Current();
-  DARTSCOPE(isolate);
-  TIMERSCOPE(time_script_loading);
+static Dart_Handle LoadScriptFromSnapshotHelper(Isolate* isolate,
+                                               const uint8_t* buffer,
+                                               bool in_place,
+                                               const char* current_func) {
   if (buffer == NULL) {
-    RETURN_NULL_ERROR(buffer);
+    return Api::NewError("%s expects argument 'buffer' to be non-null.",
+                         current_func);
   }
   const Snapshot* snapshot = Snapshot::SetupFromBuffer(buffer);
   if (!snapshot->IsScriptSnapshot()) {
     return Api::NewError("%s expects parameter 'buffer' to be a script type"
-                         " snapshot.", CURRENT_FUNC);
+                         " snapshot.", current_func);
   }
   Library& library =
       Library::Handle(isolate, isolate->object_store()->root_library());
   if (!library.IsNull()) {
     const String& library_url = String::Handle(isolate, library.url());
     return Api::NewError("%s: A script has already been loaded from '%s'.",
-                         CURRENT_FUNC, library_url.ToCString());
+                         current_func, library_url.ToCString());
   }
+  // Make room for the symbols of the script up front, instead of growing
+  // the symbol table repeatedly while reading them.
+  Symbols::Reserve(isolate, snapshot->symbol_count());
   SnapshotReader reader(snapshot->content(),
                         snapshot->length(),
                         snapshot->kind(),
                         isolate);
+  reader.set_data_in_place(in_place);
   const Object& tmp = Object::Handle(isolate, reader.ReadObject());
   if (!tmp.IsLibrary()) {
     return Api::NewError("%s: Unable to deserialize snapshot correctly.",
-                         CURRENT_FUNC);
+                         current_func);
   }
   library ^= tmp.raw();
   library.set_debuggable(true);
@@ -4187,6 +4283,23 @@ DART_EXPORT Dart_Handle Dart_LoadScriptFromSnapshot(const uint8_t* buffer) {
 }
 
 
+DART_EXPORT Dart_Handle Dart_LoadScriptFromSnapshot(const uint8_t* buffer) {
+  Isolate* isolate = Isolate::Current();
+  DARTSCOPE(isolate);
+  TIMERSCOPE(time_script_loading);
+  return LoadScriptFromSnapshotHelper(isolate, buffer, false, CURRENT_FUNC);
+}
+
+
+DART_EXPORT Dart_Handle Dart_LoadScriptFromMappedSnapshot(
+    const uint8_t* buffer) {
+  Isolate* isolate = Isolate::Current();
+  DARTSCOPE(isolate);
+  TIMERSCOPE(time_script_loading);
+  return LoadScriptFromSnapshotHelper(isolate, buffer, true, CURRENT_FUNC);
+}
+
+
 DART_EXPORT Dart_Handle Dart_RootLibrary() {
   Isolate* isolate = Isolate::Current();
   DARTSCOPE(isolate);
@@ -1199,6 +1199,48 @@ TEST_CASE(ExternalUint8ClampedArrayAccess) {
 }
 
 
+TEST_CASE(ByteArrayAcquireData) {
+  Dart_Handle byte_array = Dart_NewByteArray(10);
+  EXPECT_VALID(byte_array);
+  for (intptr_t i = 0; i < 10; ++i) {
+    EXPECT_VALID(Dart_ByteArraySetUint8At(byte_array, i, i * 3));
+  }
+  void* data = NULL;
+  intptr_t length = 0;
+  EXPECT_VALID(Dart_ByteArrayAcquireData(byte_array, &data, &length));
+  EXPECT_EQ(10, length);
+  uint8_t* bytes = reinterpret_cast<uint8_t*>(data);
+  for (intptr_t i = 0; i < length; ++i) {
+    EXPECT_EQ(i * 3, bytes[i]);
+    bytes[i] = 100 + i;
+  }
+  EXPECT_VALID(Dart_ByteArrayReleaseData(byte_array));
+  for (intptr_t i = 0; i < 10; ++i) {
+    uint8_t value = 0;
+    EXPECT_VALID(Dart_ByteArrayGetUint8At(byte_array, i, &value));
+    EXPECT_EQ(100 + i, value);
+  }
+
+  uint8_t external_data[] = { 0, 11, 22, 33 };
+  Dart_Handle external_array = Dart_NewExternalByteArray(
+      external_data, ARRAY_SIZE(external_data), NULL, NULL);
+  EXPECT_VALID(Dart_ByteArrayAcquireData(external_array, &data, &length));
+  EXPECT(data == external_data);
+  EXPECT_EQ(4, length);
+  EXPECT_VALID(Dart_ByteArrayReleaseData(external_array));
+
+  Dart_Handle empty_array = Dart_NewByteArray(0);
+  EXPECT_VALID(Dart_ByteArrayAcquireData(empty_array, &data, &length));
+  EXPECT_EQ(0, length);
+  EXPECT_VALID(Dart_ByteArrayReleaseData(empty_array));
+
+  EXPECT(Dart_IsError(Dart_ByteArrayAcquireData(Dart_NewList(1),
+                                                &data,
+                                                &length)));
+  EXPECT(Dart_IsError(Dart_ByteArrayAcquireData(byte_array, NULL, &length)));
+}
+
+
 
 static void ExternalByteArrayCallbackFinalizer(void* peer) {
   *static_cast<int*>(peer) = 42;
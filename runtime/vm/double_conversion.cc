@@ -4,6 +4,8 @@
 
 #include "vm/double_conversion.h"
 
+#include <math.h>
+
 #include "third_party/double-conversion/src/double-conversion.h"
 
 #include "vm/exceptions.h"
@@ -16,6 +18,52 @@ static const char kDoubleToStringCommonExponentChar = 'e';
 static const char* kDoubleToStringCommonInfinitySymbol = "Infinity";
 static const char* kDoubleToStringCommonNaNSymbol = "NaN";
 
+static const double kPowersOf10[] = {
+  1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6
+};
+
+
+// Writes the shortest representation of d to buffer and returns its length
+// if it has at most six fraction digits and its digits fit into 52 bits, as
+// is common for integral values, prices and measurements. Returns 0 if d
+// needs the general algorithm.
+//
+// If d is n / 10^k for an integer n with |n| < 2^52, the spacing of doubles
+// around d is less than 10^-k, so n is the only k-digit decimal that reads
+// back as d and the smallest such k gives the shortest representation.
+static intptr_t DoubleToShortDecimal(double d, char* buffer) {
+  static const double kMaxScaled = 4503599627370496.0;  // 2^52.
+  const double abs_d = fabs(d);
+  if (!(abs_d < kMaxScaled)) return 0;  // Also handles NaN.
+  for (intptr_t k = 0; k < static_cast<intptr_t>(ARRAY_SIZE(kPowersOf10));
+       k++) {
+    const double scaled = floor(abs_d * kPowersOf10[k] + 0.5);
+    if (scaled >= kMaxScaled) return 0;
+    if ((scaled / kPowersOf10[k]) != abs_d) continue;
+    // Write the digits of n backwards and insert the decimal point, padding
+    // with zeros if n has fewer digits than there are fraction digits.
+    char digits[24];
+    intptr_t length = 0;
+    uint64_t n = static_cast<uint64_t>(scaled);
+    do {
+      digits[length++] = '0' + static_cast<char>(n % 10);
+      n /= 10;
+    } while ((n != 0) || (length <= k));
+    intptr_t pos = 0;
+    if (signbit(d)) buffer[pos++] = '-';
+    for (intptr_t i = length - 1; i >= k; i--) buffer[pos++] = digits[i];
+    buffer[pos++] = '.';
+    if (k == 0) {
+      buffer[pos++] = '0';
+    } else {
+      for (intptr_t i = k - 1; i >= 0; i--) buffer[pos++] = digits[i];
+    }
+    return pos;
+  }
+  return 0;
+}
+
+
 void DoubleToCString(double d, char* buffer, int buffer_size) {
   static const int kDecimalLow = -6;
   static const int kDecimalHigh = 21;
@@ -31,6 +79,12 @@ void DoubleToCString(double d, char* buffer, int buffer_size) {
   // sign, at most three exponent digits, plus the \0.
   ASSERT(buffer_size >= 1 + 17 + 1 + 1 + 1 + 3 + 1);
 
+  intptr_t length = DoubleToShortDecimal(d, buffer);
+  if (length > 0) {
+    buffer[length] = '\0';
+    return;
+  }
+
   static const int kConversionFlags =
       double_conversion::DoubleToStringConverter::EMIT_POSITIVE_EXPONENT_SIGN |
       double_conversion::DoubleToStringConverter::EMIT_TRAILING_DECIMAL_POINT |
@@ -52,6 +106,61 @@ void DoubleToCString(double d, char* buffer, int buffer_size) {
   ASSERT(result == buffer);
 }
 
+RawString* DoubleToString(double d) {
+  const int kBufferSize = 128;
+  char buffer[kBufferSize];
+  DoubleToCString(d, buffer, kBufferSize);
+  return OneByteString::New(reinterpret_cast<const uint8_t*>(buffer),
+                            strlen(buffer),
+                            Heap::kNew);
+}
+
+
+static bool IsDigit(char c) {
+  return ('0' <= c) && (c <= '9');
+}
+
+
+bool CStringToDouble(const char* str, intptr_t length, double* result) {
+  // Only accept what the scanner accepts as a number literal, optionally
+  // preceded by a sign: digits, optionally followed by a decimal point and
+  // digits, optionally followed by an exponent. Everything else, including
+  // white space, hexadecimal integers and literals starting with a decimal
+  // point, is left to the caller.
+  intptr_t i = 0;
+  if ((i < length) && ((str[i] == '-') || (str[i] == '+'))) i++;
+  const intptr_t start = i;
+  while ((i < length) && IsDigit(str[i])) i++;
+  if (i == start) return false;
+  if ((i < length) && (str[i] == '.')) {
+    i++;
+    const intptr_t fraction_start = i;
+    while ((i < length) && IsDigit(str[i])) i++;
+    if (i == fraction_start) return false;
+  }
+  if ((i < length) && ((str[i] == 'e') || (str[i] == 'E'))) {
+    i++;
+    if ((i < length) && ((str[i] == '-') || (str[i] == '+'))) i++;
+    const intptr_t exponent_start = i;
+    while ((i < length) && IsDigit(str[i])) i++;
+    if (i == exponent_start) return false;
+  }
+  if (i != length) return false;
+
+  double_conversion::StringToDoubleConverter converter(
+      double_conversion::StringToDoubleConverter::NO_FLAGS,
+      0.0,
+      0.0,
+      NULL,
+      NULL);
+  int processed = 0;
+  *result = converter.StringToDouble(str, static_cast<int>(length),
+                                     &processed);
+  ASSERT(processed == length);
+  return true;
+}
+
+
 RawString* DoubleToStringAsFixed(double d, int fraction_digits) {
   static const int kMinFractionDigits = 0;
   static const int kMaxFractionDigits = 20;
@@ -91,7 +200,7 @@ RawString* DoubleToStringAsFixed(double d, int fraction_digits) {
   double_conversion::StringBuilder builder(buffer, kBufferSize);
   bool status = converter.ToFixed(d, fraction_digits, &builder);
   ASSERT(status);
-  return String::New(builder.Finalize());
+  return OneByteString::New(builder.Finalize());
 }
 
 
@@ -124,7 +233,7 @@ RawString* DoubleToStringAsExponential(double d, int fraction_digits) {
   double_conversion::StringBuilder builder(buffer, kBufferSize);
   bool status = converter.ToExponential(d, fraction_digits, &builder);
   ASSERT(status);
-  return String::New(builder.Finalize());
+  return OneByteString::New(builder.Finalize());
 }
 
 
@@ -163,7 +272,7 @@ RawString* DoubleToStringAsPrecision(double d, int precision) {
   double_conversion::StringBuilder builder(buffer, kBufferSize);
   bool status = converter.ToPrecision(d, precision, &builder);
   ASSERT(status);
-  return String::New(builder.Finalize());
+  return OneByteString::New(builder.Finalize());
 }
 
 }  // namespace dart
@@ -11,10 +11,15 @@
 namespace dart {
 
 void DoubleToCString(double d, char* buffer, int buffer_size);
+RawString* DoubleToString(double d);
 RawString* DoubleToStringAsFixed(double d, int fraction_digits);
 RawString* DoubleToStringAsExponential(double d, int fraction_digits);
 RawString* DoubleToStringAsPrecision(double d, int precision);
 
+// Converts the number literal in str to a double and returns true. Returns
+// false without converting if str is not a plain decimal literal.
+bool CStringToDouble(const char* str, intptr_t length, double* result);
+
 }  // namespace dart
 
 #endif  // VM_DOUBLE_CONVERSION_H_
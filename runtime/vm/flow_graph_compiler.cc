@@ -7,6 +7,7 @@
 #include "vm/flow_graph_compiler.h"
 
 #include "vm/cha.h"
+#include "vm/code_observers.h"
 #include "vm/dart_entry.h"
 #include "vm/debugger.h"
 #include "vm/deopt_instructions.h"
@@ -142,6 +143,7 @@ FlowGraphCompiler::FlowGraphCompiler(Assembler* assembler,
       current_block_(NULL),
       exception_handlers_list_(NULL),
       pc_descriptors_list_(NULL),
+      line_info_(NULL),
       stackmap_table_builder_(
           is_optimizing ? new StackmapTableBuilder() : NULL),
       block_info_(block_order_.length()),
@@ -152,7 +154,8 @@ FlowGraphCompiler::FlowGraphCompiler(Assembler* assembler,
       may_reoptimize_(false),
       double_class_(Class::ZoneHandle(
           Isolate::Current()->object_store()->double_class())),
-      parallel_move_resolver_(this) {
+      parallel_move_resolver_(this),
+      pending_deoptimization_env_(NULL) {
   ASSERT(assembler != NULL);
 }
 
@@ -164,6 +167,7 @@ bool FlowGraphCompiler::HasFinally() const {
 
 void FlowGraphCompiler::InitCompiler() {
   pc_descriptors_list_ = new DescriptorList(64);
+  line_info_ = CodeObservers::AreActive() ? new CodeLineInfo() : NULL;
   exception_handlers_list_ = new ExceptionHandlerList();
   block_info_.Clear();
   for (int i = 0; i < block_order_.length(); ++i) {
@@ -305,6 +309,16 @@ void FlowGraphCompiler::AddCurrentDescriptor(PcDescriptors::Kind kind,
                                        deopt_id,
                                        token_pos,
                                        CurrentTryIndex());
+  if ((line_info_ != NULL) &&
+      (current_block_ != NULL) &&
+      (token_pos > Scanner::kDummyTokenIndex)) {
+    // The environment of the instruction tells which inlined function the
+    // code was generated for.
+    const Function& function = (pending_deoptimization_env_ != NULL) ?
+        pending_deoptimization_env_->function() :
+        parsed_function().function();
+    line_info_->Add(assembler()->CodeSize(), function, token_pos);
+  }
 }
 
 
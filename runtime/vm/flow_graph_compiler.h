@@ -16,6 +16,7 @@ namespace dart {
 
 // Forward declarations.
 class Code;
+class CodeLineInfo;
 class DeoptInfoBuilder;
 class FlowGraph;
 class FlowGraphCompiler;
@@ -186,6 +187,8 @@ class FlowGraphCompiler : public ValueObject {
   DescriptorList* pc_descriptors_list() const {
     return pc_descriptors_list_;
   }
+  // The line info for the code observers, NULL when no observer is active.
+  const CodeLineInfo* line_info() const { return line_info_; }
   BlockEntryInstr* current_block() const { return current_block_; }
   void set_current_block(BlockEntryInstr* value) {
     current_block_ = value;
@@ -495,6 +498,7 @@ class FlowGraphCompiler : public ValueObject {
   BlockEntryInstr* current_block_;
   ExceptionHandlerList* exception_handlers_list_;
   DescriptorList* pc_descriptors_list_;
+  CodeLineInfo* line_info_;
   StackmapTableBuilder* stackmap_table_builder_;
   GrowableArray<BlockInfo*> block_info_;
   GrowableArray<CompilerDeoptInfo*> deopt_infos_;
@@ -392,6 +392,18 @@ void GCMarker::ProcessPeerReferents(PageSpace* page_space) {
       peer_table->erase(it++);
     }
   }
+  PageSpace::IdentityHashTable* hash_table =
+      page_space->GetIdentityHashTable();
+  PageSpace::IdentityHashTable::iterator hash_it = hash_table->begin();
+  while (hash_it != hash_table->end()) {
+    RawObject* raw_obj = hash_it->first;
+    ASSERT(raw_obj->IsHeapObject());
+    if (raw_obj->IsMarked()) {
+      ++hash_it;
+    } else {
+      hash_table->erase(hash_it++);
+    }
+  }
 }
 
 
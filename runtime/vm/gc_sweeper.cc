@@ -33,6 +33,9 @@ intptr_t GCSweeper::SweepPage(HeapPage* page, FreeList* freelist) {
     if (in_use_swept == in_use && !HeapTrace::is_enabled()) {
       // No more marked objects will be found on this page.
       obj_size = end - current;
+      if (is_executable) {
+        page->ClearObjectStarts(current, end);
+      }
       freelist->Free(current, obj_size);
       break;
     }
@@ -62,6 +65,7 @@ intptr_t GCSweeper::SweepPage(HeapPage* page, FreeList* freelist) {
       obj_size = free_end - current;
       if (is_executable) {
         memset(reinterpret_cast<void*>(current), 0xcc, obj_size);
+        page->ClearObjectStarts(current, free_end);
       }
       freelist->Free(current, obj_size);
     }
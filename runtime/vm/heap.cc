@@ -6,6 +6,7 @@
 
 #include "platform/assert.h"
 #include "platform/utils.h"
+#include "vm/dart.h"
 #include "vm/flags.h"
 #include "vm/heap_profiler.h"
 #include "vm/heap_trace.h"
@@ -35,7 +36,10 @@ DEFINE_FLAG(int, old_gen_heap_size, Heap::kHeapSizeInMB,
             "old gen heap size in MB,"
             "e.g: --old_gen_heap_size=1024 allocates a 1024MB old gen heap");
 
-Heap::Heap() : read_only_(false), gc_in_progress_(false) {
+Heap::Heap()
+    : identity_hash_state_(0x9e3779b9),
+      read_only_(false),
+      gc_in_progress_(false) {
   new_space_ = new Scavenger(this,
                              (FLAG_new_gen_heap_size * MB),
                              kNewObjectAlignmentOffset);
@@ -149,6 +153,16 @@ RawInstructions* Heap::FindObjectInCodeSpace(FindObjectVisitor* visitor) {
 }
 
 
+RawInstructions* Heap::FindInstructions(uword pc) const {
+  RawObject* raw_obj = old_space_->FindExecutableObject(pc);
+  if ((raw_obj == Object::null()) ||
+      !RawInstructions::ContainsPC(raw_obj, pc)) {
+    return Instructions::null();
+  }
+  return reinterpret_cast<RawInstructions*>(raw_obj);
+}
+
+
 void Heap::CollectGarbage(Space space, ApiCallbacks api_callbacks) {
   bool invoke_api_callbacks = (api_callbacks == kInvokeApiCallbacks);
   switch (space) {
@@ -376,6 +390,72 @@ int64_t Heap::PeerCount() const {
 }
 
 
+intptr_t Heap::IdentityHash(RawObject* raw_obj) {
+  ASSERT(raw_obj->IsHeapObject());
+#if defined(ARCH_IS_64_BIT)
+  intptr_t hash = raw_obj->GetIdentityHash();
+#else
+  intptr_t hash = GetIdentityHash(raw_obj);
+#endif
+  if (hash != 0) {
+    return hash;
+  }
+  uword raw_addr = RawObject::ToAddr(raw_obj);
+  if (!Contains(raw_addr)) {
+    // Objects of the read-only vm isolate heap never move.
+    ASSERT(Dart::vm_isolate()->heap()->Contains(raw_addr));
+    return (Utils::WordHash(raw_addr) & kIdentityHashMask) | 1;
+  }
+  hash = NextIdentityHash();
+#if defined(ARCH_IS_64_BIT)
+  raw_obj->SetIdentityHash(hash);
+#else
+  SetIdentityHash(raw_obj, hash);
+#endif
+  return hash;
+}
+
+
+void Heap::SetIdentityHash(RawObject* raw_obj, intptr_t hash) {
+  if (raw_obj->IsNewObject()) {
+    new_space_->SetIdentityHash(raw_obj, hash);
+  } else {
+    ASSERT(raw_obj->IsOldObject());
+    old_space_->SetIdentityHash(raw_obj, hash);
+  }
+}
+
+
+intptr_t Heap::GetIdentityHash(RawObject* raw_obj) {
+  if (raw_obj->IsNewObject()) {
+    return new_space_->GetIdentityHash(raw_obj);
+  }
+  ASSERT(raw_obj->IsOldObject());
+  return old_space_->GetIdentityHash(raw_obj);
+}
+
+
+int64_t Heap::IdentityHashCount() const {
+  return new_space_->IdentityHashCount() + old_space_->IdentityHashCount();
+}
+
+
+intptr_t Heap::NextIdentityHash() {
+  // A xorshift generator. Identity hash codes are positive Smis on all
+  // architectures and 0 is reserved for objects without a hash code.
+  intptr_t hash;
+  do {
+    uint32_t x = identity_hash_state_;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    identity_hash_state_ = x;
+    hash = x & kIdentityHashMask;
+  } while (hash == 0);
+  return hash;
+}
+
+
 void Heap::RecordBeforeGC(Space space, GCReason reason) {
   ASSERT(!gc_in_progress_);
   gc_in_progress_ = true;
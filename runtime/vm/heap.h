@@ -126,6 +126,10 @@ class Heap {
   RawInstructions* FindObjectInCodeSpace(FindObjectVisitor* visitor);
   RawInstructions* FindObjectInStubCodeSpace(FindObjectVisitor* visitor);
 
+  // Returns the instructions object containing 'pc', or null. This uses the
+  // code page index and does not walk the code space.
+  RawInstructions* FindInstructions(uword pc) const;
+
   void CollectGarbage(Space space);
   void CollectGarbage(Space space, ApiCallbacks api_callbacks);
   void CollectAllGarbage();
@@ -181,6 +185,24 @@ class Heap {
   // Returns the number of objects with a peer.
   int64_t PeerCount() const;
 
+  static const intptr_t kIdentityHashMask = 0x3FFFFFFF;
+
+  // Returns the identity hash code of an object, assigning a new one when it
+  // is first asked for. The hash code is kept in the object header on 64-bit
+  // architectures and in a side table of the object's space otherwise.
+  intptr_t IdentityHash(RawObject* raw_obj);
+
+  // Associates an identity hash code with an object in the side table.
+  void SetIdentityHash(RawObject* raw_obj, intptr_t hash);
+
+  // Retrieves the identity hash code of an object from the side table.
+  // Returns 0 if there is no association.
+  intptr_t GetIdentityHash(RawObject* raw_obj);
+
+  // Returns the number of objects with an identity hash code in the side
+  // table.
+  int64_t IdentityHashCount() const;
+
   // Stats collection.
   void RecordTime(int id, int64_t micros) {
     ASSERT((id >= 0) && (id < GCStats::kDataEntries));
@@ -236,6 +258,8 @@ class Heap {
   void RecordAfterGC();
   void PrintStats();
 
+  intptr_t NextIdentityHash();
+
   // The different spaces used for allocation.
   Scavenger* new_space_;
   PageSpace* old_space_;
@@ -246,6 +270,9 @@ class Heap {
   // The active heap trace.
   HeapTrace* heap_trace_;
 
+  // State of the generator of identity hash codes.
+  uint32_t identity_hash_state_;
+
   // This heap is in read-only mode: No allocation is allowed.
   bool read_only_;
 
@@ -5,6 +5,7 @@
 #include "platform/assert.h"
 #include "vm/globals.h"
 #include "vm/heap.h"
+#include "vm/object.h"
 #include "vm/unit_test.h"
 
 namespace dart {
@@ -50,4 +51,59 @@ TEST_CASE(LargeSweep) {
 }
 
 #endif  // defined(TARGET_ARCH_IA32) || defined(TARGET_ARCH_X64).
+
+
+TEST_CASE(IdentityHash) {
+  Isolate* isolate = Isolate::Current();
+  Heap* heap = isolate->heap();
+  const Array& new_array = Array::Handle(Array::New(1, Heap::kNew));
+  const Array& old_array = Array::Handle(Array::New(1, Heap::kOld));
+  intptr_t new_hash = heap->IdentityHash(new_array.raw());
+  intptr_t old_hash = heap->IdentityHash(old_array.raw());
+  EXPECT(new_hash > 0);
+  EXPECT(old_hash > 0);
+  EXPECT(Smi::IsValid(new_hash));
+  EXPECT(Smi::IsValid(old_hash));
+  EXPECT_EQ(new_hash, heap->IdentityHash(new_array.raw()));
+  // The hash codes survive objects being moved and collections.
+  heap->CollectGarbage(Heap::kNew);
+  heap->CollectGarbage(Heap::kNew);
+  EXPECT_EQ(new_hash, heap->IdentityHash(new_array.raw()));
+  heap->CollectGarbage(Heap::kOld);
+  EXPECT_EQ(new_hash, heap->IdentityHash(new_array.raw()));
+  EXPECT_EQ(old_hash, heap->IdentityHash(old_array.raw()));
+  // Objects of the vm isolate heap have a hash code as well.
+  intptr_t null_hash = heap->IdentityHash(Object::null());
+  EXPECT(null_hash > 0);
+  EXPECT_EQ(null_hash, heap->IdentityHash(Object::null()));
+}
+
+
+TEST_CASE(IdentityHashSideTable) {
+  Isolate* isolate = Isolate::Current();
+  Heap* heap = isolate->heap();
+  const int64_t base_count = heap->IdentityHashCount();
+  const Array& new_array = Array::Handle(Array::New(1, Heap::kNew));
+  const Array& old_array = Array::Handle(Array::New(1, Heap::kOld));
+  EXPECT_EQ(0, heap->GetIdentityHash(new_array.raw()));
+  heap->SetIdentityHash(new_array.raw(), 17);
+  heap->SetIdentityHash(old_array.raw(), 42);
+  {
+    HANDLESCOPE(isolate);
+    const Array& garbage = Array::Handle(Array::New(1, Heap::kNew));
+    heap->SetIdentityHash(garbage.raw(), 7);
+    EXPECT_EQ(base_count + 3, heap->IdentityHashCount());
+  }
+  // Entries follow the objects they belong to and are dropped with them.
+  heap->CollectGarbage(Heap::kNew);
+  heap->CollectGarbage(Heap::kNew);
+  EXPECT_EQ(base_count + 2, heap->IdentityHashCount());
+  EXPECT_EQ(17, heap->GetIdentityHash(new_array.raw()));
+  EXPECT_EQ(42, heap->GetIdentityHash(old_array.raw()));
+  heap->CollectGarbage(Heap::kOld);
+  EXPECT_EQ(base_count + 2, heap->IdentityHashCount());
+  EXPECT_EQ(17, heap->GetIdentityHash(new_array.raw()));
+  EXPECT_EQ(42, heap->GetIdentityHash(old_array.raw()));
+}
+
 }
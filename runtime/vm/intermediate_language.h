@@ -33,24 +33,24 @@ class FlowGraphOptimizer;
 // (class-name, function-name, recognized enum, fingerprint).
 // See intrinsifier for fingerprint computation.
 #define RECOGNIZED_LIST(V)                                                     \
-  V(_ObjectArray, get:length, ObjectArrayLength, 405297088)                    \
-  V(_ImmutableArray, get:length, ImmutableArrayLength, 433698233)              \
-  V(_ByteArrayBase, get:length, ByteArrayBaseLength, 1098081765)               \
-  V(_GrowableObjectArray, get:length, GrowableArrayLength, 725548050)          \
-  V(_GrowableObjectArray, get:_capacity, GrowableArrayCapacity, 725548050)     \
-  V(_StringBase, get:length, StringBaseLength, 320803993)                      \
-  V(_StringBase, get:isEmpty, StringBaseIsEmpty, 711547329)                    \
-  V(_StringBase, charCodeAt, StringBaseCharCodeAt, 984449525)                  \
-  V(_StringBase, [], StringBaseCharAt, 1062366987)                             \
-  V(_IntegerImplementation, toDouble, IntegerToDouble, 733149324)              \
-  V(_Double, toInt, DoubleToInteger, 362666636)                                \
-  V(_Double, truncate, DoubleTruncate, 620870996)                              \
-  V(_Double, round, DoubleRound, 620870996)                                    \
-  V(_Double, floor, DoubleFloor, 620870996)                                    \
-  V(_Double, ceil, DoubleCeil, 620870996)                                      \
-  V(_Double, pow, DoublePow, 1131958048)                                       \
-  V(_Double, _modulo, DoubleMod, 437099337)                                    \
-  V(::, sqrt, MathSqrt, 1662640002)                                            \
+  V(_ObjectArray, get:length, ObjectArrayLength, 558419481)                    \
+  V(_ImmutableArray, get:length, ImmutableArrayLength, 482050480)              \
+  V(_ByteArrayBase, get:length, ByteArrayBaseLength, 1146140146)               \
+  V(_GrowableObjectArray, get:length, GrowableArrayLength, 13236304)           \
+  V(_GrowableObjectArray, get:_capacity, GrowableArrayCapacity, 13236304)      \
+  V(_StringBase, get:length, StringBaseLength, 179504457)                      \
+  V(_StringBase, get:isEmpty, StringBaseIsEmpty, 1067129391)                   \
+  V(_StringBase, charCodeAt, StringBaseCharCodeAt, 515445289)                  \
+  V(_StringBase, [], StringBaseCharAt, 123636219)                              \
+  V(_IntegerImplementation, toDouble, IntegerToDouble, 1835242060)             \
+  V(_Double, toInt, DoubleToInteger, 81512819)                                 \
+  V(_Double, truncate, DoubleTruncate, 831018683)                              \
+  V(_Double, round, DoubleRound, 831018683)                                    \
+  V(_Double, floor, DoubleFloor, 831018683)                                    \
+  V(_Double, ceil, DoubleCeil, 831018683)                                      \
+  V(_Double, pow, DoublePow, 1398159905)                                       \
+  V(_Double, _modulo, DoubleMod, 526794283)                                    \
+  V(::, sqrt, MathSqrt, 1784265092)                                            \
 
 // Class that recognizes the name and owner of a function and returns the
 // corresponding enum. See RECOGNIZED_LIST above for list of recognizable
@@ -444,6 +444,11 @@ bool Intrinsifier::Object_equal(Assembler* assembler) {
 }
 
 
+bool Intrinsifier::Object_getHash(Assembler* assembler) {
+  return false;
+}
+
+
 bool Intrinsifier::String_getHashCode(Assembler* assembler) {
   return false;
 }
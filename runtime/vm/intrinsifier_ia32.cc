@@ -1771,6 +1771,13 @@ bool Intrinsifier::Object_equal(Assembler* assembler) {
 }
 
 
+// The identity hash code is kept in a side table of the heap on 32-bit
+// architectures.
+bool Intrinsifier::Object_getHash(Assembler* assembler) {
+  return false;
+}
+
+
 bool Intrinsifier::String_getHashCode(Assembler* assembler) {
   Label fall_through;
   __ movl(EAX, Address(ESP, + 1 * kWordSize));  // String object.
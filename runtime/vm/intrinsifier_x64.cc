@@ -1665,6 +1665,23 @@ bool Intrinsifier::Object_equal(Assembler* assembler) {
 }
 
 
+bool Intrinsifier::Object_getHash(Assembler* assembler) {
+  Label fall_through;
+  __ movq(RAX, Address(RSP, + 1 * kWordSize));  // Object.
+  // The identity hash code is kept in the upper half of the tags. It is 0
+  // until the runtime assigns one, and always 0 for null.
+  __ movl(RAX, FieldAddress(RAX, Object::tags_offset() +
+                                 RawObject::kIdentityHashTagBit / kBitsPerByte));
+  __ cmpq(RAX, Immediate(0));
+  __ j(EQUAL, &fall_through, Assembler::kNearJump);
+  __ SmiTag(RAX);
+  __ ret();
+  __ Bind(&fall_through);
+  // Hash not yet assigned.
+  return false;
+}
+
+
 bool Intrinsifier::String_getHashCode(Assembler* assembler) {
   Label fall_through;
   __ movq(RAX, Address(RSP, + 1 * kWordSize));  // String object.
@@ -6,8 +6,8 @@
 
 #include "include/dart_api.h"
 #include "platform/assert.h"
+#include "platform/json.h"
 #include "lib/mirrors.h"
-#include "vm/code_observers.h"
 #include "vm/compiler_stats.h"
 #include "vm/dart_api_state.h"
 #include "vm/dart_entry.h"
@@ -17,6 +17,7 @@
 #include "vm/object_store.h"
 #include "vm/parser.h"
 #include "vm/port.h"
+#include "vm/profiler.h"
 #include "vm/simulator.h"
 #include "vm/stack_frame.h"
 #include "vm/stub_code.h"
@@ -31,6 +32,7 @@ DEFINE_FLAG(bool, report_usage_count, false,
             "Track function usage and report.");
 DEFINE_FLAG(bool, trace_isolates, false,
             "Trace isolate creation and shut down.");
+DECLARE_FLAG(bool, profile);
 
 
 class IsolateMessageHandler : public MessageHandler {
@@ -272,6 +274,7 @@ Isolate::Isolate()
       stub_code_(NULL),
       debugger_(NULL),
       simulator_(NULL),
+      profiler_data_(NULL),
       long_jump_base_(NULL),
       timer_list_(),
       deopt_id_(0),
@@ -309,7 +312,14 @@ Isolate::~Isolate() {
 }
 
 void Isolate::SetCurrent(Isolate* current) {
+  Isolate* old_current = Current();
+  if (old_current != NULL) {
+    Profiler::EndExecution(old_current);
+  }
   Thread::SetThreadLocal(isolate_key, reinterpret_cast<uword>(current));
+  if (current != NULL) {
+    Profiler::BeginExecution(current);
+  }
 }
 
 
@@ -547,10 +557,17 @@ void Isolate::Shutdown() {
   if (FLAG_report_usage_count) {
     PrintInvokedFunctions();
   }
+  if (profiler_data() != NULL) {
+    if (FLAG_profile) {
+      StackZone zone(this);
+      HandleScope handle_scope(this);
+      TextBuffer buffer(1024);
+      Profiler::PrintProfile(this, Profiler::kCallTree, &buffer);
+      OS::Print("%s", buffer.buf());
+    }
+    Profiler::StopSampling(this);
+  }
   CompilerStats::Print();
-  // TODO(asiva): Move this code to Dart::Cleanup when we have that method
-  // as the cleanup for Dart::InitOnce.
-  CodeObservers::DeleteAll();
   if (FLAG_trace_isolates) {
     StackZone zone(this);
     HandleScope handle_scope(this);
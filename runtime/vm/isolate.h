@@ -25,6 +25,7 @@ class HandleScope;
 class HandleVisitor;
 class Heap;
 class ICData;
+class IsolateProfilerData;
 class LongJump;
 class MessageHandler;
 class Mutex;
@@ -246,6 +247,11 @@ class Isolate : public BaseIsolate {
   Simulator* simulator() const { return simulator_; }
   void set_simulator(Simulator* value) { simulator_ = value; }
 
+  IsolateProfilerData* profiler_data() const { return profiler_data_; }
+  void set_profiler_data(IsolateProfilerData* value) {
+    profiler_data_ = value;
+  }
+
   GcPrologueCallbacks& gc_prologue_callbacks() {
     return gc_prologue_callbacks_;
   }
@@ -369,6 +375,7 @@ class Isolate : public BaseIsolate {
   StubCode* stub_code_;
   Debugger* debugger_;
   Simulator* simulator_;
+  IsolateProfilerData* profiler_data_;
   LongJump* long_jump_base_;
   TimerList timer_list_;
   intptr_t deopt_id_;
@@ -1010,6 +1010,11 @@ RawError* Object::Init(Isolate* isolate) {
   if (!error.IsNull()) {
     return error.raw();
   }
+  patch_script = Bootstrap::LoadCollectionScript(true);
+  error = collection_lib.Patch(patch_script);
+  if (!error.IsNull()) {
+    return error.raw();
+  }
   const Script& collection_dev_script =
       Script::Handle(Bootstrap::LoadCollectionDevScript(false));
   const Library& collection_dev_lib =
@@ -6951,9 +6956,7 @@ void Stackmap::SetBit(intptr_t bit_index, bool value) const {
 }
 
 
-RawStackmap* Stackmap::New(intptr_t pc_offset,
-                           BitmapBuilder* bmap,
-                           intptr_t register_bit_count) {
+RawStackmap* Stackmap::New(BitmapBuilder* bmap, intptr_t register_bit_count) {
   ASSERT(Object::stackmap_class() != Class::null());
   ASSERT(bmap != NULL);
   Stackmap& result = Stackmap::Handle();
@@ -6977,12 +6980,10 @@ RawStackmap* Stackmap::New(intptr_t pc_offset,
     NoGCScope no_gc;
     result ^= raw;
     result.SetLength(length);
+    // Clear the padding bits of the last byte so maps can be compared with
+    // memcmp.
+    memset(result.raw_ptr()->data_, 0, payload_size);
   }
-  // When constructing a stackmap we store the pc offset in the stackmap's
-  // PC. StackmapTableBuilder::FinalizeStackmaps will replace it with the pc
-  // address.
-  ASSERT(pc_offset >= 0);
-  result.SetPC(pc_offset);
   for (intptr_t i = 0; i < length; ++i) {
     result.SetBit(i, bmap->Get(i));
   }
@@ -6991,23 +6992,43 @@ RawStackmap* Stackmap::New(intptr_t pc_offset,
 }
 
 
+bool Stackmap::Equals(const Stackmap& other) const {
+  if ((Length() != other.Length()) ||
+      (RegisterBitCount() != other.RegisterBitCount())) {
+    return false;
+  }
+  intptr_t payload_size = Utils::RoundUp(Length(), kBitsPerByte) / kBitsPerByte;
+  NoGCScope no_gc;
+  return memcmp(raw_ptr()->data_, other.raw_ptr()->data_, payload_size) == 0;
+}
+
+
+intptr_t Stackmap::Hash() const {
+  intptr_t payload_size = Utils::RoundUp(Length(), kBitsPerByte) / kBitsPerByte;
+  uint32_t hash = Length();
+  NoGCScope no_gc;
+  for (intptr_t i = 0; i < payload_size; i++) {
+    hash = (hash * 31) + raw_ptr()->data_[i];
+  }
+  return hash & kSmiMax;
+}
+
+
 const char* Stackmap::ToCString() const {
   if (IsNull()) {
     return "{null}";
   } else {
-    const char* kFormat = "%#"Px": ";
-    intptr_t fixed_length = OS::SNPrint(NULL, 0, kFormat, PC()) + 1;
     Isolate* isolate = Isolate::Current();
     // Guard against integer overflow in the computation of alloc_size.
     //
     // TODO(kmillikin): We could just truncate the string if someone
     // tries to print a 2 billion plus entry stackmap.
-    if (Length() > (kIntptrMax - fixed_length)) {
+    if (Length() > (kIntptrMax - 1)) {
       FATAL1("Length() is unexpectedly large (%"Pd")", Length());
     }
-    intptr_t alloc_size = fixed_length + Length();
+    intptr_t alloc_size = Length() + 1;
     char* chars = isolate->current_zone()->Alloc<char>(alloc_size);
-    intptr_t index = OS::SNPrint(chars, alloc_size, kFormat, PC());
+    intptr_t index = 0;
     for (intptr_t i = 0; i < Length(); i++) {
       chars[index++] = IsObject(i) ? '1' : '0';
     }
@@ -7493,9 +7514,7 @@ RawCode* Code::New(intptr_t pointer_offsets_length) {
 }
 
 
-RawCode* Code::FinalizeCode(const char* name,
-                            Assembler* assembler,
-                            bool optimized) {
+RawCode* Code::FinalizeInstructions(Assembler* assembler) {
   ASSERT(assembler != NULL);
 
   // Allocate the Instructions object.
@@ -7508,12 +7527,6 @@ RawCode* Code::FinalizeCode(const char* name,
                       instrs.size());
   assembler->FinalizeInstructions(region);
 
-  CodeObservers::NotifyAll(name,
-                           instrs.EntryPoint(),
-                           assembler->prologue_offset(),
-                           instrs.size(),
-                           optimized);
-
   const ZoneGrowableArray<int>& pointer_offsets =
       assembler->GetPointerOffsets();
 
@@ -7540,32 +7553,56 @@ RawCode* Code::FinalizeCode(const char* name,
 }
 
 
+RawCode* Code::FinalizeCode(const char* name,
+                            Assembler* assembler,
+                            bool optimized) {
+  const Code& code = Code::Handle(FinalizeInstructions(assembler));
+  code.set_is_optimized(optimized);
+  // Notify the observers once the embedded objects are resolved, so that
+  // observers copying the instructions see the final code.
+  const Instructions& instrs = Instructions::Handle(code.instructions());
+  CodeObservers::NotifyAll(name,
+                           instrs.EntryPoint(),
+                           assembler->prologue_offset(),
+                           instrs.size(),
+                           optimized,
+                           NULL);
+  return code.raw();
+}
+
+
 RawCode* Code::FinalizeCode(const Function& function,
                             Assembler* assembler,
                             bool optimized) {
-  // Calling ToFullyQualifiedCString is very expensive, try to avoid it.
-  if (CodeObservers::AreActive()) {
-    return FinalizeCode(function.ToFullyQualifiedCString(),
-                        assembler,
-                        optimized);
-  } else {
-    return FinalizeCode("", assembler);
-  }
+  // The observers are notified by NotifyCodeObservers once the compiler has
+  // attached the pc descriptors.
+  const Code& code = Code::Handle(FinalizeInstructions(assembler));
+  code.set_is_optimized(optimized);
+  return code.raw();
 }
 
 
-// Check if object matches find condition.
-bool Code::FindRawCodeVisitor::FindObject(RawObject* obj) {
-  return RawInstructions::ContainsPC(obj, pc_);
+void Code::NotifyCodeObservers(const Function& function,
+                               const Code& code,
+                               intptr_t prologue_offset,
+                               const CodeLineInfo* line_info) {
+  // Calling ToFullyQualifiedCString is very expensive, try to avoid it.
+  if (CodeObservers::AreActive()) {
+    const Instructions& instrs = Instructions::Handle(code.instructions());
+    CodeObservers::NotifyAll(function.ToFullyQualifiedCString(),
+                             instrs.EntryPoint(),
+                             prologue_offset,
+                             instrs.size(),
+                             code.is_optimized(),
+                             line_info);
+  }
 }
 
 
 RawCode* Code::LookupCode(uword pc) {
   Isolate* isolate = Isolate::Current();
   NoGCScope no_gc;
-  FindRawCodeVisitor visitor(pc);
-  RawInstructions* instr;
-  instr = isolate->heap()->FindObjectInCodeSpace(&visitor);
+  RawInstructions* instr = isolate->heap()->FindInstructions(pc);
   if (instr != Instructions::null()) {
     return instr->ptr()->code_;
   }
@@ -7574,15 +7611,23 @@ RawCode* Code::LookupCode(uword pc) {
 
 
 intptr_t Code::GetTokenIndexOfPC(uword pc) const {
-  intptr_t token_pos = -1;
   const PcDescriptors& descriptors = PcDescriptors::Handle(pc_descriptors());
-  for (intptr_t i = 0; i < descriptors.Length(); i++) {
-    if (descriptors.PC(i) == pc) {
-      token_pos = descriptors.TokenPos(i);
-      break;
+  // Descriptors are sorted by pc (see DescriptorList::FinalizePcDescriptors),
+  // find the first descriptor at 'pc'.
+  intptr_t lo = 0;
+  intptr_t hi = descriptors.Length();
+  while (lo < hi) {
+    const intptr_t mid = lo + ((hi - lo) >> 1);
+    if (descriptors.PC(mid) < pc) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
     }
   }
-  return token_pos;
+  if ((lo < descriptors.Length()) && (descriptors.PC(lo) == pc)) {
+    return descriptors.TokenPos(lo);
+  }
+  return -1;
 }
 
 
@@ -7716,13 +7761,28 @@ RawStackmap* Code::GetStackmap(uword pc, Array* maps, Stackmap* map) const {
     return Stackmap::null();
   }
   // A stack map is present in the code object, use the stack map to visit
-  // frame slots which are marked as having objects.
+  // frame slots which are marked as having objects. The table is sorted by
+  // pc offset (see StackmapTableBuilder::FinalizeStackmaps).
   *maps = stackmaps();
   *map = Stackmap::null();
-  for (intptr_t i = 0; i < maps->Length(); i++) {
-    *map ^= maps->At(i);
-    ASSERT(!map->IsNull());
-    if (map->PC() == pc) {
+  Instructions instructions;
+  instructions = this->instructions();
+  const intptr_t pc_offset = pc - instructions.EntryPoint();
+  intptr_t lo = 0;
+  intptr_t hi = (maps->Length() / kStackmapEntryLength) - 1;
+  while (lo <= hi) {
+    const intptr_t mid = lo + ((hi - lo) >> 1);
+    const intptr_t index = mid * kStackmapEntryLength;
+    const intptr_t mid_offset =
+        Smi::Value(reinterpret_cast<RawSmi*>(
+            maps->At(index + kStackmapPcOffsetEntry)));
+    if (mid_offset < pc_offset) {
+      lo = mid + 1;
+    } else if (mid_offset > pc_offset) {
+      hi = mid - 1;
+    } else {
+      *map ^= maps->At(index + kStackmapEntry);
+      ASSERT(!map->IsNull());
       return map->raw();  // We found a stack map for this frame.
     }
   }
@@ -10435,26 +10495,75 @@ const char* Bigint::ToCString() const {
 }
 
 
+// Hashes a sequence of code points. Latin-1 code points are packed four at a
+// time into a word which is mixed into the hash at once, so strings of
+// one-byte characters are hashed a word at a time. The hash only depends on
+// the code points, not on how the string is represented.
 class StringHasher : ValueObject {
  public:
-  StringHasher() : hash_(0) {}
+  StringHasher() : hash_(0), word_(0), word_length_(0), length_(0) {}
+
   void Add(int32_t ch) {
-    hash_ += ch;
-    hash_ += hash_ << 10;
-    hash_ ^= hash_ >> 6;
+    ASSERT(ch >= 0);
+    if (ch <= 0xFF) {
+      word_ |= static_cast<uint32_t>(ch) << (word_length_ * kBitsPerByte);
+      word_length_++;
+      if (word_length_ == 4) {
+        AddWord(word_);
+        word_ = 0;
+        word_length_ = 0;
+      }
+    } else {
+      FlushWord();
+      AddWord(ch);
+    }
+    length_++;
   }
+
+  // Adds four Latin-1 code points. Only valid between whole words.
+  void AddLatin1Word(const uint8_t* characters) {
+    ASSERT(word_length_ == 0);
+    AddWord(static_cast<uint32_t>(characters[0]) |
+            (static_cast<uint32_t>(characters[1]) << 8) |
+            (static_cast<uint32_t>(characters[2]) << 16) |
+            (static_cast<uint32_t>(characters[3]) << 24));
+    length_ += 4;
+  }
+
   // Return a non-zero hash of at most 'bits' bits.
   intptr_t Finalize(int bits) {
     ASSERT(1 <= bits && bits <= (kBitsPerWord - 1));
-    hash_ += hash_ << 3;
-    hash_ ^= hash_ >> 11;
-    hash_ += hash_ << 15;
-    hash_ = hash_ & ((static_cast<intptr_t>(1) << bits) - 1);
-    ASSERT(hash_ <= static_cast<uint32_t>(kMaxInt32));
-    return hash_ == 0 ? 1 : hash_;
+    FlushWord();
+    uint32_t hash = hash_ ^ length_;
+    hash ^= hash >> 16;
+    hash *= 0x85EBCA6B;
+    hash ^= hash >> 13;
+    hash *= 0xC2B2AE35;
+    hash ^= hash >> 16;
+    hash = hash & ((static_cast<intptr_t>(1) << bits) - 1);
+    ASSERT(hash <= static_cast<uint32_t>(kMaxInt32));
+    return hash == 0 ? 1 : hash;
   }
+
  private:
+  void AddWord(uint32_t word) {
+    hash_ = ((hash_ << 5) | (hash_ >> 27)) ^ word;
+    hash_ *= 0x9E3779B1;
+  }
+
+  void FlushWord() {
+    if (word_length_ > 0) {
+      AddWord(word_);
+      word_ = 0;
+      word_length_ = 0;
+    }
+  }
+
   uint32_t hash_;
+  // Latin-1 code points which have not been mixed into the hash yet.
+  uint32_t word_;
+  intptr_t word_length_;
+  uint32_t length_;
 };
 
 
@@ -10462,6 +10571,23 @@ intptr_t String::Hash(const String& str, intptr_t begin_index, intptr_t len) {
   ASSERT(begin_index >= 0);
   ASSERT(len >= 0);
   ASSERT((begin_index + len) <= str.Length());
+  if (len == 0) {
+    return StringHasher().Finalize(String::kHashBits);
+  }
+  if (str.IsOneByteString()) {
+    NoGCScope no_gc;
+    return Hash(OneByteString::CharAddr(str, begin_index), len);
+  }
+  if (str.IsExternalOneByteString()) {
+    return Hash(ExternalOneByteString::CharAddr(str, begin_index), len);
+  }
+  if (str.IsTwoByteString()) {
+    NoGCScope no_gc;
+    return Hash(TwoByteString::CharAddr(str, begin_index), len);
+  }
+  if (str.IsExternalTwoByteString()) {
+    return Hash(ExternalTwoByteString::CharAddr(str, begin_index), len);
+  }
   StringHasher hasher;
   CodePointIterator it(str, begin_index, len);
   while (it.Next()) {
@@ -10471,22 +10597,20 @@ intptr_t String::Hash(const String& str, intptr_t begin_index, intptr_t len) {
 }
 
 
-template<typename T>
-static intptr_t HashImpl(const T* characters, intptr_t len) {
+intptr_t String::Hash(const uint8_t* characters, intptr_t len) {
   ASSERT(len >= 0);
   StringHasher hasher;
-  for (intptr_t i = 0; i < len; i++) {
+  intptr_t i = 0;
+  for (; i <= len - 4; i += 4) {
+    hasher.AddLatin1Word(&characters[i]);
+  }
+  for (; i < len; i++) {
     hasher.Add(characters[i]);
   }
   return hasher.Finalize(String::kHashBits);
 }
 
 
-intptr_t String::Hash(const uint8_t* characters, intptr_t len) {
-  return HashImpl(characters, len);
-}
-
-
 intptr_t String::Hash(const uint16_t* characters, intptr_t len) {
   StringHasher hasher;
   intptr_t i = 0;
@@ -10498,7 +10622,12 @@ intptr_t String::Hash(const uint16_t* characters, intptr_t len) {
 
 
 intptr_t String::Hash(const int32_t* characters, intptr_t len) {
-  return HashImpl(characters, len);
+  ASSERT(len >= 0);
+  StringHasher hasher;
+  for (intptr_t i = 0; i < len; i++) {
+    hasher.Add(characters[i]);
+  }
+  return hasher.Finalize(String::kHashBits);
 }
 
 
@@ -10588,6 +10717,13 @@ bool String::Equals(const uint8_t* latin1_array, intptr_t len) const {
     // Lengths don't match.
     return false;
   }
+  if (len == 0) {
+    return true;
+  }
+  if (IsOneByteString()) {
+    NoGCScope no_gc;
+    return memcmp(OneByteString::CharAddr(*this, 0), latin1_array, len) == 0;
+  }
 
   for (intptr_t i = 0; i < len; i++) {
     if (this->CharAt(i) != latin1_array[i]) {
@@ -10603,6 +10739,15 @@ bool String::Equals(const uint16_t* utf16_array, intptr_t len) const {
     // Lengths don't match.
     return false;
   }
+  if (len == 0) {
+    return true;
+  }
+  if (IsTwoByteString()) {
+    NoGCScope no_gc;
+    return memcmp(TwoByteString::CharAddr(*this, 0),
+                  utf16_array,
+                  len * sizeof(uint16_t)) == 0;
+  }
 
   for (intptr_t i = 0; i < len; i++) {
     if (this->CharAt(i) != utf16_array[i]) {
@@ -29,6 +29,7 @@ class Api;
 class Assembler;
 class Closure;
 class Code;
+class CodeLineInfo;
 class DeoptInstr;
 class LocalScope;
 class Symbols;
@@ -2412,9 +2413,6 @@ class Stackmap : public Object {
 
   intptr_t Length() const { return raw_ptr()->length_; }
 
-  uword PC() const { return raw_ptr()->pc_; }
-  void SetPC(uword value) const { raw_ptr()->pc_ = value; }
-
   intptr_t RegisterBitCount() const { return raw_ptr()->register_bit_count_; }
   void SetRegisterBitCount(intptr_t register_bit_count) const {
     raw_ptr()->register_bit_count_ = register_bit_count;
@@ -2433,9 +2431,11 @@ class Stackmap : public Object {
         Utils::RoundUp(length, kBitsPerByte) / kBitsPerByte;
     return RoundedAllocationSize(sizeof(RawStackmap) + payload_size);
   }
-  static RawStackmap* New(intptr_t pc_offset,
-                          BitmapBuilder* bmap,
-                          intptr_t register_bit_count);
+  static RawStackmap* New(BitmapBuilder* bmap, intptr_t register_bit_count);
+
+  // Returns true if both maps describe the same frame layout.
+  bool Equals(const Stackmap& other) const;
+  intptr_t Hash() const;
 
  private:
   void SetLength(intptr_t length) const { raw_ptr()->length_ = length; }
@@ -2618,6 +2618,14 @@ class Code : public Object {
   void set_stackmaps(const Array& maps) const;
   RawStackmap* GetStackmap(uword pc, Array* stackmaps, Stackmap* map) const;
 
+  // The stack map table is a flat array of (pc offset, stackmap) pairs
+  // sorted by pc offset, so that it can be searched with a binary search.
+  enum {
+    kStackmapPcOffsetEntry = 0,
+    kStackmapEntry = 1,
+    kStackmapEntryLength = 2,
+  };
+
   enum {
     kSCallTableOffsetEntry = 0,
     kSCallTableFunctionEntry = 1,
@@ -2712,6 +2720,12 @@ class Code : public Object {
   static RawCode* FinalizeCode(const char* name,
                                Assembler* assembler,
                                bool optimized = false);
+  // Notifies the code observers of the code compiled for function. Called
+  // once the pc descriptors are attached. The line info may be NULL.
+  static void NotifyCodeObservers(const Function& function,
+                                  const Code& code,
+                                  intptr_t prologue_offset,
+                                  const CodeLineInfo* line_info);
   static RawCode* LookupCode(uword pc);
 
   int32_t GetPointerOffsetAt(int index) const {
@@ -2747,22 +2761,6 @@ class Code : public Object {
       GrowableArray<intptr_t>* deopt_ids) const;
 
  private:
-  // An object finder visitor interface.
-  class FindRawCodeVisitor : public FindObjectVisitor {
-   public:
-    explicit FindRawCodeVisitor(uword pc)
-        : FindObjectVisitor(Isolate::Current()), pc_(pc) { }
-    virtual ~FindRawCodeVisitor() { }
-
-    // Check if object matches find condition.
-    virtual bool FindObject(RawObject* obj);
-
-   private:
-    const uword pc_;
-
-    DISALLOW_COPY_AND_ASSIGN(FindRawCodeVisitor);
-  };
-
   static const intptr_t kEntrySize = sizeof(int32_t);  // NOLINT
 
   void set_instructions(RawInstructions* instructions) {
@@ -2791,6 +2789,10 @@ class Code : public Object {
   // and links the two in a GC safe manner.
   static RawCode* New(intptr_t pointer_offsets_length);
 
+  // Creates the code and instructions objects for the assembled code,
+  // without notifying the code observers.
+  static RawCode* FinalizeInstructions(Assembler* assembler);
+
   FINAL_HEAP_OBJECT_IMPLEMENTATION(Code, Object);
   friend class Class;
 };
@@ -4268,7 +4270,9 @@ class OneByteString : public AllStatic {
 
   friend class Class;
   friend class String;
+  friend class Jscre;
   friend class SnapshotReader;
+  friend class Utf8;
 };
 
 
@@ -4352,7 +4356,9 @@ class TwoByteString : public AllStatic {
 
   friend class Class;
   friend class String;
+  friend class Jscre;
   friend class SnapshotReader;
+  friend class Utf8;
 };
 
 
@@ -4418,6 +4424,7 @@ class ExternalOneByteString : public AllStatic {
 
   friend class Class;
   friend class String;
+  friend class Jscre;
   friend class SnapshotReader;
 };
 
@@ -4484,6 +4491,7 @@ class ExternalTwoByteString : public AllStatic {
 
   friend class Class;
   friend class String;
+  friend class Jscre;
   friend class SnapshotReader;
 };
 
@@ -4749,6 +4757,12 @@ class ByteArray : public Instance {
 
   virtual intptr_t ByteLength() const;
 
+  // Returns the address of the first byte of the array or NULL if the array
+  // is empty. The bytes of an internal array move when it is collected.
+  uint8_t* DataAddr() const {
+    return (ByteLength() == 0) ? NULL : ByteAddr(0);
+  }
+
   static void Copy(void* dst,
                    const ByteArray& src,
                    intptr_t src_offset,
@@ -6297,6 +6311,12 @@ bool String::Equals(const String& str,
   if (len != this->Length()) {
     return false;  // Lengths don't match.
   }
+  if ((len > 0) && IsOneByteString() && str.IsOneByteString()) {
+    NoGCScope no_gc;
+    return memcmp(OneByteString::CharAddr(*this, 0),
+                  OneByteString::CharAddr(str, begin_index),
+                  len) == 0;
+  }
   for (intptr_t i = 0; i < len; i++) {
     if (this->CharAt(i) != str.CharAt(begin_index + i)) {
       return false;
@@ -1612,6 +1612,66 @@ TEST_CASE(SymbolUnicode) {
 }
 
 
+TEST_CASE(StringHashRepresentations) {
+  // The hash only depends on the code points of a string, whatever its
+  // representation and length modulo the hash word size.
+  const char* kLatin1 = "Latin-1 text \xC3\xA9t\xC3\xA9 with some words";
+  for (intptr_t len = 0; len <= 9; len++) {
+    const String& one_byte =
+        String::Handle(String::SubString(String::Handle(String::New(kLatin1)),
+                                         0, len));
+    EXPECT(one_byte.IsOneByteString());
+    uint16_t utf16[9];
+    int32_t utf32[9];
+    for (intptr_t i = 0; i < len; i++) {
+      utf16[i] = one_byte.CharAt(i);
+      utf32[i] = one_byte.CharAt(i);
+    }
+    EXPECT_EQ(one_byte.Hash(), String::Hash(utf16, len));
+    EXPECT_EQ(one_byte.Hash(), String::Hash(utf32, len));
+  }
+  // Non-Latin-1 characters, including a surrogate pair, in various places.
+  uint16_t utf16[] = { 'a', 0x100, 'b', 'c', 'd', 'e', 0xD83D, 0xDC35, 'f' };
+  int32_t utf32[] = { 'a', 0x100, 'b', 'c', 'd', 'e', 0x1F435, 'f' };
+  const String& two_byte = String::Handle(String::FromUTF16(utf16, 9));
+  EXPECT(two_byte.IsTwoByteString());
+  EXPECT_EQ(two_byte.Hash(), String::Hash(utf32, 8));
+  const String& concat = String::Handle(
+      String::Concat(String::Handle(String::SubString(two_byte, 0, 4)),
+                     String::Handle(String::SubString(two_byte, 4))));
+  EXPECT_EQ(two_byte.Hash(), concat.Hash());
+  // Substrings hash like the strings they are equal to.
+  const String& hello = String::Handle(String::New("Hello, World"));
+  const String& world = String::Handle(String::New("World"));
+  EXPECT_EQ(world.Hash(), String::Hash(hello, 7, 5));
+  EXPECT_EQ(String::Hash(utf16 + 4, 5), String::Hash(two_byte, 4, 5));
+  EXPECT(hello.Hash() != world.Hash());
+}
+
+
+TEST_CASE(SymbolReserve) {
+  const String& one = String::Handle(Symbols::New("Eins"));
+  intptr_t size = Symbols::Size(Isolate::Current());
+  Symbols::Reserve(Isolate::Current(), 10000);
+  EXPECT_EQ(size, Symbols::Size(Isolate::Current()));
+  EXPECT_EQ(one.raw(), Symbols::New("Eins"));
+  const Array& symbol_table =
+      Array::Handle(Isolate::Current()->object_store()->symbol_table());
+  for (int i = 0; i < 10000; i++) {
+    char buf[256];
+    OS::SNPrint(buf, sizeof(buf), "reserved%d", i);
+    Symbols::New(buf);
+  }
+  // The symbol table did not have to grow.
+  EXPECT_EQ(symbol_table.raw(),
+            Isolate::Current()->object_store()->symbol_table());
+  EXPECT_EQ(size + 10000, Symbols::Size(Isolate::Current()));
+  EXPECT_EQ(one.raw(), Symbols::New("Eins"));
+  const String& reserved = String::Handle(Symbols::New("reserved9999"));
+  EXPECT_EQ(reserved.raw(), Symbols::New("reserved9999"));
+}
+
+
 TEST_CASE(Bool) {
   EXPECT(Bool::True().value());
   EXPECT(!Bool::False().value());
@@ -2674,6 +2734,34 @@ TEST_CASE(Code) {
 }
 
 
+// Test for finding the code object containing a pc.
+TEST_CASE(LookupCode) {
+  extern void GenerateIncrement(Assembler* assembler);
+  const intptr_t kNumCodes = 10;
+  Code* codes[kNumCodes];
+  for (intptr_t i = 0; i < kNumCodes; i++) {
+    Assembler _assembler_;
+    GenerateIncrement(&_assembler_);
+    codes[i] = &Code::Handle(Code::FinalizeCode(
+        *CreateFunction("Test_LookupCode"), &_assembler_));
+  }
+  Isolate::Current()->heap()->CollectGarbage(Heap::kOld);
+  for (intptr_t i = 0; i < kNumCodes; i++) {
+    const Code& code = *codes[i];
+    uword entry_point = code.EntryPoint();
+    EXPECT_EQ(code.raw(), Code::LookupCode(entry_point));
+    EXPECT_EQ(code.raw(), Code::LookupCode(entry_point + code.Size() / 2));
+    EXPECT_EQ(code.raw(), Code::LookupCode(entry_point + code.Size() - 1));
+  }
+  // The header of the instructions object is not part of the code.
+  const Instructions& instructions =
+      Instructions::Handle(codes[0]->instructions());
+  EXPECT_EQ(Code::null(), Code::LookupCode(RawObject::ToAddr(
+      instructions.raw())));
+  EXPECT_EQ(Code::null(), Code::LookupCode(0));
+}
+
+
 // Test for Embedded String object in the instructions.
 TEST_CASE(EmbedStringInCode) {
   extern void GenerateEmbedStringInCode(Assembler* assembler, const char* str);
@@ -65,7 +65,8 @@ class PerfCodeObserver : public CodeObserver {
                       uword base,
                       uword prologue_offset,
                       uword size,
-                      bool optimized) {
+                      bool optimized,
+                      const CodeLineInfo* line_info) {
     Dart_FileWriteCallback file_write = Isolate::file_write_callback();
     ASSERT(file_write != NULL);
     const char* format = "%"Px" %"Px" %s%s\n";
@@ -130,7 +131,8 @@ class PprofCodeObserver : public CodeObserver {
                       uword base,
                       uword prologue_offset,
                       uword size,
-                      bool optimized) {
+                      bool optimized,
+                      const CodeLineInfo* line_info) {
     ASSERT(pprof_symbol_generator_ != NULL);
     pprof_symbol_generator_->AddCode(base, size);
     pprof_symbol_generator_->AddCodeRegion(name, base, size);
@@ -154,7 +156,8 @@ class GdbCodeObserver : public CodeObserver {
                       uword base,
                       uword prologue_offset,
                       uword size,
-                      bool optimized) {
+                      bool optimized,
+                      const CodeLineInfo* line_info) {
     if (prologue_offset > 0) {
       // In order to ensure that gdb sees the first instruction of a function
       // as the prologue sequence we register two symbols for the cases when
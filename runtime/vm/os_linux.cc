@@ -4,11 +4,15 @@
 
 #include "vm/os.h"
 
+#include <elf.h>
 #include <errno.h>
+#include <fcntl.h>
 #include <limits.h>
 #include <malloc.h>
 #include <time.h>
+#include <sys/mman.h>
 #include <sys/resource.h>
+#include <sys/syscall.h>
 #include <sys/time.h>
 #include <sys/types.h>
 #include <unistd.h>
@@ -18,6 +22,7 @@
 #include "vm/dart.h"
 #include "vm/debuginfo.h"
 #include "vm/isolate.h"
+#include "vm/thread.h"
 #include "vm/zone.h"
 
 
@@ -29,12 +34,14 @@ DEFINE_FLAG(bool, generate_gdb_symbols, false,
     "Generate symbols of generated dart functions for debugging with GDB");
 DEFINE_FLAG(bool, generate_perf_events_symbols, false,
     "Generate events symbols for profiling with perf");
+DEFINE_FLAG(bool, generate_perf_jitdump, false,
+    "Writes jitdump data for profiling generated code with perf");
 DEFINE_FLAG(charp, generate_pprof_symbols, NULL,
     "Writes pprof events symbols to the provided file");
 
 class PerfCodeObserver : public CodeObserver {
  public:
-  PerfCodeObserver() {
+  PerfCodeObserver() : out_file_(NULL) {
     Dart_FileOpenCallback file_open = Isolate::file_open_callback();
     if (file_open == NULL) {
       return;
@@ -49,22 +56,22 @@ class PerfCodeObserver : public CodeObserver {
 
   ~PerfCodeObserver() {
     Dart_FileCloseCallback file_close = Isolate::file_close_callback();
-    if (file_close == NULL) {
+    if ((file_close == NULL) || (out_file_ == NULL)) {
       return;
     }
-    ASSERT(out_file_ != NULL);
     (*file_close)(out_file_);
   }
 
   virtual bool IsActive() const {
-    return FLAG_generate_perf_events_symbols;
+    return FLAG_generate_perf_events_symbols && (out_file_ != NULL);
   }
 
   virtual void Notify(const char* name,
                       uword base,
                       uword prologue_offset,
                       uword size,
-                      bool optimized) {
+                      bool optimized,
+                      const CodeLineInfo* line_info) {
     Dart_FileWriteCallback file_write = Isolate::file_write_callback();
     ASSERT(file_write != NULL);
     const char* format = "%"Px" %"Px" %s%s\n";
@@ -82,6 +89,258 @@ class PerfCodeObserver : public CodeObserver {
   DISALLOW_COPY_AND_ASSIGN(PerfCodeObserver);
 };
 
+
+// Writes /tmp/jit-<pid>.dump in the jitdump format, which includes the
+// generated code. 'perf inject --jit' uses it to add the generated code to
+// a profile recorded with 'perf record -k mono', so that 'perf report' and
+// 'perf annotate' can resolve and disassemble generated code. The format is
+// described in tools/perf/Documentation/jitdump-specification.txt of the
+// Linux sources.
+class JitDumpCodeObserver : public CodeObserver {
+ public:
+  JitDumpCodeObserver() : out_fd_(-1), marker_(NULL), code_index_(0) {
+    const char* format = "/tmp/jit-%"Pd".dump";
+    intptr_t pid = getpid();
+    intptr_t len = OS::SNPrint(NULL, 0, format, pid);
+    char* filename = new char[len + 1];
+    OS::SNPrint(filename, len + 1, format, pid);
+    out_fd_ = TEMP_FAILURE_RETRY(
+        open(filename, O_CREAT | O_TRUNC | O_RDWR, 0666));
+    delete[] filename;
+    if (out_fd_ < 0) {
+      return;
+    }
+    FileHeader header;
+    header.magic = kMagic;
+    header.version = kVersion;
+    header.total_size = sizeof(header);
+    header.elf_mach = ElfMachine();
+    header.pad1 = 0;
+    header.pid = pid;
+    header.timestamp = Timestamp();
+    header.flags = 0;
+    // perf finds the dump file through an executable mapping of it.
+    marker_size_ = getpagesize();
+    marker_ = mmap(NULL, marker_size_, PROT_READ | PROT_EXEC, MAP_PRIVATE,
+                   out_fd_, 0);
+    if ((marker_ == MAP_FAILED) || !WriteFully(&header, sizeof(header))) {
+      if (marker_ != MAP_FAILED) {
+        munmap(marker_, marker_size_);
+      }
+      marker_ = NULL;
+      close(out_fd_);
+      out_fd_ = -1;
+    }
+  }
+
+  ~JitDumpCodeObserver() {
+    if (out_fd_ < 0) {
+      return;
+    }
+    RecordHeader close_record;
+    close_record.id = kCodeClose;
+    close_record.total_size = sizeof(close_record);
+    close_record.timestamp = Timestamp();
+    WriteFully(&close_record, sizeof(close_record));
+    munmap(marker_, marker_size_);
+    close(out_fd_);
+  }
+
+  virtual bool IsActive() const {
+    return FLAG_generate_perf_jitdump && (out_fd_ >= 0);
+  }
+
+  virtual void Notify(const char* name,
+                      uword base,
+                      uword prologue_offset,
+                      uword size,
+                      bool optimized,
+                      const CodeLineInfo* line_info) {
+    const char* marker = optimized ? "*" : "";
+    const char* format = "%s%s";
+    intptr_t len = OS::SNPrint(NULL, 0, format, marker, name);
+    char* full_name = Isolate::Current()->current_zone()->Alloc<char>(len + 1);
+    OS::SNPrint(full_name, len + 1, format, marker, name);
+
+    CodeLoadRecord record;
+    record.header.id = kCodeLoad;
+    record.header.total_size = sizeof(record) + (len + 1) + size;
+    record.pid = getpid();
+    record.tid = syscall(SYS_gettid);
+    record.vma = base;
+    record.code_addr = base;
+    record.code_size = size;
+    intptr_t debug_info_size = 0;
+    uint8_t* debug_info = NULL;
+    if (line_info != NULL) {
+      debug_info = BuildDebugInfo(base, line_info, &debug_info_size);
+    }
+    // Records of concurrently compiling isolates must not interleave.
+    MutexLocker ml(&mutex_);
+    record.header.timestamp = Timestamp();
+    record.code_index = code_index_++;
+    if (debug_info != NULL) {
+      // The debug info must precede the code load record it describes.
+      DebugInfoRecord* debug_record =
+          reinterpret_cast<DebugInfoRecord*>(debug_info);
+      debug_record->header.timestamp = record.header.timestamp;
+      WriteFully(debug_info, debug_info_size);
+    }
+    WriteFully(&record, sizeof(record));
+    WriteFully(full_name, len + 1);
+    WriteFully(reinterpret_cast<void*>(base), size);
+  }
+
+ private:
+  static const uint32_t kMagic = 0x4A695444;  // 'JiTD'.
+  static const uint32_t kVersion = 1;
+
+  enum RecordType {
+    kCodeLoad = 0,
+    kCodeDebugInfo = 2,
+    kCodeClose = 3,
+  };
+
+  struct FileHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t total_size;
+    uint32_t elf_mach;
+    uint32_t pad1;
+    uint32_t pid;
+    uint64_t timestamp;
+    uint64_t flags;
+  };
+
+  struct RecordHeader {
+    uint32_t id;
+    uint32_t total_size;
+    uint64_t timestamp;
+  };
+
+  // Followed by the zero terminated name and the code bytes.
+  struct CodeLoadRecord {
+    RecordHeader header;
+    uint32_t pid;
+    uint32_t tid;
+    uint64_t vma;
+    uint64_t code_addr;
+    uint64_t code_size;
+    uint64_t code_index;
+  };
+
+  // Followed by the debug entries.
+  struct DebugInfoRecord {
+    RecordHeader header;
+    uint64_t code_addr;
+    uint64_t nr_entry;
+  };
+
+  // Followed by the zero terminated name of the source file.
+  struct DebugEntry {
+    uint64_t code_addr;
+    uint32_t line;
+    uint32_t discrim;
+  };
+
+  // Returns a debug info record for the code at base, allocated in the
+  // current zone, or NULL if there are no lines. Consecutive entries for
+  // the same line are merged.
+  static uint8_t* BuildDebugInfo(uword base,
+                                 const CodeLineInfo* line_info,
+                                 intptr_t* record_size) {
+    intptr_t length = line_info->Length();
+    Zone* zone = Isolate::Current()->current_zone();
+    const char** urls = zone->Alloc<const char*>(length);
+    intptr_t* lines = zone->Alloc<intptr_t>(length);
+    intptr_t* pc_offsets = zone->Alloc<intptr_t>(length);
+    intptr_t count = 0;
+    intptr_t size = sizeof(DebugInfoRecord);
+    for (intptr_t i = 0; i < length; i++) {
+      const char* url;
+      intptr_t line;
+      line_info->GetLocationAt(i, &url, &line);
+      if ((count > 0) && (lines[count - 1] == line) &&
+          (strcmp(urls[count - 1], url) == 0)) {
+        continue;
+      }
+      urls[count] = url;
+      lines[count] = line;
+      pc_offsets[count] = line_info->PcOffsetAt(i);
+      size += sizeof(DebugEntry) + strlen(url) + 1;
+      count++;
+    }
+    if (count == 0) {
+      return NULL;
+    }
+    uint8_t* buffer = zone->Alloc<uint8_t>(size);
+    DebugInfoRecord* record = reinterpret_cast<DebugInfoRecord*>(buffer);
+    record->header.id = kCodeDebugInfo;
+    record->header.total_size = size;
+    record->header.timestamp = 0;
+    record->code_addr = base;
+    record->nr_entry = count;
+    uint8_t* current = buffer + sizeof(DebugInfoRecord);
+    for (intptr_t i = 0; i < count; i++) {
+      DebugEntry entry;
+      entry.code_addr = base + pc_offsets[i];
+      entry.line = lines[i];
+      entry.discrim = 0;
+      memmove(current, &entry, sizeof(entry));
+      current += sizeof(entry);
+      intptr_t url_size = strlen(urls[i]) + 1;
+      memmove(current, urls[i], url_size);
+      current += url_size;
+    }
+    ASSERT(current == buffer + size);
+    *record_size = size;
+    return buffer;
+  }
+
+  static uint32_t ElfMachine() {
+#if defined(TARGET_ARCH_IA32)
+    return EM_386;
+#elif defined(TARGET_ARCH_X64)
+    return EM_X86_64;
+#elif defined(TARGET_ARCH_ARM)
+    return EM_ARM;
+#elif defined(TARGET_ARCH_MIPS)
+    return EM_MIPS;
+#else
+#error Unknown architecture.
+#endif
+  }
+
+  // Timestamps must use the clock of 'perf record -k mono'.
+  static uint64_t Timestamp() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (static_cast<uint64_t>(ts.tv_sec) * kNanosecondsPerSecond) +
+        ts.tv_nsec;
+  }
+
+  bool WriteFully(const void* buffer, intptr_t length) {
+    const uint8_t* current = reinterpret_cast<const uint8_t*>(buffer);
+    while (length > 0) {
+      ssize_t written = TEMP_FAILURE_RETRY(write(out_fd_, current, length));
+      if (written < 0) {
+        return false;
+      }
+      current += written;
+      length -= written;
+    }
+    return true;
+  }
+
+  int out_fd_;
+  void* marker_;
+  intptr_t marker_size_;
+  uint64_t code_index_;
+  Mutex mutex_;
+
+  DISALLOW_COPY_AND_ASSIGN(JitDumpCodeObserver);
+};
+
 class PprofCodeObserver : public CodeObserver {
  public:
   PprofCodeObserver() {
@@ -129,7 +388,8 @@ class PprofCodeObserver : public CodeObserver {
                       uword base,
                       uword prologue_offset,
                       uword size,
-                      bool optimized) {
+                      bool optimized,
+                      const CodeLineInfo* line_info) {
     ASSERT(pprof_symbol_generator_ != NULL);
     pprof_symbol_generator_->AddCode(base, size);
     pprof_symbol_generator_->AddCodeRegion(name, base, size);
@@ -153,7 +413,8 @@ class GdbCodeObserver : public CodeObserver {
                       uword base,
                       uword prologue_offset,
                       uword size,
-                      bool optimized) {
+                      bool optimized,
+                      const CodeLineInfo* line_info) {
     if (prologue_offset > 0) {
       // In order to ensure that gdb sees the first instruction of a function
       // as the prologue sequence we register two symbols for the cases when
@@ -378,6 +639,9 @@ void OS::RegisterCodeObservers() {
   if (FLAG_generate_perf_events_symbols) {
     CodeObservers::Register(new PerfCodeObserver);
   }
+  if (FLAG_generate_perf_jitdump) {
+    CodeObservers::Register(new JitDumpCodeObserver);
+  }
   if (FLAG_generate_gdb_symbols) {
     CodeObservers::Register(new GdbCodeObserver);
   }
@@ -35,6 +35,7 @@ HeapPage* HeapPage::Initialize(VirtualMemory* memory, PageType type) {
   result->next_ = NULL;
   result->used_ = 0;
   result->executable_ = is_executable;
+  result->object_starts_ = NULL;
   return result;
 }
 
@@ -47,6 +48,7 @@ HeapPage* HeapPage::Allocate(intptr_t size, PageType type) {
 
 
 void HeapPage::Deallocate() {
+  free(object_starts_);
   // The memory for this object will become unavailable after the delete below.
   delete memory_;
 }
@@ -90,6 +92,72 @@ RawObject* HeapPage::FindObject(FindObjectVisitor* visitor) const {
 }
 
 
+// Number of words in the object start bitmap of a regular page.
+static const intptr_t kObjectStartsLength =
+    (PageSpace::kPageSize >> kObjectAlignmentLog2) / kBitsPerWord;
+
+
+void HeapPage::RecordObjectStart(uword addr) {
+  ASSERT((addr >= object_start()) && (addr < object_end()));
+  if (object_starts_ == NULL) {
+    return;
+  }
+  intptr_t index = (addr - object_start()) >> kObjectAlignmentLog2;
+  object_starts_[index / kBitsPerWord] |=
+      static_cast<uword>(1) << (index % kBitsPerWord);
+}
+
+
+void HeapPage::ClearObjectStarts(uword start, uword end) {
+  if (object_starts_ == NULL) {
+    return;
+  }
+  intptr_t first = (start - object_start()) >> kObjectAlignmentLog2;
+  intptr_t last = (end - object_start()) >> kObjectAlignmentLog2;
+  for (intptr_t index = first; index < last; index++) {
+    object_starts_[index / kBitsPerWord] &=
+        ~(static_cast<uword>(1) << (index % kBitsPerWord));
+  }
+}
+
+
+RawObject* HeapPage::FindObjectContaining(uword addr) const {
+  if ((addr < object_start()) || (addr >= object_end())) {
+    return Object::null();
+  }
+  if (object_starts_ == NULL) {
+    // Large pages hold a single object.
+    return RawObject::FromAddr(object_start());
+  }
+  // Find the closest object start at or below 'addr'.
+  intptr_t index = (addr - object_start()) >> kObjectAlignmentLog2;
+  intptr_t word_index = index / kBitsPerWord;
+  intptr_t bit = index % kBitsPerWord;
+  uword word = object_starts_[word_index];
+  if (bit != (kBitsPerWord - 1)) {
+    word &= (static_cast<uword>(1) << (bit + 1)) - 1;
+  }
+  while (word == 0) {
+    if (word_index == 0) {
+      return Object::null();
+    }
+    word = object_starts_[--word_index];
+  }
+  bit = kBitsPerWord - 1;
+  while ((word & (static_cast<uword>(1) << bit)) == 0) {
+    bit--;
+  }
+  uword obj_addr = object_start() +
+      (((word_index * kBitsPerWord) + bit) << kObjectAlignmentLog2);
+  RawObject* raw_obj = RawObject::FromAddr(obj_addr);
+  if (addr >= (obj_addr + raw_obj->Size())) {
+    // 'addr' is in free space following the object.
+    return Object::null();
+  }
+  return raw_obj;
+}
+
+
 void HeapPage::WriteProtect(bool read_only) {
   VirtualMemory::Protection prot;
   if (read_only) {
@@ -115,6 +183,9 @@ PageSpace::PageSpace(Heap* heap, intptr_t max_capacity)
       pages_(NULL),
       pages_tail_(NULL),
       large_pages_(NULL),
+      executable_pages_(NULL),
+      executable_pages_length_(0),
+      executable_pages_capacity_(0),
       max_capacity_(max_capacity),
       capacity_(0),
       in_use_(0),
@@ -128,6 +199,7 @@ PageSpace::PageSpace(Heap* heap, intptr_t max_capacity)
 PageSpace::~PageSpace() {
   FreePages(pages_);
   FreePages(large_pages_);
+  free(executable_pages_);
 }
 
 
@@ -148,6 +220,11 @@ HeapPage* PageSpace::AllocatePage(HeapPage::PageType type) {
   pages_tail_ = page;
   capacity_ += kPageSize;
   page->set_object_end(page->memory_->end());
+  if (type == HeapPage::kExecutable) {
+    page->object_starts_ = reinterpret_cast<uword*>(
+        calloc(kObjectStartsLength, sizeof(uword)));
+    AddExecutablePage(page);
+  }
   return page;
 }
 
@@ -160,12 +237,18 @@ HeapPage* PageSpace::AllocateLargePage(intptr_t size, HeapPage::PageType type) {
   capacity_ += page_size;
   // Only one object in this page.
   page->set_object_end(page->object_start() + size);
+  if (type == HeapPage::kExecutable) {
+    AddExecutablePage(page);
+  }
   return page;
 }
 
 
 void PageSpace::FreePage(HeapPage* page, HeapPage* previous_page) {
   capacity_ -= page->memory_->size();
+  if (page->type() == HeapPage::kExecutable) {
+    RemoveExecutablePage(page);
+  }
   // Remove the page from the list.
   if (previous_page != NULL) {
     previous_page->set_next(page->next());
@@ -182,6 +265,9 @@ void PageSpace::FreePage(HeapPage* page, HeapPage* previous_page) {
 
 void PageSpace::FreeLargePage(HeapPage* page, HeapPage* previous_page) {
   capacity_ -= page->memory_->size();
+  if (page->type() == HeapPage::kExecutable) {
+    RemoveExecutablePage(page);
+  }
   // Remove the page from the list.
   if (previous_page != NULL) {
     previous_page->set_next(page->next());
@@ -202,6 +288,41 @@ void PageSpace::FreePages(HeapPage* pages) {
 }
 
 
+void PageSpace::AddExecutablePage(HeapPage* page) {
+  if (executable_pages_length_ == executable_pages_capacity_) {
+    intptr_t new_capacity =
+        (executable_pages_capacity_ == 0) ? 8 : 2 * executable_pages_capacity_;
+    HeapPage** new_pages = reinterpret_cast<HeapPage**>(
+        realloc(executable_pages_, new_capacity * sizeof(HeapPage*)));
+    if (new_pages == NULL) {
+      FATAL("Out of memory");
+    }
+    executable_pages_ = new_pages;
+    executable_pages_capacity_ = new_capacity;
+  }
+  intptr_t index = executable_pages_length_;
+  while ((index > 0) && (executable_pages_[index - 1] > page)) {
+    executable_pages_[index] = executable_pages_[index - 1];
+    index--;
+  }
+  executable_pages_[index] = page;
+  executable_pages_length_++;
+}
+
+
+void PageSpace::RemoveExecutablePage(HeapPage* page) {
+  intptr_t index = 0;
+  while (executable_pages_[index] != page) {
+    index++;
+    ASSERT(index < executable_pages_length_);
+  }
+  executable_pages_length_--;
+  for (; index < executable_pages_length_; index++) {
+    executable_pages_[index] = executable_pages_[index + 1];
+  }
+}
+
+
 uword PageSpace::TryAllocate(intptr_t size,
                              HeapPage::PageType type,
                              GrowthPolicy growth_policy) {
@@ -225,6 +346,9 @@ uword PageSpace::TryAllocate(intptr_t size,
         freelist_[type].Free(free_start, free_size);
       }
     }
+    if ((result != 0) && (type == HeapPage::kExecutable)) {
+      PageFor(RawObject::FromAddr(result))->RecordObjectStart(result);
+    }
   } else {
     // Large page allocation.
     intptr_t page_size = LargePageSizeFor(size);
@@ -292,6 +416,29 @@ bool PageSpace::Contains(uword addr, HeapPage::PageType type) const {
 }
 
 
+RawObject* PageSpace::FindExecutableObject(uword addr) const {
+  // Find the last page starting at or below 'addr'.
+  intptr_t lo = 0;
+  intptr_t hi = executable_pages_length_;
+  while (lo < hi) {
+    intptr_t mid = lo + ((hi - lo) >> 1);
+    if (reinterpret_cast<uword>(executable_pages_[mid]) <= addr) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  if (lo == 0) {
+    return Object::null();
+  }
+  HeapPage* page = executable_pages_[lo - 1];
+  if (!page->Contains(addr)) {
+    return Object::null();
+  }
+  return page->FindObjectContaining(addr);
+}
+
+
 void PageSpace::StartEndAddress(uword* start, uword* end) const {
   ASSERT(pages_ != NULL || large_pages_ != NULL);
   *start = static_cast<uword>(~0);
@@ -344,6 +491,23 @@ int64_t PageSpace::PeerCount() const {
 }
 
 
+void PageSpace::SetIdentityHash(RawObject* raw_obj, intptr_t hash) {
+  ASSERT(hash != 0);
+  identity_hash_table_[raw_obj] = hash;
+}
+
+
+intptr_t PageSpace::GetIdentityHash(RawObject* raw_obj) {
+  IdentityHashTable::iterator it = identity_hash_table_.find(raw_obj);
+  return (it == identity_hash_table_.end()) ? 0 : it->second;
+}
+
+
+int64_t PageSpace::IdentityHashCount() const {
+  return static_cast<int64_t>(identity_hash_table_.size());
+}
+
+
 void PageSpace::VisitObjectPointers(ObjectPointerVisitor* visitor) const {
   HeapPage* page = pages_;
   while (page != NULL) {
@@ -57,6 +57,15 @@ class HeapPage {
 
   RawObject* FindObject(FindObjectVisitor* visitor) const;
 
+  // Executable pages keep a bitmap of object start addresses, one bit per
+  // object alignment unit, so that the object containing an address can be
+  // found without walking the page.
+  void RecordObjectStart(uword addr);
+  void ClearObjectStarts(uword start, uword end);
+
+  // Returns the object in this executable page containing 'addr', or null.
+  RawObject* FindObjectContaining(uword addr) const;
+
   void WriteProtect(bool read_only);
 
  private:
@@ -77,6 +86,8 @@ class HeapPage {
   uword used_;
   uword object_end_;
   bool executable_;
+  // Object start bitmap of regular executable pages, NULL otherwise.
+  uword* object_starts_;
 
   friend class PageSpace;
 
@@ -194,6 +205,11 @@ class PageSpace {
   RawObject* FindObject(FindObjectVisitor* visitor,
                         HeapPage::PageType type) const;
 
+  // Returns the object in an executable page containing 'addr', or null.
+  // Uses a table of the executable pages sorted by address and the object
+  // start bitmap of the page, instead of walking all executable objects.
+  RawObject* FindExecutableObject(uword addr) const;
+
   // Collect the garbage in the page space using mark-sweep.
   void MarkSweep(bool invoke_api_callbacks);
 
@@ -220,6 +236,16 @@ class PageSpace {
 
   PeerTable* GetPeerTable() { return &peer_table_; }
 
+  typedef std::map<RawObject*, intptr_t> IdentityHashTable;
+
+  void SetIdentityHash(RawObject* raw_obj, intptr_t hash);
+
+  intptr_t GetIdentityHash(RawObject* raw_obj);
+
+  int64_t IdentityHashCount() const;
+
+  IdentityHashTable* GetIdentityHashTable() { return &identity_hash_table_; }
+
  private:
   // Ids for time and data records in Heap::GCStats.
   enum {
@@ -245,6 +271,9 @@ class PageSpace {
 
   static intptr_t LargePageSizeFor(intptr_t size);
 
+  void AddExecutablePage(HeapPage* page);
+  void RemoveExecutablePage(HeapPage* page);
+
   bool CanIncreaseCapacity(intptr_t increase) {
     ASSERT(capacity_ <= max_capacity_);
     return increase <= (max_capacity_ - capacity_);
@@ -258,8 +287,15 @@ class PageSpace {
   HeapPage* pages_tail_;
   HeapPage* large_pages_;
 
+  // All executable pages, regular and large, sorted by address.
+  HeapPage** executable_pages_;
+  intptr_t executable_pages_length_;
+  intptr_t executable_pages_capacity_;
+
   PeerTable peer_table_;
 
+  IdentityHashTable identity_hash_table_;
+
   // Various sizes being tracked for this generation.
   intptr_t max_capacity_;
   intptr_t capacity_;
@@ -0,0 +1,535 @@
+// Copyright (c) 2013, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/profiler.h"
+
+#include "platform/json.h"
+#include "platform/utils.h"
+#include "vm/dart.h"
+#include "vm/flags.h"
+#include "vm/growable_array.h"
+#include "vm/hash_map.h"
+#include "vm/heap.h"
+#include "vm/isolate.h"
+#include "vm/object.h"
+#include "vm/stack_frame.h"
+#include "vm/stub_code.h"
+
+namespace dart {
+
+DEFINE_FLAG(bool, profile, false,
+            "Sample all isolates with the CPU profiler and print their "
+            "profiles when they shut down.");
+DEFINE_FLAG(int, profile_period, 1,
+            "Time between CPU profiler samples in milliseconds.");
+
+bool Profiler::initialized_ = false;
+bool Profiler::sampler_running_ = false;
+bool Profiler::shutdown_ = false;
+Monitor* Profiler::monitor_ = NULL;
+IsolateProfilerData* Profiler::isolates_ = NULL;
+
+
+SampleBuffer::SampleBuffer(intptr_t capacity)
+    : samples_(new Sample[capacity]),
+      capacity_(capacity),
+      cursor_(0),
+      reading_(false) {
+  ASSERT(capacity > 0);
+}
+
+
+SampleBuffer::~SampleBuffer() {
+  delete[] samples_;
+}
+
+
+Sample* SampleBuffer::ReserveSample() {
+  if (reading_) {
+    return NULL;
+  }
+  Sample* sample = &samples_[cursor_ % capacity_];
+  cursor_++;
+  return sample;
+}
+
+
+intptr_t SampleBuffer::Length() const {
+  return Utils::Minimum(cursor_, capacity_);
+}
+
+
+const Sample& SampleBuffer::At(intptr_t index) const {
+  ASSERT((index >= 0) && (index < Length()));
+  if (cursor_ <= capacity_) {
+    return samples_[index];
+  }
+  return samples_[(cursor_ + index) % capacity_];
+}
+
+
+IsolateProfilerData::IsolateProfilerData(Isolate* isolate,
+                                         intptr_t sample_capacity)
+    : isolate_(isolate),
+      sample_buffer_(sample_capacity),
+      running_(false),
+      thread_(),
+      stack_top_(0),
+      next_(NULL) {
+}
+
+
+IsolateProfilerData::~IsolateProfilerData() {
+}
+
+
+void Profiler::InitOnce() {
+  ASSERT(monitor_ == NULL);
+  monitor_ = new Monitor();
+}
+
+
+void Profiler::Shutdown() {
+  monitor_->Enter();
+  shutdown_ = true;
+  // Wake up the sampler thread and wait for it to acknowledge the shutdown.
+  monitor_->NotifyAll();
+  while (sampler_running_) {
+    monitor_->Wait(Monitor::kNoTimeout);
+  }
+  monitor_->Exit();
+}
+
+
+// Returns the highest stack address frames of the current thread may be
+// walked up to. This is the top of the isolate's stack when the isolate was
+// set up on this thread, otherwise the current stack position.
+static uword CurrentStackTop(Isolate* isolate) {
+  uword stack_position = reinterpret_cast<uword>(&isolate);
+  uword stack_limit = isolate->saved_stack_limit();
+  uword stack_top = stack_limit + Isolate::GetSpecifiedStackSize();
+  if ((stack_position > stack_limit) && (stack_position < stack_top)) {
+    return stack_top;
+  }
+  return stack_position;
+}
+
+
+bool Profiler::StartSampling(Isolate* isolate) {
+  ASSERT(isolate == Isolate::Current());
+  monitor_->Enter();
+  if (!initialized_) {
+    initialized_ = PlatformInit();
+  }
+  if (!initialized_ || shutdown_) {
+    monitor_->Exit();
+    return false;
+  }
+  if (isolate->profiler_data() == NULL) {
+    IsolateProfilerData* data =
+        new IsolateProfilerData(isolate, kSampleBufferCapacity);
+    // The isolate is running on the current thread.
+    data->running_ = true;
+    data->thread_ = Thread::GetCurrentThreadId();
+    data->stack_top_ = CurrentStackTop(isolate);
+    data->next_ = isolates_;
+    isolates_ = data;
+    isolate->set_profiler_data(data);
+  }
+  if (!sampler_running_) {
+    int result = Thread::Start(SamplerThreadMain, 0);
+    if (result != 0) {
+      FATAL1("Could not start profiler sampler thread %d.", result);
+    }
+    sampler_running_ = true;
+  }
+  monitor_->Notify();
+  monitor_->Exit();
+  return true;
+}
+
+
+void Profiler::StopSampling(Isolate* isolate) {
+  ASSERT(isolate == Isolate::Current());
+  IsolateProfilerData* data = isolate->profiler_data();
+  if (data == NULL) {
+    return;
+  }
+  monitor_->Enter();
+  IsolateProfilerData* previous = NULL;
+  IsolateProfilerData* current = isolates_;
+  while (current != data) {
+    previous = current;
+    current = current->next_;
+    ASSERT(current != NULL);
+  }
+  if (previous == NULL) {
+    isolates_ = data->next_;
+  } else {
+    previous->next_ = data->next_;
+  }
+  isolate->set_profiler_data(NULL);
+  monitor_->Exit();
+  delete data;
+}
+
+
+void Profiler::BeginExecution(Isolate* isolate) {
+  IsolateProfilerData* data = isolate->profiler_data();
+  if (data == NULL) {
+    return;
+  }
+  monitor_->Enter();
+  data->running_ = true;
+  data->thread_ = Thread::GetCurrentThreadId();
+  data->stack_top_ = CurrentStackTop(isolate);
+  monitor_->Exit();
+}
+
+
+void Profiler::EndExecution(Isolate* isolate) {
+  IsolateProfilerData* data = isolate->profiler_data();
+  if (data == NULL) {
+    return;
+  }
+  monitor_->Enter();
+  data->running_ = false;
+  monitor_->Exit();
+}
+
+
+void Profiler::SamplerThreadMain(uword parameter) {
+  monitor_->Enter();
+  while (!shutdown_) {
+    if (isolates_ == NULL) {
+      monitor_->Wait(Monitor::kNoTimeout);
+      continue;
+    }
+    monitor_->Wait(FLAG_profile_period);
+    if (shutdown_) {
+      break;
+    }
+    for (IsolateProfilerData* data = isolates_;
+         data != NULL;
+         data = data->next_) {
+      if (data->running_) {
+        SampleThread(data);
+      }
+    }
+  }
+  sampler_running_ = false;
+  monitor_->NotifyAll();
+  monitor_->Exit();
+}
+
+
+void Profiler::RecordSample(IsolateProfilerData* data,
+                            uword pc,
+                            uword fp,
+                            uword sp) {
+  Sample* sample = data->sample_buffer()->ReserveSample();
+  if (sample == NULL) {
+    return;
+  }
+  // Walk the frame pointer chain. Every frame holds the caller's frame
+  // pointer followed by the return address; only frames between the
+  // interrupted stack pointer and the top of the isolate's stack are read.
+  uword stack_top = data->stack_top();
+  sample->pcs_[0] = pc;
+  intptr_t depth = 1;
+  while (depth < Sample::kMaxDepth) {
+    if ((fp < sp) ||
+        (fp > (stack_top - (2 * kWordSize))) ||
+        !Utils::IsAligned(fp, kWordSize)) {
+      break;
+    }
+    uword* frame = reinterpret_cast<uword*>(fp);
+    uword caller_fp = frame[0];
+    uword return_address = frame[1];
+    if (return_address == 0) {
+      break;
+    }
+    sample->pcs_[depth++] = return_address;
+    if (caller_fp <= fp) {
+      break;
+    }
+    fp = caller_fp;
+  }
+  sample->depth_ = depth;
+}
+
+
+// The names of the functions executing at a pc, innermost first.
+class PcSymbols : public ZoneAllocated {
+ public:
+  PcSymbols(uword pc, bool is_return_address)
+      : pc_(pc), is_return_address_(is_return_address), names_(2) { }
+
+  intptr_t Hashcode() const { return static_cast<intptr_t>(pc_ >> 2); }
+  bool Equals(PcSymbols* other) const {
+    return (pc_ == other->pc_) &&
+        (is_return_address_ == other->is_return_address_);
+  }
+
+  uword pc() const { return pc_; }
+  bool is_return_address() const { return is_return_address_; }
+  ZoneGrowableArray<const char*>* names() { return &names_; }
+
+  // Only used to reuse a single lookup key.
+  void set_key(uword pc, bool is_return_address) {
+    pc_ = pc;
+    is_return_address_ = is_return_address;
+  }
+
+ private:
+  uword pc_;
+  bool is_return_address_;
+  ZoneGrowableArray<const char*> names_;
+
+  DISALLOW_COPY_AND_ASSIGN(PcSymbols);
+};
+
+
+class ProfileNode : public ZoneAllocated {
+ public:
+  explicit ProfileNode(const char* name)
+      : name_(name), count_(0), self_count_(0), children_(2) { }
+
+  const char* name() const { return name_; }
+  intptr_t count() const { return count_; }
+  intptr_t self_count() const { return self_count_; }
+  void Tick() { count_++; }
+  void TickSelf() { self_count_++; }
+
+  intptr_t NumChildren() const { return children_.length(); }
+  ProfileNode* ChildAt(intptr_t index) const { return children_[index]; }
+
+  ProfileNode* GetChild(const char* name) {
+    for (intptr_t i = 0; i < children_.length(); i++) {
+      if (strcmp(children_[i]->name(), name) == 0) {
+        return children_[i];
+      }
+    }
+    ProfileNode* child = new ProfileNode(name);
+    children_.Add(child);
+    return child;
+  }
+
+  void SortChildren() {
+    children_.Sort(CompareCount);
+    for (intptr_t i = 0; i < children_.length(); i++) {
+      children_[i]->SortChildren();
+    }
+  }
+
+ private:
+  static int CompareCount(ProfileNode* const* a, ProfileNode* const* b) {
+    return (*b)->count() - (*a)->count();
+  }
+
+  const char* name_;
+  intptr_t count_;
+  intptr_t self_count_;
+  ZoneGrowableArray<ProfileNode*> children_;
+
+  DISALLOW_COPY_AND_ASSIGN(ProfileNode);
+};
+
+
+// Builds a call tree from the samples of an isolate.
+class ProfileBuilder : public ValueObject {
+ public:
+  explicit ProfileBuilder(Isolate* isolate)
+      : isolate_(isolate),
+        root_(new ProfileNode("[Root]")),
+        code_(Code::Handle()),
+        function_(Function::Handle()),
+        lookup_key_(new PcSymbols(0, false)),
+        symbols_() { }
+
+  void AddSample(const Sample& sample);
+
+  void PrintCallTree(TextBuffer* buffer);
+  void PrintCollapsedStacks(TextBuffer* buffer);
+
+  ProfileNode* root() const { return root_; }
+
+ private:
+  PcSymbols* Symbolize(uword pc, bool is_return_address);
+  void SymbolizeCode(uword pc, PcSymbols* symbols);
+  void PrintNode(ProfileNode* node, intptr_t depth, TextBuffer* buffer);
+  void PrintStacks(ProfileNode* node, const char* path, TextBuffer* buffer);
+
+  Isolate* isolate_;
+  ProfileNode* root_;
+  Code& code_;
+  Function& function_;
+  // Zone allocated objects cannot live on the stack.
+  PcSymbols* lookup_key_;
+  DirectChainedHashMap<PointerKeyValueTrait<PcSymbols> > symbols_;
+
+  DISALLOW_COPY_AND_ASSIGN(ProfileBuilder);
+};
+
+
+void ProfileBuilder::AddSample(const Sample& sample) {
+  ProfileNode* node = root_;
+  node->Tick();
+  // Walk from the outermost frame to the interrupted frame.
+  for (intptr_t i = sample.depth() - 1; i >= 0; i--) {
+    PcSymbols* symbols = Symbolize(sample.pc(i), i > 0);
+    ZoneGrowableArray<const char*>* names = symbols->names();
+    for (intptr_t j = names->length() - 1; j >= 0; j--) {
+      node = node->GetChild((*names)[j]);
+      node->Tick();
+    }
+  }
+  node->TickSelf();
+}
+
+
+PcSymbols* ProfileBuilder::Symbolize(uword pc, bool is_return_address) {
+  lookup_key_->set_key(pc, is_return_address);
+  PcSymbols* symbols = symbols_.Lookup(lookup_key_);
+  if (symbols == NULL) {
+    symbols = new PcSymbols(pc, is_return_address);
+    SymbolizeCode(pc, symbols);
+    symbols_.Insert(symbols);
+  }
+  return symbols;
+}
+
+
+void ProfileBuilder::SymbolizeCode(uword pc, PcSymbols* symbols) {
+  Zone* zone = isolate_->current_zone();
+  ZoneGrowableArray<const char*>* names = symbols->names();
+  // A return address may be the end of the code of the caller.
+  uword lookup_pc = symbols->is_return_address() ? pc - 1 : pc;
+  code_ = Code::LookupCode(lookup_pc);
+  if (code_.IsNull()) {
+    // Shared stubs live in the vm isolate.
+    const Instructions& instructions = Instructions::Handle(
+        Dart::vm_isolate()->heap()->FindInstructions(lookup_pc));
+    if (!instructions.IsNull()) {
+      code_ = instructions.code();
+    }
+  }
+  if (code_.IsNull()) {
+    if (isolate_->heap()->CodeContains(lookup_pc)) {
+      names->Add("[Unknown code]");
+      return;
+    }
+    const char* native_name = Profiler::NativeSymbolName(lookup_pc);
+    if (native_name == NULL) {
+      names->Add("[Native] <unknown>");
+    } else {
+      names->Add(zone->PrintToString("[Native] %s", native_name));
+    }
+    return;
+  }
+  function_ = code_.function();
+  if (function_.IsNull()) {
+    const char* stub_name = StubCode::NameOfStub(code_.EntryPoint());
+    names->Add(zone->PrintToString("[Stub] %s",
+                                   (stub_name == NULL) ? "<unknown>"
+                                                       : stub_name));
+    return;
+  }
+  if (!code_.is_optimized()) {
+    names->Add(zone->PrintToString("[Unoptimized] %s",
+                                   function_.ToFullyQualifiedCString()));
+    return;
+  }
+  // Expand the functions inlined at this pc, the last function returned is
+  // the optimized function itself.
+  InlinedFunctionsInDartFrameIterator inlined(code_, pc);
+  uword inlined_pc = 0;
+  function_ = inlined.GetNextFunction(&inlined_pc);
+  while (!function_.IsNull()) {
+    const char* name = function_.ToFullyQualifiedCString();
+    function_ = inlined.GetNextFunction(&inlined_pc);
+    names->Add(zone->PrintToString("[%s] %s",
+                                   function_.IsNull() ? "Optimized"
+                                                      : "Inlined",
+                                   name));
+  }
+}
+
+
+void ProfileBuilder::PrintCallTree(TextBuffer* buffer) {
+  root_->SortChildren();
+  buffer->Printf("Profile of isolate '%s': %"Pd" samples\n",
+                 isolate_->name(), root_->count());
+  buffer->Printf("   total      self  function\n");
+  PrintNode(root_, 0, buffer);
+}
+
+
+void ProfileBuilder::PrintNode(ProfileNode* node,
+                               intptr_t depth,
+                               TextBuffer* buffer) {
+  double percent = (root_->count() == 0) ? 0.0 :
+      (100.0 * node->count()) / root_->count();
+  buffer->Printf("%7.2f%% %8"Pd"  %*s%s\n",
+                 percent,
+                 node->self_count(),
+                 static_cast<int>(2 * depth), "",
+                 node->name());
+  for (intptr_t i = 0; i < node->NumChildren(); i++) {
+    PrintNode(node->ChildAt(i), depth + 1, buffer);
+  }
+}
+
+
+void ProfileBuilder::PrintCollapsedStacks(TextBuffer* buffer) {
+  for (intptr_t i = 0; i < root_->NumChildren(); i++) {
+    ProfileNode* child = root_->ChildAt(i);
+    PrintStacks(child, child->name(), buffer);
+  }
+}
+
+
+void ProfileBuilder::PrintStacks(ProfileNode* node,
+                                 const char* path,
+                                 TextBuffer* buffer) {
+  if (node->self_count() > 0) {
+    buffer->Printf("%s %"Pd"\n", path, node->self_count());
+  }
+  Zone* zone = isolate_->current_zone();
+  for (intptr_t i = 0; i < node->NumChildren(); i++) {
+    ProfileNode* child = node->ChildAt(i);
+    PrintStacks(child,
+                zone->PrintToString("%s;%s", path, child->name()),
+                buffer);
+  }
+}
+
+
+void Profiler::PrintProfile(Isolate* isolate,
+                            ProfileFormat format,
+                            TextBuffer* buffer) {
+  ASSERT(isolate == Isolate::Current());
+  IsolateProfilerData* data = isolate->profiler_data();
+  ASSERT(data != NULL);
+  SampleBuffer* samples = data->sample_buffer();
+  ProfileBuilder builder(isolate);
+  // No samples are taken while the buffer is read.
+  samples->set_reading(true);
+  for (intptr_t i = 0; i < samples->Length(); i++) {
+    builder.AddSample(samples->At(i));
+  }
+  samples->set_reading(false);
+  switch (format) {
+    case kCallTree:
+      builder.PrintCallTree(buffer);
+      break;
+    case kCollapsedStacks:
+      builder.PrintCollapsedStacks(buffer);
+      break;
+    default:
+      UNREACHABLE();
+  }
+}
+
+}  // namespace dart
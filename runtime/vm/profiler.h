@@ -0,0 +1,163 @@
+// Copyright (c) 2013, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#ifndef VM_PROFILER_H_
+#define VM_PROFILER_H_
+
+#include "include/dart_api.h"
+#include "platform/thread.h"
+#include "vm/allocation.h"
+#include "vm/globals.h"
+
+namespace dart {
+
+// Forward declarations.
+class Isolate;
+class TextBuffer;
+
+// A sample of the stack of the thread running an isolate. pcs_[0] is the
+// interrupted pc, the following entries are the return addresses found by
+// walking the frame pointer chain.
+class Sample {
+ public:
+  static const intptr_t kMaxDepth = 32;
+
+  intptr_t depth() const { return depth_; }
+  uword pc(intptr_t index) const {
+    ASSERT((index >= 0) && (index < depth_));
+    return pcs_[index];
+  }
+
+ private:
+  intptr_t depth_;
+  uword pcs_[kMaxDepth];
+
+  friend class Profiler;
+};
+
+
+// A fixed size ring buffer of samples. Samples are written from the thread
+// running the isolate, possibly from a signal handler, and therefore the
+// buffer never allocates once it has been created.
+class SampleBuffer {
+ public:
+  explicit SampleBuffer(intptr_t capacity);
+  ~SampleBuffer();
+
+  // Returns the slot for the next sample, overwriting the oldest sample once
+  // the buffer is full. Returns NULL while the buffer is being read.
+  Sample* ReserveSample();
+
+  // Number of samples currently held in the buffer.
+  intptr_t Length() const;
+  // The samples are ordered from oldest to newest.
+  const Sample& At(intptr_t index) const;
+
+  void Clear() { cursor_ = 0; }
+
+  void set_reading(bool value) { reading_ = value; }
+
+ private:
+  Sample* samples_;
+  intptr_t capacity_;
+  intptr_t cursor_;  // Total number of samples taken.
+  volatile bool reading_;
+
+  DISALLOW_COPY_AND_ASSIGN(SampleBuffer);
+};
+
+
+// Per isolate profiler state, owned by the isolate while it is sampled.
+class IsolateProfilerData {
+ public:
+  IsolateProfilerData(Isolate* isolate, intptr_t sample_capacity);
+  ~IsolateProfilerData();
+
+  Isolate* isolate() const { return isolate_; }
+  SampleBuffer* sample_buffer() { return &sample_buffer_; }
+
+  // The thread running the isolate and the top of its stack when the isolate
+  // was entered. Frames are only walked below stack_top.
+  bool running() const { return running_; }
+  ThreadId thread() const { return thread_; }
+  uword stack_top() const { return stack_top_; }
+
+ private:
+  Isolate* isolate_;
+  SampleBuffer sample_buffer_;
+  bool running_;
+  ThreadId thread_;
+  uword stack_top_;
+  IsolateProfilerData* next_;
+
+  friend class Profiler;
+
+  DISALLOW_COPY_AND_ASSIGN(IsolateProfilerData);
+};
+
+
+// The profiler samples the threads running profiled isolates at a fixed
+// period from a separate sampler thread. On POSIX systems the sampled thread
+// is interrupted with SIGPROF and records its own stack, on Windows the
+// sampler thread suspends the sampled thread and records its stack.
+//
+// Samples are symbolized when a profile is requested: each pc is attributed
+// to optimized, unoptimized or stub code, expanding functions inlined into
+// optimized code, or to native code.
+class Profiler : public AllStatic {
+ public:
+  enum ProfileFormat {
+    kCallTree = 0,
+    kCollapsedStacks,
+  };
+
+  static void InitOnce();
+  // Stops the sampler thread and waits for it to exit. Called at VM
+  // shutdown, after all isolates have stopped sampling.
+  static void Shutdown();
+
+  // Start and stop sampling an isolate.
+  static bool StartSampling(Isolate* isolate);
+  static void StopSampling(Isolate* isolate);
+
+  // Called when a thread enters or exits an isolate.
+  static void BeginExecution(Isolate* isolate);
+  static void EndExecution(Isolate* isolate);
+
+  // Writes the profile of the samples taken so far in the current isolate.
+  static void PrintProfile(Isolate* isolate,
+                           ProfileFormat format,
+                           TextBuffer* buffer);
+
+  // Records a sample for a thread stopped at the given registers. Must only
+  // be called on the sampled thread or while it is suspended.
+  static void RecordSample(IsolateProfilerData* data,
+                           uword pc,
+                           uword fp,
+                           uword sp);
+
+ private:
+  static const intptr_t kSampleBufferCapacity = 16 * KB;
+
+  static void SamplerThreadMain(uword parameter);
+
+  // Platform specific support.
+  static bool PlatformInit();
+  static void SampleThread(IsolateProfilerData* data);
+  // Returns the name of the native symbol containing pc or NULL, the result
+  // is allocated in the current zone.
+  static const char* NativeSymbolName(uword pc);
+
+  static bool initialized_;
+  static bool sampler_running_;
+  static bool shutdown_;
+  static Monitor* monitor_;
+  static IsolateProfilerData* isolates_;
+
+  friend class ProfileBuilder;
+};
+
+}  // namespace dart
+
+#endif  // VM_PROFILER_H_
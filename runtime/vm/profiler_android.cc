@@ -0,0 +1,25 @@
+// Copyright (c) 2013, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/profiler.h"
+
+namespace dart {
+
+// Bionic does not expose the machine context of a signal, so sampling is not
+// supported on Android.
+bool Profiler::PlatformInit() {
+  return false;
+}
+
+
+void Profiler::SampleThread(IsolateProfilerData* data) {
+  UNREACHABLE();
+}
+
+
+const char* Profiler::NativeSymbolName(uword pc) {
+  return NULL;
+}
+
+}  // namespace dart
@@ -0,0 +1,73 @@
+// Copyright (c) 2013, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/profiler.h"
+
+#include <dlfcn.h>
+#include <signal.h>
+#include <string.h>
+#include <ucontext.h>
+
+#include "vm/isolate.h"
+#include "vm/zone.h"
+
+namespace dart {
+
+static void ProfileSignalHandler(int signal, siginfo_t* info, void* context) {
+  if (signal != SIGPROF) {
+    return;
+  }
+  Isolate* isolate = Isolate::Current();
+  if ((isolate == NULL) || (isolate->profiler_data() == NULL)) {
+    return;
+  }
+  ucontext_t* ucontext = reinterpret_cast<ucontext_t*>(context);
+  mcontext_t mcontext = ucontext->uc_mcontext;
+  uword pc = 0;
+  uword fp = 0;
+  uword sp = 0;
+#if defined(HOST_ARCH_IA32)
+  pc = static_cast<uword>(mcontext.gregs[REG_EIP]);
+  fp = static_cast<uword>(mcontext.gregs[REG_EBP]);
+  sp = static_cast<uword>(mcontext.gregs[REG_ESP]);
+#elif defined(HOST_ARCH_X64)
+  pc = static_cast<uword>(mcontext.gregs[REG_RIP]);
+  fp = static_cast<uword>(mcontext.gregs[REG_RBP]);
+  sp = static_cast<uword>(mcontext.gregs[REG_RSP]);
+#elif defined(HOST_ARCH_ARM)
+  pc = static_cast<uword>(mcontext.arm_pc);
+  fp = static_cast<uword>(mcontext.arm_fp);
+  sp = static_cast<uword>(mcontext.arm_sp);
+#else
+  UNIMPLEMENTED();
+#endif
+  Profiler::RecordSample(isolate->profiler_data(), pc, fp, sp);
+}
+
+
+bool Profiler::PlatformInit() {
+  struct sigaction act;
+  memset(&act, 0, sizeof(act));
+  act.sa_sigaction = ProfileSignalHandler;
+  sigemptyset(&act.sa_mask);
+  act.sa_flags = SA_RESTART | SA_SIGINFO;
+  return sigaction(SIGPROF, &act, NULL) == 0;
+}
+
+
+void Profiler::SampleThread(IsolateProfilerData* data) {
+  pthread_kill(data->thread(), SIGPROF);
+}
+
+
+const char* Profiler::NativeSymbolName(uword pc) {
+  Dl_info info;
+  if ((dladdr(reinterpret_cast<void*>(pc), &info) == 0) ||
+      (info.dli_sname == NULL)) {
+    return NULL;
+  }
+  return Isolate::Current()->current_zone()->MakeCopyOfString(info.dli_sname);
+}
+
+}  // namespace dart
@@ -0,0 +1,84 @@
+// Copyright (c) 2013, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "platform/assert.h"
+#include "platform/json.h"
+#include "vm/dart_api_impl.h"
+#include "vm/profiler.h"
+#include "vm/unit_test.h"
+
+namespace dart {
+
+TEST_CASE(SampleBuffer) {
+  SampleBuffer buffer(3);
+  EXPECT_EQ(0, buffer.Length());
+  for (intptr_t i = 0; i < 5; i++) {
+    Sample* sample = buffer.ReserveSample();
+    EXPECT(sample != NULL);
+  }
+  // The oldest samples are overwritten once the buffer is full.
+  EXPECT_EQ(3, buffer.Length());
+  buffer.set_reading(true);
+  EXPECT(buffer.ReserveSample() == NULL);
+  buffer.set_reading(false);
+  buffer.Clear();
+  EXPECT_EQ(0, buffer.Length());
+}
+
+
+static void WriteCallback(const void* data, intptr_t length, void* stream) {
+  TextBuffer* buffer = reinterpret_cast<TextBuffer*>(stream);
+  buffer->Printf("%.*s", static_cast<int>(length),
+                 reinterpret_cast<const char*>(data));
+}
+
+
+TEST_CASE(CpuProfile) {
+  const char* kScriptChars =
+      "spin(int ms) {\n"
+      "  var watch = new Stopwatch()..start();\n"
+      "  var count = 0;\n"
+      "  while (watch.elapsedMilliseconds < ms) {\n"
+      "    count++;\n"
+      "  }\n"
+      "  return count;\n"
+      "}\n";
+  Dart_Handle lib = TestCase::LoadTestScript(kScriptChars, NULL);
+  EXPECT_VALID(lib);
+
+  TextBuffer profile(1024);
+  // No profile before profiling is started.
+  EXPECT(Dart_IsError(Dart_CpuProfile(kCpuProfileCallTree,
+                                      WriteCallback,
+                                      &profile)));
+  Dart_Handle result = Dart_StartCpuProfiling();
+  if (Dart_IsError(result)) {
+    // Not supported on this platform.
+    return;
+  }
+  Dart_Handle args[1] = { Dart_NewInteger(200) };
+  result = Dart_Invoke(lib, NewString("spin"), 1, args);
+  EXPECT_VALID(result);
+
+  result = Dart_CpuProfile(kCpuProfileCallTree, WriteCallback, &profile);
+  EXPECT_VALID(result);
+  EXPECT_SUBSTRING("Profile of isolate", profile.buf());
+  EXPECT_SUBSTRING("spin", profile.buf());
+  EXPECT_NOTSUBSTRING(": 0 samples", profile.buf());
+
+  TextBuffer stacks(1024);
+  result = Dart_CpuProfile(kCpuProfileCollapsedStacks, WriteCallback, &stacks);
+  EXPECT_VALID(result);
+  EXPECT_SUBSTRING("spin", stacks.buf());
+
+  EXPECT(Dart_IsError(Dart_CpuProfile(static_cast<Dart_CpuProfileFormat>(7),
+                                      WriteCallback,
+                                      &profile)));
+  EXPECT_VALID(Dart_StopCpuProfiling());
+  EXPECT(Dart_IsError(Dart_CpuProfile(kCpuProfileCallTree,
+                                      WriteCallback,
+                                      &profile)));
+}
+
+}  // namespace dart
@@ -0,0 +1,48 @@
+// Copyright (c) 2013, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/profiler.h"
+
+namespace dart {
+
+bool Profiler::PlatformInit() {
+  return true;
+}
+
+
+// Windows has no signals to interrupt a thread with, instead the sampled
+// thread is suspended while its stack is recorded from the sampler thread.
+void Profiler::SampleThread(IsolateProfilerData* data) {
+  HANDLE thread = OpenThread(THREAD_SUSPEND_RESUME | THREAD_GET_CONTEXT,
+                             FALSE,
+                             data->thread());
+  if (thread == NULL) {
+    return;
+  }
+  if (SuspendThread(thread) == static_cast<DWORD>(-1)) {
+    CloseHandle(thread);
+    return;
+  }
+  CONTEXT context;
+  memset(&context, 0, sizeof(context));
+  context.ContextFlags = CONTEXT_CONTROL;
+  if (GetThreadContext(thread, &context)) {
+#if defined(HOST_ARCH_IA32)
+    RecordSample(data, context.Eip, context.Ebp, context.Esp);
+#elif defined(HOST_ARCH_X64)
+    RecordSample(data, context.Rip, context.Rbp, context.Rsp);
+#else
+    UNIMPLEMENTED();
+#endif
+  }
+  ResumeThread(thread);
+  CloseHandle(thread);
+}
+
+
+const char* Profiler::NativeSymbolName(uword pc) {
+  return NULL;
+}
+
+}  // namespace dart
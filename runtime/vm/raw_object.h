@@ -292,6 +292,23 @@ class RawObject {
     ptr()->tags_ = WatchedBit::update(false, tags);
   }
 
+#if defined(ARCH_IS_64_BIT)
+  // Support for the identity hash code kept in the upper half of the tags.
+  // A value of 0 means that no hash code has been assigned yet. The hash code
+  // does not fit in the tags on 32-bit architectures where the heap keeps it
+  // in a side table instead.
+  static const intptr_t kIdentityHashTagBit = 32;
+  static const intptr_t kIdentityHashTagSize = 32;
+
+  intptr_t GetIdentityHash() const {
+    return IdentityHashTag::decode(ptr()->tags_);
+  }
+  void SetIdentityHash(intptr_t hash) {
+    uword tags = ptr()->tags_;
+    ptr()->tags_ = IdentityHashTag::update(hash, tags);
+  }
+#endif
+
   // Support for object tags.
   bool IsCanonical() const {
     return CanonicalObjectTag::decode(ptr()->tags_);
@@ -371,6 +388,12 @@ class RawObject {
                                        kReservedTagBit,
                                        kReservedTagSize> {};  // NOLINT
 
+#if defined(ARCH_IS_64_BIT)
+  class IdentityHashTag : public BitField<intptr_t,
+                                          kIdentityHashTagBit,
+                                          kIdentityHashTagSize> {};  // NOLINT
+#endif
+
   RawObject* ptr() const {
     ASSERT(IsHeapObject());
     return reinterpret_cast<RawObject*>(
@@ -811,7 +834,9 @@ class RawPcDescriptors : public RawObject {
 
 // Stackmap is an immutable representation of the layout of the stack at a
 // PC. The stack map representation consists of a bit map which marks each
-// live object index starting from the base of the frame.
+// live object index starting from the base of the frame. The PC itself is
+// not stored in the map: the code object's stack map table pairs each PC
+// offset with its map, so safepoints with identical layouts share one map.
 //
 // The Stackmap also consists of a link to the code object corresponding to
 // the frame which the stack map is describing.  The bit map representation
@@ -826,8 +851,6 @@ class RawStackmap : public RawObject {
   intptr_t length_;  // Length of payload, in bits.
   intptr_t register_bit_count_;  // Live register bits, included in length_.
 
-  uword pc_;  // PC corresponding to this stack map representation.
-
   // Variable length data follows here (bitmap of the stack layout).
   uint8_t data_[0];
 };
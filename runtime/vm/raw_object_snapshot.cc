@@ -755,8 +755,21 @@ RawTokenStream* TokenStream::ReadFrom(SnapshotReader* reader,
   intptr_t len = reader->ReadSmiValue();
 
   // Create the token stream object.
-  TokenStream& token_stream = TokenStream::ZoneHandle(
-      reader->isolate(), NEW_OBJECT_WITH_LEN(TokenStream, len));
+  TokenStream& token_stream =
+      TokenStream::ZoneHandle(reader->isolate(), TokenStream::null());
+  bool in_place = (kind == Snapshot::kScript) && reader->data_in_place();
+  if (in_place) {
+    // The snapshot buffer outlives the isolate, refer to the stream of
+    // tokens in the buffer instead of making a copy of it.
+    uint8_t* data = const_cast<uint8_t*>(reader->CurrentBufferAddress());
+    reader->Advance(len);
+    *(reader->DataHandle()) =
+        ExternalUint8Array::New(data, len, NULL, NULL, Heap::kOld);
+    token_stream = TokenStream::New();
+    token_stream.SetStream(*(reader->DataHandle()));
+  } else {
+    token_stream = NEW_OBJECT_WITH_LEN(TokenStream, len);
+  }
   reader->AddBackRef(object_id, &token_stream, kIsDeserialized);
 
   // Set the object tags.
@@ -764,7 +777,7 @@ RawTokenStream* TokenStream::ReadFrom(SnapshotReader* reader,
 
   // Read the stream of tokens into the TokenStream object for script
   // snapshots as we made a copy of token stream.
-  if (kind == Snapshot::kScript) {
+  if ((kind == Snapshot::kScript) && !in_place) {
     NoGCScope no_gc;
     RawExternalUint8Array* stream = token_stream.GetStream();
     reader->ReadBytes(stream->ptr()->external_data_->data(), len);
@@ -1659,6 +1672,10 @@ void String::ReadFromImpl(SnapshotReader* reader,
 }
 
 
+// Shorter strings are cheaper to copy than to wrap as external strings.
+static const intptr_t kMinInPlaceStringLength = 64;
+
+
 RawOneByteString* OneByteString::ReadFrom(SnapshotReader* reader,
                                           intptr_t object_id,
                                           intptr_t tags,
@@ -1680,6 +1697,16 @@ RawOneByteString* OneByteString::ReadFrom(SnapshotReader* reader,
       reader->ReadBytes(raw_ptr, len);
     }
     ASSERT((hash == 0) || (String::Hash(str_obj, 0, str_obj.Length()) == hash));
+  } else if ((kind == Snapshot::kScript) &&
+             reader->data_in_place() &&
+             !RawObject::IsCanonical(tags) &&
+             (len >= kMinInPlaceStringLength)) {
+    // Refer to the characters in the snapshot buffer, the string is
+    // immutable so there is no need to copy it into the heap.
+    const uint8_t* data = reader->CurrentBufferAddress();
+    reader->Advance(len);
+    str_obj = ExternalOneByteString::New(data, len, NULL, NULL,
+                                         HEAP_SPACE(kind));
   } else {
     String::ReadFromImpl<OneByteString, uint8_t>(
         reader, &str_obj, len, tags, Symbols::FromLatin1, kind);
@@ -1745,6 +1772,10 @@ static void StringWriteTo(SnapshotWriter* writer,
   // Write out the hash field.
   writer->Write<RawObject*>(hash);
 
+  if (RawObject::IsCanonical(tags)) {
+    writer->IncrementSymbolCount();
+  }
+
   // Write out the string.
   if (len > 0) {
     if (class_id == kOneByteStringCid) {
@@ -606,6 +606,22 @@ void Scavenger::ProcessPeerReferents() {
       heap_->SetPeer(raw_obj, it->second);
     }
   }
+  IdentityHashTable prev_hashes;
+  std::swap(prev_hashes, identity_hash_table_);
+  for (IdentityHashTable::iterator it = prev_hashes.begin();
+       it != prev_hashes.end();
+       ++it) {
+    RawObject* raw_obj = it->first;
+    ASSERT(raw_obj->IsHeapObject());
+    uword raw_addr = RawObject::ToAddr(raw_obj);
+    uword header = *reinterpret_cast<uword*>(raw_addr);
+    if (IsForwarding(header)) {
+      // The object has survived.  Preserve its identity hash code.
+      uword new_addr = ForwardedAddr(header);
+      raw_obj = RawObject::FromAddr(new_addr);
+      heap_->SetIdentityHash(raw_obj, it->second);
+    }
+  }
 }
 
 
@@ -710,4 +726,21 @@ int64_t Scavenger::PeerCount() const {
   return static_cast<int64_t>(peer_table_.size());
 }
 
+
+void Scavenger::SetIdentityHash(RawObject* raw_obj, intptr_t hash) {
+  ASSERT(hash != 0);
+  identity_hash_table_[raw_obj] = hash;
+}
+
+
+intptr_t Scavenger::GetIdentityHash(RawObject* raw_obj) {
+  IdentityHashTable::iterator it = identity_hash_table_.find(raw_obj);
+  return (it == identity_hash_table_.end()) ? 0 : it->second;
+}
+
+
+int64_t Scavenger::IdentityHashCount() const {
+  return static_cast<int64_t>(identity_hash_table_.size());
+}
+
 }  // namespace dart
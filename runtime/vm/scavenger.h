@@ -95,6 +95,12 @@ class Scavenger {
 
   int64_t PeerCount() const;
 
+  void SetIdentityHash(RawObject* raw_obj, intptr_t hash);
+
+  intptr_t GetIdentityHash(RawObject* raw_obj);
+
+  int64_t IdentityHashCount() const;
+
  private:
   // Ids for time and data records in Heap::GCStats.
   enum {
@@ -158,6 +164,9 @@ class Scavenger {
   typedef std::map<RawObject*, void*> PeerTable;
   PeerTable peer_table_;
 
+  typedef std::map<RawObject*, intptr_t> IdentityHashTable;
+  IdentityHashTable identity_hash_table_;
+
   // Current allocation top and end. These values are being accessed directly
   // from generated code.
   uword top_;
@@ -117,6 +117,7 @@ const Snapshot* Snapshot::SetupFromBuffer(const void* raw_memory) {
   ASSERT(kHeaderSize == sizeof(Snapshot));
   ASSERT(kLengthIndex == length_offset());
   ASSERT((kSnapshotFlagIndex * sizeof(int32_t)) == kind_offset());
+  ASSERT((kSymbolCountIndex * sizeof(int32_t)) == symbol_count_offset());
   ASSERT((kHeapObjectTag & kInlined));
   // No object can have kFreeBit and kMarkBit set simultaneously. If kFreeBit
   // is set then the rest of tags is a pointer to the next FreeListElement which
@@ -148,6 +149,7 @@ SnapshotReader::SnapshotReader(const uint8_t* buffer,
     : BaseReader(buffer, size),
       kind_(kind),
       isolate_(isolate),
+      data_in_place_(false),
       cls_(Class::Handle()),
       obj_(Object::Handle()),
       str_(String::Handle()),
@@ -783,7 +785,8 @@ SnapshotWriter::SnapshotWriter(Snapshot::Kind kind,
       forward_list_(),
       exception_type_(Exceptions::kNone),
       exception_msg_(NULL),
-      error_(LanguageError::Handle()) {
+      error_(LanguageError::Handle()),
+      symbol_count_(0) {
 }
 
 
@@ -973,7 +976,7 @@ void FullSnapshotWriter::WriteFullSnapshot() {
     // Write out all forwarded objects.
     WriteForwardedObjects();
 
-    FillHeader(kind());
+    FillHeader(kind(), symbol_count());
     UnmarkAll();
 
     isolate->set_long_jump_base(base);
@@ -1275,7 +1278,7 @@ void ScriptSnapshotWriter::WriteScriptSnapshot(const Library& lib) {
     NoGCScope no_gc;
     ReserveHeader();
     WriteObject(lib.raw());
-    FillHeader(kind());
+    FillHeader(kind(), symbol_count());
     UnmarkAll();
     isolate->set_long_jump_base(base);
   } else {
@@ -123,9 +123,10 @@ class Snapshot {
     kMessage,   // A partial snapshot used only for isolate messaging.
   };
 
-  static const int kHeaderSize = 2 * sizeof(int32_t);
+  static const int kHeaderSize = 3 * sizeof(int32_t);
   static const int kLengthIndex = 0;
   static const int kSnapshotFlagIndex = 1;
+  static const int kSymbolCountIndex = 2;
 
   static const Snapshot* SetupFromBuffer(const void* raw_memory);
 
@@ -133,6 +134,7 @@ class Snapshot {
   const uint8_t* content() const { return content_; }
   int32_t length() const { return length_; }
   Kind kind() const { return static_cast<Kind>(kind_); }
+  int32_t symbol_count() const { return symbol_count_; }
 
   bool IsMessageSnapshot() const { return kind_ == kMessage; }
   bool IsScriptSnapshot() const { return kind_ == kScript; }
@@ -143,12 +145,16 @@ class Snapshot {
   static intptr_t kind_offset() {
     return OFFSET_OF(Snapshot, kind_);
   }
+  static intptr_t symbol_count_offset() {
+    return OFFSET_OF(Snapshot, symbol_count_);
+  }
 
  private:
-  Snapshot() : length_(0), kind_(kFull) {}
+  Snapshot() : length_(0), kind_(kFull), symbol_count_(0) {}
 
   int32_t length_;  // Stream length.
   int32_t kind_;  // Kind of snapshot.
+  int32_t symbol_count_;  // Number of symbols written to the snapshot.
   uint8_t content_[];  // Stream content.
 
   DISALLOW_COPY_AND_ASSIGN(Snapshot);
@@ -223,6 +229,13 @@ class SnapshotReader : public BaseReader {
   ExternalUint8Array* DataHandle() { return &data_; }
   UnhandledException* ErrorHandle() { return &error_; }
 
+  // When set, the snapshot buffer is guaranteed to stay valid and unmodified
+  // for the lifetime of the isolate (e.g. a read-only mapping of a snapshot
+  // file), so immutable data such as token streams can be referenced in
+  // place instead of being copied into the heap.
+  bool data_in_place() const { return data_in_place_; }
+  void set_data_in_place(bool value) { data_in_place_ = value; }
+
   // Reads an object.
   RawObject* ReadObject();
 
@@ -308,6 +321,7 @@ class SnapshotReader : public BaseReader {
 
   Snapshot::Kind kind_;  // Indicates type of snapshot(full, script, message).
   Isolate* isolate_;  // Current isolate.
+  bool data_in_place_;  // Reference immutable data in the snapshot buffer.
   Class& cls_;  // Temporary Class handle.
   Object& obj_;  // Temporary Object handle.
   String& str_;  // Temporary String handle.
@@ -414,10 +428,11 @@ class BaseWriter {
     stream_.set_current(stream_.buffer() + Snapshot::kHeaderSize);
   }
 
-  void FillHeader(Snapshot::Kind kind) {
+  void FillHeader(Snapshot::Kind kind, intptr_t symbol_count) {
     int32_t* data = reinterpret_cast<int32_t*>(stream_.buffer());
     data[Snapshot::kLengthIndex] = stream_.bytes_written();
     data[Snapshot::kSnapshotFlagIndex] = kind;
+    data[Snapshot::kSymbolCountIndex] = symbol_count;
   }
 
  private:
@@ -443,6 +458,11 @@ class SnapshotWriter : public BaseWriter {
 
   uword GetObjectTags(RawObject* raw);
 
+  // Number of symbols written so far. Recorded in the snapshot header, so
+  // that the reader can size the symbol table before reading them.
+  intptr_t symbol_count() const { return symbol_count_; }
+  void IncrementSymbolCount() { symbol_count_++; }
+
   Exceptions::ExceptionType exception_type() const {
     return exception_type_;
   }
@@ -502,6 +522,7 @@ class SnapshotWriter : public BaseWriter {
   Exceptions::ExceptionType exception_type_;  // Exception type.
   const char* exception_msg_;  // Message associated with exception.
   LanguageError& error_;  // Error handle.
+  intptr_t symbol_count_;  // Number of symbols written.
 
   friend class RawArray;
   friend class RawClass;
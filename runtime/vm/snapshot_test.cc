@@ -1115,6 +1115,8 @@ UNIT_TEST_CASE(ScriptSnapshot) {
     EXPECT_VALID(result);
     script_snapshot = reinterpret_cast<uint8_t*>(malloc(size));
     memmove(script_snapshot, buffer, size);
+    // The symbols of the script, like "FieldsTest", are counted in the header.
+    EXPECT(Snapshot::SetupFromBuffer(script_snapshot)->symbol_count() > 0);
     Dart_ExitScope();
     Dart_ShutdownIsolate();
   }
@@ -1210,6 +1212,108 @@ UNIT_TEST_CASE(ScriptSnapshot1) {
 }
 
 
+UNIT_TEST_CASE(MappedScriptSnapshot) {
+  // String literals are canonical and copied out of the snapshot. The long
+  // message built from them is not canonical and stays in the buffer.
+  const char* kScriptChars =
+      "class Greeting {"
+      "  static String message;"
+      "  static void init() {"
+      "    var buffer = new StringBuffer();"
+      "    buffer.add('The quick brown fox jumps over the lazy dog. ');"
+      "    buffer.add('Pack my box with five dozen liquor jugs.');"
+      "    message = buffer.toString();"
+      "  }"
+      "  static String testMain() {"
+      "    var buffer = new StringBuffer();"
+      "    for (int i = 0; i < 3; i++) {"
+      "      buffer.add('hello');"
+      "    }"
+      "    return buffer.toString();"
+      "  }"
+      "}";
+  const char* kMessage =
+      "The quick brown fox jumps over the lazy dog. "
+      "Pack my box with five dozen liquor jugs.";
+
+  Dart_Handle result;
+  uint8_t* buffer;
+  intptr_t size;
+  uint8_t* full_snapshot = NULL;
+  uint8_t* script_snapshot = NULL;
+
+  {
+    // Start an Isolate, and create a full snapshot of it.
+    TestIsolateScope __test_isolate__;
+    Dart_EnterScope();  // Start a Dart API scope for invoking API functions.
+
+    // Write out the script snapshot.
+    result = Dart_CreateSnapshot(&buffer, &size);
+    EXPECT_VALID(result);
+    full_snapshot = reinterpret_cast<uint8_t*>(malloc(size));
+    memmove(full_snapshot, buffer, size);
+    Dart_ExitScope();
+  }
+
+  {
+    // Create an Isolate using the full snapshot, load a script and create
+    // a script snapshot of the script.
+    TestCase::CreateTestIsolateFromSnapshot(full_snapshot);
+    Dart_EnterScope();  // Start a Dart API scope for invoking API functions.
+
+    // Create a test library and Load up a test script in it. Set the
+    // message so that it is written to the snapshot.
+    Dart_Handle lib = TestCase::LoadTestScript(kScriptChars, NULL);
+    Dart_Handle cls = Dart_GetClass(lib, NewString("Greeting"));
+    EXPECT_VALID(Dart_Invoke(cls, NewString("init"), 0, NULL));
+
+    // Write out the script snapshot.
+    result = Dart_CreateScriptSnapshot(&buffer, &size);
+    EXPECT_VALID(result);
+    script_snapshot = reinterpret_cast<uint8_t*>(malloc(size));
+    memmove(script_snapshot, buffer, size);
+    Dart_ExitScope();
+    Dart_ShutdownIsolate();
+  }
+
+  {
+    // Now Create an Isolate using the full snapshot, load the script
+    // snapshot created above in place and execute it. The token stream
+    // is compiled straight out of the snapshot buffer.
+    TestCase::CreateTestIsolateFromSnapshot(full_snapshot);
+    Dart_EnterScope();  // Start a Dart API scope for invoking API functions.
+
+    EXPECT(script_snapshot != NULL);
+    result = Dart_LoadScriptFromMappedSnapshot(script_snapshot);
+    EXPECT_VALID(result);
+
+    Dart_Handle cls = Dart_GetClass(result, NewString("Greeting"));
+    result = Dart_Invoke(cls, NewString("testMain"), 0, NULL);
+    EXPECT_VALID(result);
+    EXPECT(Dart_IsString(result));
+    const char* str = NULL;
+    EXPECT_VALID(Dart_StringToCString(result, &str));
+    EXPECT_STREQ("hellohellohello", str);
+
+    // The message refers to its characters in the snapshot buffer.
+    result = Dart_GetField(cls, NewString("message"));
+    EXPECT_VALID(result);
+    {
+      Isolate* isolate = Isolate::Current();
+      HandleScope scope(isolate);
+      String& message = String::Handle(isolate);
+      message ^= Api::UnwrapHandle(result);
+      EXPECT(message.IsExternal());
+      EXPECT_STREQ(kMessage, message.ToCString());
+    }
+    Dart_ExitScope();
+  }
+  Dart_ShutdownIsolate();
+  free(full_snapshot);
+  free(script_snapshot);
+}
+
+
 TEST_CASE(IntArrayMessage) {
   StackZone zone(Isolate::Current());
   uint8_t* buffer = NULL;
@@ -282,16 +282,29 @@ EntryFrame* StackFrameIterator::NextEntryFrame() {
 
 InlinedFunctionsInDartFrameIterator::InlinedFunctionsInDartFrameIterator(
     StackFrame* frame) : index_(0),
-                         frame_(frame),
+                         pc_(frame->pc()),
                          func_(Function::Handle()),
                          deopt_info_(DeoptInfo::Handle()),
                          object_table_(Array::Handle()) {
-  ASSERT(frame_ != NULL);
-  const Code& code = Code::Handle(frame_->LookupDartCode());
+  Init(Code::Handle(frame->LookupDartCode()));
+}
+
+
+InlinedFunctionsInDartFrameIterator::InlinedFunctionsInDartFrameIterator(
+    const Code& code, uword pc) : index_(0),
+                                  pc_(pc),
+                                  func_(Function::Handle()),
+                                  deopt_info_(DeoptInfo::Handle()),
+                                  object_table_(Array::Handle()) {
+  Init(code);
+}
+
+
+void InlinedFunctionsInDartFrameIterator::Init(const Code& code) {
   ASSERT(code.is_optimized());
   func_ = code.function();
   intptr_t deopt_reason = kDeoptUnknown;
-  deopt_info_ = code.GetDeoptInfoAtPc(frame_->pc(), &deopt_reason);
+  deopt_info_ = code.GetDeoptInfoAtPc(pc_, &deopt_reason);
   object_table_ = code.object_table();
 }
 
@@ -304,7 +317,7 @@ RawFunction* InlinedFunctionsInDartFrameIterator::GetNextFunction(uword* pc) {
     // We are at a PC that has no deoptimization info so there are no
     // inlined functions to iterate over, we return the function.
     index_ = -1;  // No more functions.
-    *pc = frame_->pc();
+    *pc = pc_;
     return func_.raw();
   }
   // Iterate over the deopt instructions and determine the inlined
@@ -232,11 +232,15 @@ class DartFrameIterator : public ValueObject {
 class InlinedFunctionsInDartFrameIterator : public ValueObject {
  public:
   explicit InlinedFunctionsInDartFrameIterator(StackFrame* frame);
+  // Iterates over the functions inlined at 'pc' in optimized 'code'.
+  InlinedFunctionsInDartFrameIterator(const Code& code, uword pc);
   RawFunction* GetNextFunction(uword* pc);
 
  private:
+  void Init(const Code& code);
+
   intptr_t index_;
-  StackFrame* frame_;
+  uword pc_;
   Function& func_;
   DeoptInfo& deopt_info_;
   Array& object_table_;
@@ -115,6 +115,24 @@ intptr_t Symbols::Size(Isolate* isolate) {
 }
 
 
+void Symbols::Reserve(Isolate* isolate, intptr_t count) {
+  ASSERT(isolate != NULL);
+  ASSERT(count >= 0);
+  const Array& symbol_table =
+      Array::Handle(isolate, isolate->object_store()->symbol_table());
+  intptr_t table_size = symbol_table.Length() - 1;
+  intptr_t used_elements = Size(isolate) + count;
+  intptr_t new_table_size = table_size;
+  // Stay below the load at which InsertIntoSymbolTable grows the table.
+  while (used_elements > ((new_table_size / 4) * 3)) {
+    new_table_size *= 2;
+  }
+  if (new_table_size > table_size) {
+    GrowSymbolTable(symbol_table, new_table_size);
+  }
+}
+
+
 void Symbols::Add(const Array& symbol_table, const String& str) {
   // Should only be run by the vm isolate.
   ASSERT(Isolate::Current() == Dart::vm_isolate());
@@ -308,11 +326,13 @@ void Symbols::DumpStats() {
 }
 
 
-void Symbols::GrowSymbolTable(const Array& symbol_table) {
+void Symbols::GrowSymbolTable(const Array& symbol_table,
+                              intptr_t new_table_size) {
   // TODO(iposva): Avoid exponential growth.
+  ASSERT(Utils::IsPowerOfTwo(new_table_size));
   num_of_grows_ += 1;
   intptr_t table_size = symbol_table.Length() - 1;
-  intptr_t new_table_size = table_size * 2;
+  intptr_t mask = new_table_size - 1;
   Array& new_symbol_table = Array::Handle(Array::New(new_table_size + 1));
   // Copy all elements from the original symbol table to the newly allocated
   // array.
@@ -322,11 +342,11 @@ void Symbols::GrowSymbolTable(const Array& symbol_table) {
     element ^= symbol_table.At(i);
     if (!element.IsNull()) {
       intptr_t hash = element.Hash();
-      intptr_t index = hash % new_table_size;
+      intptr_t index = hash & mask;
       new_element = new_symbol_table.At(index);
       intptr_t num_collisions = 0;
       while (!new_element.IsNull()) {
-        index = (index + 1) % new_table_size;  // Move to next element.
+        index = (index + 1) & mask;  // Move to next element.
         new_element = new_symbol_table.At(index);
         num_collisions += 1;
       }
@@ -361,7 +381,7 @@ void Symbols::InsertIntoSymbolTable(const Array& symbol_table,
 
   // Rehash if symbol_table is 75% full.
   if (used_elements > ((table_size / 4) * 3)) {
-    GrowSymbolTable(symbol_table);
+    GrowSymbolTable(symbol_table, table_size * 2);
   }
 }
 
@@ -373,13 +393,18 @@ intptr_t Symbols::FindIndex(const Array& symbol_table,
                             intptr_t hash) {
   // Last element of the array is the number of used elements.
   intptr_t table_size = symbol_table.Length() - 1;
-  intptr_t index = hash % table_size;
+  ASSERT(Utils::IsPowerOfTwo(table_size));
+  intptr_t mask = table_size - 1;
+  intptr_t index = hash & mask;
   intptr_t num_collisions = 0;
 
+  // Symbols always have their hash computed, so most mismatching symbols
+  // are skipped without comparing characters.
   String& symbol = String::Handle();
   symbol ^= symbol_table.At(index);
-  while (!symbol.IsNull() && !symbol.Equals(characters, len)) {
-    index = (index + 1) % table_size;  // Move to next element.
+  while (!symbol.IsNull() &&
+         ((symbol.Hash() != hash) || !symbol.Equals(characters, len))) {
+    index = (index + 1) & mask;  // Move to next element.
     symbol ^= symbol_table.At(index);
     num_collisions += 1;
   }
@@ -414,13 +439,16 @@ intptr_t Symbols::FindIndex(const Array& symbol_table,
                             intptr_t hash) {
   // Last element of the array is the number of used elements.
   intptr_t table_size = symbol_table.Length() - 1;
-  intptr_t index = hash % table_size;
+  ASSERT(Utils::IsPowerOfTwo(table_size));
+  intptr_t mask = table_size - 1;
+  intptr_t index = hash & mask;
   intptr_t num_collisions = 0;
 
   String& symbol = String::Handle();
   symbol ^= symbol_table.At(index);
-  while (!symbol.IsNull() && !symbol.Equals(str, begin_index, len)) {
-    index = (index + 1) % table_size;  // Move to next element.
+  while (!symbol.IsNull() &&
+         ((symbol.Hash() != hash) || !symbol.Equals(str, begin_index, len))) {
+    index = (index + 1) & mask;  // Move to next element.
     symbol ^= symbol_table.At(index);
     num_collisions += 1;
   }
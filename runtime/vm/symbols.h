@@ -286,6 +286,10 @@ PREDEFINED_SYMBOLS_LIST(DEFINE_SYMBOL_HANDLE_ACCESSOR)
   // Get number of symbols in an isolate's symbol table.
   static intptr_t Size(Isolate* isolate);
 
+  // Grow the symbol table of the isolate, if necessary, so that 'count' more
+  // symbols can be added without growing it again.
+  static void Reserve(Isolate* isolate, intptr_t count);
+
   // Creates a Symbol given a C string that is assumed to contain
   // UTF-8 encoded characters and '\0' is considered a termination character.
   // TODO(7123) - Rename this to FromCString(....).
@@ -320,6 +324,7 @@ PREDEFINED_SYMBOLS_LIST(DEFINE_SYMBOL_HANDLE_ACCESSOR)
   static void DumpStats();
 
  private:
+  // The symbol table sizes are powers of two.
   enum {
     kInitialVMIsolateSymtabSize = 512,
     kInitialSymtabSize = 2048
@@ -339,8 +344,9 @@ PREDEFINED_SYMBOLS_LIST(DEFINE_SYMBOL_HANDLE_ACCESSOR)
                                     const String& symbol,
                                     intptr_t index);
 
-  // Grow the symbol table.
-  static void GrowSymbolTable(const Array& symbol_table);
+  // Grow the symbol table to new_table_size entries.
+  static void GrowSymbolTable(const Array& symbol_table,
+                              intptr_t new_table_size);
 
   // Return index in symbol table if the symbol already exists or
   // return the index into which the new symbol can be added.
@@ -4,12 +4,76 @@
 
 #include "vm/unicode.h"
 
+#if defined(HOST_ARCH_X64)
+#include <emmintrin.h>  // NOLINT
+#endif
+
+#include "platform/utils.h"
 #include "vm/allocation.h"
 #include "vm/globals.h"
 #include "vm/object.h"
 
 namespace dart {
 
+// The ASCII fast paths look at 16 bytes at a time with SSE2 on X64, where it
+// is always available, and at a word at a time elsewhere.
+#if defined(HOST_ARCH_X64)
+static const intptr_t kSimdBytes = sizeof(__m128i);
+#endif
+
+
+// Returns the number of ASCII bytes at the start of 'utf8_array'.
+static intptr_t AsciiPrefixLength(const uint8_t* utf8_array,
+                                  intptr_t array_len) {
+  intptr_t i = 0;
+#if defined(HOST_ARCH_X64)
+  for (; i + kSimdBytes <= array_len; i += kSimdBytes) {
+    __m128i bytes =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(&utf8_array[i]));
+    // The mask has a bit set for each byte with the high bit set.
+    int mask = _mm_movemask_epi8(bytes);
+    if (mask != 0) {
+      return i + Utils::CountTrailingZeros(mask);
+    }
+  }
+#else
+  while ((i < array_len) && !Utils::IsAligned(&utf8_array[i], kWordSize)) {
+    if (utf8_array[i] > 0x7F) return i;
+    i++;
+  }
+  // The high bit of every byte of a word.
+  const uword kHighBits = (~static_cast<uword>(0) / 0xFF) * 0x80;
+  for (; i + kWordSize <= array_len; i += kWordSize) {
+    uword word = *reinterpret_cast<const uword*>(&utf8_array[i]);
+    if ((word & kHighBits) != 0) break;
+  }
+#endif
+  while ((i < array_len) && (utf8_array[i] <= 0x7F)) {
+    i++;
+  }
+  return i;
+}
+
+
+// Copies 'length' ASCII bytes to UTF-16 code units.
+static void WidenAscii(const uint8_t* src, uint16_t* dst, intptr_t length) {
+  intptr_t i = 0;
+#if defined(HOST_ARCH_X64)
+  const __m128i zero = _mm_setzero_si128();
+  for (; i + kSimdBytes <= length; i += kSimdBytes) {
+    __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&src[i]));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&dst[i]),
+                     _mm_unpacklo_epi8(bytes, zero));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&dst[i + kSimdBytes / 2]),
+                     _mm_unpackhi_epi8(bytes, zero));
+  }
+#endif
+  for (; i < length; i++) {
+    dst[i] = src[i];
+  }
+}
+
+
 const int8_t Utf8::kTrailBytes[256] = {
   1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
   1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
@@ -61,8 +125,45 @@ intptr_t Utf8::CodeUnitCount(const uint8_t* utf8_array,
                              Type* type) {
   intptr_t len = 0;
   Type char_type = kLatin1;
-  for (intptr_t i = 0; i < array_len; i++) {
+  intptr_t i = 0;
+#if defined(HOST_ARCH_X64)
+  // As signed bytes, trail bytes are in [-128, -65], the starts of code
+  // points above U+00FF are in [-60, -1] and the starts of supplementary
+  // code points are in [-16, -1].
+  const __m128i kMaxTrailByte = _mm_set1_epi8(-65);
+  const __m128i kMaxLatin1SequenceStart = _mm_set1_epi8(-61);
+  const __m128i kMaxBmpSequenceStart = _mm_set1_epi8(-17);
+  for (; i + kSimdBytes <= array_len; i += kSimdBytes) {
+    __m128i bytes =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(&utf8_array[i]));
+    int non_ascii = _mm_movemask_epi8(bytes);
+    if (non_ascii == 0) {
+      len += kSimdBytes;
+      continue;
+    }
+    int starts = _mm_movemask_epi8(_mm_cmpgt_epi8(bytes, kMaxTrailByte));
+    int above_latin1 = non_ascii &
+        _mm_movemask_epi8(_mm_cmpgt_epi8(bytes, kMaxLatin1SequenceStart));
+    int supplementary = non_ascii &
+        _mm_movemask_epi8(_mm_cmpgt_epi8(bytes, kMaxBmpSequenceStart));
+    // Supplementary code points take two UTF-16 code units.
+    len += Utils::CountOneBits(starts) + Utils::CountOneBits(supplementary);
+    if (supplementary != 0) {
+      char_type = kSupplementary;
+    } else if ((above_latin1 != 0) && (char_type == kLatin1)) {
+      char_type = kBMP;
+    }
+  }
+#endif
+  while (i < array_len) {
     uint8_t code_unit = utf8_array[i];
+    if (code_unit <= kMaxOneByteChar) {
+      intptr_t ascii_len = AsciiPrefixLength(&utf8_array[i], array_len - i);
+      len += ascii_len;
+      i += ascii_len;
+      continue;
+    }
+    i++;
     if (!IsTrailByte(code_unit)) {
       ++len;
       if (!IsLatin1SequenceStart(code_unit)) {  // > U+00FF
@@ -86,7 +187,9 @@ bool Utf8::IsValid(const uint8_t* utf8_array, intptr_t array_len) {
   while (i < array_len) {
     uint32_t ch = utf8_array[i] & 0xFF;
     intptr_t j = 1;
-    if (ch >= 0x80) {
+    if (ch <= kMaxOneByteChar) {
+      j = AsciiPrefixLength(&utf8_array[i], array_len - i);
+    } else {
       int8_t num_trail_bytes = kTrailBytes[ch];
       bool is_malformed = false;
       for (; j < num_trail_bytes; ++j) {
@@ -127,6 +230,40 @@ intptr_t Utf8::Length(int32_t ch) {
 
 
 intptr_t Utf8::Length(const String& str) {
+  if (str.IsOneByteString()) {
+    // Latin-1 characters above ASCII take two bytes.
+    intptr_t str_len = str.Length();
+    intptr_t length = str_len;
+    if (str_len == 0) {
+      return length;
+    }
+    NoGCScope no_gc;
+    const uint8_t* latin1 = OneByteString::CharAddr(str, 0);
+    intptr_t i = 0;
+    while (i < str_len) {
+      if (latin1[i] <= kMaxOneByteChar) {
+        i += AsciiPrefixLength(&latin1[i], str_len - i);
+      } else {
+        length++;
+        i++;
+      }
+    }
+    return length;
+  }
+  if (str.IsTwoByteString()) {
+    intptr_t str_len = str.Length();
+    intptr_t length = 0;
+    if (str_len == 0) {
+      return length;
+    }
+    NoGCScope no_gc;
+    const uint16_t* utf16 = TwoByteString::CharAddr(str, 0);
+    intptr_t i = 0;
+    while (i < str_len) {
+      length += Utf8::Length(Utf16::Next(utf16, &i, str_len));
+    }
+    return length;
+  }
   intptr_t length = 0;
   String::CodePointIterator it(str);
   while (it.Next()) {
@@ -166,6 +303,57 @@ intptr_t Utf8::Encode(int32_t ch, char* dst) {
 
 intptr_t Utf8::Encode(const String& src, char* dst, intptr_t len) {
   intptr_t pos = 0;
+  if (src.IsOneByteString()) {
+    // Runs of ASCII characters are copied as they are.
+    intptr_t src_len = src.Length();
+    if (src_len == 0) {
+      return pos;
+    }
+    NoGCScope no_gc;
+    const uint8_t* latin1 = OneByteString::CharAddr(src, 0);
+    intptr_t i = 0;
+    while (i < src_len) {
+      int32_t ch = latin1[i];
+      if (ch <= kMaxOneByteChar) {
+        intptr_t ascii_len = AsciiPrefixLength(
+            &latin1[i], Utils::Minimum(src_len - i, len - pos));
+        if (ascii_len == 0) {
+          break;
+        }
+        memmove(&dst[pos], &latin1[i], ascii_len);
+        pos += ascii_len;
+        i += ascii_len;
+      } else {
+        if (pos + 2 > len) {
+          break;
+        }
+        pos += Utf8::Encode(ch, &dst[pos]);
+        i++;
+      }
+    }
+    return pos;
+  }
+  if (src.IsTwoByteString()) {
+    intptr_t src_len = src.Length();
+    if (src_len == 0) {
+      return pos;
+    }
+    NoGCScope no_gc;
+    const uint16_t* utf16 = TwoByteString::CharAddr(src, 0);
+    intptr_t i = 0;
+    while (i < src_len) {
+      intptr_t next = i;
+      int32_t ch = Utf16::Next(utf16, &next, src_len);
+      intptr_t num_bytes = Utf8::Length(ch);
+      if (pos + num_bytes > len) {
+        break;
+      }
+      Utf8::Encode(ch, &dst[pos]);
+      pos += num_bytes;
+      i = next;
+    }
+    return pos;
+  }
   String::CodePointIterator it(src);
   while (it.Next()) {
     int32_t ch = it.Current();
@@ -219,16 +407,26 @@ bool Utf8::DecodeToLatin1(const uint8_t* utf8_array,
                           intptr_t len) {
   intptr_t i = 0;
   intptr_t j = 0;
-  intptr_t num_bytes;
-  for (; (i < array_len) && (j < len); i += num_bytes, ++j) {
+  while ((i < array_len) && (j < len)) {
+    if (utf8_array[i] <= kMaxOneByteChar) {
+      // Copy a run of ASCII characters at once.
+      intptr_t ascii_len = AsciiPrefixLength(
+          &utf8_array[i], Utils::Minimum(array_len - i, len - j));
+      memmove(&dst[j], &utf8_array[i], ascii_len);
+      i += ascii_len;
+      j += ascii_len;
+      continue;
+    }
     int32_t ch;
     ASSERT(IsLatin1SequenceStart(utf8_array[i]));
-    num_bytes = Utf8::Decode(&utf8_array[i], (array_len - i), &ch);
+    intptr_t num_bytes = Utf8::Decode(&utf8_array[i], (array_len - i), &ch);
     if (ch == -1) {
       return false;  // Invalid input.
     }
     ASSERT(Utf::IsLatin1(ch));
     dst[j] = ch;
+    i += num_bytes;
+    ++j;
   }
   if ((i < array_len) && (j == len)) {
     return false;  // Output overflow.
@@ -243,11 +441,19 @@ bool Utf8::DecodeToUTF16(const uint8_t* utf8_array,
                          intptr_t len) {
   intptr_t i = 0;
   intptr_t j = 0;
-  intptr_t num_bytes;
-  for (; (i < array_len) && (j < len); i += num_bytes, ++j) {
+  while ((i < array_len) && (j < len)) {
+    if (utf8_array[i] <= kMaxOneByteChar) {
+      // Widen a run of ASCII characters at once.
+      intptr_t ascii_len = AsciiPrefixLength(
+          &utf8_array[i], Utils::Minimum(array_len - i, len - j));
+      WidenAscii(&utf8_array[i], &dst[j], ascii_len);
+      i += ascii_len;
+      j += ascii_len;
+      continue;
+    }
     int32_t ch;
     bool is_supplementary = IsSupplementarySequenceStart(utf8_array[i]);
-    num_bytes = Utf8::Decode(&utf8_array[i], (array_len - i), &ch);
+    intptr_t num_bytes = Utf8::Decode(&utf8_array[i], (array_len - i), &ch);
     if (ch == -1) {
       return false;  // Invalid input.
     }
@@ -257,6 +463,8 @@ bool Utf8::DecodeToUTF16(const uint8_t* utf8_array,
     } else {
       dst[j] = ch;
     }
+    i += num_bytes;
+    ++j;
   }
   if ((i < array_len) && (j == len)) {
     return false;  // Output overflow.
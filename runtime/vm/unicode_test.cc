@@ -3,6 +3,7 @@
 // BSD-style license that can be found in the LICENSE file.
 
 #include "vm/globals.h"
+#include "vm/object.h"
 #include "vm/unicode.h"
 #include "vm/unit_test.h"
 
@@ -1025,4 +1026,60 @@ TEST_CASE(Utf8Decode) {
   }
 }
 
+
+// Inserts multi-byte sequences at every offset of a long ASCII text, so that
+// they are found at all positions of the blocks the fast paths look at.
+TEST_CASE(Utf8LongText) {
+  const intptr_t kTextLength = 100;
+  const char* kSequences[] = { "\xC3\xA9", "\xE2\x82\xAC", "\xF0\x90\x8C\x82" };
+  const intptr_t kCodeUnits[] = { 1, 1, 2 };
+  const uint16_t kFirstCodeUnits[] = { 0xE9, 0x20AC, 0xD800 };
+  for (intptr_t kind = 0; kind < 3; kind++) {
+    const char* sequence = kSequences[kind];
+    intptr_t sequence_length = strlen(sequence);
+    for (intptr_t offset = 0; offset < kTextLength; offset++) {
+      uint8_t utf8[kTextLength + 4];
+      for (intptr_t i = 0; i < kTextLength; i++) {
+        utf8[(i < offset) ? i : (i + sequence_length)] = 'a' + (i % 26);
+      }
+      memmove(&utf8[offset], sequence, sequence_length);
+      intptr_t length = kTextLength + sequence_length;
+      EXPECT(Utf8::IsValid(utf8, length));
+      Utf8::Type type;
+      intptr_t len = Utf8::CodeUnitCount(utf8, length, &type);
+      EXPECT_EQ(kTextLength + kCodeUnits[kind], len);
+      EXPECT_EQ(kind == 0 ? Utf8::kLatin1 :
+                (kind == 1 ? Utf8::kBMP : Utf8::kSupplementary), type);
+      uint16_t utf16[kTextLength + 2];
+      EXPECT(Utf8::DecodeToUTF16(utf8, length, utf16, len));
+      for (intptr_t i = 0; i < offset; i++) {
+        EXPECT_EQ('a' + (i % 26), utf16[i]);
+      }
+      EXPECT_EQ(kFirstCodeUnits[kind], utf16[offset]);
+      EXPECT_EQ('a' + ((kTextLength - 1) % 26), utf16[len - 1]);
+      String& str = String::Handle();
+      if (kind == 0) {
+        uint8_t latin1[kTextLength + 1];
+        EXPECT(Utf8::DecodeToLatin1(utf8, length, latin1, len));
+        EXPECT_EQ(0xE9, latin1[offset]);
+        EXPECT(!memcmp(utf8, latin1, offset));
+        str = OneByteString::New(latin1, len, Heap::kNew);
+      } else {
+        str = TwoByteString::New(utf16, len, Heap::kNew);
+      }
+      // Round trip through the string.
+      EXPECT_EQ(length, Utf8::Length(str));
+      char encoded[kTextLength + 4];
+      EXPECT_EQ(length, Utf8::Encode(str, encoded, length));
+      EXPECT(!memcmp(utf8, encoded, length));
+      // Encoding stops at the last character which fits.
+      EXPECT_EQ(offset, Utf8::Encode(str, encoded, offset + 1));
+      // A truncated sequence or a stray trail byte is invalid.
+      EXPECT(!Utf8::IsValid(utf8, offset + sequence_length - 1));
+      utf8[offset] = 0x80;
+      EXPECT(!Utf8::IsValid(utf8, length));
+    }
+  }
+}
+
 }  // namespace dart
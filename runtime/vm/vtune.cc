@@ -19,7 +19,8 @@ void VTuneCodeObserver::Notify(const char* name,
                                uword base,
                                uword prologue_offset,
                                uword size,
-                               bool optimized) {
+                               bool optimized,
+                               const CodeLineInfo* line_info) {
   ASSERT(IsActive());
   iJIT_Method_Load jmethod;
   memset(&jmethod, 0, sizeof(jmethod));
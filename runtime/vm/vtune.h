@@ -18,7 +18,8 @@ class VTuneCodeObserver : public CodeObserver {
                       uword base,
                       uword prologue_offset,
                       uword size,
-                      bool optimized);
+                      bool optimized,
+                      const CodeLineInfo* line_info);
 };
 #endif
 
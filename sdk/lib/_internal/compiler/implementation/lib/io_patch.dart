@@ -167,7 +167,10 @@ patch class Process {
 }
 
 patch class ServerSocket {
-  patch factory ServerSocket(String bindAddress, int port, int backlog) {
+  patch factory ServerSocket(String bindAddress,
+                             int port,
+                             int backlog,
+                             {bool shared: false}) {
     throw new UnsupportedError("ServerSocket constructor");
   }
 }
@@ -112,19 +112,35 @@ class _BufferList {
   }
 
   /**
-   * Remove a number of bytes from the buffer list. Currently the
-   * number of bytes to remove must be confined to the first buffer.
+   * Returns up to [count] buffers from the front of the list without
+   * removing them. Use [index] to determine the index of the first byte in
+   * the first buffer.
+   */
+  List<List<int>> firstBuffers(int count) {
+    List<List<int>> result = new List<List<int>>();
+    for (List<int> buffer in _buffers) {
+      if (result.length == count) break;
+      result.add(buffer);
+    }
+    return result;
+  }
+
+  /**
+   * Remove a number of bytes from the buffer list.
    */
   void removeBytes(int count) {
-    int firstRemaining = first.length - _index;
-    assert(count <= firstRemaining);
-    if (count == firstRemaining) {
+    assert(count <= _length);
+    _length -= count;
+    while (count > 0) {
+      int firstRemaining = first.length - _index;
+      if (count < firstRemaining) {
+        _index += count;
+        return;
+      }
+      count -= firstRemaining;
       _buffers.removeFirst();
       _index = 0;
-    } else {
-      _index += count;
     }
-    _length -= count;
   }
 
 
@@ -96,4 +96,9 @@ class _BufferUtils {
   // if the List is a builtin VM List type and false if it is
   // a user defined List type.
   external static bool _isBuiltinList(List buffer);
+
+  // Check if a List is an external byte array, such as a list created
+  // with [:new Uint8List.transferable:]. The data of external byte arrays
+  // is not moved by the garbage collector.
+  external static bool _isExternalByteArray(List buffer);
 }
@@ -7,4 +7,6 @@ part of dart.io;
 class _EventHandler {
   external static void _start();
   external static _sendData(Object sender, ReceivePort receivePort, int data);
+  external static int _addTimer(ReceivePort receivePort, int wakeupTime);
+  external static void _cancelTimer(int id);
 }
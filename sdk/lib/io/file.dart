@@ -16,6 +16,40 @@ class FileMode {
 }
 
 
+/**
+ * FileMapMode describes the modes in which a file can be mapped into
+ * memory using [RandomAccessFile.mapSync].
+ *
+ * Changes to a list mapped with mode [READ] are private to the list and
+ * never written to the file. Changes to a list mapped with mode
+ * [READ_WRITE] are written to the file and are visible to every other
+ * mapping of the file. Mapping a file with mode [READ_WRITE] requires the
+ * file to be opened for writing.
+ */
+class FileMapMode {
+  static const READ = const FileMapMode._internal(0);
+  static const READ_WRITE = const FileMapMode._internal(1);
+  const FileMapMode._internal(int this._mode);
+  final int _mode;
+}
+
+
+/**
+ * FileMapAccess describes how a list returned by
+ * [RandomAccessFile.mapSync] is going to be accessed. The operating system
+ * uses it to decide how much of the file to read ahead. It is only a hint
+ * and has no effect on platforms which do not support it.
+ */
+class FileMapAccess {
+  static const NORMAL = const FileMapAccess._internal(0);
+  static const SEQUENTIAL = const FileMapAccess._internal(1);
+  static const RANDOM = const FileMapAccess._internal(2);
+  static const WILL_NEED = const FileMapAccess._internal(3);
+  const FileMapAccess._internal(int this._access);
+  final int _access;
+}
+
+
 /**
  * [File] objects are references to files.
  *
@@ -283,12 +317,14 @@ abstract class File {
 abstract class RandomAccessFile {
   /**
    * Close the file. Returns a [:Future<RandomAccessFile>:] that
-   * completes with this RandomAccessFile when it has been closed.
+   * completes with this RandomAccessFile when it has been closed. A file
+   * with pending [readListAt] or [writeListAt] operations cannot be closed.
    */
   Future<RandomAccessFile> close();
 
   /**
-   * Synchronously close the file.
+   * Synchronously close the file. A file with pending [readListAt] or
+   * [writeListAt] operations cannot be closed.
    */
   void closeSync();
 
@@ -353,6 +389,53 @@ abstract class RandomAccessFile {
    */
   int writeListSync(List<int> buffer, int offset, int bytes);
 
+  /**
+   * Read up to [bytes] bytes from the file starting at byte [position]
+   * into [buffer] starting at [offset]. The current byte position in the
+   * file is not used. Returns a [:Future<int>:] that completes with the
+   * number of bytes read, which is less than [bytes] only at the end of
+   * the file.
+   *
+   * Reads issued together are submitted to the operating system together.
+   * A buffer created with [:new Uint8List.transferable:] is filled
+   * directly, other buffers are filled from a temporary buffer when the
+   * read completes. The buffer must not be used until the read has
+   * completed.
+   */
+  Future<int> readListAt(List<int> buffer, int offset, int bytes, int position);
+
+  /**
+   * Write [bytes] bytes from [buffer] starting at [offset] to the file
+   * starting at byte [position]. The current byte position in the file is
+   * not used. Returns a [:Future<RandomAccessFile>:] that completes with
+   * this RandomAccessFile when all the bytes have been written.
+   *
+   * Writes issued together are submitted to the operating system
+   * together. A buffer created with [:new Uint8List.transferable:] is
+   * written directly and must not be changed until the write has
+   * completed, other buffers are copied first.
+   */
+  Future<RandomAccessFile> writeListAt(List<int> buffer,
+                                       int offset,
+                                       int bytes,
+                                       int position);
+
+  /**
+   * Synchronously map [length] bytes of the file starting at byte
+   * [position] into memory. The returned list reads and writes the file
+   * contents directly without copying them. If [length] is not given the
+   * file is mapped up to its end.
+   *
+   * The mapping stays valid when the file is closed and is released when
+   * the list is garbage collected. The range mapped must be within the
+   * file. Accessing the list after the file has been truncated below the
+   * mapped range crashes the process.
+   */
+  Uint8List mapSync({FileMapMode mode: FileMapMode.READ,
+                     int position: 0,
+                     int length,
+                     FileMapAccess access: FileMapAccess.NORMAL});
+
   /**
    * Write a string to the file using the given [encoding]. Returns a
    * [:Future<RandomAccessFile>:] that completes with this
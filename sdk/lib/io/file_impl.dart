@@ -311,6 +311,10 @@ const int _READ_REQUEST = 16;
 const int _READ_LIST_REQUEST = 17;
 const int _WRITE_LIST_REQUEST = 18;
 
+// Operations of the native file I/O engine.
+const int _IO_READ = 0;
+const int _IO_WRITE = 1;
+
 // Base class for _File and _RandomAccessFile with shared functions.
 class _FileBase {
   bool _isErrorResponse(response) {
@@ -719,12 +723,103 @@ class _File extends _FileBase implements File {
 }
 
 
+// Positional reads and writes performed by the native file I/O engine
+// directly on external byte arrays. Requests issued while handling the same
+// event are submitted in one batch. The completions are posted to a receive
+// port which is only open while requests are pending, so it does not keep
+// the isolate alive.
+class _FileIO {
+  static Future submit(_RandomAccessFile file,
+                       int operation,
+                       List<int> buffer,
+                       int offset,
+                       int bytes,
+                       int position) {
+    if (_port == null) {
+      _port = new ReceivePort();
+      _port.receive(_handleMessage);
+    }
+    if (_batch == null) {
+      _batch = [];
+      // The batch is submitted when this message is received, after the
+      // current event has been handled.
+      _port.toSendPort().send(null);
+    }
+    int id = _nextId++;
+    var request = new _FileIORequest(file, buffer);
+    _pending[id] = request;
+    file._pendingIO++;
+    _batch..add(id)
+          ..add(file._id)
+          ..add(operation)
+          ..add(buffer)
+          ..add(offset)
+          ..add(bytes)
+          ..add(position);
+    return request.completer.future;
+  }
+
+  // Whether the engine can transfer to and from the buffer directly. The
+  // engine addresses the data of external Uint8Lists in bytes. Other
+  // external lists are copied like any other list.
+  static bool isDirectBuffer(List buffer) {
+    return (buffer is Uint8List) && _BufferUtils._isExternalByteArray(buffer);
+  }
+
+  static void _flush() {
+    var batch = _batch;
+    _batch = null;
+    _submit(_port.toSendPort(), batch);
+  }
+
+  static void _handleMessage(List message, SendPort replyTo) {
+    if (message == null) {
+      _flush();
+      return;
+    }
+    _FileIORequest request = _pending.remove(message[0]);
+    request.file._pendingIO--;
+    if (_pending.isEmpty && _batch == null) {
+      _port.close();
+      _port = null;
+    }
+    request.completer.complete(message[1]);
+  }
+
+  external static void _submit(SendPort port, List batch);
+
+  static ReceivePort _port;
+  static List _batch;
+  static final Map<int, _FileIORequest> _pending =
+      new Map<int, _FileIORequest>();
+  static int _nextId = 0;
+}
+
+
+class _FileIORequest {
+  _FileIORequest(_RandomAccessFile this.file, List<int> this.buffer);
+
+  final _RandomAccessFile file;
+  // The buffer is referenced until the request completes as the native
+  // code accesses its data directly.
+  final List<int> buffer;
+  final Completer completer = new Completer();
+}
+
+
 class _RandomAccessFile extends _FileBase implements RandomAccessFile {
   _RandomAccessFile(int this._id, String this._name);
 
   Future<RandomAccessFile> close() {
     Completer<RandomAccessFile> completer = new Completer<RandomAccessFile>();
     if (closed) return _completeWithClosedException(completer);
+    if (_pendingIO > 0) {
+      new Timer(0, (t) {
+        completer.completeError(new FileIOException(
+            "Cannot close file '$_name' with pending operations"));
+      });
+      return completer.future;
+    }
     _ensureFileService();
     List request = new List.fixedLength(2);
     request[0] = _CLOSE_REQUEST;
@@ -746,6 +841,10 @@ class _RandomAccessFile extends _FileBase implements RandomAccessFile {
 
   void closeSync() {
     _checkNotClosed();
+    if (_pendingIO > 0) {
+      throw new FileIOException(
+          "Cannot close file '$_name' with pending operations");
+    }
     var id = _close(_id);
     if (id == -1) {
       throw new FileIOException("Cannot close file '$_name'");
@@ -977,6 +1076,119 @@ class _RandomAccessFile extends _FileBase implements RandomAccessFile {
     return result;
   }
 
+  Future<int> readListAt(List<int> buffer,
+                         int offset,
+                         int bytes,
+                         int position) {
+    Completer<int> completer = new Completer<int>();
+    if (buffer is !List ||
+        offset is !int ||
+        bytes is !int ||
+        position is !int) {
+      // Complete asynchronously so the user has a chance to setup
+      // handlers without getting exceptions when registering the
+      // then handler.
+      new Timer(0, (t) {
+        completer.completeError(new FileIOException(
+            "Invalid arguments to readListAt for file '$_name'"));
+      });
+      return completer.future;
+    }
+    if (closed) return _completeWithClosedException(completer);
+    try {
+      _checkReadWriteListArguments(buffer.length, offset, bytes);
+      if (position < 0) throw new RangeError.value(position);
+    } catch (e) {
+      new Timer(0, (t) => completer.completeError(e));
+      return completer.future;
+    }
+    if (bytes == 0) {
+      new Timer(0, (t) => completer.complete(0));
+      return completer.future;
+    }
+    List<int> target = buffer;
+    int targetOffset = offset;
+    if (!_FileIO.isDirectBuffer(buffer)) {
+      target = new Uint8List.transferable(bytes);
+      targetOffset = 0;
+    }
+    return _FileIO.submit(this, _IO_READ, target, targetOffset, bytes,
+                          position).then((response) {
+      if (_isErrorResponse(response)) {
+        throw _exceptionFromResponse(response,
+                                     "readListAt failed for file '$_name'");
+      }
+      if (!identical(target, buffer)) {
+        buffer.setRange(offset, response, target);
+      }
+      return response;
+    });
+  }
+
+  Future<RandomAccessFile> writeListAt(List<int> buffer,
+                                       int offset,
+                                       int bytes,
+                                       int position) {
+    Completer<RandomAccessFile> completer = new Completer<RandomAccessFile>();
+    if (buffer is !List ||
+        offset is !int ||
+        bytes is !int ||
+        position is !int) {
+      // Complete asynchronously so the user has a chance to setup
+      // handlers without getting exceptions when registering the
+      // then handler.
+      new Timer(0, (t) {
+        completer.completeError(new FileIOException(
+            "Invalid arguments to writeListAt for file '$_name'"));
+      });
+      return completer.future;
+    }
+    if (closed) return _completeWithClosedException(completer);
+    List<int> source = buffer;
+    int sourceOffset = offset;
+    try {
+      _checkReadWriteListArguments(buffer.length, offset, bytes);
+      if (position < 0) throw new RangeError.value(position);
+      if (bytes > 0 && !_FileIO.isDirectBuffer(buffer)) {
+        source = new Uint8List.transferable(bytes);
+        source.setRange(0, bytes, buffer, offset);
+        sourceOffset = 0;
+      }
+    } catch (e) {
+      new Timer(0, (t) => completer.completeError(e));
+      return completer.future;
+    }
+    if (bytes == 0) {
+      new Timer(0, (t) => completer.complete(this));
+      return completer.future;
+    }
+    return _writeAt(source, sourceOffset, bytes, position);
+  }
+
+  Future<RandomAccessFile> _writeAt(List<int> buffer,
+                                    int offset,
+                                    int bytes,
+                                    int position) {
+    return _FileIO.submit(this, _IO_WRITE, buffer, offset, bytes,
+                          position).then((response) {
+      if (_isErrorResponse(response)) {
+        throw _exceptionFromResponse(response,
+                                     "writeListAt failed for file '$_name'");
+      }
+      if (response == 0) {
+        throw new FileIOException("writeListAt failed for file '$_name'");
+      }
+      if (response < bytes) {
+        // Write the rest of a partial write.
+        return _writeAt(buffer,
+                        offset + response,
+                        bytes - response,
+                        position + response);
+      }
+      return this;
+    });
+  }
+
   Future<RandomAccessFile> writeString(String string,
                                        [Encoding encoding = Encoding.UTF_8]) {
     if (encoding is! Encoding) {
@@ -1097,6 +1309,34 @@ class _RandomAccessFile extends _FileBase implements RandomAccessFile {
     });
   }
 
+  external static _map(int id, int mode, int position, int length, int access);
+
+  Uint8List mapSync({FileMapMode mode: FileMapMode.READ,
+                     int position: 0,
+                     int length,
+                     FileMapAccess access: FileMapAccess.NORMAL}) {
+    _checkNotClosed();
+    if (mode is !FileMapMode ||
+        position is !int ||
+        (length != null && length is !int) ||
+        access is !FileMapAccess) {
+      throw new FileIOException("Invalid arguments to map for file '$_name'");
+    }
+    int fileLength = lengthSync();
+    if (length == null) length = fileLength - position;
+    if (position < 0) throw new RangeError.value(position);
+    if (length < 0) throw new RangeError.value(length);
+    if (position + length > fileLength) {
+      throw new RangeError.value(position + length);
+    }
+    if (length == 0) return new Uint8List(0);
+    var result = _map(_id, mode._mode, position, length, access._access);
+    if (result is OSError) {
+      throw new FileIOException("map failed for file '$_name'", result);
+    }
+    return result;
+  }
+
   external static _length(int id);
 
   int lengthSync() {
@@ -1160,6 +1400,8 @@ class _RandomAccessFile extends _FileBase implements RandomAccessFile {
 
   final String _name;
   int _id;
+  // Number of readListAt and writeListAt requests in progress.
+  int _pendingIO = 0;
 
   SendPort _fileService;
 }
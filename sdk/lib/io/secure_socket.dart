@@ -368,6 +368,38 @@ class _SecureSocket implements SecureSocket {
     return bytes;
   }
 
+  int writeBuffers(List<List<int>> buffers, [int offset = 0]) {
+    // The data is encrypted before it is written to the socket, so the
+    // buffers are passed to writeList one at a time.
+    int total = 0;
+    for (int i = 0; i < buffers.length; i++) {
+      List<int> buffer = buffers[i];
+      int start = (i == 0) ? offset : 0;
+      int bytes = writeList(buffer, start, buffer.length - start);
+      total += bytes;
+      if (bytes < buffer.length - start) break;
+    }
+    return total;
+  }
+
+  int writeFile(RandomAccessFile file, int position, int count) {
+    // The data is encrypted, so it is read into Dart and written through
+    // writeList.
+    if (_closedWrite) {
+      throw new SocketIOException("Writing to a closed socket");
+    }
+    if (_status != CONNECTED) return 0;
+    int free = secureFilter.buffers[WRITE_PLAINTEXT].free;
+    if (count > free) count = free;
+    if (count <= 0) return 0;
+    List<int> data = new Uint8List(count);
+    int savedPosition = file.positionSync();
+    file.setPositionSync(position);
+    int bytes = file.readListSync(data, 0, count);
+    file.setPositionSync(savedPosition);
+    return writeList(data, 0, bytes);
+  }
+
   X509Certificate get peerCertificate => secureFilter.peerCertificate;
 
   void _secureConnectHandler() {
@@ -8,8 +8,16 @@ abstract class ServerSocket {
   /**
    * Constructs a new server socket, binds it to a given address and port,
    * and listens on it.
+   *
+   * If [shared] is [:true:] several server sockets, for example one in
+   * each of a number of isolates, can be bound to the same address and
+   * port. The incoming connections are then distributed between them.
+   * This is only supported on Linux 3.9 or later and Mac OS.
    */
-  external factory ServerSocket(String bindAddress, int port, int backlog);
+  external factory ServerSocket(String bindAddress,
+                                int port,
+                                int backlog,
+                                {bool shared: false});
 
   /**
    * The connection handler gets called when there is a new incoming
@@ -73,6 +81,25 @@ abstract class Socket {
    */
   int writeList(List<int> buffer, int offset, int count);
 
+  /**
+   * Writes the lists in [buffers] to the socket in order, starting at
+   * [offset] in the first list. Where the platform supports it all the
+   * lists are written with a single system call. The number of
+   * successfully written bytes is returned. This function is non-blocking
+   * and will only write data if buffer space is available in the socket.
+   */
+  int writeBuffers(List<List<int>> buffers, [int offset = 0]);
+
+  /**
+   * Writes up to [count] bytes of [file] starting at file position
+   * [position] to the socket. Where the platform supports it the data is
+   * transferred by the operating system without being read into Dart. The
+   * position of [file] is not changed. The number of successfully written
+   * bytes is returned. This function is non-blocking and will only write
+   * data if buffer space is available in the socket.
+   */
+  int writeFile(RandomAccessFile file, int position, int count);
+
   /**
    * The connect handler gets called when connection to a given host
    * succeeded.
@@ -75,6 +75,9 @@ class _SocketInputStream implements InputStream {
 
 class _SocketOutputStream
     extends _BaseOutputStream implements OutputStream {
+  // Maximum number of pending buffers passed to the socket in one write.
+  static const int _MAX_BUFFERS = 64;
+
   _SocketOutputStream(Socket socket)
       : _socket = socket, _pendingWrites = new _BufferList();
 
@@ -174,14 +177,18 @@ class _SocketOutputStream
   }
 
   void _onWrite() {
-    // Write as much buffered data to the socket as possible.
+    // Write as much buffered data to the socket as possible, passing
+    // several buffers to the socket at a time.
     while (!_pendingWrites.isEmpty) {
-      List<int> buffer = _pendingWrites.first;
+      List<List<int>> buffers = _pendingWrites.firstBuffers(_MAX_BUFFERS);
       int offset = _pendingWrites.index;
-      int bytesToWrite = buffer.length - offset;
+      int bytesToWrite = -offset;
+      for (int i = 0; i < buffers.length; i++) {
+        bytesToWrite += buffers[i].length;
+      }
       int bytesWritten;
       try {
-        bytesWritten = _socket.writeList(buffer, offset, bytesToWrite);
+        bytesWritten = _socket.writeBuffers(buffers, offset);
       } catch (e) {
         _pendingWrites.clear();
         if (_onError != null) _onError(e);
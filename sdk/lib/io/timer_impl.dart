@@ -4,27 +4,20 @@
 
 part of dart.io;
 
+// Timers are kept by the event handler in a timing wheel where adding and
+// cancelling a timer takes constant time. When timers expire the event
+// handler posts the list of their ids to the timer receive port.
 class _Timer implements Timer {
-  // Set jitter to wake up timer events that would happen in _TIMER_JITTER ms.
-  static const int _TIMER_JITTER = 0;
-
-  // Disables the timer.
-  static const int _NO_TIMER = -1;
-
   static Timer _createTimer(void callback(Timer timer),
                            int milliSeconds,
                            bool repeating) {
     _EventHandler._start();
-    if (_timers == null) {
-      _timers = new DoubleLinkedQueue<_Timer>();
-    }
     Timer timer = new _Timer._internal();
     timer._callback = callback;
     timer._milliSeconds = milliSeconds;
     timer._wakeupTime = (new DateTime.now()).millisecondsSinceEpoch + milliSeconds;
     timer._repeating = repeating;
-    timer._addTimerToList();
-    timer._notifyEventHandler();
+    timer._schedule();
     return timer;
   }
 
@@ -46,138 +39,96 @@ class _Timer implements Timer {
   }
 
 
-  // Cancels a set timer. The timer is removed from the timer list and if
-  // the given timer is the earliest timer the native timer is reset.
+  // Cancels a set timer. The timer is removed from the event handler and
+  // the timer receive port is closed if it was the last timer.
   void cancel() {
     _clear();
-    DoubleLinkedQueueEntry<_Timer> entry = _timers.firstEntry();
-    DoubleLinkedQueueEntry<_Timer> first = _timers.firstEntry();
-
-     while (entry != null) {
-      if (identical(entry.element, this)) {
-        entry.remove();
-        if (first.element == this) {
-          entry = _timers.firstEntry();
-          _notifyEventHandler();
-        }
-        return;
-      }
-      entry = entry.nextEntry();
+    if (_id != null && _timers.remove(_id) != null) {
+      _EventHandler._cancelTimer(_id);
     }
+    _shutdownTimerHandlerIfIdle();
   }
 
   void _advanceWakeupTime() {
     _wakeupTime += _milliSeconds;
   }
 
-  // Adds a timer to the timer list and resets the native timer if it is the
-  // earliest timer in the list.  Timers with the same wakeup time are enqueued
-  // in order and notified in FIFO order.
-  void _addTimerToList() {
-    if (_callback != null) {
-
-      DoubleLinkedQueueEntry<_Timer> entry = _timers.firstEntry();
-      while (entry != null) {
-        if (_wakeupTime < entry.element._wakeupTime) {
-          entry.prepend(this);
-          return;
-        }
-        entry = entry.nextEntry();
-      }
-      _timers.addLast(this);
-    }
-  }
-
-
-  void _notifyEventHandler() {
-    if (_handling_callbacks) {
-      // While we are already handling callbacks we will not notify the event
-      // handler. _handleTimeout will call _notifyEventHandler once all pending
-      // timers are processed.
-      return;
+  // Adds the timer to the event handler.
+  void _schedule() {
+    if (_timers == null) {
+      _timers = new Map<int, _Timer>();
     }
-
-    if (_timers.firstEntry() == null) {
-      // No pending timers: Close the receive port and let the event handler
-      // know.
-      if (_receivePort != null) {
-        _EventHandler._sendData(null, _receivePort, _NO_TIMER);
-        _shutdownTimerHandler();
-      }
-    } else {
-      if (_receivePort == null) {
-        // Create a receive port and register a message handler for the timer
-        // events.
-        _createTimerHandler();
-      }
-      _EventHandler._sendData(null,
-                              _receivePort,
-                              _timers.firstEntry().element._wakeupTime);
+    if (_receivePort == null) {
+      _createTimerHandler();
     }
+    _id = _EventHandler._addTimer(_receivePort, _wakeupTime);
+    _timers[_id] = this;
   }
 
 
   // Creates a receive port and registers the timer handler on that
   // receive port.
-  void _createTimerHandler() {
-
-    void _handleTimeout() {
-      int currentTime =
-          (new DateTime.now()).millisecondsSinceEpoch + _TIMER_JITTER;
-
-      // Collect all pending timers.
-      DoubleLinkedQueueEntry<_Timer> entry = _timers.firstEntry();
-      var pending_timers = new List();
-      while (entry != null) {
-        _Timer timer = entry.element;
-        if (timer._wakeupTime <= currentTime) {
-          entry.remove();
-          pending_timers.addLast(timer);
-          entry = _timers.firstEntry();
-        } else {
-          break;
-        }
-      }
+  static void _createTimerHandler() {
+    _receivePort = new ReceivePort();
+    _receivePort.receive((List ids, ignored) {
+      _handleTimeout(ids);
+    });
+  }
 
-      // Trigger all of the pending timers. New timers added as part of the
-      // callbacks will be enqueued now and notified in the next spin at the
-      // earliest.
-      _handling_callbacks = true;
-      try {
-        for (var timer in pending_timers) {
-          // One of the timers in the pending_timers list can cancel
-          // one of the later timers which will set the callback to
-          // null.
-          if (timer._callback != null) {
-            timer._callback(timer);
-            if (timer._repeating) {
-              timer._advanceWakeupTime();
-              timer._addTimerToList();
-            }
+  static void _handleTimeout(List ids) {
+    // Collect the expired timers. Timers cancelled after they expired are
+    // no longer known.
+    var pending_timers = new List();
+    for (int id in ids) {
+      _Timer timer = _timers.remove(id);
+      if (timer != null) pending_timers.add(timer);
+    }
+    // Timers with the same wakeup time are notified in FIFO order. The ids
+    // are increasing, also for repeating timers added again.
+    pending_timers.sort((a, b) {
+      int result = a._wakeupTime.compareTo(b._wakeupTime);
+      return (result != 0) ? result : a._id.compareTo(b._id);
+    });
+
+    // Trigger all of the pending timers. New timers added as part of the
+    // callbacks will be notified in the next spin at the earliest.
+    _handling_callbacks = true;
+    try {
+      for (var timer in pending_timers) {
+        // One of the timers in the pending_timers list can cancel
+        // one of the later timers which will set the callback to
+        // null.
+        if (timer._callback != null) {
+          timer._callback(timer);
+          if (timer._repeating) {
+            timer._advanceWakeupTime();
+            timer._schedule();
           }
         }
-      } finally {
-        _handling_callbacks = false;
       }
-      _notifyEventHandler();
-    }
-
-    if(_receivePort == null) {
-      _receivePort = new ReceivePort();
-      _receivePort.receive((var message, ignored) {
-        _handleTimeout();
-      });
+    } finally {
+      _handling_callbacks = false;
     }
+    _shutdownTimerHandlerIfIdle();
   }
 
-  void _shutdownTimerHandler() {
-    _receivePort.close();
-    _receivePort = null;
+  // Closes the receive port when there are no pending timers so that it
+  // does not keep the isolate alive.
+  static void _shutdownTimerHandlerIfIdle() {
+    if (_handling_callbacks) {
+      // _handleTimeout will check again once all pending timers are
+      // processed.
+      return;
+    }
+    if (_receivePort != null && _timers.isEmpty) {
+      _receivePort.close();
+      _receivePort = null;
+    }
   }
 
 
-  // Timers are ordered by wakeup time.
-  static DoubleLinkedQueue<_Timer> _timers;
+  // Maps the ids given by the event handler to the pending timers.
+  static Map<int, _Timer> _timers;
 
   static ReceivePort _receivePort;
   static bool _handling_callbacks = false;
@@ -186,6 +137,7 @@ class _Timer implements Timer {
   int _milliSeconds;
   int _wakeupTime;
   bool _repeating;
+  int _id;
 }
 
 // Provide a closure which will allocate a Timer object to be able to hook
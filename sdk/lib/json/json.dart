@@ -668,47 +668,55 @@ class _JsonStringifier {
 
   static void escape(StringBuffer sb, String s) {
     final int length = s.length;
-    bool needsEscape = false;
-    final charCodes = new List<int>();
+    // Characters which need no escaping are added in runs, so strings
+    // without any escapes are added as they are.
+    int offset = 0;
     for (int i = 0; i < length; i++) {
       int charCode = s.charCodeAt(i);
-      if (charCode < 32) {
-        needsEscape = true;
-        charCodes.add(JsonParser.BACKSLASH);
-        switch (charCode) {
-        case JsonParser.BACKSPACE:
-          charCodes.add(JsonParser.CHAR_b);
-          break;
-        case JsonParser.TAB:
-          charCodes.add(JsonParser.CHAR_t);
-          break;
-        case JsonParser.NEWLINE:
-          charCodes.add(JsonParser.CHAR_n);
-          break;
-        case JsonParser.FORM_FEED:
-          charCodes.add(JsonParser.CHAR_f);
-          break;
-        case JsonParser.CARRIAGE_RETURN:
-          charCodes.add(JsonParser.CHAR_r);
-          break;
-        default:
-          charCodes.add(JsonParser.CHAR_u);
-          charCodes.add(hexDigit((charCode >> 12) & 0xf));
-          charCodes.add(hexDigit((charCode >> 8) & 0xf));
-          charCodes.add(hexDigit((charCode >> 4) & 0xf));
-          charCodes.add(hexDigit(charCode & 0xf));
-          break;
-        }
-      } else if (charCode == JsonParser.QUOTE ||
-          charCode == JsonParser.BACKSLASH) {
-        needsEscape = true;
-        charCodes.add(JsonParser.BACKSLASH);
-        charCodes.add(charCode);
-      } else {
-        charCodes.add(charCode);
+      if (charCode >= 32 &&
+          charCode != JsonParser.QUOTE &&
+          charCode != JsonParser.BACKSLASH) {
+        continue;
       }
+      if (i > offset) sb.add(s.substring(offset, i));
+      offset = i + 1;
+      switch (charCode) {
+      case JsonParser.BACKSPACE:
+        sb.add(r'\b');
+        break;
+      case JsonParser.TAB:
+        sb.add(r'\t');
+        break;
+      case JsonParser.NEWLINE:
+        sb.add(r'\n');
+        break;
+      case JsonParser.FORM_FEED:
+        sb.add(r'\f');
+        break;
+      case JsonParser.CARRIAGE_RETURN:
+        sb.add(r'\r');
+        break;
+      case JsonParser.QUOTE:
+        sb.add(r'\"');
+        break;
+      case JsonParser.BACKSLASH:
+        sb.add(r'\\');
+        break;
+      default:
+        sb.addCharCode(JsonParser.BACKSLASH);
+        sb.addCharCode(JsonParser.CHAR_u);
+        sb.addCharCode(hexDigit((charCode >> 12) & 0xf));
+        sb.addCharCode(hexDigit((charCode >> 8) & 0xf));
+        sb.addCharCode(hexDigit((charCode >> 4) & 0xf));
+        sb.addCharCode(hexDigit(charCode & 0xf));
+        break;
+      }
+    }
+    if (offset == 0) {
+      sb.add(s);
+    } else if (offset < length) {
+      sb.add(s.substring(offset, length));
     }
-    sb.add(needsEscape ? new String.fromCharCodes(charCodes) : s);
   }
 
   void checkCycle(final object) {
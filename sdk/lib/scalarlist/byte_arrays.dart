@@ -324,6 +324,43 @@ abstract class ByteArray {
    * `byteOffset + 8` is greater than the length of this byte array.
    */
   int setFloat64(int byteOffset, double value);
+
+  /**
+   * Sets the [length] bytes starting at position [start] in this byte array
+   * to the low eight bits of the specified [value]. If [length] is not
+   * specified, the bytes up to the end of this byte array are set.
+   *
+   * Throws [RangeError] if [start] or [length] are negative, or
+   * if `start + length` is greater than the length of this byte array.
+   */
+  void fill(int value, [int start, int length]);
+
+  /**
+   * Returns the offset of the first byte at or after position [start] in
+   * this byte array that is equal to the specified [value], or -1 if there
+   * is no such byte. A [value] outside the range 0 to 255 is never found.
+   */
+  int indexOf(int value, [int start]);
+
+  /**
+   * Compares the bytes of this byte array with the bytes of [other] as
+   * unsigned numbers, in lexicographic order. Returns a negative integer,
+   * zero or a positive integer if this byte array is ordered before, equal
+   * to or after [other].
+   */
+  int compareTo(ByteArray other);
+
+  /**
+   * Returns the CRC-32 checksum, as used by zlib and Ethernet, of the
+   * [length] bytes starting at position [start] in this byte array. If
+   * [length] is not specified, the bytes up to the end of this byte array
+   * are included. A checksum can be computed in parts by passing the
+   * result for the preceding bytes as [crc].
+   *
+   * Throws [RangeError] if [start] or [length] are negative, or
+   * if `start + length` is greater than the length of this byte array.
+   */
+  int crc32([int start, int length, int crc]);
 }
 
 /**
@@ -0,0 +1,126 @@
+// Copyright (c) 2013, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// Test parsing and stringifying larger and deeper JSON documents, with
+// repeated keys, escapes and non-Latin-1 strings.
+library json_nested_test;
+
+import "dart:json";
+
+String document(String name, int count) {
+  var sb = new StringBuffer();
+  sb.add('[');
+  for (int i = 0; i < count; i++) {
+    if (i > 0) sb.add(',');
+    sb.add('{"id":$i,"name":"$name $i","tags":["a\\tb","\\u00e9\\ud83d\\ude00"],'
+           '"ratio":${i}.5e-1,"ok":${i % 2 == 0},"none":null}');
+  }
+  sb.add(']');
+  return sb.toString();
+}
+
+
+void testDocument(String name) {
+  var list = parse(document(name, 100));
+  Expect.equals(100, list.length);
+  for (int i = 0; i < 100; i++) {
+    Map map = list[i];
+    Expect.listEquals(["id", "name", "tags", "ratio", "ok", "none"],
+                      map.keys.toList());
+    Expect.equals(i, map["id"]);
+    Expect.equals("$name $i", map["name"]);
+    Expect.listEquals(["a\tb", "é😀"], map["tags"]);
+    Expect.equals(double.parse("$i.5e-1"), map["ratio"]);
+    Expect.equals(i % 2 == 0, map["ok"]);
+    Expect.isTrue(map.containsKey("none"));
+    Expect.isNull(map["none"]);
+  }
+  // Parsed lists and maps can be modified.
+  list.add(1);
+  list[0]["id"] = -1;
+  Expect.equals(101, list.length);
+  Expect.equals(-1, list[0]["id"]);
+  Expect.equals(stringify(list), stringify(parse(stringify(list))));
+}
+
+
+void testIntegers() {
+  Expect.listEquals([0, -0, 999999999999999999, -999999999999999999],
+                    parse('[0,-0,999999999999999999,-999999999999999999]'));
+  Expect.equals(int.parse("123456789012345678901234567890"),
+                parse('{"a":123456789012345678901234567890}')["a"]);
+  Expect.equals(-9223372036854775808, parse('-9223372036854775808'));
+}
+
+
+void testDoubles() {
+  var sb = new StringBuffer();
+  sb.add('0.');
+  for (int i = 0; i < 100; i++) sb.add('1');
+  var long = sb.toString();
+  var numbers = '[1.5,-0.25,1e3,2E-2,6.02214129e23,-0.0,1e400,$long]';
+  var expected = [1.5, -0.25, 1000.0, 0.02, 6.02214129e23, -0.0,
+                  double.INFINITY, double.parse(long)];
+  Expect.listEquals(expected, parse(numbers));
+  // Input with characters outside Latin-1 is parsed from UTF-16.
+  var list = parse('["€",${numbers.substring(1)}');
+  Expect.equals("€", list[0]);
+  Expect.listEquals(expected, list.getRange(1, expected.length));
+}
+
+
+void testDeepNesting() {
+  int depth = 5000;
+  var sb = new StringBuffer();
+  for (int i = 0; i < depth; i++) sb.add('[{"a":');
+  sb.add('0');
+  for (int i = 0; i < depth; i++) sb.add('}]');
+  var value = parse(sb.toString());
+  for (int i = 0; i < depth; i++) value = value[0]["a"];
+  Expect.equals(0, value);
+}
+
+
+void testReviver() {
+  var calls = [];
+  var result = parse('{"a":[1,{"b":2}],"c":"d"}', (key, value) {
+    calls.add(key);
+    return (value is int) ? value + 1 : value;
+  });
+  Expect.listEquals([0, "b", 1, "a", "c", ""], calls);
+  Expect.equals(2, result["a"][0]);
+  Expect.equals(3, result["a"][1]["b"]);
+}
+
+
+void testErrors() {
+  bool badFormat(e) => e is FormatException;
+  for (var json in ['', '[1,]', '{"a":1,}', '{"a" 1}', '[01]', '"\\x"',
+                    '"\\ud800', '[1] 2', '{1:2}', '"a\nb"', '-', '1.',
+                    '1e', 'nul', '[€']) {
+    Expect.throws(() => parse(json), badFormat, json);
+  }
+}
+
+
+void testStringify() {
+  Expect.equals('"plain"', stringify("plain"));
+  Expect.equals(r'"\"q\"\\\b\f\n\r\t\u0001\u001f"',
+                stringify("\"q\"\\\b\f\n\r\t\u0001\u001f"));
+  Expect.equals('"a\\nb€c"', stringify("a\nb€c"));
+  Expect.equals('["€",{"k\\"":"v"}]', stringify(["€", {"k\"": "v"}]));
+}
+
+
+main() {
+  testDocument("ascii");
+  testDocument("über");
+  testDocument("€");
+  testIntegers();
+  testDoubles();
+  testDeepNesting();
+  testReviver();
+  testErrors();
+  testStringify();
+}
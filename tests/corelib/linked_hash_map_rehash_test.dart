@@ -0,0 +1,113 @@
+// Copyright (c) 2013, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// Dart test for linked hash-maps which grow, shrink and are rehashed.
+library linkedHashMapRehash.test;
+import 'dart:collection' show LinkedHashMap;
+
+// All instances have the same hash code.
+class Colliding {
+  final int id;
+  const Colliding(this.id);
+  int get hashCode => 42;
+  bool operator ==(other) => other is Colliding && other.id == id;
+}
+
+
+void testOrderAcrossRehash() {
+  Map map = new LinkedHashMap();
+  for (int i = 0; i < 1000; i++) map[i] = "$i";
+  // Remove every other entry so that the map is rehashed with holes.
+  for (int i = 0; i < 1000; i += 2) map.remove(i);
+  for (int i = 1000; i < 2000; i++) map[i] = "$i";
+  Expect.equals(1500, map.length);
+  var expected = [];
+  for (int i = 1; i < 1000; i += 2) expected.add(i);
+  for (int i = 1000; i < 2000; i++) expected.add(i);
+  Expect.listEquals(expected, map.keys.toList());
+  for (var key in map.keys) Expect.equals("$key", map[key]);
+  for (int i = 0; i < 1000; i += 2) {
+    Expect.isFalse(map.containsKey(i));
+    Expect.isNull(map[i]);
+  }
+}
+
+
+void testRemoveAndAddRepeatedly() {
+  Map map = new LinkedHashMap();
+  map["first"] = 0;
+  for (int i = 0; i < 10000; i++) {
+    map["key"] = i;
+    Expect.equals(i, map.remove("key"));
+  }
+  Expect.equals(1, map.length);
+  Expect.equals(0, map["first"]);
+  Expect.isNull(map.remove("key"));
+  Expect.listEquals(["first"], map.keys.toList());
+}
+
+
+void testCollisions() {
+  Map map = new LinkedHashMap();
+  for (int i = 0; i < 100; i++) map[new Colliding(i)] = i;
+  Expect.equals(100, map.length);
+  for (int i = 0; i < 100; i += 3) map.remove(new Colliding(i));
+  for (int i = 0; i < 100; i++) {
+    Expect.equals(i % 3 != 0, map.containsKey(new Colliding(i)));
+  }
+  map[const Colliding(0)] = "again";
+  Expect.equals("again", map[new Colliding(0)]);
+  Expect.equals(0, map.keys.last.id);
+}
+
+
+void testValuesAndClear() {
+  Map map = new LinkedHashMap();
+  map["a"] = null;
+  Expect.isTrue(map.containsKey("a"));
+  Expect.isTrue(map.containsValue(null));
+  Expect.equals(null, map.putIfAbsent("a", () => 1));
+  Expect.equals(2, map.putIfAbsent("b", () => 2));
+  Expect.listEquals([null, 2], map.values.toList());
+  map.clear();
+  Expect.isTrue(map.isEmpty);
+  Expect.isTrue(map.keys.isEmpty);
+  map["c"] = 3;
+  Expect.listEquals(["c"], map.keys.toList());
+}
+
+
+void testNullKey() {
+  Map map = new LinkedHashMap();
+  Expect.throws(() => map[null] = 1, (e) => e is ArgumentError);
+  Expect.throws(() => map[null], (e) => e is ArgumentError);
+  Expect.throws(() => map.containsKey(null), (e) => e is ArgumentError);
+}
+
+
+void testConcurrentModification() {
+  Map map = new LinkedHashMap();
+  for (int i = 0; i < 4; i++) map[i] = i;
+  Expect.throws(() {
+    for (var key in map.keys) map[key + 100] = key;
+  }, (e) => e is ConcurrentModificationError);
+  // Updating and removing entries while iterating does not rehash the map.
+  map = new LinkedHashMap();
+  for (int i = 0; i < 4; i++) map[i] = i;
+  map.forEach((key, value) {
+    map[key] = value + 1;
+    map.remove(3);
+  });
+  Expect.listEquals([1, 2, 3], map.values.toList());
+}
+
+
+main() {
+  testOrderAcrossRehash();
+  testRemoveAndAddRepeatedly();
+  testCollisions();
+  testValuesAndClear();
+  testNullKey();
+  testConcurrentModification();
+}
@@ -36,7 +36,7 @@ main() {
   Expect.isFalse(map5.values is List);
   Expect.equals(2, map5.values.length);
   Expect.isTrue(map5.values.first == 43 || map5.values.first == 500);
-  Expect.isTrue(map5.values.last == 43 || map5.values.first == 500);
+  Expect.isTrue(map5.values.last == 43 || map5.values.last == 500);
   Expect.notEquals(map5.values.first, map5.values.last);
 
   Expect.isTrue(map6.values is Iterable);
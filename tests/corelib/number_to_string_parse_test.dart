@@ -0,0 +1,108 @@
+// Copyright (c) 2013, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// Dart test for converting numbers to strings and back, covering both the
+// common short forms and the general algorithms.
+
+void testDoubleToString() {
+  Expect.equals("0.0", 0.0.toString());
+  Expect.equals("-0.0", (-0.0).toString());
+  Expect.equals("1.0", 1.0.toString());
+  Expect.equals("-42.0", (-42.0).toString());
+  Expect.equals("0.1", 0.1.toString());
+  Expect.equals("0.29", 0.29.toString());
+  Expect.equals("1.005", 1.005.toString());
+  Expect.equals("-9879.79", (-9879.79).toString());
+  Expect.equals("0.000001", 0.000001.toString());
+  Expect.equals("0.0000015", 0.0000015.toString());
+  Expect.equals("1e-7", 1e-7.toString());
+  Expect.equals("0.30000000000000004", (0.1 + 0.2).toString());
+  Expect.equals("0.3333333333333333", (1 / 3).toString());
+  Expect.equals("4503599627370495.0", 4503599627370495.0.toString());
+  Expect.equals("9007199254740992.0", 9007199254740992.0.toString());
+  Expect.equals("100000000000000000000.0", 1e20.toString());
+  Expect.equals("1e+21", 1e21.toString());
+  Expect.equals("5e-324", 5e-324.toString());
+  Expect.equals("Infinity", double.INFINITY.toString());
+  Expect.equals("-Infinity", (-double.INFINITY).toString());
+  Expect.equals("NaN", double.NAN.toString());
+  Expect.equals("2.5", "${2.5}");
+}
+
+
+void testDoubleRoundTrip() {
+  double value = 1.0;
+  for (int i = 0; i < 2000; i++) {
+    for (double d in [value, -value, value / 7, 1 / value]) {
+      Expect.equals(d, double.parse(d.toString()));
+    }
+    value = value * 1.37 + 0.01;
+  }
+  for (int i = 0; i < 100000; i += 7) {
+    Expect.equals(i / 100, double.parse((i / 100).toString()));
+    Expect.equals(-i / 1000, double.parse((-i / 1000).toString()));
+  }
+}
+
+
+void testDoubleParse() {
+  Expect.equals(1.5, double.parse("1.5"));
+  Expect.equals(1.5, double.parse("+1.5"));
+  Expect.equals(-1.5, double.parse("-1.5"));
+  Expect.isTrue(double.parse("-0.0").isNegative);
+  Expect.isTrue(double.parse("-0").isNegative);
+  Expect.isFalse(double.parse("+0.0").isNegative);
+  Expect.equals(0.5, double.parse(".5"));
+  Expect.equals(12.0, double.parse(" 12 "));
+  Expect.equals(100000.0, double.parse("1E+5"));
+  Expect.equals(0.00001, double.parse("1e-5"));
+  Expect.equals(16.0, double.parse("0x10"));
+  Expect.equals(1.5, double.parse("0000000000000000000000000000000000001.5"));
+  Expect.equals(1e22, double.parse("10000000000000000000000"));
+  Expect.equals(5e-324, double.parse("2.4703282292062328e-324"));
+  Expect.equals(0.0, double.parse("1e-400"));
+  Expect.equals(double.INFINITY, double.parse("1.7976931348623159e308"));
+  Expect.equals(-double.INFINITY, double.parse("-Infinity"));
+  Expect.isTrue(double.parse("NaN").isNaN);
+  for (var invalid in ["", "-", "+", "1.", "1e", "1.5e", "e5", "1..2", "1_0",
+                       "- 1", "1.5x"]) {
+    Expect.throws(() => double.parse(invalid),
+                  (e) => e is FormatException);
+  }
+}
+
+
+void testIntToStringAndParse() {
+  Expect.equals("0", 0.toString());
+  Expect.equals("-7", (-7).toString());
+  Expect.equals("1073741823", 1073741823.toString());
+  Expect.equals("-1073741824", (-1073741824).toString());
+  Expect.equals("9223372036854775807", 9223372036854775807.toString());
+  Expect.equals("-9223372036854775808", (-9223372036854775808).toString());
+  Expect.equals("18446744073709551616", (1 << 64).toString());
+  for (int i = 1; i < 64; i++) {
+    for (int value in [(1 << i) - 1, 1 << i, -(1 << i), -(1 << i) - 1]) {
+      Expect.equals(value, int.parse(value.toString()));
+    }
+  }
+  Expect.equals(7, int.parse("007"));
+  Expect.equals(7, int.parse("+7"));
+  Expect.equals(0, int.parse("-0"));
+  Expect.equals(12, int.parse(" 12 "));
+  Expect.equals(16, int.parse("0x10"));
+  Expect.equals(123456789012345678, int.parse("123456789012345678"));
+  Expect.equals(-123456789012345678, int.parse("-123456789012345678"));
+  Expect.equals(12345678901234567890, int.parse("12345678901234567890"));
+  for (var invalid in ["", "-", "+", "1.5", "1e5", "--1", "- 1", "12a"]) {
+    Expect.throws(() => int.parse(invalid), (e) => e is FormatException);
+  }
+}
+
+
+main() {
+  testDoubleToString();
+  testDoubleRoundTrip();
+  testDoubleParse();
+  testIntToStringAndParse();
+}
@@ -0,0 +1,59 @@
+// Copyright (c) 2013, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// Dart test program for matching regular expressions against strings with
+// one-byte and two-byte characters.
+
+void testLatin1() {
+  // Characters above 127 still fit in one byte.
+  var str = "café naïve über";
+  Expect.equals("café", new RegExp("c\\w*.").stringMatch(str));
+  Expect.equals("über", new RegExp("ü.*").stringMatch(str));
+  Expect.equals(3, new RegExp("é").firstMatch(str).start);
+  // A case insensitive character whose other case does not fit in one byte.
+  Expect.isTrue(new RegExp("Ÿ", caseSensitive: false).hasMatch("ÿ"));
+  Expect.isFalse(new RegExp("Ā").hasMatch("ÿ\u0001"));
+}
+
+
+void testTwoByte() {
+  var str = "a€ b€ c€";
+  var matches = new RegExp("(\\w)€").allMatches(str).toList();
+  Expect.equals(3, matches.length);
+  Expect.equals("c", matches[2].group(1));
+  Expect.equals(6, matches[2].start);
+}
+
+
+void testAllMatches() {
+  // Every match scans on from the end of the previous one.
+  var buffer = new StringBuffer();
+  for (int i = 0; i < 1000; i++) buffer.add("key$i=value$i;");
+  var str = buffer.toString();
+  var matches = new RegExp("key(\\d+)=(\\w+);").allMatches(str).toList();
+  Expect.equals(1000, matches.length);
+  for (int i = 0; i < 1000; i++) {
+    Expect.equals("$i", matches[i].group(1));
+    Expect.equals("value$i", matches[i].group(2));
+  }
+  // Required characters which are not found end the scan.
+  Expect.isNull(new RegExp("key\\d+!").firstMatch(str));
+  Expect.isNull(new RegExp("x").firstMatch(str));
+}
+
+
+void testEmpty() {
+  Expect.isTrue(new RegExp("").hasMatch(""));
+  Expect.isTrue(new RegExp("^\$").hasMatch(""));
+  Expect.isFalse(new RegExp("a").hasMatch(""));
+  Expect.equals(1, new RegExp("").allMatches("").length);
+}
+
+
+main() {
+  testLatin1();
+  testTwoByte();
+  testAllMatches();
+  testEmpty();
+}
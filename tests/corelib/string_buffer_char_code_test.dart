@@ -0,0 +1,96 @@
+// Copyright (c) 2013, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// Dart test for StringBuffer.addCharCode mixed with adding strings.
+
+void testCharCodes() {
+  StringBuffer buffer = new StringBuffer();
+  buffer.addCharCode(0x61);
+  buffer.addCharCode(0xE9);
+  Expect.equals(2, buffer.length);
+  Expect.equals("aé", buffer.toString());
+  buffer.addCharCode(0x20AC);
+  Expect.equals("aé€", buffer.toString());
+  // Supplementary code points are added as surrogate pairs.
+  buffer.addCharCode(0x1D11E);
+  Expect.equals(5, buffer.length);
+  String result = buffer.toString();
+  Expect.equals(0xD834, result.charCodeAt(3));
+  Expect.equals(0xDD1E, result.charCodeAt(4));
+  Expect.equals(new String.fromCharCodes([0x61, 0xE9, 0x20AC, 0x1D11E]),
+                result);
+}
+
+
+void testMixed() {
+  StringBuffer buffer = new StringBuffer("<");
+  String expectedString = "<";
+  for (int i = 0; i < 1000; i++) {
+    buffer.addCharCode(0x30 + i % 10);
+    expectedString = "$expectedString${i % 10}";
+    if (i % 7 == 0) {
+      buffer.add(i);
+      expectedString = "$expectedString$i";
+    }
+    if (i % 100 == 0) {
+      buffer.addCharCode(0x3A9);
+      expectedString = "$expectedStringΩ";
+    }
+    Expect.equals(expectedString.length, buffer.length);
+  }
+  Expect.equals(expectedString, buffer.toString());
+  // Adding after toString continues the contents.
+  buffer.addCharCode(0x3E);
+  buffer.add("!");
+  Expect.equals("$expectedString>!", buffer.toString());
+}
+
+
+void testManyParts() {
+  StringBuffer buffer = new StringBuffer();
+  for (int i = 0; i < 10000; i++) buffer.add("ab");
+  String hundred = "cccccccccccccccccccccccccccccccccccccccccccccccccc"
+                   "cccccccccccccccccccccccccccccccccccccccccccccccccc";
+  for (int i = 0; i < 300; i++) buffer.add(hundred);
+  Expect.equals(50000, buffer.length);
+  String result = buffer.toString();
+  Expect.equals(50000, result.length);
+  for (int i = 0; i < 20000; i += 2) {
+    Expect.equals("ab", result.substring(i, i + 2));
+  }
+  for (int i = 20000; i < 50000; i += 100) {
+    Expect.equals(hundred, result.substring(i, i + 100));
+  }
+}
+
+
+void testClear() {
+  StringBuffer buffer = new StringBuffer();
+  buffer.addCharCode(0x4242);
+  buffer.add("x");
+  buffer.addCharCode(0x42);
+  buffer.clear();
+  Expect.isTrue(buffer.isEmpty);
+  Expect.equals("", buffer.toString());
+  buffer.addCharCode(0x43);
+  Expect.equals("C", buffer.toString());
+}
+
+
+void testInvalid() {
+  StringBuffer buffer = new StringBuffer();
+  Expect.throws(() => buffer.addCharCode(-1), (e) => e is ArgumentError);
+  Expect.throws(() => buffer.addCharCode(0x110000),
+                (e) => e is ArgumentError);
+  Expect.equals(0, buffer.length);
+}
+
+
+main() {
+  testCharCodes();
+  testMixed();
+  testManyParts();
+  testClear();
+  testInvalid();
+}
@@ -0,0 +1,212 @@
+// Copyright (c) 2013, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// Dart test program for the bulk operations on native byte arrays.
+
+// Library tag to be able to run in html test framework.
+library ByteArrayBulkTest;
+
+import 'dart:scalarlist';
+
+// Returns the typed list after setting its elements to the values.
+List init(List typed, List values) {
+  typed.setRange(0, values.length, values);
+  return typed;
+}
+
+
+void testSetRangeVariants() {
+  var array = new Uint8List(16);
+  var view = new Uint8List.view(array.asByteArray(), 4, 8);
+  var source = new Uint8ClampedList(10);
+  for (int i = 0; i < 10; i++) source[i] = i + 1;
+
+  view.setRange(1, 5, source, 3);
+  Expect.listEquals([0, 0, 0, 0, 0, 4, 5, 6, 7, 8, 0, 0, 0, 0, 0, 0], array);
+  array.setRange(0, 4, view, 1);
+  Expect.listEquals([4, 5, 6, 7, 0, 4, 5, 6, 7, 8, 0, 0, 0, 0, 0, 0], array);
+
+  // Overlapping copies within the same array, in both directions.
+  array.setRange(1, 8, array, 0);
+  Expect.listEquals([4, 4, 5, 6, 7, 0, 4, 5, 6, 8, 0, 0, 0, 0, 0, 0], array);
+  array.setRange(0, 8, array, 1);
+  Expect.listEquals([4, 5, 6, 7, 0, 4, 5, 6, 6, 8, 0, 0, 0, 0, 0, 0], array);
+
+  var ints = new Int32List(6);
+  var intView = new Int32List.view(ints.asByteArray(), 4, 4);
+  intView.setRange(0, 4, init(new Int32List(4), [-1, 2, -3, 4]));
+  Expect.listEquals([0, -1, 2, -3, 4, 0], ints);
+  ints.setRange(3, 3, ints, 1);
+  Expect.listEquals([0, -1, 2, -1, 2, -3], ints);
+
+  var doubles = init(new Float64List(3), [1.5, 2.5, 3.5]);
+  var doubleView = new Float64List.view(new Float64List(4).asByteArray(), 8);
+  doubleView.setRange(0, 3, doubles);
+  Expect.listEquals([1.5, 2.5, 3.5], doubleView);
+  doubles.setRange(0, 2, doubleView, 1);
+  Expect.listEquals([2.5, 3.5, 3.5], doubles);
+
+  // Range errors are reported for the view, not the backing array.
+  Expect.throws(() => view.setRange(5, 4, source),
+                (e) => e is RangeError);
+  Expect.throws(() => array.setRange(0, 4, view, 6),
+                (e) => e is RangeError);
+  Expect.throws(() => ints.setRange(-1, 2, intView),
+                (e) => e is RangeError);
+}
+
+
+void testFill() {
+  var bytes = new Uint8List(10).asByteArray();
+  bytes.fill(7);
+  for (int i = 0; i < 10; i++) Expect.equals(7, bytes.getUint8(i));
+  bytes.fill(0x1FF, 2, 3);
+  Expect.equals(7, bytes.getUint8(1));
+  Expect.equals(0xFF, bytes.getUint8(2));
+  Expect.equals(0xFF, bytes.getUint8(4));
+  Expect.equals(7, bytes.getUint8(5));
+  var sub = bytes.subByteArray(6, 3);
+  sub.fill(-2);
+  Expect.equals(7, bytes.getUint8(5));
+  Expect.equals(0xFE, bytes.getUint8(6));
+  Expect.equals(0xFE, bytes.getUint8(8));
+  Expect.equals(7, bytes.getUint8(9));
+  sub.fill(1, 3, 0);
+  Expect.throws(() => sub.fill(0, 2, 2), (e) => e is RangeError);
+  Expect.throws(() => sub.fill(0, -1), (e) => e is RangeError);
+}
+
+
+void testByteIndexOf() {
+  var request = "GET / HTTP/1.1\r\nHost: x\r\n".charCodes;
+  var bytes = init(new Uint8List(request.length), request).asByteArray();
+  Expect.equals(14, bytes.indexOf(13));
+  Expect.equals(23, bytes.indexOf(13, 15));
+  Expect.equals(-1, bytes.indexOf(13, 24));
+  Expect.equals(-1, bytes.indexOf(13, 100));
+  Expect.equals(0, bytes.indexOf(71, -5));
+  Expect.equals(-1, bytes.indexOf(256));
+  Expect.equals(-1, bytes.indexOf(-1));
+  var sub = bytes.subByteArray(16, 8);
+  Expect.equals(7, sub.indexOf(13));
+  Expect.equals(-1, sub.indexOf(10));
+}
+
+
+void testListIndexOf() {
+  var bytes = init(new Uint8List(4), [1, 255, 3, 255]);
+  Expect.equals(1, bytes.indexOf(255));
+  Expect.equals(3, bytes.indexOf(255, 2));
+  Expect.equals(-1, bytes.indexOf(-1));
+  Expect.equals(-1, bytes.indexOf(255, 4));
+  Expect.equals(0, bytes.indexOf(1, -3));
+  Expect.equals(-1, bytes.indexOf("x"));
+
+  var signed = init(new Int8List(3), [1, -1, 127]);
+  Expect.equals(1, signed.indexOf(-1));
+  Expect.equals(-1, signed.indexOf(255));
+
+  var ints = init(new Int32List(4), [0, -7, 1 << 30, 0x7FFFFFFF]);
+  Expect.equals(1, ints.indexOf(-7));
+  Expect.equals(2, ints.indexOf(1 << 30));
+  Expect.equals(3, ints.indexOf(0x7FFFFFFF));
+  Expect.equals(-1, ints.indexOf(0xFFFFFFF9));
+  Expect.equals(-1, ints.indexOf(1 << 40));
+
+  var unsigned = new Uint64List(3);
+  unsigned[2] = 0xFFFFFFFFFFFFFFFF;
+  Expect.equals(-1, unsigned.indexOf(-1));
+  Expect.equals(2, unsigned.indexOf(0xFFFFFFFFFFFFFFFF));
+
+  var doubles = init(new Float64List(4), [0.5, double.NAN, -0.0, 1e300]);
+  Expect.equals(0, doubles.indexOf(0.5));
+  Expect.equals(2, doubles.indexOf(0.0));
+  Expect.equals(3, doubles.indexOf(1e300));
+  Expect.equals(-1, doubles.indexOf(double.NAN));
+  var floats = init(new Float32List(2), [0.5, 0.1]);
+  Expect.equals(1, floats.indexOf(floats[1]));
+  Expect.equals(-1, floats.indexOf(0.1));
+}
+
+
+void testLongListIndexOf() {
+  // Searches beyond the first elements use the native search.
+  for (var list in [new Uint8List(300), new Int8List(300),
+                    new Uint16List(300), new Int32List(300),
+                    new Uint32List(300), new Int64List(300)]) {
+    list[100] = 5;
+    list[250] = 5;
+    list[299] = 127;
+    Expect.equals(100, list.indexOf(5));
+    Expect.equals(250, list.indexOf(5, 101));
+    Expect.equals(299, list.indexOf(127, 1));
+    Expect.equals(-1, list.indexOf(6));
+    Expect.equals(-1, list.indexOf(1 << 62));
+    Expect.equals(-1, list.indexOf(5.0 + 0.5));
+    Expect.equals(-1, list.indexOf(null));
+  }
+  var ints = new Int32List(300);
+  ints[200] = -1;
+  Expect.equals(200, ints.indexOf(-1));
+  Expect.equals(-1, ints.indexOf(0xFFFFFFFF));
+  var unsigned = new Uint32List(300);
+  unsigned[200] = 0xFFFFFFFF;
+  Expect.equals(-1, unsigned.indexOf(-1));
+  Expect.equals(200, unsigned.indexOf(0xFFFFFFFF));
+  var doubles = new Float64List(300);
+  for (int i = 0; i < 300; i++) doubles[i] = 1.0;
+  doubles[150] = double.NAN;
+  doubles[160] = -0.0;
+  doubles[170] = 0.1;
+  Expect.equals(160, doubles.indexOf(0.0));
+  Expect.equals(-1, doubles.indexOf(0.0, 161));
+  Expect.equals(170, doubles.indexOf(0.1));
+  Expect.equals(-1, doubles.indexOf(double.NAN));
+  var floats = new Float32List(300);
+  floats[170] = 0.1;
+  Expect.equals(170, floats.indexOf(floats[170]));
+  Expect.equals(-1, floats.indexOf(0.1));
+}
+
+
+void testCompareTo() {
+  ByteArray bytes(List<int> list) {
+    return init(new Uint8List(list.length), list).asByteArray();
+  }
+  Expect.equals(0, bytes([]).compareTo(bytes([])));
+  Expect.equals(0, bytes([1, 2]).compareTo(bytes([1, 2])));
+  Expect.isTrue(bytes([1, 2]).compareTo(bytes([1, 3])) < 0);
+  Expect.isTrue(bytes([1, 200]).compareTo(bytes([1, 3])) > 0);
+  Expect.isTrue(bytes([1, 2]).compareTo(bytes([1, 2, 0])) < 0);
+  Expect.isTrue(bytes([2]).compareTo(bytes([1, 2, 0])) > 0);
+  var whole = bytes([9, 1, 2, 3, 9]);
+  Expect.equals(0, whole.subByteArray(1, 3).compareTo(bytes([1, 2, 3])));
+  Expect.isTrue(whole.subByteArray(1).compareTo(bytes([1, 2, 3])) > 0);
+  var signed = init(new Int8List(1), [-1]).asByteArray();
+  Expect.isTrue(signed.compareTo(bytes([127])) > 0);
+}
+
+
+void testCrc32() {
+  var bytes = init(new Uint8List(9), "123456789".charCodes).asByteArray();
+  Expect.equals(0xCBF43926, bytes.crc32());
+  Expect.equals(0, bytes.crc32(3, 0));
+  Expect.equals(bytes.crc32(), bytes.crc32(4, null, bytes.crc32(0, 4)));
+  Expect.equals(bytes.crc32(2, 5), bytes.subByteArray(2, 5).crc32());
+  Expect.equals(0xD202EF8D, new Uint8List(1).asByteArray().crc32());
+  Expect.throws(() => bytes.crc32(5, 5), (e) => e is RangeError);
+}
+
+
+main() {
+  for (int i = 0; i < 2000; i++) {
+    testSetRangeVariants();
+    testFill();
+    testByteIndexOf();
+    testListIndexOf();
+    testLongListIndexOf();
+    testCompareTo();
+    testCrc32();
+  }
+}
@@ -0,0 +1,102 @@
+// Copyright (c) 2013, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// Test mapping files into memory.
+
+import "dart:io";
+import "dart:scalarlist";
+
+const FILE_LENGTH = 100000;
+
+int expectedByte(int position) => (position * 13) & 0xFF;
+
+
+File createFile(Directory directory) {
+  var file = new File("${directory.path}/file");
+  var data = new List<int>(FILE_LENGTH);
+  for (int i = 0; i < FILE_LENGTH; i++) data[i] = expectedByte(i);
+  file.writeAsBytesSync(data);
+  return file;
+}
+
+
+void testMapRead(Directory directory) {
+  var file = createFile(directory);
+  var raf = file.openSync();
+  var list = raf.mapSync(access: FileMapAccess.SEQUENTIAL);
+  Expect.isTrue(list is Uint8List);
+  Expect.equals(FILE_LENGTH, list.length);
+  for (int i = 0; i < FILE_LENGTH; i++) {
+    Expect.equals(expectedByte(i), list[i]);
+  }
+  // Positions do not have to be aligned to pages.
+  var positions = [1, 4095, 4096, 4097, 65537, FILE_LENGTH - 1];
+  for (var position in positions) {
+    list = raf.mapSync(position: position,
+                       length: 1,
+                       access: FileMapAccess.RANDOM);
+    Expect.equals(1, list.length);
+    Expect.equals(expectedByte(position), list[0]);
+  }
+  list = raf.mapSync(position: 5000);
+  Expect.equals(FILE_LENGTH - 5000, list.length);
+  Expect.equals(expectedByte(5000), list[0]);
+  Expect.equals(0, raf.mapSync(position: FILE_LENGTH).length);
+  // Changes to a list mapped for reading are not written to the file.
+  list[0] = expectedByte(5000) + 1;
+  Expect.equals(expectedByte(5000) + 1, list[0]);
+  raf.closeSync();
+  // The mapping stays valid after the file is closed.
+  Expect.equals(expectedByte(5001), list[1]);
+  Expect.equals(expectedByte(5000), file.readAsBytesSync()[5000]);
+  directory.deleteSync(recursive: true);
+}
+
+
+void testMapReadWrite(Directory directory) {
+  var file = createFile(directory);
+  var raf = file.openSync(FileMode.APPEND);
+  var list = raf.mapSync(mode: FileMapMode.READ_WRITE, position: 10000,
+                         length: 100);
+  var other = raf.mapSync(mode: FileMapMode.READ_WRITE);
+  for (int i = 0; i < 100; i++) list[i] = 0xFF - expectedByte(10000 + i);
+  // Every shared mapping of the file sees the changes.
+  for (int i = 0; i < 100; i++) {
+    Expect.equals(0xFF - expectedByte(10000 + i), other[10000 + i]);
+  }
+  raf.closeSync();
+  var data = file.readAsBytesSync();
+  Expect.equals(FILE_LENGTH, data.length);
+  for (int i = 0; i < FILE_LENGTH; i++) {
+    var expected = expectedByte(i);
+    if (i >= 10000 && i < 10100) expected = 0xFF - expected;
+    Expect.equals(expected, data[i]);
+  }
+  directory.deleteSync(recursive: true);
+}
+
+
+void testMapErrors(Directory directory) {
+  var file = createFile(directory);
+  var raf = file.openSync();
+  Expect.throws(() => raf.mapSync(position: -1),
+                (e) => e is RangeError);
+  Expect.throws(() => raf.mapSync(position: 1, length: FILE_LENGTH),
+                (e) => e is RangeError);
+  Expect.throws(() => raf.mapSync(position: FILE_LENGTH + 1),
+                (e) => e is RangeError);
+  // Files opened for reading cannot be mapped for writing.
+  Expect.throws(() => raf.mapSync(mode: FileMapMode.READ_WRITE),
+                (e) => e is FileIOException && e.osError != null);
+  raf.closeSync();
+  Expect.throws(() => raf.mapSync(), (e) => e is FileIOException);
+  directory.deleteSync(recursive: true);
+}
+
+
+main() {
+  testMapRead(new Directory("").createTempSync());
+  testMapReadWrite(new Directory("").createTempSync());
+  testMapErrors(new Directory("").createTempSync());
+}
@@ -0,0 +1,132 @@
+// Copyright (c) 2013, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// Test positional reads and writes of random access files.
+
+import "dart:async";
+import "dart:io";
+import "dart:isolate";
+import "dart:scalarlist";
+
+const CHUNK_SIZE = 1000;
+const CHUNKS = 20;
+
+int expectedByte(int position) => (position * 7) & 0xFF;
+
+List<int> chunkData(int chunk) {
+  var data = new List<int>(CHUNK_SIZE);
+  for (int i = 0; i < CHUNK_SIZE; i++) {
+    data[i] = expectedByte(chunk * CHUNK_SIZE + i);
+  }
+  return data;
+}
+
+
+// Writes the chunks of the file in reverse order, alternating between
+// transferable and ordinary buffers, and reads them back the same way.
+void testReadWriteAt(Directory directory) {
+  var keepAlive = new ReceivePort();
+  var file = new File("${directory.path}/file");
+  var raf = file.openSync(FileMode.WRITE);
+  var writes = [];
+  for (int chunk = CHUNKS - 1; chunk >= 0; chunk--) {
+    var data = chunkData(chunk);
+    var buffer = data;
+    if (chunk.isEven) {
+      buffer = new Uint8List.transferable(CHUNK_SIZE);
+      buffer.setRange(0, CHUNK_SIZE, data);
+    }
+    writes.add(raf.writeListAt(buffer, 0, CHUNK_SIZE, chunk * CHUNK_SIZE));
+  }
+  Expect.throws(raf.closeSync, (e) => e is FileIOException);
+  Future.wait(writes).then((_) {
+    Expect.equals(CHUNKS * CHUNK_SIZE, raf.lengthSync());
+    // The current position is not used or changed.
+    Expect.equals(0, raf.positionSync());
+    var reads = [];
+    var buffers = [];
+    for (int chunk = 0; chunk < CHUNKS; chunk++) {
+      var buffer = chunk.isEven ?
+          new Uint8List.transferable(CHUNK_SIZE + 2) :
+          new List<int>.fixedLength(CHUNK_SIZE + 2);
+      buffers.add(buffer);
+      reads.add(raf.readListAt(buffer, 1, CHUNK_SIZE, chunk * CHUNK_SIZE));
+    }
+    // Reads at the end of the file are short.
+    reads.add(raf.readListAt(new List<int>(10), 0, 10, CHUNKS * CHUNK_SIZE - 3));
+    reads.add(raf.readListAt(new List<int>(10), 0, 10, CHUNKS * CHUNK_SIZE));
+    return Future.wait(reads).then((results) {
+      for (int chunk = 0; chunk < CHUNKS; chunk++) {
+        Expect.equals(CHUNK_SIZE, results[chunk]);
+        var buffer = buffers[chunk];
+        for (int i = 0; i < CHUNK_SIZE; i++) {
+          Expect.equals(expectedByte(chunk * CHUNK_SIZE + i), buffer[i + 1]);
+        }
+      }
+      Expect.equals(3, results[CHUNKS]);
+      Expect.equals(0, results[CHUNKS + 1]);
+    });
+  }).then((_) {
+    return raf.readListAt([], 0, 1, 0).catchError((e) {
+      Expect.isTrue(e.error is RangeError);
+    });
+  }).then((_) => raf.close()).then((_) {
+    return raf.writeListAt([1], 0, 1, 0).catchError((e) {
+      Expect.isTrue(e.error is FileIOException);
+    });
+  }).then((_) {
+    directory.deleteSync(recursive: true);
+    keepAlive.close();
+  });
+}
+
+
+// External lists other than Uint8List are copied, so their offsets and
+// lengths count elements like for any other list.
+void testReadWriteAtWithNonByteList(Directory directory) {
+  var keepAlive = new ReceivePort();
+  var file = new File("${directory.path}/file");
+  var raf = file.openSync(FileMode.WRITE);
+  var source = new Uint16List.transferable(6);
+  for (int i = 0; i < 6; i++) source[i] = i + 1;
+  var target = new Int32List.transferable(6);
+  var signed = new Int8List.transferable(3);
+  raf.writeListAt(source, 1, 4, 0).then((_) {
+    Expect.equals(4, raf.lengthSync());
+    return raf.readListAt(target, 2, 4, 0);
+  }).then((read) {
+    Expect.equals(4, read);
+    Expect.listEquals([0, 0, 2, 3, 4, 5], target);
+    return raf.readListAt(signed, 1, 2, 2);
+  }).then((read) {
+    Expect.equals(2, read);
+    Expect.listEquals([0, 4, 5], signed);
+    raf.closeSync();
+    directory.deleteSync(recursive: true);
+    keepAlive.close();
+  });
+}
+
+
+void testWriteAtOnReadOnlyError(Directory directory) {
+  var keepAlive = new ReceivePort();
+  var file = new File("${directory.path}/file");
+  file.createSync();
+  var raf = file.openSync();
+  raf.writeListAt([1, 2, 3], 0, 3, 0).catchError((e) {
+    Expect.isTrue(e.error is FileIOException);
+    Expect.isTrue(e.error.osError != null);
+  }).then((_) {
+    raf.closeSync();
+    directory.deleteSync(recursive: true);
+    keepAlive.close();
+  });
+}
+
+
+main() {
+  testReadWriteAt(new Directory("").createTempSync());
+  testWriteAtOnReadOnlyError(new Directory("").createTempSync());
+  testReadWriteAtWithNonByteList(new Directory("").createTempSync());
+}
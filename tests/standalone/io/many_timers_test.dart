@@ -0,0 +1,42 @@
+// Copyright (c) 2013, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// Test many concurrent timers with deadlines spread over several levels of
+// the timing wheel of the event handler.
+
+import "dart:async";
+
+const TIMERS = 20000;
+
+int fired = 0;
+
+
+Timer startTimer(int index) {
+  int delay = (index * 7919) % 1500;
+  int wakeupTime = new DateTime.now().millisecondsSinceEpoch + delay;
+  return new Timer(delay, (timer) {
+    Expect.isTrue(index % 3 != 0);
+    // Timers never fire early.
+    var now = new DateTime.now().millisecondsSinceEpoch;
+    Expect.isTrue(now >= wakeupTime);
+    fired++;
+  });
+}
+
+
+main() {
+  var timers = new List(TIMERS);
+  for (int i = 0; i < TIMERS; i++) {
+    timers[i] = startTimer(i);
+  }
+  // The cancelled timers never fire.
+  int cancelled = 0;
+  for (int i = 0; i < TIMERS; i += 3) {
+    timers[i].cancel();
+    cancelled++;
+  }
+  new Timer(2000, (timer) {
+    Expect.equals(TIMERS - cancelled, fired);
+  });
+}
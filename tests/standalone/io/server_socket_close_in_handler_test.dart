@@ -0,0 +1,63 @@
+// Copyright (c) 2013, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// Test closing a server socket from its connection handler while other
+// connections are pending. Every client connection must be closed.
+
+import "dart:io";
+import "dart:isolate";
+
+const HOST = "127.0.0.1";
+const CONNECTIONS = 50;
+
+void testCloseInConnectionHandler() {
+  var keepAlive = new ReceivePort();
+  var server = new ServerSocket(HOST, 0, CONNECTIONS);
+  var sockets = new List<Socket>.fixedLength(CONNECTIONS);
+  var finished = new Set<int>();
+  int connected = 0;
+  int accepted = 0;
+
+  void done(int i) {
+    finished.add(i);
+    if (finished.length == CONNECTIONS) keepAlive.close();
+  }
+
+  void connectionHandler(Socket connection) {
+    accepted++;
+    Expect.equals(1, accepted);
+    connection.close();
+    server.close();
+  }
+
+  void connectHandler() {
+    connected++;
+    if (connected < CONNECTIONS) return;
+    for (int i = 0; i < CONNECTIONS; i++) {
+      var socket = sockets[i];
+      socket.onData = () => socket.read();
+      socket.onClosed = () {
+        socket.close();
+        done(i);
+      };
+      socket.onError = (e) {
+        socket.close();
+        done(i);
+      };
+    }
+    // Only start accepting once all connections are pending on the
+    // listening socket.
+    server.onConnection = connectionHandler;
+  }
+
+  for (int i = 0; i < CONNECTIONS; i++) {
+    sockets[i] = new Socket(HOST, server.port);
+    sockets[i].onConnect = connectHandler;
+  }
+}
+
+
+main() {
+  testCloseInConnectionHandler();
+}
@@ -0,0 +1,48 @@
+// Copyright (c) 2013, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// Test binding several shared server sockets to the same port.
+
+import "dart:io";
+import "dart:isolate";
+
+const HOST = "127.0.0.1";
+const SERVERS = 4;
+const CONNECTIONS = 200;
+
+void testSharedServerSockets() {
+  var servers = new List<ServerSocket>.fixedLength(SERVERS);
+  servers[0] = new ServerSocket(HOST, 0, 128, shared: true);
+  int port = servers[0].port;
+  for (int i = 1; i < SERVERS; i++) {
+    servers[i] = new ServerSocket(HOST, port, 128, shared: true);
+  }
+  // Binding a server socket which is not shared to the port fails.
+  Expect.throws(() => new ServerSocket(HOST, port, 128),
+                (e) => e is SocketIOException);
+
+  int accepted = 0;
+  void closeServers() {
+    for (int i = 0; i < SERVERS; i++) {
+      servers[i].close();
+    }
+  }
+  for (int i = 0; i < SERVERS; i++) {
+    servers[i].onConnection = (Socket connection) {
+      connection.close();
+      accepted++;
+      if (accepted == CONNECTIONS) closeServers();
+    };
+  }
+
+  for (int i = 0; i < CONNECTIONS; i++) {
+    var socket = new Socket(HOST, port);
+    socket.onConnect = () => socket.close();
+  }
+}
+
+
+main() {
+  testSharedServerSockets();
+}
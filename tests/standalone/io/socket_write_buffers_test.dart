@@ -0,0 +1,89 @@
+// Copyright (c) 2013, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// Test writing several buffers and a file to a socket in one call.
+
+import "dart:io";
+import "dart:isolate";
+import "dart:scalarlist";
+
+const HOST = "127.0.0.1";
+
+// Sends the data written by the client to the [done] callback once the
+// client closes the connection.
+ServerSocket startServer(void done(ServerSocket server, List<int> received)) {
+  var server = new ServerSocket(HOST, 0, 5);
+  server.onConnection = (Socket connection) {
+    var received = [];
+    connection.onData = () => received.addAll(connection.read());
+    connection.onClosed = () {
+      connection.close();
+      done(server, received);
+    };
+  };
+  return server;
+}
+
+
+void testWriteBuffers() {
+  var keepAlive = new ReceivePort();
+  var typed = new Uint8List(3);
+  typed[0] = 4;
+  typed[1] = 5;
+  typed[2] = 6;
+  var buffers = [[0, 1, 2, 3], typed, [], "789".charCodes, [10]];
+  var server = startServer((server, received) {
+    Expect.listEquals([2, 3, 4, 5, 6, 55, 56, 57, 10], received);
+    server.close();
+    keepAlive.close();
+  });
+  var socket = new Socket(HOST, server.port);
+  socket.onConnect = () {
+    Expect.equals(9, socket.writeBuffers(buffers, 2));
+    Expect.equals(0, socket.writeBuffers([]));
+    Expect.throws(() => socket.writeBuffers(buffers, 5),
+                  (e) => e is RangeError);
+    socket.close(true);
+  };
+}
+
+
+void testWriteFile() {
+  var keepAlive = new ReceivePort();
+  var file = new File(new Options().script).openSync();
+  List<int> contents = new Uint8List(file.lengthSync());
+  Expect.equals(contents.length,
+                file.readListSync(contents, 0, contents.length));
+  file.setPositionSync(7);
+  var server = startServer((server, received) {
+    Expect.listEquals(contents.getRange(10, contents.length - 10), received);
+    server.close();
+    file.closeSync();
+    keepAlive.close();
+  });
+  var socket = new Socket(HOST, server.port);
+  socket.onConnect = () {
+    int count = contents.length - 10;
+    int written = 0;
+    void write() {
+      written += socket.writeFile(file, 10 + written, count - written);
+      // The position of the file is not used or changed.
+      Expect.equals(7, file.positionSync());
+      if (written < count) {
+        socket.onWrite = write;
+      } else {
+        socket.close(true);
+      }
+    }
+    write();
+    Expect.throws(() => socket.writeFile(file, -1, 1),
+                  (e) => e is RangeError);
+  };
+}
+
+
+main() {
+  testWriteBuffers();
+  testWriteFile();
+}